@@ -0,0 +1,290 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#include "srsran/common/crash_handler.h"
+#include "srsran/phy/io/filesource.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+
+#ifndef DISABLE_RF
+#include "srsran/phy/rf/rf.h"
+#endif
+
+#define MHZ 1000000
+#define MAX_EARFCN 1000
+
+int    band         = -1;
+int    earfcn_start = -1, earfcn_end = -1;
+int    earfcn_step  = 1;
+double center_freq  = 0.0;
+double srate        = 23.04e6;
+float  capture_ms   = 60.0f;
+
+uint32_t nof_threads      = 0;
+uint32_t max_frames       = SRSRAN_DEFAULT_MAX_FRAMES_PSS;
+uint32_t nof_valid_frames = SRSRAN_DEFAULT_NOF_VALID_PSS_FRAMES;
+
+char* input_file_name = NULL;
+float rf_gain         = 70.0;
+char* rf_args         = "";
+char* rf_dev          = "";
+
+void usage(char* prog)
+{
+  printf("Usage: %s [agdiseSlrmnt] -b band\n", prog);
+  printf("\t-i input file, complex float samples at the capture sampling rate [Default use RF]\n");
+#ifndef DISABLE_RF
+  printf("\t-a RF args [Default %s]\n", rf_args);
+  printf("\t-d RF devicename, e.g. zmq [Default %s]\n", rf_dev);
+  printf("\t-g RF gain [Default %.2f dB]\n", rf_gain);
+#endif
+  printf("\t-s earfcn_start [Default All]\n");
+  printf("\t-e earfcn_end [Default All]\n");
+  printf("\t-S earfcn_step [Default %d]\n", earfcn_step);
+  printf("\t-l capture centre frequency in Hz [Default centre of the searched EARFCNs]\n");
+  printf("\t-r capture sampling rate, a multiple of %.2f MHz [Default %.2f MHz]\n",
+         SRSRAN_CS_SAMP_FREQ / MHZ,
+         srate / MHZ);
+  printf("\t-m capture length in ms [Default %.1f]\n", capture_ms);
+  printf("\t-n nof_frames_total [Default %d]\n", max_frames);
+  printf("\t-t number of threads, 0 for one per CPU core [Default %d]\n", nof_threads);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "agdiseSlrmntvb")) != -1) {
+    switch (opt) {
+      case 'a':
+        rf_args = argv[optind];
+        break;
+      case 'b':
+        band = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        rf_dev = argv[optind];
+        break;
+      case 'g':
+        rf_gain = strtof(argv[optind], NULL);
+        break;
+      case 'i':
+        input_file_name = argv[optind];
+        break;
+      case 's':
+        earfcn_start = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        earfcn_end = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'S':
+        earfcn_step = SRSRAN_MAX((int)strtol(argv[optind], NULL, 10), 1);
+        break;
+      case 'l':
+        center_freq = strtod(argv[optind], NULL);
+        break;
+      case 'r':
+        srate = strtod(argv[optind], NULL);
+        break;
+      case 'm':
+        capture_ms = strtof(argv[optind], NULL);
+        break;
+      case 'n':
+        max_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (band == -1) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static int capture_file(cf_t* buffer, uint32_t nsamples)
+{
+  srsran_filesource_t file_source = {};
+
+  if (srsran_filesource_init(&file_source, input_file_name, SRSRAN_COMPLEX_FLOAT_BIN)) {
+    ERROR("Error opening file %s", input_file_name);
+    return SRSRAN_ERROR;
+  }
+  int n = srsran_filesource_read(&file_source, buffer, (int)nsamples);
+  srsran_filesource_free(&file_source);
+  return n;
+}
+
+#ifndef DISABLE_RF
+static int capture_rf(cf_t* buffer, uint32_t nsamples)
+{
+  srsran_rf_t rf = {};
+
+  printf("Opening RF device...\n");
+  if (srsran_rf_open_devname(&rf, rf_dev, rf_args, 1)) {
+    ERROR("Error opening rf");
+    return SRSRAN_ERROR;
+  }
+  srsran_rf_set_rx_gain(&rf, rf_gain);
+  srsran_rf_set_rx_freq(&rf, 0, center_freq);
+  srsran_rf_set_rx_srate(&rf, srate);
+  srsran_rf_start_rx_stream(&rf, false);
+
+  int n = srsran_rf_recv_with_time(&rf, buffer, nsamples, true, NULL, NULL);
+
+  srsran_rf_stop_rx_stream(&rf);
+  srsran_rf_close(&rf);
+  return n;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  srsran_earfcn_t                channels[MAX_EARFCN];
+  double                         channel_freq_hz[MAX_EARFCN];
+  uint32_t                       channel_earfcn[MAX_EARFCN];
+  uint32_t                       nof_channels = 0;
+  srsran_ue_cellsearch_wb_t      cs           = {};
+  srsran_ue_cellsearch_wb_args_t args         = {};
+  struct timeval                 t[3]         = {};
+
+  srsran_debug_handle_crash(argc, argv);
+
+  parse_args(argc, argv);
+
+  int nof_freqs = srsran_band_get_fd_band(band, channels, earfcn_start, earfcn_end, MAX_EARFCN);
+  if (nof_freqs <= 0) {
+    ERROR("Error getting EARFCN list");
+    exit(-1);
+  }
+  if (center_freq == 0.0) {
+    center_freq = (channels[0].fd + channels[nof_freqs - 1].fd) / 2 * MHZ;
+  }
+
+  // Keep the EARFCNs whose 6 central PRB are within the capture bandwidth
+  for (int i = 0; i < nof_freqs; i += earfcn_step) {
+    double f = channels[i].fd * MHZ;
+    if (fabs(f - center_freq) <= (srate - SRSRAN_CS_SAMP_FREQ) / 2) {
+      channel_freq_hz[nof_channels] = f;
+      channel_earfcn[nof_channels]  = channels[i].id;
+      nof_channels++;
+    }
+  }
+  if (nof_channels == 0) {
+    ERROR("No EARFCN within %.2f MHz around %.2f MHz", srate / MHZ, center_freq / MHZ);
+    exit(-1);
+  }
+
+  args.srate_hz         = srate;
+  args.center_freq_hz   = center_freq;
+  args.max_samples      = (uint32_t)(srate * capture_ms / 1000);
+  args.max_frames       = max_frames;
+  args.nof_valid_frames = SRSRAN_MIN(nof_valid_frames, max_frames);
+  args.nof_threads      = nof_threads;
+  if (srsran_ue_cellsearch_wb_init(&cs, &args, channel_freq_hz, nof_channels)) {
+    ERROR("Error initiating wideband cell search");
+    exit(-1);
+  }
+
+  cf_t* buffer = srsran_vec_cf_malloc(args.max_samples);
+  if (buffer == NULL) {
+    exit(-1);
+  }
+
+  printf("Capturing %.1f ms at %.2f MHz, %.2f Msps, %d EARFCNs from %d to %d\n",
+         capture_ms,
+         center_freq / MHZ,
+         srate / MHZ,
+         nof_channels,
+         channel_earfcn[0],
+         channel_earfcn[nof_channels - 1]);
+
+  int nof_samples = SRSRAN_ERROR;
+  if (input_file_name) {
+    nof_samples = capture_file(buffer, args.max_samples);
+  } else {
+#ifndef DISABLE_RF
+    nof_samples = capture_rf(buffer, args.max_samples);
+#else
+    ERROR("Compiled without RF support, an input file is needed");
+#endif
+  }
+  if (nof_samples <= 0) {
+    ERROR("Error capturing samples");
+    exit(-1);
+  }
+
+  gettimeofday(&t[1], NULL);
+  int n = srsran_ue_cellsearch_wb_scan(&cs, buffer, (uint32_t)nof_samples);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  if (n < 0) {
+    ERROR("Error searching cells");
+    exit(-1);
+  }
+
+  uint32_t n_found_cells = 0;
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+      srsran_ue_cellsearch_result_t* cell = &cs.channels[c].found_cells[N_id_2];
+      if (cell->psr > 2.0) {
+        printf("Found CELL %.1f MHz, EARFCN=%d, PHYID=%d, CP=%s, PSR=%.1f, CFO=%+.1f kHz, PSS power=%.1f dBfs\n",
+               cs.channels[c].freq_hz / MHZ,
+               channel_earfcn[c],
+               cell->cell_id,
+               srsran_cp_string(cell->cp),
+               cell->psr,
+               cell->cfo / 1000,
+               srsran_convert_power_to_dB(cell->peak));
+        n_found_cells++;
+      }
+    }
+  }
+
+  double duration_s = t[0].tv_sec + t[0].tv_usec * 1e-6;
+  printf("\n\nFound %d cells in %d EARFCNs in %.2f s with %d threads, %.1f cells/s\n",
+         n_found_cells,
+         nof_channels,
+         duration_s,
+         cs.nof_workers,
+         n_found_cells / duration_s);
+
+  printf("\nBye\n");
+
+  srsran_ue_cellsearch_wb_free(&cs);
+  free(buffer);
+  exit(0);
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_INTERVAL_SET_H
+#define SRSRAN_INTERVAL_SET_H
+
+#include "interval.h"
+#include <algorithm>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Set of points represented as disjoint, sorted, half-open intervals.
+ * Overlapping or adjacent intervals are merged on insertion, so e.g. the received byte ranges of a segmented SDU
+ * collapse into a single interval once all the segments are received. The list of intervals grows as needed.
+ */
+template <typename T>
+class interval_set
+{
+  using interval_list = std::vector<interval<T> >;
+
+public:
+  using const_iterator = typename interval_list::const_iterator;
+
+  /// Adds [start, stop) to the set
+  void add(T start, T stop)
+  {
+    if (start >= stop) {
+      return;
+    }
+    auto first = std::find_if(intervals.begin(), intervals.end(), [start](const interval<T>& i) {
+      return i.stop() >= start;
+    });
+    auto last  = std::find_if(first, intervals.end(), [stop](const interval<T>& i) { return i.start() > stop; });
+    if (first != last) {
+      // merge with all the intervals that overlap or touch [start, stop)
+      first->set(std::min(start, first->start()), std::max(stop, (last - 1)->stop()));
+      intervals.erase(first + 1, last);
+      return;
+    }
+    intervals.insert(first, interval<T>{start, stop});
+  }
+
+  /// Checks whether all points in [start, stop) belong to the set
+  bool contains(T start, T stop) const
+  {
+    return std::any_of(intervals.begin(), intervals.end(), [start, stop](const interval<T>& i) {
+      return i.start() <= start and stop <= i.stop();
+    });
+  }
+
+  void   clear() { intervals.clear(); }
+  bool   empty() const { return intervals.empty(); }
+  size_t nof_intervals() const { return intervals.size(); }
+
+  const_iterator begin() const { return intervals.begin(); }
+  const_iterator end() const { return intervals.end(); }
+
+private:
+  interval_list intervals;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_INTERVAL_SET_H
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TRIPLE_BUFFER_H
+#define SRSRAN_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace srsran {
+
+/**
+ * Wait-free single-writer/single-reader channel that always gives the reader the last value published by the writer.
+ * The writer fills write_buffer() and calls publish(). The reader calls update() and, if it returns true, a more
+ * recent value is available in read_buffer(). Intermediate values may be skipped by the reader, and neither side ever
+ * blocks or copies the value.
+ */
+template <typename T>
+class triple_buffer
+{
+public:
+  triple_buffer() = default;
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+
+  /// Writer side. Buffer owned by the writer until the next publish()
+  T& write_buffer() { return buffers[write_idx]; }
+
+  /// Writer side. Makes the content of write_buffer() visible to the reader
+  void publish()
+  {
+    uint8_t prev = middle.exchange(write_idx | dirty_flag, std::memory_order_acq_rel);
+    write_idx    = prev & index_mask;
+  }
+
+  /// Reader side. Fetches the last published value. Returns false if nothing new was published since the last call
+  bool update()
+  {
+    if ((middle.load(std::memory_order_relaxed) & dirty_flag) == 0) {
+      return false;
+    }
+    uint8_t prev = middle.exchange(read_idx, std::memory_order_acq_rel);
+    read_idx     = prev & index_mask;
+    return true;
+  }
+
+  /// Reader side. Buffer owned by the reader until the next update()
+  const T& read_buffer() const { return buffers[read_idx]; }
+
+private:
+  static const uint8_t dirty_flag = 0x4;
+  static const uint8_t index_mask = 0x3;
+
+  std::array<T, 3>     buffers   = {};
+  uint8_t              write_idx = 0;
+  uint8_t              read_idx  = 1;
+  std::atomic<uint8_t> middle{2};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TRIPLE_BUFFER_H
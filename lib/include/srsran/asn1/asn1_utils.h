@@ -29,7 +29,10 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <new>
 #include <string>
+#include <vector>
 
 namespace asn1 {
 
@@ -188,6 +191,58 @@ public:
 /*********************
   function helpers
 *********************/
+
+/**
+ * Monotonic memory arena for the storage of dyn_arrays.
+ * While a dyn_array_arena_scope is active in a thread, the dyn_arrays allocated by that thread take their storage from
+ * the arena instead of the heap, which avoids one heap allocation per decoded SEQUENCE OF/OCTET STRING in large message
+ * trees. Memory is only given back when the arena is reset, so the dyn_arrays allocated from it must be destroyed
+ * before calling reset() or destroying the arena.
+ */
+class dyn_array_arena
+{
+public:
+  explicit dyn_array_arena(size_t block_size_ = 16384) : block_size(block_size_) {}
+  dyn_array_arena(const dyn_array_arena&) = delete;
+  dyn_array_arena& operator=(const dyn_array_arena&) = delete;
+
+  void* allocate(size_t sz, size_t alignment);
+  void  reset();
+
+  size_t nof_bytes_used() const { return bytes_used; }
+  size_t nof_blocks() const { return blocks.size(); }
+
+  /// Arena selected by the calling thread, or nullptr if dyn_arrays are allocated from the heap
+  static dyn_array_arena* current();
+
+private:
+  friend class dyn_array_arena_scope;
+
+  struct block_t {
+    std::unique_ptr<uint8_t[]> mem;
+    size_t                     size;
+  };
+
+  size_t               block_size;
+  std::vector<block_t> blocks;
+  size_t               block_idx    = 0;
+  size_t               block_offset = 0;
+  size_t               bytes_used   = 0;
+};
+
+/// RAII guard that selects an arena for the dyn_arrays allocated by the calling thread during its lifetime
+class dyn_array_arena_scope
+{
+public:
+  explicit dyn_array_arena_scope(dyn_array_arena& arena);
+  dyn_array_arena_scope(const dyn_array_arena_scope&) = delete;
+  dyn_array_arena_scope& operator=(const dyn_array_arena_scope&) = delete;
+  ~dyn_array_arena_scope();
+
+private:
+  dyn_array_arena* prev_arena;
+};
+
 template <class T>
 class dyn_array
 {
@@ -197,14 +252,14 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = allocate(size_, in_arena_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = allocate(cap_, in_arena_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
@@ -213,7 +268,7 @@ public:
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      deallocate(data_, cap_, in_arena_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -239,10 +294,12 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*       old_data     = data_;
+    uint32_t old_cap      = cap_;
+    bool     old_in_arena = in_arena_;
+    cap_                  = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = allocate(cap_, in_arena_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -252,7 +309,7 @@ public:
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      deallocate(old_data, old_cap, old_in_arena);
     }
   }
   iterator erase(iterator it)
@@ -287,9 +344,35 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
-  T*       data_ = nullptr;
-  uint32_t size_ = 0;
-  uint32_t cap_  = 0;
+  static T* allocate(uint32_t nof_items, bool& in_arena)
+  {
+    dyn_array_arena* arena = dyn_array_arena::current();
+    in_arena               = arena != nullptr;
+    if (not in_arena) {
+      return new T[nof_items];
+    }
+    T* mem = static_cast<T*>(arena->allocate(sizeof(T) * nof_items, alignof(T)));
+    for (uint32_t i = 0; i < nof_items; ++i) {
+      new (mem + i) T;
+    }
+    return mem;
+  }
+  static void deallocate(T* mem, uint32_t nof_items, bool in_arena)
+  {
+    if (not in_arena) {
+      delete[] mem;
+      return;
+    }
+    // The arena memory is only given back on arena reset
+    for (uint32_t i = 0; i < nof_items; ++i) {
+      mem[i].~T();
+    }
+  }
+
+  T*       data_     = nullptr;
+  uint32_t size_     = 0;
+  uint32_t cap_      = 0;
+  bool     in_arena_ = false;
 };
 
 template <class T, uint32_t MAX_N>
@@ -100,8 +100,9 @@ public:
 #endif
 
   struct buffer_metadata_t {
-    uint32_t            pdcp_sn = 0;
-    buffer_latency_calc tp;
+    uint32_t                              pdcp_sn = 0;
+    buffer_latency_calc                   tp;
+    std::chrono::steady_clock::time_point queue_tp; ///< time of arrival to the RLC Tx queue, set with AQM enabled
   } md;
 
   byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_OFFLOAD_EXECUTOR_H
+#define SRSRAN_OFFLOAD_EXECUTOR_H
+
+#include "task_scheduler.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace srsran {
+
+/**
+ * Executor that runs the CPU-heavy, state-less part of a procedure (e.g. ASN.1 decoding) in a dedicated worker thread,
+ * and hands its result back to the thread that runs the task_scheduler passed in start().
+ * Jobs are run one at a time and in order of submission, and their completions are delivered through a single task
+ * queue, so the completions are observed by the scheduler thread in the same order the jobs were submitted.
+ * Jobs are never discarded. When "queue_size" jobs are pending, execute() blocks the scheduler thread and runs the
+ * completions of the oldest jobs inline, as they become ready, until there is room for the new job.
+ * While the executor is not started, the job and its completion are both run inline by the caller.
+ */
+class offload_executor
+{
+public:
+  explicit offload_executor(std::string name_ = "CTRL_OFFLOAD") : name(std::move(name_)) {}
+  offload_executor(const offload_executor&) = delete;
+  offload_executor& operator=(const offload_executor&) = delete;
+  ~offload_executor() { stop(); }
+
+  //! Launches the worker thread. The completions of the jobs are run by the thread running "sched"
+  void start(task_scheduler* sched, int32_t prio = -1, uint32_t queue_size = 512)
+  {
+    if (worker != nullptr) {
+      return;
+    }
+    max_pending      = queue_size;
+    completion_queue = sched->make_task_queue(queue_size);
+    worker.reset(new task_worker(name, queue_size, false, prio));
+  }
+
+  //! Stops the worker thread. Jobs that did not complete yet are discarded
+  void stop()
+  {
+    if (worker != nullptr) {
+      worker->stop();
+      worker.reset();
+      completion_queue.reset();
+      std::lock_guard<std::mutex> lock(completed_mutex);
+      completed.clear();
+      drain_scheduled = false;
+      nof_pending     = 0;
+    }
+  }
+
+  bool is_started() const { return worker != nullptr; }
+
+  //! Total time spent by the worker thread running jobs
+  std::chrono::microseconds busy_time() const
+  {
+    return std::chrono::microseconds(busy_time_us.load(std::memory_order_relaxed));
+  }
+
+  //! Total time spent by the scheduler thread running the completions of the jobs
+  std::chrono::microseconds completion_time() const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(completion_busy);
+  }
+
+  /**
+   * Runs "job()" in the worker thread and then "then(job())" in the scheduler thread.
+   * The job must not access state owned by the scheduler thread. Its return type must be default-constructible and
+   * movable. Must be called from the scheduler thread.
+   */
+  template <typename Job, typename Then>
+  void execute(Job&& job, Then&& then)
+  {
+    if (worker == nullptr) {
+      then(job());
+      return;
+    }
+    // Control-plane work cannot be dropped. Wait for the oldest jobs to finish and complete them here, so that the
+    // completions are still observed in order of submission
+    while (nof_pending >= max_pending) {
+      complete_next(true);
+    }
+    nof_pending++;
+    using item_t = work_item<typename std::decay<Job>::type, typename std::decay<Then>::type>;
+    std::unique_ptr<work_item_base> item(new item_t(std::forward<Job>(job), std::forward<Then>(then)));
+    worker->push_task([this, item = std::move(item)]() mutable {
+      auto t_start = std::chrono::steady_clock::now();
+      item->run();
+      busy_time_us.fetch_add(
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count(),
+          std::memory_order_relaxed);
+      bool schedule_drain = false;
+      {
+        std::lock_guard<std::mutex> lock(completed_mutex);
+        completed.push_back(std::move(item));
+        schedule_drain  = not drain_scheduled;
+        drain_scheduled = true;
+      }
+      completed_cvar.notify_one();
+      if (schedule_drain) {
+        // Cannot fail, as at most one drain task is enqueued at any time
+        completion_queue.try_push([this]() {
+          while (complete_next(false)) {
+          }
+        });
+      }
+    });
+  }
+
+private:
+  struct work_item_base {
+    virtual ~work_item_base() = default;
+    virtual void run()        = 0;
+    virtual void complete()   = 0;
+  };
+  template <typename Job, typename Then>
+  struct work_item final : public work_item_base {
+    template <typename J, typename T>
+    work_item(J&& job_, T&& then_) : job(std::forward<J>(job_)), then(std::forward<T>(then_))
+    {}
+    void run() override { result = job(); }
+    void complete() override { then(std::move(result)); }
+
+    Job                                                         job;
+    Then                                                        then;
+    typename std::decay<decltype(std::declval<Job&>()())>::type result{};
+  };
+
+  /// Runs the completion of the oldest finished job in the scheduler thread. If "wait" is set, blocks until a job
+  /// finishes. Returns false if there was no finished job
+  bool complete_next(bool wait)
+  {
+    std::unique_ptr<work_item_base> item;
+    {
+      std::unique_lock<std::mutex> lock(completed_mutex);
+      if (wait) {
+        completed_cvar.wait(lock, [this]() { return not completed.empty(); });
+      }
+      if (completed.empty()) {
+        drain_scheduled = false;
+        return false;
+      }
+      item = std::move(completed.front());
+      completed.pop_front();
+    }
+    auto t_start = std::chrono::steady_clock::now();
+    nof_pending--;
+    item->complete();
+    completion_busy += std::chrono::steady_clock::now() - t_start;
+    return true;
+  }
+
+  std::string                  name;
+  std::unique_ptr<task_worker> worker;
+  srsran::task_queue_handle    completion_queue;
+  std::atomic<uint64_t>        busy_time_us{0};
+  // Jobs run by the worker whose completion is still to be run by the scheduler thread, in order of submission
+  std::mutex                                  completed_mutex;
+  std::condition_variable                     completed_cvar;
+  std::deque<std::unique_ptr<work_item_base>> completed;
+  bool                                        drain_scheduled = false;
+  // Only accessed by the scheduler thread
+  uint32_t                 max_pending = 0;
+  uint32_t                 nof_pending = 0; ///< jobs submitted and not completed yet
+  std::chrono::nanoseconds completion_busy{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_OFFLOAD_EXECUTOR_H
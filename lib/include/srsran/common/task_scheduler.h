@@ -27,6 +27,7 @@
 #include "multiqueue.h"
 #include "thread_pool.h"
 #include "timers.h"
+#include <chrono>
 
 namespace srsran {
 
@@ -83,8 +84,10 @@ public:
   {
     srsran::move_task_t task{};
     if (external_tasks.wait_pop(&task)) {
+      auto t0 = std::chrono::steady_clock::now();
       task();
       run_all_internal_tasks();
+      busy += std::chrono::steady_clock::now() - t0;
       return true;
     }
     run_all_internal_tasks();
@@ -104,6 +107,9 @@ public:
 
   srsran::timer_handler* get_timer_handler() { return &timers; }
 
+  //! Total time spent running tasks popped in run_next_task(), excluding the time waiting for them.
+  std::chrono::microseconds busy_time() const { return std::chrono::duration_cast<std::chrono::microseconds>(busy); }
+
 private:
   // Perform pending stack deferred tasks
   void run_all_internal_tasks()
@@ -117,6 +123,7 @@ private:
   srsran::task_multiqueue   external_tasks;
   srsran::task_queue_handle background_queue; ///< Queue for handling the outcomes of tasks run in the background
   srsran::timer_handler     timers;
+  std::chrono::nanoseconds  busy{0};
   srsran::dyn_blocking_queue<srsran::move_task_t>
       internal_tasks; ///< enqueues stack tasks from within main thread. Avoids locking
 };
@@ -32,7 +32,9 @@ struct mac_args_t {
   uint32_t                      prach_bi; ///< Backoff Indicator to prevent UE from PRACHing too fast
   sched_interface::sched_args_t sched;
   int                           lcid_padding;
-  uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
+  uint32_t                      nof_prealloc_ues;    ///< Number of UE resources to pre-allocate at eNB startup
+  uint32_t                      max_nof_softbuffers; ///< Max HARQ softbuffers per cell and direction (0: no limit)
+  bool                          rx_softbuffer_8bit;  ///< Store UL HARQ LLRs with 8-bit (requires 8-bit PUSCH decoder)
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
 };
@@ -46,12 +46,26 @@ struct pdcp_metrics_t {
   std::vector<srsran::pdcp_metrics_t> ues;
 };
 
+/// Time spent by the stack thread in each layer since the previous metrics report
+struct stack_thread_metrics_t {
+  float period_ms;  ///< wall-clock time covered by the report
+  float busy_ms;    ///< total time spent running tasks, i.e. the sum of all the fields below except offload_ms
+  float timers_ms;  ///< timer expiries of all layers
+  float rrc_ms;     ///< RRC messages and commands processed in the TTI tick
+  float s1ap_ms;    ///< messages received from the MME
+  float x2_ms;      ///< EN-DC tasks and user-plane PDUs forwarded through X2
+  float ctrl_ms;    ///< completion of the RRC/S1AP jobs run in the control-plane executor
+  float other_ms;   ///< MAC/RLC/PDCP/GTP-U user-plane tasks and any other stack task
+  float offload_ms; ///< time spent by the control-plane executor thread. Not accounted in busy_ms
+};
+
 struct stack_metrics_t {
-  mac_metrics_t  mac;
-  rrc_metrics_t  rrc;
-  rlc_metrics_t  rlc;
-  pdcp_metrics_t pdcp;
-  s1ap_metrics_t s1ap;
+  mac_metrics_t          mac;
+  rrc_metrics_t          rrc;
+  rlc_metrics_t          rlc;
+  pdcp_metrics_t         pdcp;
+  s1ap_metrics_t         s1ap;
+  stack_thread_metrics_t thread;
 };
 
 struct enb_metrics_t {
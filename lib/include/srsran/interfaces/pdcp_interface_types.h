@@ -126,6 +126,22 @@ enum class pdcp_discard_timer_t {
   infinity = -1
 };
 
+// Robust Header Compression configuration of a DRB (TS 36.323 Sec. 5.5, TS 38.323 Sec. 5.7)
+struct pdcp_rohc_config_t {
+  uint16_t max_cid     = 15;
+  bool     profile_rtp = false; ///< Profile 0x0001
+  bool     profile_udp = false; ///< Profile 0x0002
+  bool     profile_ip  = false; ///< Profile 0x0004
+
+  bool enabled() const { return profile_rtp or profile_udp or profile_ip; }
+  bool operator==(const pdcp_rohc_config_t& other) const
+  {
+    return max_cid == other.max_cid and profile_rtp == other.profile_rtp and profile_udp == other.profile_udp and
+           profile_ip == other.profile_ip;
+  }
+  bool operator!=(const pdcp_rohc_config_t& other) const { return not(*this == other); }
+};
+
 class pdcp_config_t
 {
 public:
@@ -164,15 +180,14 @@ public:
 
   bool status_report_required = false;
 
-  // TODO: Support the following configurations
-  // bool do_rohc;
+  pdcp_rohc_config_t rohc;
 
   bool operator==(const pdcp_config_t& other) const
   {
     return bearer_id == other.bearer_id and rb_type == other.rb_type and tx_direction == other.tx_direction and
            rx_direction == other.rx_direction and sn_len == other.sn_len and hdr_len_bytes == other.hdr_len_bytes and
            t_reordering == other.t_reordering and discard_timer == other.discard_timer and rat == other.rat and
-           status_report_required == other.status_report_required;
+           status_report_required == other.status_report_required and rohc == other.rohc;
   }
   bool operator!=(const pdcp_config_t& other) const { return not(*this == other); }
 
@@ -160,6 +160,36 @@ struct rlc_um_nr_config_t {
   uint8_t             bearer_id;       // This is not in the 3GPP TS 38.322
 };
 
+/// Active queue management of the RLC Tx SDU queue
+enum class rlc_aqm_type_t { none, codel, pie, nulltype };
+inline std::string to_string(const rlc_aqm_type_t& type)
+{
+  constexpr static const char* options[] = {"none", "CoDel", "PIE"};
+  return enum_to_text(options, (uint32_t)rlc_aqm_type_t::nulltype, (uint32_t)type);
+}
+
+struct rlc_aqm_config_t {
+  rlc_aqm_type_t type        = rlc_aqm_type_t::none;
+  uint32_t       target_ms   = 5;   // CoDel target sojourn time or PIE reference queueing delay
+  uint32_t       interval_ms = 100; // CoDel interval or PIE drop probability update period
+
+  // Defaults of RFC 8289 and RFC 8033
+  static rlc_aqm_config_t codel()
+  {
+    rlc_aqm_config_t cfg = {};
+    cfg.type             = rlc_aqm_type_t::codel;
+    return cfg;
+  }
+  static rlc_aqm_config_t pie()
+  {
+    rlc_aqm_config_t cfg = {};
+    cfg.type             = rlc_aqm_type_t::pie;
+    cfg.target_ms        = 15;
+    cfg.interval_ms      = 15;
+    return cfg;
+  }
+};
+
 #define RLC_TX_QUEUE_LEN (256)
 
 class rlc_config_t
@@ -172,9 +202,17 @@ public:
   rlc_um_config_t    um;
   rlc_um_nr_config_t um_nr;
   uint32_t           tx_queue_length;
+  rlc_aqm_config_t   aqm;
 
   rlc_config_t() :
-    rat(srsran_rat_t::lte), rlc_mode(rlc_mode_t::tm), am(), am_nr(), um(), um_nr(), tx_queue_length(RLC_TX_QUEUE_LEN){};
+    rat(srsran_rat_t::lte),
+    rlc_mode(rlc_mode_t::tm),
+    am(),
+    am_nr(),
+    um(),
+    um_nr(),
+    tx_queue_length(RLC_TX_QUEUE_LEN),
+    aqm(){};
 
   // Factory for MCH
   static rlc_config_t mch_config()
@@ -106,6 +106,13 @@ typedef struct SRSRAN_API {
   srsran_interp_lin_t           srsran_interp_lin_3;
   srsran_interp_lin_t           srsran_interp_lin_mbsfn;
 
+  /* Smoothing filter of the last configuration, computed again only when the configuration changes */
+  float                 smooth_filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
+  uint32_t              smooth_filter_len;
+  srsran_chest_filter_t smooth_filter_type;
+  float                 smooth_filter_coef[2];
+  bool                  smooth_filter_valid;
+
   float rssi[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float rsrp[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float rsrp_corr[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
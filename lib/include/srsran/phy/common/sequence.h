@@ -83,6 +83,23 @@ SRSRAN_API void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, ui
 
 SRSRAN_API void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed);
 
+/* Generates the sequence packed in 64 bit words, with the first bit in the LSB of the first word. The bits of the last
+ * word beyond the sequence length are set to zero. The c vector shall fit at least ceil(length / 64) words.
+ */
+SRSRAN_API void srsran_sequence_gen_packed64(uint64_t* c, uint32_t length, uint32_t seed);
+
+/* Apply a sequence previously generated with srsran_sequence_gen_packed64(), equivalent to the srsran_sequence_apply_*
+ * functions without generating the sequence again
+ */
+SRSRAN_API void srsran_sequence_packed64_apply_s(const uint64_t* c, const int16_t* in, int16_t* out, uint32_t length);
+
+SRSRAN_API void srsran_sequence_packed64_apply_c(const uint64_t* c, const int8_t* in, int8_t* out, uint32_t length);
+
+SRSRAN_API void srsran_sequence_packed64_apply_bit(const uint64_t* c, const uint8_t* in, uint8_t* out, uint32_t length);
+
+SRSRAN_API void
+srsran_sequence_packed64_apply_packed(const uint64_t* c, const uint8_t* in, uint8_t* out, uint32_t length);
+
 SRSRAN_API int srsran_sequence_pbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pcfich(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id);
@@ -126,6 +143,8 @@ SRSRAN_API void srsran_sequence_pdsch_apply_c(const int8_t* in,
                                               uint32_t      cell_id,
                                               uint32_t      len);
 
+SRSRAN_API uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API int
 srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
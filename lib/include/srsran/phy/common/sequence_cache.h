@@ -0,0 +1,133 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SEQUENCE_CACHE_H
+#define SRSRAN_SEQUENCE_CACHE_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+
+/**
+ * @brief Number of entries of every cache set
+ */
+#define SRSRAN_SEQUENCE_CACHE_NOF_WAYS 4
+
+/**
+ * @brief Cached pseudo-random sequence
+ */
+typedef struct SRSRAN_API {
+  uint32_t  seed;      ///< Sequence initialization value (c_init)
+  uint32_t  len;       ///< Number of cached sequence bits, 0 if the entry is empty
+  uint32_t  nof_words; ///< Number of allocated 64 bit words
+  uint64_t  last_use;  ///< Access counter value of the last use, for the LRU eviction
+  uint64_t* c;         ///< Packed sequence, as generated by srsran_sequence_gen_packed64()
+} srsran_sequence_cache_entry_t;
+
+/**
+ * @brief Sequence cache metrics, accumulated since the initialization or the last reset
+ */
+typedef struct SRSRAN_API {
+  uint64_t nof_hits;      ///< Number of sequences read from the cache
+  uint64_t nof_misses;    ///< Number of sequences generated
+  uint64_t nof_evictions; ///< Number of sequences replaced by a different one
+  float    hit_rate;      ///< Ratio of accesses served from the cache
+} srsran_sequence_cache_metrics_t;
+
+/**
+ * @brief Set-associative cache of packed pseudo-random sequences with Least Recently Used (LRU) eviction
+ *
+ * The sequences are identified by their initialization value, which for the physical channels scrambling already
+ * results from the RNTI, slot, codeword and cell identifier. It is not thread-safe, every physical channel object
+ * shall use its own.
+ */
+typedef struct SRSRAN_API {
+  srsran_sequence_cache_entry_t*  entries;      ///< Entries, grouped in sets of SRSRAN_SEQUENCE_CACHE_NOF_WAYS
+  uint32_t                        nof_sets;     ///< Number of sets
+  uint64_t                        access_count; ///< Access counter, for the LRU eviction
+  srsran_sequence_cache_metrics_t metrics;      ///< Accumulated metrics
+} srsran_sequence_cache_t;
+
+/**
+ * @brief Initialises a sequence cache. The sequences are allocated as they are cached
+ * @param q Sequence cache object
+ * @param nof_entries Minimum number of cached sequences, it is rounded up to a whole number of sets
+ * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries);
+
+/**
+ * @brief Releases the memory of a sequence cache
+ * @param q Sequence cache object
+ */
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+/**
+ * @brief Empties the cache and clears its metrics, keeping the allocated memory
+ * @param q Sequence cache object
+ */
+SRSRAN_API void srsran_sequence_cache_reset(srsran_sequence_cache_t* q);
+
+/**
+ * @brief Gets a packed sequence, generating it if it is not cached or shorter than the requested length
+ * @param q Sequence cache object
+ * @param seed Sequence initialization value
+ * @param length Sequence length in bits
+ * @return The packed sequence if successful, NULL otherwise. It is valid until the next access to the cache
+ */
+SRSRAN_API const uint64_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t length);
+
+/**
+ * @brief Cached equivalents of srsran_sequence_apply_s(), srsran_sequence_apply_c(), srsran_sequence_apply_bit() and
+ * srsran_sequence_apply_packed(). They generate the sequence without caching it if the cache is not available.
+ */
+SRSRAN_API void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                              const int16_t*           in,
+                                              int16_t*                 out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                              const int8_t*            in,
+                                              int8_t*                  out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                                const uint8_t*           in,
+                                                uint8_t*                 out,
+                                                uint32_t                 length,
+                                                uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                                   const uint8_t*           in,
+                                                   uint8_t*                 out,
+                                                   uint32_t                 length,
+                                                   uint32_t                 seed);
+
+/**
+ * @brief Gets the metrics accumulated since the initialization or the last reset
+ * @param q Sequence cache object
+ * @param metrics Destination of the metrics
+ */
+SRSRAN_API void srsran_sequence_cache_get_metrics(const srsran_sequence_cache_t*   q,
+                                                  srsran_sequence_cache_metrics_t* metrics);
+
+#endif // SRSRAN_SEQUENCE_CACHE_H
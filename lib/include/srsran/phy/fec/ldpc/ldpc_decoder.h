@@ -35,6 +35,11 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 
+/*!
+ * \brief Maximum number of code blocks decoded at once by a batched LDPC decoder.
+ */
+#define SRSRAN_LDPC_DECODER_MAX_BATCH 32
+
 /*!
  * \brief Types of LDPC decoder.
  */
@@ -99,6 +104,18 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+
+  void*     ptr_batch;  /*!< \brief Registers used by the batched decoder, NULL if not available. */
+  uint16_t* pcm_batch;  /*!< \brief Parity check matrix (compact form) for the interleaved code blocks. */
+  uint32_t  batch_size; /*!< \brief Number of code blocks decoded at once, 1 if the batched decoder is not available. */
+
+  int (*decode_batch_c)(void*,
+                        const int8_t* const*,
+                        uint8_t* const*,
+                        uint32_t,
+                        uint32_t,
+                        srsran_crc_t*,
+                        int*); /*!< \brief Pointer to the batched decoding function (8-bit version). */
 } srsran_ldpc_decoder_t;
 
 /*!
@@ -179,4 +196,28 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Carries out the decoding of several code blocks of the same base graph and lifting size with 8-bit integer-valued
+ * LLRs. For small lifting sizes the SIMD decoders only fill a fraction of their registers with a code block, the
+ * batched decoder interleaves up to \ref srsran_ldpc_decoder_t::batch_size code blocks in the registers and decodes
+ * them at once. Larger sets are decoded in consecutive batches, and one code block after the other if the decoder
+ * does not support batching.
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs The LLRs of each code block, each with room for the whole codeword.
+ * \param[out] messages The messages (uncoded bits) resulting from the decoding of each code block.
+ * \param[in] nof_cb The number of code blocks.
+ * \param[in] cdwd_rm_length The largest number of bits forming the codewords (after rate matching).
+ * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
+ * \param[out] results For each code block, the number of used iterations, and 0 if CRC is provided and did not match
+ * \return -1 if an error occurred, 0 otherwise
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch_crc_c(srsran_ldpc_decoder_t* q,
+                                                      const int8_t* const*   llrs,
+                                                      uint8_t* const*        messages,
+                                                      uint32_t               nof_cb,
+                                                      uint32_t               cdwd_rm_length,
+                                                      srsran_crc_t*          crc,
+                                                      int*                   results);
+
 #endif // SRSRAN_LDPCDECODER_H
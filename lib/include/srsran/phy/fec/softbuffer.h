@@ -45,6 +45,7 @@ typedef struct SRSRAN_API {
   uint8_t** data;
   bool*     cb_crc;
   bool      tb_crc;
+  bool      llr_is_8bit; ///< Set if buffer_f stores 8-bit saturated LLRs (int8_t) instead of 16-bit LLRs
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
@@ -67,6 +68,33 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Rx soft-buffer storing 8-bit saturated LLRs, which halves the memory of the 16-bit soft-buffer
+ * @note The LTE PDSCH/PUSCH decoder must be configured with 8-bit LLRs for using it. NR LDPC decoding is always 8-bit
+ * @param q The Rx soft-buffer pointer
+ * @param nof_prb The maximum number of PRB, which determines the number of code blocks to allocate
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_8bit(srsran_softbuffer_rx_t* q, uint32_t nof_prb);
+
+/**
+ * @brief Initialises Rx soft-buffer storing 8-bit saturated LLRs for a number of code blocks and their size
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks to allocate
+ * @param max_cb_size The code block size to allocate, in number of LLRs
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_guru_8bit(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
+/**
+ * @brief Computes the number of bytes allocated by an Rx soft-buffer, for memory footprint reporting
+ * @param q The Rx soft-buffer pointer
+ * @return The number of bytes used for storing LLRs and decoded data
+ */
+SRSRAN_API uint32_t srsran_softbuffer_rx_nof_bytes(const srsran_softbuffer_rx_t* q);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
@@ -110,6 +110,23 @@ SRSRAN_API int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                                        float              scaling,
                                        float              noise_estimate);
 
+/* Linear ZF/MMSE detection of nof_layers layers from nof_rxant antennas, with the channel "h" of every layer seen by
+ * every receive antenna (h[layer][rxant], precoding included). The channel is assumed flat within every group of
+ * SRSRAN_NRE consecutive REs, as it is after interpolation, so one filter per PRB is computed from its central RE and
+ * applied to the whole PRB. The detected symbols are unbiased and "sinr" (optional) gives the linear SINR of every
+ * layer and RE, so that 1 / sinr is the noise variance of "x" for srsran_demod_soft_demodulate_nvar_b().
+ */
+SRSRAN_API int srsran_predecoding_prb(cf_t*                 y[SRSRAN_MAX_PORTS],
+                                      cf_t*                 h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS],
+                                      cf_t*                 x[SRSRAN_MAX_LAYERS],
+                                      float*                sinr[SRSRAN_MAX_LAYERS],
+                                      uint32_t              nof_rxant,
+                                      uint32_t              nof_layers,
+                                      uint32_t              nof_re,
+                                      srsran_mimo_decoder_t decoder,
+                                      float                 scaling,
+                                      float                 noise_estimate);
+
 SRSRAN_API int srsran_precoding_pmi_select(cf_t*     h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                            uint32_t  nof_symbols,
                                            float     noise_estimate,
@@ -23,7 +23,7 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM and 256QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
  *****************************************************************************/
@@ -42,4 +42,16 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/* Number of int8_t LLR units per unit of natural-log likelihood ratio given by srsran_demod_soft_demodulate_nvar_b() */
+#define SRSRAN_DEMOD_SOFT_LLR_SCALE 8.0f
+
+/* Max-log soft demodulation with the noise variance of every symbol, which usually comes from the equalizer. The LLRs
+ * have the sign convention of srsran_demod_soft_demodulate_b() and are scaled by SRSRAN_DEMOD_SOFT_LLR_SCALE, rounded
+ * and saturated to int8_t. */
+SRSRAN_API int srsran_demod_soft_demodulate_nvar_b(srsran_mod_t modulation,
+                                                   const cf_t*  symbols,
+                                                   const float* noise_var,
+                                                   int8_t*      llr,
+                                                   int          nsymbols);
+
 #endif // SRSRAN_DEMOD_SOFT_H
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/refsignal_ul.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/mimo/layermap.h"
 #include "srsran/phy/mimo/precoding.h"
@@ -45,6 +46,9 @@
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
 
+/* Number of scrambling sequences cached by the eNb, every UE uses a different one in each subframe */
+#define SRSRAN_PUSCH_SCRAMBLING_CACHE_SIZE 160
+
 /* PUSCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -73,6 +77,9 @@ typedef struct SRSRAN_API {
   // EVM buffer
   srsran_evm_buffer_t* evm_buffer;
 
+  // Descrambling sequences, eNb only
+  srsran_sequence_cache_t scrambling_cache;
+
 } srsran_pusch_t;
 
 typedef struct SRSRAN_API {
@@ -24,6 +24,7 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/ch_estimation/dmrs_sch.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/modem/evm.h"
 #include "srsran/phy/modem/modem_table.h"
 #include "srsran/phy/phch/phch_cfg_nr.h"
@@ -32,6 +33,11 @@
 #include "srsran/phy/phch/uci_nr.h"
 #include "srsran/phy/scrambling/scrambling.h"
 
+/**
+ * @brief Number of scrambling sequences cached by the gNb, the sequence only depends on the RNTI and code word
+ */
+#define SRSRAN_PUSCH_NR_SCRAMBLING_CACHE_SIZE 64
+
 /**
  * @brief PUSCH encoder and decoder initialization arguments
  */
@@ -75,6 +81,8 @@ typedef struct SRSRAN_API {
   uint32_t             G_csi1;    ///< Number of encoded CSI part 1 bits
   uint32_t             G_csi2;    ///< Number of encoded CSI part 2 bits
   uint32_t             G_ulsch;   ///< Number of encoded shared channel
+
+  srsran_sequence_cache_t scrambling_cache; ///< Descrambling sequences, gNb only
 } srsran_pusch_nr_t;
 
 /**
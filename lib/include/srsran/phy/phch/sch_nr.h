@@ -76,6 +76,9 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Code block decoder workers, NULL if the code blocks are decoded sequentially
+  void* workers_ptr;
 } srsran_sch_nr_t;
 
 /**
@@ -85,7 +88,8 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;        ///< Maximum number of LDPC iterations
+  uint32_t nof_decoder_workers; ///< Threads decoding code blocks along with the caller, 0 for sequential decoding
 } srsran_sch_nr_args_t;
 
 /**
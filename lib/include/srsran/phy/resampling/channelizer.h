@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         channelizer.h
+ *
+ *  Description:  Fast-convolution filterbank that extracts several narrowband
+ *                channels at arbitrary frequency offsets from a wideband signal
+ *                and decimates them by an integer ratio. A single input DFT is
+ *                shared by all channels, every channel only costs a small iDFT.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_CHANNELIZER_H
+#define SRSRAN_CHANNELIZER_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/dft/dft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Output DFT size, the input DFT size is this times the decimation ratio
+ */
+#define SRSRAN_CHANNELIZER_FFT_SIZE 256
+
+/**
+ * Number of output samples produced by every input DFT
+ */
+#define SRSRAN_CHANNELIZER_WINDOW_SZ (3 * SRSRAN_CHANNELIZER_FFT_SIZE / 4)
+
+typedef struct {
+  uint32_t k0;    ///< Input DFT bin closest to the channel centre
+  double   phase; ///< Phase of the next output window in radians
+  double   step;  ///< Phase increment between output windows in radians
+  cf_t*    nco;   ///< Residual frequency correction within an output window
+} srsran_channelizer_channel_t;
+
+typedef struct {
+  uint32_t                      ratio;        ///< Decimation ratio
+  uint32_t                      nof_channels; ///< Number of extracted channels
+  uint32_t                      state_len;    ///< Number of input samples in the input DFT buffer
+  srsran_dft_plan_t             fft;          ///< Input DFT, shared by all channels
+  srsran_dft_plan_t             ifft;         ///< Output iDFT
+  cf_t*                         in_buffer;    ///< Input DFT buffer, keeps the overlap between windows
+  cf_t*                         fft_buffer;   ///< Input DFT output
+  cf_t*                         ifft_in;      ///< Output iDFT input
+  cf_t*                         ifft_out;     ///< Output iDFT output
+  cf_t*                         filter;       ///< Frequency domain channel filter, in output DFT order
+  srsran_channelizer_channel_t* channels;     ///< Channel states
+} srsran_channelizer_t;
+
+/**
+ * @brief Initialises the channelizer
+ *
+ * Every channel is shifted to baseband, low-pass filtered with a cut-off of 0.39 times the output sampling rate and
+ * decimated by ratio. Channels can be centred anywhere within the input bandwidth and their outputs are phase
+ * continuous across calls to srsran_channelizer_run().
+ *
+ * @param q Channelizer object
+ * @param ratio Decimation ratio
+ * @param freq_offset Channel centre frequencies normalised to the input sampling rate, within [-0.5, 0.5)
+ * @param nof_channels Number of channels
+ * @return SRSRAN_SUCCESS if the initialisation is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_channelizer_init(srsran_channelizer_t* q, uint32_t ratio, const double* freq_offset, uint32_t nof_channels);
+
+/**
+ * @brief Clears the filter state, the next output sample corresponds to the next input sample
+ * @param q Channelizer object
+ */
+SRSRAN_API void srsran_channelizer_reset(srsran_channelizer_t* q);
+
+/**
+ * @brief Returns the delay of the channel outputs in output samples
+ * @param q Channelizer object
+ */
+SRSRAN_API uint32_t srsran_channelizer_get_delay(const srsran_channelizer_t* q);
+
+/**
+ * @brief Channelizes a block of input samples
+ *
+ * Outputs are produced in windows of SRSRAN_CHANNELIZER_WINDOW_SZ samples, the remaining input samples are kept until
+ * the next call. Every output buffer shall fit nsamples / ratio + SRSRAN_CHANNELIZER_WINDOW_SZ samples.
+ *
+ * @param q Channelizer object
+ * @param input Input samples
+ * @param output Output buffer of every channel
+ * @param nsamples Number of input samples
+ * @return The number of samples written in every output buffer
+ */
+SRSRAN_API uint32_t srsran_channelizer_run(srsran_channelizer_t* q,
+                                           const cf_t*           input,
+                                           cf_t**                output,
+                                           uint32_t              nsamples);
+
+/**
+ * @brief Frees the channelizer
+ * @param q Channelizer object
+ */
+SRSRAN_API void srsran_channelizer_free(srsran_channelizer_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_CHANNELIZER_H
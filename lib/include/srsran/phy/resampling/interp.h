@@ -93,12 +93,19 @@ SRSRAN_API void srsran_interp_linear_vector3(srsran_interp_linsrsran_vec_t* q,
 
 typedef struct {
   cf_t*    diff_vec;
-  cf_t*    diff_vec2;
   float*   ramp;
   uint32_t vector_len;
   uint32_t M;
   uint32_t max_vector_len;
   uint32_t max_M;
+
+  /* Interpolation weights and sample indexes of a group of intervals filling a whole number of SIMD registers,
+   * precomputed for the current M */
+  int32_t*  simd_idx;
+  float*    simd_weight;
+  uint32_t* simd_offset;
+  uint32_t  simd_nof_regs;
+  uint32_t  simd_nof_intervals;
 } srsran_interp_lin_t;
 
 SRSRAN_API int srsran_interp_linear_init(srsran_interp_lin_t* q, uint32_t vector_len, uint32_t M);
@@ -60,6 +60,7 @@ typedef struct SRSRAN_API {
   bool                        enable_decode;      ///< Enables PBCH Decoder
   bool                        disable_polar_simd; ///< Disables polar encoder/decoder SIMD acceleration
   float                       pbch_dmrs_thr;      ///< NR-PBCH DMRS threshold for blind decoding, set to 0 for default
+  uint32_t                    max_sweep_freqs;    ///< Maximum number of SSB frequencies correlated at once in a sweep
 } srsran_ssb_args_t;
 
 /**
@@ -97,6 +98,10 @@ typedef struct SRSRAN_API {
   uint32_t symbol_sz;     ///< Current SSB symbol size (for the given base-band sampling rate)
   uint32_t corr_sz;       ///< Correlation size
   uint32_t corr_window;   ///< Correlation window length
+  uint32_t corr_band_sz;  ///< Number of correlation bins around the SSB kept for the decimated PSS detection
+  uint32_t corr_dec;      ///< Decimation of the coarse correlation, ratio between the correlation and band sizes
+  uint32_t corr_shift;    ///< Correlation bins steered for detecting a CFO up to the SSB subcarrier spacing
+  int32_t  corr_center;   ///< Correlation bin of the SSB center frequency
   uint32_t ssb_sz;        ///< SSB size in samples at the configured sampling rate
   int32_t  f_offset;      ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
   uint32_t cp_sz;         ///< CP length for the given symbol size
@@ -110,6 +115,7 @@ typedef struct SRSRAN_API {
   srsran_dft_plan_t fft;       ///< FFT object for demodulate the SSB.
   srsran_dft_plan_t fft_corr;  ///< FFT for correlation
   srsran_dft_plan_t ifft_corr; ///< IFFT for correlation
+  srsran_dft_plan_t ifft_band; ///< IFFT for the decimated correlation
   srsran_pbch_nr_t  pbch;      ///< PBCH encoder and decoder
 
   /// Frequency/Time domain temporal data
@@ -117,7 +123,9 @@ typedef struct SRSRAN_API {
   cf_t* tmp_time;                     ///< Temporal time domain buffer
   cf_t* tmp_corr;                     ///< Temporal correlation frequency domain buffer
   cf_t* sf_buffer;                    ///< subframe buffer
+  cf_t* tmp_band;                     ///< Temporal correlation band buffer
   cf_t* pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+  cf_t* pss_band;                     ///< PSS correlation bands for the decimated detection, for each swept frequency
 } srsran_ssb_t;
 
 /**
@@ -163,6 +171,31 @@ SRSRAN_API int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg);
  */
 SRSRAN_API int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res);
 
+/**
+ * @brief Searches for SSB transmissions at several SSB center frequencies of the same base-band buffer, for example the
+ * synchronization raster points (GSCN) within the received bandwidth, and decodes their PBCH messages
+ *
+ * @remark Each input window is transformed to frequency domain once and correlated with the PSS of up to
+ * max_sweep_freqs frequencies, which is considerably faster than calling srsran_ssb_search() for each of them
+ *
+ * @remark The frequencies must be at an integer number of subcarriers from the center frequency, as the SSB frequency
+ * given to srsran_ssb_set_cfg(). The configured SSB frequency is restored afterwards
+ *
+ * @param q SSB object
+ * @param in Input baseband buffer
+ * @param nof_samples Number of samples available in the buffer
+ * @param ssb_freq_hz SSB center frequencies in Hz
+ * @param nof_freqs Number of SSB center frequencies
+ * @param res SSB Search result for each frequency
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_search_sweep(srsran_ssb_t*            q,
+                                       const cf_t*              in,
+                                       uint32_t                 nof_samples,
+                                       const double*            ssb_freq_hz,
+                                       uint32_t                 nof_freqs,
+                                       srsran_ssb_search_res_t* res);
+
 /**
  * @brief Decides if the SSB object is configured and a given subframe is configured for SSB transmission
  * @param q SSB object
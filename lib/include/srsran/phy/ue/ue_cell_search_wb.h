@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Wideband cell search.
+ *
+ *                Searches LTE cells in several channels of a single wideband
+ *                capture. The capture is split into SRSRAN_CS_SAMP_FREQ streams
+ *                centred at every channel frequency with a fast-convolution
+ *                filterbank, and every stream is scanned with the regular
+ *                srsran_ue_cellsearch_t by a pool of worker threads.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include <pthread.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/resampling/channelizer.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+
+typedef struct SRSRAN_API {
+  double   srate_hz;         ///< Capture sampling rate, an integer multiple of SRSRAN_CS_SAMP_FREQ
+  double   center_freq_hz;   ///< Capture centre frequency
+  uint32_t max_samples;      ///< Maximum number of capture samples
+  uint32_t max_frames;       ///< Maximum number of 5 ms frames scanned for every N_id_2
+  uint32_t nof_valid_frames; ///< Number of frames with PSS detections needed to stop the scan of an N_id_2
+  uint32_t nof_threads;      ///< Number of worker threads, 0 for one per CPU core
+} srsran_ue_cellsearch_wb_args_t;
+
+typedef struct SRSRAN_API {
+  double                        freq_hz;        ///< Channel centre frequency
+  uint32_t                      nof_cells;      ///< Number of found cells, at most one per N_id_2
+  uint32_t                      max_N_id_2;     ///< N_id_2 of the cell with the highest peak
+  srsran_ue_cellsearch_result_t found_cells[3]; ///< Found cells, indexed by N_id_2
+} srsran_ue_cellsearch_wb_channel_t;
+
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_t cs;       ///< Cell search reading from the worker channel
+  pthread_t              thread;   ///< Worker thread
+  void*                  parent;   ///< Wideband cell search the worker belongs to
+  const cf_t*            stream;   ///< Samples of the channel being scanned
+  uint32_t               read_idx; ///< Next sample to read from the stream
+  int                    ret;      ///< Worker return code
+} srsran_ue_cellsearch_wb_worker_t;
+
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_wb_args_t     args;
+  srsran_channelizer_t               channelizer;
+  uint32_t                           nof_channels;
+  srsran_ue_cellsearch_wb_channel_t* channels;
+  cf_t**                             stream;     ///< Channelized samples of every channel
+  uint32_t                           stream_len; ///< Number of samples of every stream
+  uint32_t                           nof_workers;
+  srsran_ue_cellsearch_wb_worker_t*  workers;
+  pthread_mutex_t                    mutex;
+  uint32_t                           next_channel; ///< Next channel to scan, protected by mutex
+} srsran_ue_cellsearch_wb_t;
+
+/**
+ * @brief Initialises the wideband cell search for the given channels
+ * @param q Wideband cell search object
+ * @param args Capture and search arguments
+ * @param channel_freq_hz Channel centre frequencies, within the capture bandwidth
+ * @param nof_channels Number of channels
+ * @return SRSRAN_SUCCESS if the initialisation is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t*            q,
+                                            const srsran_ue_cellsearch_wb_args_t* args,
+                                            const double*                         channel_freq_hz,
+                                            uint32_t                              nof_channels);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/**
+ * @brief Searches cells in all channels of a capture
+ *
+ * Every N_id_2 of every channel is scanned from the start of its stream, which wraps around if the capture is shorter
+ * than the scan. The results are stored in q->channels.
+ *
+ * @param q Wideband cell search object
+ * @param samples Capture at args.srate_hz centred at args.center_freq_hz
+ * @param nof_samples Number of capture samples, up to args.max_samples
+ * @return The total number of found cells or SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t* q, const cf_t* samples, uint32_t nof_samples);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
@@ -30,6 +30,7 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/rlc/rlc_metrics.h"
+#include <atomic>
 
 namespace srsran {
 
@@ -105,14 +106,54 @@ private:
   srsue::rrc_interface_rlc*  rrc    = nullptr;
   srsran::timer_handler*     timers = nullptr;
 
-  typedef std::map<uint16_t, std::unique_ptr<rlc_common> >  rlc_map_t;
-
-  rlc_map_t        rlc_array, rlc_array_mrb;
-  pthread_rwlock_t rwlock;
+  /**
+   * RLC entity of an LCID. Entities are only added, removed or moved by the stack thread, which accesses them
+   * directly. The MAC accesses them from other threads through a bearer_guard, which pins the published entity until
+   * it goes out of scope. Each slot counts its own readers, so there is no lock shared by all the bearers.
+   */
+  struct bearer_slot {
+    std::unique_ptr<rlc_common> entity;
+    std::atomic<rlc_common*>    published{nullptr};
+    std::atomic<uint32_t>       nof_readers{0};
+
+    void                        publish(std::unique_ptr<rlc_common> entity_);
+    std::unique_ptr<rlc_common> unpublish();
+  };
+  // Pins the entity of an LCID for the MAC. get() is nullptr if the LCID is invalid or has no bearer
+  class bearer_guard
+  {
+  public:
+    template <std::size_t N>
+    bearer_guard(std::array<bearer_slot, N>& slots, uint32_t lcid) : slot(lcid < N ? &slots[lcid] : nullptr)
+    {
+      if (slot != nullptr) {
+        // the reader must be visible before the entity is loaded, see bearer_slot::unpublish()
+        slot->nof_readers.fetch_add(1);
+        entity = slot->published.load();
+      }
+    }
+    bearer_guard(const bearer_guard&) = delete;
+    bearer_guard& operator=(const bearer_guard&) = delete;
+    ~bearer_guard()
+    {
+      if (slot != nullptr) {
+        slot->nof_readers.fetch_sub(1);
+      }
+    }
+    rlc_common* get() const { return entity; }
+
+  private:
+    bearer_slot* slot   = nullptr;
+    rlc_common*  entity = nullptr;
+  };
+
+  std::array<bearer_slot, SRSRAN_N_RADIO_BEARERS> rlc_array;
+  std::array<bearer_slot, SRSRAN_N_MCH_LCIDS>     rlc_array_mrb;
 
   uint32_t default_lcid = 0;
 
-  bsr_callback_t bsr_callback = nullptr;
+  bsr_callback_t                                     bsr_callback = nullptr;
+  std::array<rlc_bsr_filter, SRSRAN_N_RADIO_BEARERS> bsr_filters; ///< only for the bearers in rlc_array
 
   // Timer needed for metrics calculation
   std::chrono::high_resolution_clock::time_point metrics_tp;
@@ -122,6 +163,7 @@ private:
 
   void update_bsr(uint32_t lcid);
   void update_bsr_mch(uint32_t lcid);
+  void report_bsr(uint32_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue);
 };
 
 void rlc_bearer_metrics_print(const rlc_bearer_metrics_t& metrics);
@@ -26,8 +26,10 @@
 #include "srsran/common/common.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_aqm.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -122,6 +124,18 @@ protected:
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
 
+  // Counters updated in the PDCP, Tx and Rx paths, kept out of metrics_mutex
+  struct hot_metrics_t {
+    std::atomic<uint32_t> num_tx_sdus{0};
+    std::atomic<uint64_t> num_tx_sdu_bytes{0};
+    std::atomic<uint32_t> num_lost_sdus{0};
+    std::atomic<uint32_t> num_tx_pdus{0};
+    std::atomic<uint64_t> num_tx_pdu_bytes{0};
+    std::atomic<uint32_t> num_rx_pdus{0};
+    std::atomic<uint64_t> num_rx_pdu_bytes{0};
+  };
+  hot_metrics_t hot_metrics;
+
   srsue::rrc_interface_rlc*  rrc  = nullptr;
   srsue::pdcp_interface_rlc* pdcp = nullptr;
 
@@ -153,18 +167,16 @@ public:
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
-    bool                  tx_enabled = false;
+    std::atomic<bool>     tx_enabled = {false};
     byte_buffer_pool*     pool       = nullptr;
     srslog::basic_logger& logger;
     std::string           rb_name;
 
     bsr_callback_t bsr_callback;
 
-    // Tx SDU buffers
-    byte_buffer_queue tx_sdu_queue;
-
-    // Mutexes
-    std::mutex mutex;
+    // Tx SDU buffers. Written and discarded by PDCP, read by the Tx entity, without a shared lock
+    spsc_byte_buffer_queue tx_sdu_queue;
+    rlc_aqm                aqm;
   };
 
   /*******************************************************
@@ -27,6 +27,7 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
 #include <array>
+#include <deque>
 #include <list>
 #include <vector>
 
@@ -462,7 +463,7 @@ private:
 template <class T>
 class pdu_retx_queue_list
 {
-  std::list<T> queue;
+  std::deque<T> queue;
 
 public:
   ~pdu_retx_queue_list() = default;
@@ -485,7 +486,7 @@ public:
     return queue.front();
   }
 
-  const std::list<T>& get_inner_queue() const { return queue; }
+  const std::deque<T>& get_inner_queue() const { return queue; }
 
   void   clear() { queue.clear(); }
   size_t size() const { return queue.size(); }
@@ -496,7 +497,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         return true;
       }
@@ -509,7 +510,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         if (elem.overlaps(so)) {
           return true;
@@ -23,8 +23,10 @@
 #define SRSRAN_RLC_AM_LTE_H
 
 #include "srsran/adt/accumulators.h"
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/triple_buffer.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -176,7 +178,8 @@ public:
   // Timeout callback interface
   void timer_expired(uint32_t timeout_id) final;
 
-  // Functions needed by Tx subclass to query rx state
+  // Functions needed by Tx subclass to query rx state. They only access the last status published by the Rx entity,
+  // and never take the Rx mutex
   int  get_status_pdu_length();
   int  get_status_pdu(rlc_status_pdu_t* status, uint32_t nof_bytes);
   bool get_do_status();
@@ -191,6 +194,8 @@ private:
   void print_rx_segments();
   bool add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment);
   void reset_status();
+  void sync_status();
+  void publish_status();
 
   rlc_am*           parent = nullptr;
   rlc_am_lte_tx*    tx     = nullptr;
@@ -221,12 +226,24 @@ private:
   std::mutex mutex;
 
   // Rx windows
-  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE>            rx_window;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
 
+  // Rx state needed to build a status PDU, published by the Rx entity whenever a status report is pending
+  struct status_snapshot_t {
+    uint32_t                                     seq        = 0;
+    uint32_t                                     vr_r       = 0;
+    uint32_t                                     vr_ms      = 0;
+    uint32_t                                     packed_len = 0; // Length of the status PDU with all NACKs
+    bounded_vector<uint16_t, RLC_AM_WINDOW_SIZE> missing_sns;    // SNs in [vr_r, vr_ms) not received yet
+  };
+  triple_buffer<status_snapshot_t> status_buffer;
+  std::atomic<uint32_t>            status_seq      = {0}; // seq of the last published status snapshot
+  std::atomic<uint32_t>            status_sent_seq = {0}; // seq of the last status snapshot sent by the Tx entity
+
   /****************************************************************************
    * Timers
    * Ref: 3GPP TS 36.322 v10.0.0 Section 7
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_AM_LTE_PACKING_H
 #define SRSRAN_RLC_AM_LTE_PACKING_H
 
+#include "srsran/adt/interval_set.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_am_data_structs.h" // required for rlc_am_pdu_segment
@@ -43,8 +44,24 @@ struct rlc_amd_rx_pdu {
   explicit rlc_amd_rx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
+// Segments received for an SN, sorted by SO. Only the received byte ranges are checked to detect a complete PDU
 struct rlc_amd_rx_pdu_segments_t {
   std::list<rlc_amd_rx_pdu> segments;
+  interval_set<uint32_t>    received;       // byte ranges of the PDU received so far
+  uint32_t                  pdu_length = 0; // known once the last segment is received
+  uint32_t                  rlc_sn     = 0;
+
+  rlc_amd_rx_pdu_segments_t() = default;
+  explicit rlc_amd_rx_pdu_segments_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
+
+  void add_received(const rlc_amd_pdu_header_t& header, uint32_t nof_bytes)
+  {
+    received.add(header.so, header.so + nof_bytes);
+    if (header.lsf) {
+      pdu_length = header.so + nof_bytes;
+    }
+  }
+  bool is_complete() const { return pdu_length > 0 and received.contains(0, pdu_length); }
 };
 
 /****************************************************************************
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_AM_NR_H
 #define SRSRAN_RLC_AM_NR_H
 
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/timers.h"
@@ -104,7 +105,7 @@ public:
   bool     configure(const rlc_config_t& cfg_) final;
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) final;
   void     handle_control_pdu(uint8_t* payload, uint32_t nof_bytes) final;
-  void     handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set);
+  void     handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sns);
 
   void reestablish() final;
   void stop() final;
@@ -165,8 +166,11 @@ private:
 
   // Queues, buffers and container
   pdu_retx_queue_list<rlc_amd_retx_nr_t> retx_queue;
-  uint32_t         sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
-  pdcp_sn_vector_t notify_info_vec;
+  uint32_t              sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
+  pdcp_sn_vector_t      notify_info_vec;
+  std::vector<uint32_t> retx_sn_vec; // SNs scheduled for retransmission by the status PDU being handled
+  // SNs with pending retransmissions, indexed when a status PDU is handled to check NACKs without scanning retx_queue
+  bounded_bitset<cardinality(rlc_am_nr_sn_size_t::size18bits)> retx_queue_sns;
 
   // Helper constants
   uint32_t min_hdr_size = 2; // Pre-initialized for 12 bit SN, updated by configure()
@@ -185,6 +189,9 @@ private:
    ***************************************************************************/
   srsran::timer_handler::unique_timer poll_retransmit_timer;
 
+  // Mutex to protect members. The PDCP write path does not take it
+  std::mutex mutex;
+
 public:
   // Getters/Setters
   void set_tx_state(const rlc_am_nr_tx_state_t& st_) { st = st_; }   // This should only be used for testing.
@@ -281,6 +288,10 @@ private:
 
   // RX Window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
+  // One bit per SN, set for the SDUs of the RX window that are fully received. Allows to skip over the received SDUs
+  // a word at a time when looking for missing SDUs.
+  bounded_bitset<cardinality(rlc_am_nr_sn_size_t::size18bits)> rx_sdu_received;
+  uint32_t find_first_not_received(uint32_t start_sn, uint32_t stop_sn) const;
 
   // Mutexes
   std::mutex mutex;
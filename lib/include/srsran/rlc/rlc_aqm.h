@@ -0,0 +1,102 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RLC_AQM_H
+#define SRSRAN_RLC_AQM_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/interfaces/rlc_interface_types.h"
+#include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
+#include <chrono>
+#include <random>
+
+namespace srsran {
+
+/**
+ * Active queue management of the RLC Tx SDU queue. It keeps the queueing delay low when the queue is filled by
+ * congestion-controlled traffic, e.g. TCP, which would otherwise keep it full and add the time to drain it to the
+ * latency of every SDU of the bearer.
+ * - CoDel (RFC 8289) drops SDUs at the head of the queue when their sojourn time stays above the target for an
+ *   interval, at a rate that grows with the square root of the number of drops.
+ * - PIE (RFC 8033) drops SDUs on arrival with a probability that is updated periodically from the queueing delay,
+ *   which is the sojourn time of the last SDU read from the queue.
+ * As spsc_byte_buffer_queue, enqueue() is called by the thread writing SDUs and read() by the one building PDUs.
+ */
+class rlc_aqm
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  void configure(const rlc_aqm_config_t& cfg_);
+  bool is_enabled() const { return cfg.type != rlc_aqm_type_t::none; }
+
+  /// Stamps the SDU with its arrival time. Returns false if the SDU has to be dropped instead of queued
+  bool enqueue(byte_buffer_t& sdu, uint32_t queue_bytes)
+  {
+    return not is_enabled() or enqueue(sdu, queue_bytes, clock::now());
+  }
+  bool enqueue(byte_buffer_t& sdu, uint32_t queue_bytes, clock::time_point now);
+
+  /// Reads the next SDU from the queue. Returns nullptr if the queue is empty or the SDU was discarded or dropped
+  unique_byte_buffer_t read(spsc_byte_buffer_queue& queue)
+  {
+    return is_enabled() ? read(queue, clock::now()) : queue.read();
+  }
+  unique_byte_buffer_t read(spsc_byte_buffer_queue& queue, clock::time_point now);
+
+  uint64_t get_nof_drops() const { return nof_drops.load(std::memory_order_relaxed); }
+
+private:
+  /// Queues with less than one MTU are never considered to be building up
+  static const uint32_t mtu_bytes = 1500;
+
+  bool codel_drop(clock::duration sojourn_time, uint32_t queue_bytes, clock::time_point now);
+  bool codel_ok_to_drop(clock::duration sojourn_time, uint32_t queue_bytes, clock::time_point now);
+  void pie_update(clock::time_point now, uint32_t queue_bytes);
+  bool pie_drop(uint32_t queue_bytes);
+
+  rlc_aqm_config_t cfg = {};
+  clock::duration  target{0};
+  clock::duration  interval{0};
+
+  // CoDel state, only used by the reader
+  clock::time_point first_above_time = {};
+  clock::time_point drop_next        = {};
+  uint32_t          count            = 0;
+  uint32_t          last_count       = 0;
+  bool              dropping         = false;
+
+  // PIE state, only used by the writer, apart from the queueing delay measured by the reader
+  std::atomic<int64_t>                   qdelay_us       = {0};
+  std::chrono::microseconds              qdelay_old      = {};
+  std::chrono::microseconds              burst_allowance = {};
+  clock::time_point                      next_update     = {};
+  double                                 drop_prob       = 0;
+  std::minstd_rand                       rng;
+  std::uniform_real_distribution<double> uniform_dist{0.0, 1.0};
+
+  std::atomic<uint64_t> nof_drops = {0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RLC_AQM_H
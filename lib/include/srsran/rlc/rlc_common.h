@@ -28,6 +28,7 @@
 #include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/rlc/rlc_metrics.h"
+#include <atomic>
 #include <cstdlib>
 #include <list>
 
@@ -218,6 +219,40 @@ struct rlc_status_pdu_t {
 
 typedef std::function<void(uint32_t, uint32_t, uint32_t)> bsr_callback_t;
 
+/**
+ * Filter of the buffer state reports pushed to the MAC. The occupancy of each queue is quantized into levels, exact
+ * below 16 bytes and with steps of 1/8 of the largest power of two below the occupancy above that. A report only
+ * goes through when the level of one of the queues changes, which includes every transition from and to empty, or
+ * when it is the first one after reset(). It can be used concurrently by the threads writing SDUs and reading PDUs.
+ */
+class rlc_bsr_filter
+{
+public:
+  /// Returns true if the buffer state has to be reported
+  bool update(uint32_t newtx_queue, uint32_t prio_tx_queue)
+  {
+    uint64_t level = (uint64_t)to_level(newtx_queue) << 32U | to_level(prio_tx_queue);
+    return last_level.exchange(level, std::memory_order_relaxed) != level;
+  }
+
+  /// Lets the next report go through
+  void reset() { last_level.store(invalid_level, std::memory_order_relaxed); }
+
+  static uint32_t to_level(uint32_t nof_bytes)
+  {
+    if (nof_bytes < 16) {
+      return nof_bytes;
+    }
+    uint32_t msb = 31 - __builtin_clz(nof_bytes);
+    return msb << 3U | ((nof_bytes >> (msb - 3)) & 0x7U);
+  }
+
+private:
+  static const uint64_t invalid_level = UINT64_MAX;
+
+  std::atomic<uint64_t> last_level = {invalid_level};
+};
+
 /****************************************************************************
  * RLC Common interface
  * Common interface for all RLC entities
@@ -26,6 +26,7 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/rlc/rlc_aqm.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <map>
@@ -91,7 +92,6 @@ protected:
     void             stop();
     void             reestablish();
     void             empty_queue();
-    void             write_sdu(unique_byte_buffer_t sdu);
     void             discard_sdu(uint32_t discard_sn);
     bool             sdu_queue_is_full();
     int              try_write_sdu(unique_byte_buffer_t sdu);
@@ -110,9 +110,11 @@ protected:
 
     rlc_config_t cfg = {};
 
-    // TX SDU buffers
-    byte_buffer_queue    tx_sdu_queue;
-    unique_byte_buffer_t tx_sdu;
+    // TX SDU buffers. The buffer state is computed from the queue counters and tx_sdu_bytes without the mutex
+    spsc_byte_buffer_queue tx_sdu_queue;
+    unique_byte_buffer_t   tx_sdu;
+    std::atomic<uint32_t>  tx_sdu_bytes = {0}; ///< bytes of tx_sdu left to transmit
+    rlc_aqm                aqm;
 
     // Mutexes
     std::mutex mutex;
@@ -125,6 +127,10 @@ protected:
     virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
+    void update_tx_sdu_bytes()
+    {
+      tx_sdu_bytes.store(tx_sdu != nullptr ? tx_sdu->N_bytes : 0, std::memory_order_relaxed);
+    }
     virtual void debug_state() = 0;
     virtual void reset()       = 0;
   };
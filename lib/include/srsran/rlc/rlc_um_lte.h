@@ -24,6 +24,7 @@
 
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/rlc/rlc_am_data_structs.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <map>
@@ -33,10 +34,25 @@
 
 namespace srsran {
 
-typedef struct {
-  rlc_umd_pdu_header_t header;
+// Received UMD PDU. Only the fields of the header needed for reassembly are unpacked. The length indicators are read
+// from the packed header, which stays in the PDU buffer in front of the data
+struct rlc_umd_pdu_t {
+  uint32_t             sn       = 0;
+  uint8_t              fi       = 0;       // Framing info
+  uint32_t             N_li     = 0;       // Number of length indicators
+  const uint8_t*       li_field = nullptr; // Extension part of the packed header
   unique_byte_buffer_t buf;
-} rlc_umd_pdu_t;
+
+  rlc_umd_pdu_t() = default;
+  explicit rlc_umd_pdu_t(uint32_t sn_) : sn(sn_) {}
+
+  // Returns the i-th length indicator. Pairs of 12-bit E/LI fields are packed in 3 bytes
+  uint16_t li(uint32_t i) const
+  {
+    const uint8_t* ptr = li_field + 3 * (i / 2);
+    return (i % 2 == 0) ? ((ptr[0] & 0x7F) << 4) | ((ptr[1] & 0xF0) >> 4) : ((ptr[1] & 0x07) << 8) | ptr[2];
+  }
+};
 
 class rlc_um_lte : public rlc_um_base
 {
@@ -95,8 +111,9 @@ private:
   private:
     void reset();
 
-    // Rx window
-    std::map<uint32_t, rlc_umd_pdu_t> rx_window;
+    // Rx window, indexed by SN and sized to the whole SN space in configure(), since a PDU ahead of the reordering
+    // window is stored before the PDUs it pushes out of the window are reassembled
+    std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_t> > rx_window;
 
     // RX SDU buffers
     uint32_t vr_ur_in_rx_sdu = 0;
@@ -22,9 +22,11 @@
 #ifndef SRSRAN_RLC_UM_NR_H
 #define SRSRAN_RLC_UM_NR_H
 
+#include "srsran/adt/interval_set.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/interfaces/ue_interfaces.h"
+#include "srsran/rlc/rlc_am_data_structs.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <map>
@@ -115,16 +117,25 @@ private:
     uint32_t UM_Window_Size = 0;
     uint32_t mod            = 0; // Rx counter modulus
 
-    // Rx window
-    typedef struct {
-      std::map<uint32_t, rlc_umd_pdu_nr_t> segments; // Map of segments with SO as key
-      unique_byte_buffer_t                 sdu;
-      uint32_t                             next_expected_so;
-      uint32_t                             total_sdu_length;
-    } rlc_umd_pdu_segments_nr_t;
-    std::map<uint32_t, rlc_umd_pdu_segments_nr_t> rx_window;
-
-    void update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments, const rlc_umd_pdu_nr_t& rx_pdu);
+    // Rx window. The segments of an SDU are copied into the SDU buffer at their SO as they arrive, and only the
+    // received byte ranges are tracked
+    struct rlc_umd_rx_sdu_nr_t {
+      uint32_t                  sn = 0;
+      unique_byte_buffer_t      sdu;
+      interval_set<uint32_t> received;             // byte ranges of the SDU received so far
+      uint32_t               total_sdu_length = 0; // known once the last segment is received
+
+      rlc_umd_rx_sdu_nr_t() = default;
+      explicit rlc_umd_rx_sdu_nr_t(uint32_t sn_) : sn(sn_) {}
+    };
+    // Sized to UM_Window_Size in configure(). A new SN only shares its slot with an SN that the new PDU pushes out of
+    // the reassembly window, and which is discarded when the new PDU is stored
+    std::unique_ptr<rlc_ringbuffer_base<rlc_umd_rx_sdu_nr_t> > rx_window;
+
+    bool add_segment(rlc_umd_rx_sdu_nr_t&          rx_sdu_nr,
+                     const rlc_um_nr_pdu_header_t& header,
+                     const uint8_t*                payload,
+                     const uint32_t                nof_bytes);
 
     // TS 38.322 Sec. 7.3
     srsran::timer_handler::unique_timer reassembly_timer; // to detect loss of RLC PDUs at lower layers
@@ -34,8 +34,10 @@
 #include "srsran/common/block_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include <atomic>
 #include <functional>
 #include <pthread.h>
+#include <vector>
 
 namespace srsran {
 
@@ -125,6 +127,138 @@ public:
   dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
 };
 
+/**
+ * Lock-free bounded queue of SDUs with a single producer (the upper layer, which writes and discards SDUs) and a
+ * single consumer (the entity building PDUs). The interface mirrors byte_buffer_queue.
+ * Discarded SDUs leave an empty slot in the queue, which read() returns as nullptr. The counters returned by
+ * size_bytes() and get_n_sdus() only account for SDUs that were neither read nor discarded.
+ */
+class spsc_byte_buffer_queue
+{
+public:
+  explicit spsc_byte_buffer_queue(uint32_t capacity = 128) : slots(capacity) {}
+  spsc_byte_buffer_queue(const spsc_byte_buffer_queue&) = delete;
+  spsc_byte_buffer_queue& operator=(const spsc_byte_buffer_queue&) = delete;
+  ~spsc_byte_buffer_queue() { clear(); }
+
+  /// Producer side. In case the queue is full, the SDU is returned back to the caller
+  srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
+  {
+    uint32_t tail = tail_count.load(std::memory_order_relaxed);
+    if (tail - head_count.load(std::memory_order_acquire) >= slots.size()) {
+      return std::move(msg);
+    }
+    // Counters are updated before the SDU becomes visible to the consumer, so they never underflow
+    unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(1, std::memory_order_relaxed);
+    slot_t& slot = slots[tail % slots.size()];
+    slot.pdcp_sn = msg->md.pdcp_sn;
+    slot.sdu.store(msg.release(), std::memory_order_relaxed);
+    tail_count.store(tail + 1, std::memory_order_release);
+    return {};
+  }
+
+  /// Producer side. Removes the first SDU with the given PDCP SN that was not read yet. Returns false if none is found
+  bool discard(uint32_t pdcp_sn)
+  {
+    uint32_t tail = tail_count.load(std::memory_order_relaxed);
+    for (uint32_t i = head_count.load(std::memory_order_acquire); i != tail; ++i) {
+      slot_t& slot = slots[i % slots.size()];
+      if (slot.pdcp_sn != pdcp_sn) {
+        continue;
+      }
+      // The consumer may be reading this slot. Whoever takes the pointer out of the slot owns the SDU.
+      byte_buffer_t* sdu = slot.sdu.load(std::memory_order_relaxed);
+      if (sdu != nullptr && slot.sdu.compare_exchange_strong(sdu, nullptr, std::memory_order_acquire)) {
+        unique_byte_buffer_t discarded{sdu};
+        on_pop(*discarded);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Consumer side. Returns nullptr if the queue is empty or the SDU at the head of the queue was discarded
+  unique_byte_buffer_t read()
+  {
+    uint32_t head = head_count.load(std::memory_order_relaxed);
+    if (head == tail_count.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    unique_byte_buffer_t sdu{slots[head % slots.size()].sdu.exchange(nullptr, std::memory_order_acquire)};
+    head_count.store(head + 1, std::memory_order_release);
+    if (sdu != nullptr) {
+      on_pop(*sdu);
+    }
+    return sdu;
+  }
+
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    if (is_empty()) {
+      return false;
+    }
+    *msg = read();
+    return true;
+  }
+
+  /// Consumer side. Drops all the SDUs in the queue
+  void clear()
+  {
+    while (not is_empty()) {
+      read();
+    }
+  }
+
+  /// Changes the capacity of the queue. Must not be called concurrently with any other method
+  void resize(uint32_t capacity)
+  {
+    std::vector<unique_byte_buffer_t> pending;
+    while (not is_empty()) {
+      unique_byte_buffer_t sdu = read();
+      if (sdu != nullptr) {
+        pending.push_back(std::move(sdu));
+      }
+    }
+    slots = std::vector<slot_t>(capacity);
+    head_count.store(0, std::memory_order_relaxed);
+    tail_count.store(0, std::memory_order_relaxed);
+    for (unique_byte_buffer_t& sdu : pending) {
+      if (try_write(std::move(sdu)).is_error()) {
+        break;
+      }
+    }
+  }
+
+  /// Number of slots in use, including the ones of discarded SDUs
+  uint32_t size() const
+  {
+    return tail_count.load(std::memory_order_acquire) - head_count.load(std::memory_order_acquire);
+  }
+  uint32_t get_n_sdus() const { return n_sdus.load(std::memory_order_relaxed); }
+  uint32_t size_bytes() const { return unread_bytes.load(std::memory_order_relaxed); }
+  bool     is_empty() const { return size() == 0; }
+  bool     is_full() const { return size() >= slots.size(); }
+
+private:
+  struct slot_t {
+    std::atomic<byte_buffer_t*> sdu{nullptr};
+    uint32_t                    pdcp_sn = 0; ///< copy of the SDU PDCP SN, so that discard() never reads the SDU
+  };
+
+  void on_pop(const byte_buffer_t& sdu)
+  {
+    unread_bytes.fetch_sub(sdu.N_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::vector<slot_t>   slots;
+  std::atomic<uint32_t> head_count   = {0}; ///< written by the consumer only
+  std::atomic<uint32_t> tail_count   = {0}; ///< written by the producer only
+  std::atomic<uint32_t> unread_bytes = {0};
+  std::atomic<uint32_t> n_sdus       = {0};
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_BYTE_BUFFERQUEUE_H
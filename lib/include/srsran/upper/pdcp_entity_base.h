@@ -33,6 +33,7 @@
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include "srsran/upper/rohc.h"
 
 namespace srsran {
 
@@ -169,6 +170,12 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // Header compression (DRBs only)
+  rohc_compressor   rohc_tx;
+  rohc_decompressor rohc_rx;
+  bool              reconfigure_rohc(const pdcp_config_t& cnfg_);
+  void              configure_rohc();
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
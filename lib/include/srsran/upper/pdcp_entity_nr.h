@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_NR_H
 
 #include "pdcp_entity_base.h"
+#include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
@@ -71,7 +72,7 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
-  uint32_t nof_discard_timers() { return discard_timers_map.size(); }
+  uint32_t nof_discard_timers() { return nof_pending_discards; }
   bool     is_reordering_timer_running() { return reordering_timer.is_running(); }
 
   // State variable setters (should be used only for testing)
@@ -98,9 +99,13 @@ private:
   // Constants: 3GPP TS 38.323 v15.2.0, section 7.2
   uint32_t window_size = 0;
 
-  // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  // Reordering window, indexed by COUNT modulo Window_Size. Stored COUNTs always lie in [RX_DELIV, RX_DELIV +
+  // Window_Size), hence a slot holds at most one PDU and a non-empty slot means the COUNT was received.
+  std::vector<unique_byte_buffer_t> reorder_window;
+  uint32_t                          nof_reorder_pdus = 0;
+  timer_handler::unique_timer       reordering_timer;
+
+  unique_byte_buffer_t& reorder_slot(uint32_t count) { return reorder_window[count & (window_size - 1)]; }
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
@@ -110,9 +115,21 @@ private:
   class reordering_callback;
   std::unique_ptr<reordering_callback> reordering_fnc;
 
-  // Discard callback (discardTimer)
-  class discard_callback;
-  std::map<uint32_t, timer_handler::unique_timer> discard_timers_map;
+  // Discard timer (discardTimer). All SDUs of the bearer use the same timeout, so the discard deadlines grow with
+  // COUNT and are kept in a FIFO. A single timer runs until the earliest deadline.
+  struct discard_entry_t {
+    uint32_t deadline; // in the time base of discard_clock()
+    bool     pending;  // false once RLC notified the delivery of the SDU
+  };
+  srsran::deque<discard_entry_t> discard_queue;
+  uint32_t                       discard_queue_count  = 0; // COUNT of the SDU at the front of discard_queue
+  uint32_t                       nof_pending_discards = 0;
+  uint32_t                       discard_timer_start  = 0; // discard_clock() value when discard_timer was started
+  timer_handler::unique_timer    discard_timer;
+
+  uint32_t discard_clock() const;
+  void     discard_timer_expired();
+  void     pop_delivered_discards();
 
   // COUNT overflow protection
   bool tx_overflow = false;
@@ -138,22 +155,6 @@ private:
   pdcp_entity_nr* parent;
 };
 
-// Discard callback (discardTimer)
-class pdcp_entity_nr::discard_callback
-{
-public:
-  discard_callback(pdcp_entity_nr* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
-
-private:
-  pdcp_entity_nr* parent;
-  uint32_t        discard_sn;
-};
-
 /*
  * Helpers
  */
@@ -162,6 +163,11 @@ inline void pdcp_entity_nr::pass_to_upper_layers(unique_byte_buffer_t sdu)
   if (is_srb()) {
     rrc->write_pdu(lcid, std::move(sdu));
   } else {
+    // Header decompression is done in order of COUNT
+    if (rohc_rx.is_enabled() and not rohc_rx.decompress(*sdu)) {
+      logger.warning("%s Dropping SDU with header decompression failure", rb_name.c_str());
+      return;
+    }
     gw->write_pdu(lcid, std::move(sdu));
   }
 }
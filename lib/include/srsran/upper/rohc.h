@@ -0,0 +1,198 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * @file rohc.h
+ *
+ * @brief Robust Header Compression (ROHC) in unidirectional mode, as used by PDCP DRBs.
+ *        Supported profiles are 0x0000 (uncompressed), 0x0001 (RTP/UDP/IP), 0x0002 (UDP/IP) and 0x0004 (IP),
+ *        for IPv4 headers without options or fragmentation and IPv6 headers without extension headers.
+ *        The compressor sends IR, UO-0, UO-1 and UOR-2 packets, the latter with extension 0 at most. Packets that
+ *        cannot be expressed with those formats are sent as IR packets.
+ *        Ref: RFC 3095, RFC 3843
+ */
+
+#ifndef SRSRAN_ROHC_H
+#define SRSRAN_ROHC_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/interfaces/pdcp_interface_types.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <vector>
+
+namespace srsran {
+
+#define ROHC_PROFILE_UNCOMPRESSED 0x0000
+#define ROHC_PROFILE_RTP 0x0001
+#define ROHC_PROFILE_UDP 0x0002
+#define ROHC_PROFILE_IP 0x0004
+
+#define ROHC_SMALL_CID_MAX 15
+#define ROHC_LARGE_CID_MAX 16383
+
+/// Packet counters of a compressor or decompressor. Byte counters include the payload
+struct rohc_metrics_t {
+  uint64_t nof_packets        = 0;
+  uint64_t nof_ir_packets     = 0;
+  uint64_t nof_errors         = 0; ///< packets that could not be compressed or decompressed
+  uint64_t uncompressed_bytes = 0;
+  uint64_t compressed_bytes   = 0;
+};
+
+/// CRCs of RFC 3095 Sec. 5.9.1, computed with their initial value of all ones
+enum class rohc_crc_type_t { crc3, crc7, crc8 };
+uint8_t rohc_crc(rohc_crc_type_t type, const uint8_t* data, uint32_t len);
+
+/// Header fields of the IP, UDP and RTP headers that are handled by ROHC
+struct rohc_hdr_fields_t {
+  // Static fields
+  uint8_t                 ip_version = 4;
+  uint8_t                 protocol   = 0; ///< IPv4 Protocol or IPv6 Next Header
+  uint32_t                flow_label = 0;
+  std::array<uint8_t, 16> src_addr   = {}; ///< IPv4 addresses use the first 4 octets
+  std::array<uint8_t, 16> dst_addr   = {};
+  uint16_t                src_port   = 0;
+  uint16_t                dst_port   = 0;
+  uint32_t                ssrc       = 0;
+
+  // Dynamic fields
+  uint8_t  tos          = 0; ///< IPv4 Type of Service or IPv6 Traffic Class
+  uint8_t  ttl          = 0; ///< IPv4 Time to Live or IPv6 Hop Limit
+  uint16_t ip_id        = 0;
+  bool     df           = false;
+  uint16_t udp_checksum = 0;
+  uint8_t  rtp_flags    = 0; ///< first octet of the RTP header (V, P, X, CC)
+  bool     rtp_marker   = false;
+  uint8_t  rtp_pt       = 0;
+  uint16_t sn           = 0; ///< RTP SN, or SN generated by the compressor for the UDP and IP profiles
+  uint32_t ts           = 0;
+};
+
+/// State shared by the compressor and decompressor contexts to encode the RTP timestamp
+struct rohc_ts_state_t {
+  uint32_t stride = 0; ///< TS_STRIDE, 0 if unknown
+  uint32_t offset = 0; ///< TS_OFFSET
+
+  uint32_t scale(uint32_t ts) const { return stride != 0 ? (ts - offset) / stride : ts; }
+  uint32_t unscale(uint32_t ts_scaled) const { return stride != 0 ? ts_scaled * stride + offset : ts_scaled; }
+  bool     is_scalable(uint32_t ts) const { return stride == 0 or (ts - offset) % stride == 0; }
+};
+
+/**
+ * ROHC compressor of one PDCP entity. Each flow is assigned its own context. Once all the CIDs up to MAX_CID are in
+ * use, the least recently used context is reinitialized for the new flow.
+ */
+class rohc_compressor
+{
+public:
+  explicit rohc_compressor(srslog::basic_logger& logger) : logger(logger) {}
+
+  /// Drops all contexts and applies the config. A config without profiles disables compression and frees the contexts
+  void configure(const pdcp_rohc_config_t& cfg);
+  /// Drops all contexts, so that every flow restarts with IR packets
+  void reset();
+  bool is_enabled() const { return cfg.enabled(); }
+
+  /// Replaces the headers of the IP packet in the buffer by a ROHC header. Returns false if the packet is malformed
+  bool compress(byte_buffer_t& pkt);
+
+  const rohc_metrics_t& get_metrics() const { return metrics; }
+
+private:
+  struct context_t {
+    bool              in_use        = false;
+    uint16_t          profile       = ROHC_PROFILE_UNCOMPRESSED;
+    uint64_t          last_used     = 0;
+    uint32_t          ir_left       = 0; ///< number of IR packets still to send
+    uint32_t          pkts_since_ir = 0;
+    bool              rnd           = false; ///< IP-ID is sent as is, rather than as an offset from SN
+    uint16_t          ip_id_offset  = 0;
+    uint16_t          next_sn       = 0; ///< SN generated for the UDP and IP profiles
+    rohc_ts_state_t   ts_state;
+    rohc_hdr_fields_t ref;
+    /// W-LSB window with the SN and scaled TS of the last packets, any of which the decompressor may use as reference
+    std::array<std::pair<uint16_t, uint32_t>, 4> window     = {};
+    uint32_t                                     window_len = 0;
+  };
+
+  context_t& find_context(uint16_t profile, const rohc_hdr_fields_t& fields, uint16_t& cid, bool& is_new);
+  /// Updates the context with the changes that the decompressor can not infer. Returns true if an IR is required
+  bool     update_dynamic_state(context_t& ctx, const rohc_hdr_fields_t& fields);
+  uint32_t write_ir(uint16_t cid, const context_t& ctx, const rohc_hdr_fields_t& fields, uint8_t* out) const;
+  /// Writes the smallest UO packet that describes the headers, or returns 0 if none does
+  uint32_t write_uo(uint16_t                 cid,
+                    const context_t&         ctx,
+                    const rohc_hdr_fields_t& fields,
+                    const uint8_t*           hdr,
+                    uint8_t*                 out) const;
+  void     push_window(context_t& ctx, const rohc_hdr_fields_t& fields);
+
+  srslog::basic_logger&  logger;
+  pdcp_rohc_config_t     cfg;
+  std::vector<context_t> contexts;
+  uint64_t               nof_packets = 0;
+  rohc_metrics_t         metrics;
+};
+
+/**
+ * ROHC decompressor of one PDCP entity. Packets must be delivered in order, as done by PDCP when delivering SDUs to
+ * upper layers.
+ */
+class rohc_decompressor
+{
+public:
+  explicit rohc_decompressor(srslog::basic_logger& logger) : logger(logger) {}
+
+  /// Drops all contexts and applies the config. A config without profiles disables decompression and frees the contexts
+  void configure(const pdcp_rohc_config_t& cfg);
+  /// Drops all contexts. Packets are discarded until IR packets are received
+  void reset();
+  bool is_enabled() const { return cfg.enabled(); }
+
+  /// Replaces the ROHC header in the buffer by the uncompressed headers. Returns false if the packet must be discarded
+  bool decompress(byte_buffer_t& pkt);
+
+  const rohc_metrics_t& get_metrics() const { return metrics; }
+
+private:
+  struct context_t {
+    bool              valid        = false;
+    uint16_t          profile      = ROHC_PROFILE_UNCOMPRESSED;
+    bool              rnd          = false;
+    uint16_t          ip_id_offset = 0;
+    rohc_ts_state_t   ts_state;
+    rohc_hdr_fields_t ref;
+  };
+
+  bool decompress_ir(byte_buffer_t& pkt, uint16_t cid, uint32_t start, uint32_t first, uint32_t next);
+  bool decompress_uo(byte_buffer_t& pkt, context_t& ctx, uint32_t first, uint32_t next);
+  bool profile_enabled(uint16_t profile) const;
+
+  srslog::basic_logger&  logger;
+  pdcp_rohc_config_t     cfg;
+  std::vector<context_t> contexts;
+  rohc_metrics_t         metrics;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_ROHC_H
@@ -109,6 +109,60 @@ map_enum_number<const int64_t>(const int64_t* array, uint32_t nof_types, uint32_
 template const float
 map_enum_number<const float>(const float* array, uint32_t nof_types, uint32_t enum_val, const char* enum_type);
 
+/*********************
+   dyn_array_arena
+*********************/
+
+static thread_local dyn_array_arena* current_dyn_array_arena = nullptr;
+
+void* dyn_array_arena::allocate(size_t sz, size_t alignment)
+{
+  while (block_idx < blocks.size()) {
+    block_t& block = blocks[block_idx];
+    uintptr_t addr = reinterpret_cast<uintptr_t>(block.mem.get()) + block_offset;
+    size_t    pad  = (alignment - addr % alignment) % alignment;
+    if (block_offset + pad + sz <= block.size) {
+      block_offset += pad + sz;
+      bytes_used += sz;
+      return reinterpret_cast<void*>(addr + pad);
+    }
+    // Current block exhausted. Move to the next one
+    block_idx++;
+    block_offset = 0;
+  }
+
+  // All blocks exhausted. Allocate a new block, large enough for the requested size
+  block_t new_block;
+  new_block.size = std::max(block_size, sz + alignment);
+  new_block.mem.reset(new uint8_t[new_block.size]);
+  blocks.push_back(std::move(new_block));
+  block_idx    = blocks.size() - 1;
+  block_offset = 0;
+  return allocate(sz, alignment);
+}
+
+void dyn_array_arena::reset()
+{
+  block_idx    = 0;
+  block_offset = 0;
+  bytes_used   = 0;
+}
+
+dyn_array_arena* dyn_array_arena::current()
+{
+  return current_dyn_array_arena;
+}
+
+dyn_array_arena_scope::dyn_array_arena_scope(dyn_array_arena& arena) : prev_arena(current_dyn_array_arena)
+{
+  current_dyn_array_arena = &arena;
+}
+
+dyn_array_arena_scope::~dyn_array_arena_scope()
+{
+  current_dyn_array_arena = prev_arena;
+}
+
 /*********************
        bit_ref
 *********************/
@@ -150,28 +204,32 @@ SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("pack: Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t total_bits = offset + n_bits;
+  if (total_bits > 64) {
+    // The bits do not fit in one 64-bit word together with the current byte offset. Pack the MSBs first
+    SRSASN_CODE ret = pack(val >> 32u, n_bits - 32u);
+    if (ret != SRSASN_SUCCESS) {
+      return ret;
     }
+    return pack(val & 0xffffffffu, 32);
+  }
+  uint32_t nof_bytes = ceil_frac(total_bits, 8u);
+  if (ptr + nof_bytes > max_ptr) {
+    log_error("pack: Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
   }
+
+  // Left-align the bits already written in the current byte and the new bits in a 64-bit word, and write it byte-wise
+  uint64_t word = (offset > 0) ? (uint64_t)(*ptr >> (8u - offset)) << (64u - offset) : 0;
+  word |= (val & ((1ul << n_bits) - 1ul)) << (64u - total_bits);
+  for (uint32_t i = 0; i < nof_bytes; ++i) {
+    ptr[i] = static_cast<uint8_t>(word >> (56u - 8u * i));
+  }
+  ptr += total_bits / 8;
+  offset = total_bits % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -183,24 +241,35 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     return SRSASN_ERROR_DECODE_FAIL;
   }
   val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("unpack_bits: Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += static_cast<T>((*ptr) & mask) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t total_bits = offset + n_bits;
+  if (total_bits > 64) {
+    // Only reachable for 64-bit values that start at a non-zero byte offset. Unpack the MSBs first
+    uint64_t    msbs = 0, lsbs = 0;
+    SRSASN_CODE ret  = unpack_bits(msbs, ptr, offset, max_ptr, n_bits - 32u);
+    if (ret != SRSASN_SUCCESS) {
+      return ret;
     }
+    ret = unpack_bits(lsbs, ptr, offset, max_ptr, 32u);
+    val = static_cast<T>((msbs << 32u) | lsbs);
+    return ret;
+  }
+  uint32_t nof_bytes = ceil_frac(total_bits, 8u);
+  if (ptr + nof_bytes > max_ptr) {
+    log_error("unpack_bits: Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
   }
+
+  // Load all the bytes spanned by the field in a left-aligned 64-bit word, and extract the field in one go
+  uint64_t word = 0;
+  for (uint32_t i = 0; i < nof_bytes; ++i) {
+    word |= (uint64_t)ptr[i] << (56u - 8u * i);
+  }
+  val = static_cast<T>((word << offset) >> (64u - n_bits));
+  ptr += total_bits / 8;
+  offset = total_bits % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -260,9 +329,11 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
+    // Each output byte combines the LSBs of a byte with the MSBs of the next one
     for (uint32_t i = 0; i < n_bytes; ++i) {
-      HANDLE_CODE(unpack(buf[i], 8));
+      buf[i] = static_cast<uint8_t>((ptr[i] << offset) | (ptr[i + 1] >> (8u - offset)));
     }
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -285,8 +356,8 @@ template <typename Ptr>
 SRSASN_CODE bit_ref_impl<Ptr>::advance_bits(uint32_t n_bits)
 {
   uint32_t extra_bits     = (offset + n_bits) % 8;
-  uint32_t bytes_required = ceilf((offset + n_bits) / 8.0f);
-  uint32_t bytes_offset   = floorf((offset + n_bits) / 8.0f);
+  uint32_t bytes_required = ceil_frac(offset + n_bits, 8u);
+  uint32_t bytes_offset   = (offset + n_bits) / 8;
 
   if (ptr + bytes_required > max_ptr) {
     log_error("advance_bytes: Buffer size limit was achieved");
@@ -323,9 +394,14 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
+    // Each input byte is split between the LSBs of the current byte and the MSBs of the next one
+    uint8_t carry = static_cast<uint8_t>(*ptr & (uint8_t)(0xffu << (8u - offset)));
     for (uint32_t i = 0; i < n_bytes; ++i) {
-      pack(buf[i], 8);
+      ptr[i] = carry | static_cast<uint8_t>(buf[i] >> offset);
+      carry  = static_cast<uint8_t>(buf[i] << (8u - offset));
     }
+    ptr += n_bytes;
+    *ptr = carry;
   }
   return SRSASN_SUCCESS;
 }
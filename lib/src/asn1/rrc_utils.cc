@@ -342,6 +342,14 @@ srsran::pdcp_config_t make_drb_pdcp_config_t(const uint8_t bearer_id, bool is_ue
                     discard_timer,
                     status_report_required,
                     srsran_rat_t::lte);
+
+  if (pdcp_cfg.hdr_compress.type().value == pdcp_cfg_s::hdr_compress_c_::types_opts::rohc) {
+    const pdcp_cfg_s::hdr_compress_c_::rohc_s_& rohc = pdcp_cfg.hdr_compress.rohc();
+    cfg.rohc.max_cid                                 = rohc.max_cid_present ? rohc.max_cid : 15;
+    cfg.rohc.profile_rtp                             = rohc.profiles.profile0x0001;
+    cfg.rohc.profile_udp                             = rohc.profiles.profile0x0002;
+    cfg.rohc.profile_ip                              = rohc.profiles.profile0x0004;
+  }
   return cfg;
 }
 
@@ -27,7 +27,7 @@
 namespace srsran {
 
 pdcp_entity_base::pdcp_entity_base(task_sched_handle task_sched_, srslog::basic_logger& logger) :
-  logger(logger), task_sched(task_sched_)
+  logger(logger), task_sched(task_sched_), rohc_tx(logger), rohc_rx(logger)
 {}
 
 pdcp_entity_base::~pdcp_entity_base() {}
@@ -46,6 +46,50 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
   logger.debug(sec_cfg.k_up_int.data(), 32, "K_up_int");
 }
 
+/****************************************************************************
+ * Header compression
+ ***************************************************************************/
+
+/**
+ * Applies the header compression config of a DRB. A config without header compression tears down the contexts of the
+ * previous one.
+ */
+void pdcp_entity_base::configure_rohc()
+{
+  if (not is_drb()) {
+    return;
+  }
+  rohc_tx.configure(cfg.rohc);
+  rohc_rx.configure(cfg.rohc);
+  if (cfg.rohc.enabled()) {
+    logger.info("ROHC enabled with MAX_CID=%d, profiles: RTP=%s, UDP=%s, IP=%s",
+                cfg.rohc.max_cid,
+                cfg.rohc.profile_rtp ? "yes" : "no",
+                cfg.rohc.profile_udp ? "yes" : "no",
+                cfg.rohc.profile_ip ? "yes" : "no");
+  }
+}
+
+/**
+ * Reconfiguration of an active entity, where only the header compression config may change.
+ * Returns false if any other parameter differs from the current config.
+ */
+bool pdcp_entity_base::reconfigure_rohc(const pdcp_config_t& cnfg_)
+{
+  pdcp_config_t new_cfg = cnfg_;
+  new_cfg.rohc          = cfg.rohc;
+  if (new_cfg != cfg) {
+    logger.error("Bearer reconfiguration not supported. LCID=%s.", rb_name.c_str());
+    return false;
+  }
+  if (cnfg_.rohc != cfg.rohc) {
+    logger.info("%s header compression %s", rb_name.c_str(), cnfg_.rohc.enabled() ? "reconfigured" : "released");
+    cfg.rohc = cnfg_.rohc;
+    configure_rohc();
+  }
+  return true;
+}
+
 /****************************************************************************
  * Security functions
  ***************************************************************************/
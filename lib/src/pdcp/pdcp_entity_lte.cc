@@ -61,12 +61,8 @@ pdcp_entity_lte::~pdcp_entity_lte()
 bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
 {
   if (active) {
-    // Already configured
-    if (cnfg_ != cfg) {
-      logger.error("Bearer reconfiguration not supported. LCID=%s.", rb_name.c_str());
-      return false;
-    }
-    return true;
+    // Already configured. Only the header compression can be changed
+    return reconfigure_rohc(cnfg_);
   }
 
   cfg     = cnfg_;
@@ -99,6 +95,8 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
               static_cast<uint32_t>(cfg.discard_timer));
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
+  configure_rohc();
+
   if (is_drb() and not rlc->rb_is_um(lcid)) {
     undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
     rx_counts_info.reserve(reordering_window);
@@ -131,6 +129,12 @@ void pdcp_entity_lte::reestablish()
   } else {
     // Sending the status report will be triggered by the RRC if required
   }
+
+  // Restart header compression from the IR state in both directions
+  if (is_drb()) {
+    rohc_tx.reset();
+    rohc_rx.reset();
+  }
 }
 
 // Used to stop/pause the entity (called on RRC conn release)
@@ -182,6 +186,15 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
       return;
     }
   }
+
+  // Perform header compression. The stored copy is left uncompressed, as it may be forwarded on handover
+  if (rohc_tx.is_enabled() and not rohc_tx.compress(*sdu)) {
+    logger.warning("Could not compress SDU. Discarding SN=%d", used_sn);
+    if (undelivered_sdus != nullptr) {
+      undelivered_sdus->clear_sdu(used_sn);
+    }
+    return;
+  }
   // check for pending security config in transmit direction
   if (enable_security_tx_sn != -1 && enable_security_tx_sn == static_cast<int32_t>(tx_count)) {
     enable_integrity(DIRECTION_TX);
@@ -300,6 +313,10 @@ void pdcp_entity_lte::handle_control_pdu(unique_byte_buffer_t pdu)
     case PDCP_PDU_TYPE_STATUS_REPORT:
       handle_status_report_pdu(std::move(pdu));
       break;
+    case PDCP_PDU_TYPE_INTERSPERSED_ROHC_FEEDBACK_PACKET:
+      // ROHC is only operated in U-mode, which does not use feedback
+      logger.info("Ignoring interspersed ROHC feedback");
+      break;
     default:
       logger.warning("Unhandled control PDU");
       return;
@@ -389,6 +406,12 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
     st.rx_hfn++;
   }
 
+  // Perform header decompression
+  if (rohc_rx.is_enabled() and not rohc_rx.decompress(*pdu)) {
+    logger.warning("%s Dropping SDU SN=%d with header decompression failure", rb_name.c_str(), sn);
+    return;
+  }
+
   // Pass to upper layers
   gw->write_pdu(lcid, std::move(pdu));
 }
@@ -453,6 +476,12 @@ void pdcp_entity_lte::handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu)
   // Store Rx SN/COUNT
   update_rx_counts_queue(count);
 
+  // Perform header decompression
+  if (rohc_rx.is_enabled() and not rohc_rx.decompress(*pdu)) {
+    logger.warning("%s Dropping SDU SN=%d with header decompression failure", rb_name.c_str(), sn);
+    return;
+  }
+
   // Pass to upper layers
   gw->write_pdu(lcid, std::move(pdu));
 }
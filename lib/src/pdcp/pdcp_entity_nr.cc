@@ -44,20 +44,19 @@ pdcp_entity_nr::pdcp_entity_nr(srsue::rlc_interface_pdcp* rlc_,
 bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
 {
   if (active) {
-    // Already configured
-    if (cnfg_ != cfg) {
-      logger.error("Bearer reconfiguration not supported. LCID=%s.", rb_name.c_str());
-      return false;
-    }
-    return true;
+    // Already configured. Only the header compression can be changed
+    return reconfigure_rohc(cnfg_);
   }
 
   cfg         = cnfg_;
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
+  reorder_window.resize(window_size);
 
   rlc_mode = rlc->rb_is_um(lcid) ? rlc_mode_t::UM : rlc_mode_t::AM;
 
+  configure_rohc();
+
   // t-Reordering timer
   if (cfg.t_reordering != pdcp_t_reordering_t::infinity) {
     reordering_timer = task_sched.get_unique_timer();
@@ -82,6 +81,12 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   if (rlc_mode == rlc_mode_t::UM) {
     cfg.discard_timer = pdcp_discard_timer_t::infinity;
   }
+
+  // discardTimer
+  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
+    discard_timer = task_sched.get_unique_timer();
+    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), [this](uint32_t tid) { discard_timer_expired(); });
+  }
   return true;
 }
 
@@ -90,6 +95,12 @@ void pdcp_entity_nr::reestablish()
 {
   logger.info("Re-establish %s with bearer ID: %d", rb_name.c_str(), cfg.bearer_id);
   // TODO
+
+  // Reset the header compression protocol in both directions (38.323 5.1.2)
+  if (is_drb()) {
+    rohc_tx.reset();
+    rohc_rx.reset();
+  }
 }
 
 // Used to stop/pause the entity (called on RRC conn release)
@@ -125,18 +136,28 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
     tx_overflow = true;
   }
 
+  // Perform header compression
+  if (rohc_tx.is_enabled() and not rohc_tx.compress(*sdu)) {
+    logger.warning("Could not compress %s SDU. Dropping packet", rb_name.c_str());
+    return;
+  }
+
   // Start discard timer
   if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
-    timer_handler::unique_timer discard_timer = task_sched.get_unique_timer();
-    discard_callback            discard_fnc(this, tx_next);
-    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_fnc);
-    discard_timer.run();
-    discard_timers_map.insert(std::make_pair(tx_next, std::move(discard_timer)));
+    uint32_t now = discard_clock();
+    if (discard_queue.empty()) {
+      discard_queue_count = tx_next;
+    }
+    discard_queue.push_back({now + static_cast<uint32_t>(cfg.discard_timer), true});
+    nof_pending_discards++;
+    if (not discard_timer.is_running()) {
+      discard_timer_start = now;
+      discard_timer.set(static_cast<uint32_t>(cfg.discard_timer));
+      discard_timer.run();
+    }
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, static_cast<uint32_t>(cfg.discard_timer));
   }
 
-  // Perform header compression TODO
-
   // Write PDCP header info
   write_data_header(sdu, tx_next);
 
@@ -286,13 +307,15 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  unique_byte_buffer_t& slot = reorder_slot(rcvd_count);
+  if (slot != nullptr) {
     logger.debug("Duplicate PDU, dropping");
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  slot = std::move(pdu);
+  nof_reorder_pdus++;
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -328,9 +351,18 @@ void pdcp_entity_nr::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
 {
   logger.debug("Received delivery notification from RLC. Nof SNs=%ld", pdcp_sns.size());
   for (uint32_t sn : pdcp_sns) {
-    // Remove timer from map
+    // The SN of the SDU passed to RLC is its COUNT
+    uint32_t idx = sn - discard_queue_count;
+    if (idx >= discard_queue.size() or not discard_queue[idx].pending) {
+      continue;
+    }
     logger.debug("Stopping discard timer for SN=%ld", sn);
-    discard_timers_map.erase(sn);
+    discard_queue[idx].pending = false;
+    nof_pending_discards--;
+  }
+  pop_delivered_discards();
+  if (discard_queue.empty()) {
+    discard_timer.stop();
   }
 }
 
@@ -347,10 +379,8 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  while (reorder_slot(rx_deliv) != nullptr) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -362,7 +392,8 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    nof_reorder_pdus--;
+    pass_to_upper_layers(std::move(reorder_slot(rx_deliv)));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
@@ -376,14 +407,16 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
 void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 {
   parent->logger.info(
-      "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
+      "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->nof_reorder_pdus);
 
   // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+  for (uint32_t count = parent->rx_deliv; count < parent->rx_reord; ++count) {
+    unique_byte_buffer_t& slot = parent->reorder_slot(count);
+    if (slot != nullptr) {
+      // Deliver to upper layers
+      parent->nof_reorder_pdus--;
+      parent->pass_to_upper_layers(std::move(slot));
+    }
   }
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
@@ -402,17 +435,45 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
   }
 }
 
+// Time in ms, which only advances while the discard timer is running. Only differences between values are relevant.
+uint32_t pdcp_entity_nr::discard_clock() const
+{
+  return discard_timer_start + (discard_timer.is_running() ? discard_timer.time_elapsed() : 0);
+}
+
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_nr::discard_timer_expired()
 {
-  parent->logger.debug("Discard timer expired for PDU with SN=%d", discard_sn);
+  uint32_t now = discard_timer_start + discard_timer.duration();
+
+  for (; not discard_queue.empty() and discard_queue.front().deadline <= now; discard_queue.pop_front()) {
+    if (discard_queue.front().pending) {
+      logger.debug("Discard timer expired for PDU with SN=%d", discard_queue_count);
+
+      // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
+      rlc->discard_sdu(lcid, discard_queue_count);
+      nof_pending_discards--;
+    }
+    discard_queue_count++;
+  }
+  pop_delivered_discards();
 
-  // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
-  parent->rlc->discard_sdu(parent->lcid, discard_sn);
+  // Wait for the next deadline. The timer clock only advances after the expiry callbacks were called, so a timer
+  // started here needs one extra tick.
+  if (not discard_queue.empty()) {
+    discard_timer_start = now - 1;
+    discard_timer.set(discard_queue.front().deadline - now + 1);
+    discard_timer.run();
+  }
+}
 
-  // Remove timer from map
-  // NOTE: this will delete the callback. It *must* be the last instruction.
-  parent->discard_timers_map.erase(discard_sn);
+// Removes the SDUs already delivered from the front of the discard queue
+void pdcp_entity_nr::pop_delivered_discards()
+{
+  while (not discard_queue.empty() and not discard_queue.front().pending) {
+    discard_queue.pop_front();
+    discard_queue_count++;
+  }
 }
 
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
@@ -0,0 +1,1067 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/rohc.h"
+#include <cstring>
+
+namespace srsran {
+
+namespace {
+
+const uint32_t rohc_ir_repetitions = 3;   ///< IR packets sent when a context is (re)initialized
+const uint32_t rohc_ir_refresh     = 256; ///< packets after which the context is refreshed with an IR packet
+const uint32_t rohc_max_hdr_len    = 128; ///< largest ROHC header built by the compressor
+
+const uint32_t ipv4_hdr_len = 20;
+const uint32_t ipv6_hdr_len = 40;
+const uint32_t udp_hdr_len  = 8;
+const uint32_t rtp_hdr_len  = 12;
+const uint32_t max_hdr_len  = ipv6_hdr_len + udp_hdr_len + rtp_hdr_len;
+
+const uint8_t ip_proto_udp = 17;
+
+const uint8_t rohc_type_ir       = 0xfc; ///< IR packet, last bit indicates the presence of the dynamic chain
+const uint8_t rohc_type_ir_dyn   = 0xf8;
+const uint8_t rohc_type_padding  = 0xe0;
+const uint8_t rohc_type_add_cid  = 0xe0;
+const uint8_t rohc_type_feedback = 0xf0;
+
+/*******************************************************************************
+ * CRC and bit field helpers
+ ******************************************************************************/
+
+struct rohc_crc_tables_t {
+  std::array<uint8_t, 256> crc3, crc7, crc8;
+
+  rohc_crc_tables_t()
+  {
+    // Polynomials in reflected form: CRC-3 1+x+x^3, CRC-7 1+x+x^2+x^3+x^6+x^7 and CRC-8 1+x+x^2+x^8
+    build(crc3, 0x6);
+    build(crc7, 0x79);
+    build(crc8, 0xe0);
+  }
+
+  static void build(std::array<uint8_t, 256>& table, uint8_t poly)
+  {
+    for (uint32_t i = 0; i < table.size(); ++i) {
+      uint8_t crc = i;
+      for (uint32_t b = 0; b < 8; ++b) {
+        crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+      }
+      table[i] = crc;
+    }
+  }
+};
+
+const rohc_crc_tables_t crc_tables;
+
+uint8_t crc_init(rohc_crc_type_t type)
+{
+  return type == rohc_crc_type_t::crc3 ? 0x7 : (type == rohc_crc_type_t::crc7 ? 0x7f : 0xff);
+}
+
+uint8_t crc_update(rohc_crc_type_t type, const uint8_t* data, uint32_t len, uint8_t crc)
+{
+  const std::array<uint8_t, 256>& table = type == rohc_crc_type_t::crc3
+                                              ? crc_tables.crc3
+                                              : (type == rohc_crc_type_t::crc7 ? crc_tables.crc7 : crc_tables.crc8);
+  for (uint32_t i = 0; i < len; ++i) {
+    crc = table[data[i] ^ crc];
+  }
+  return crc;
+}
+
+/// CRC of the uncompressed headers, computed first over the CRC-STATIC and then over the CRC-DYNAMIC octets
+/// (RFC 3095 Sec. 5.9.2)
+uint8_t header_crc(rohc_crc_type_t type, uint16_t profile, const uint8_t* hdr)
+{
+  bool           is_ipv4 = (hdr[0] >> 4) == 4;
+  const uint8_t* udp     = hdr + (is_ipv4 ? ipv4_hdr_len : ipv6_hdr_len);
+  const uint8_t* rtp     = udp + udp_hdr_len;
+  bool           has_udp = profile == ROHC_PROFILE_RTP or profile == ROHC_PROFILE_UDP;
+
+  uint8_t crc = crc_init(type);
+  if (is_ipv4) {
+    crc = crc_update(type, hdr, 2, crc);      // Version, IHL, TOS
+    crc = crc_update(type, hdr + 6, 4, crc);  // Flags, Fragment Offset, TTL, Protocol
+    crc = crc_update(type, hdr + 12, 8, crc); // Addresses
+  } else {
+    crc = crc_update(type, hdr, 4, crc);      // Version, Traffic Class, Flow Label
+    crc = crc_update(type, hdr + 6, 34, crc); // Next Header, Hop Limit, Addresses
+  }
+  if (has_udp) {
+    crc = crc_update(type, udp, 4, crc); // Ports
+  }
+  if (profile == ROHC_PROFILE_RTP) {
+    crc = crc_update(type, rtp, 1, crc);     // V, P, X, CC
+    crc = crc_update(type, rtp + 8, 4, crc); // SSRC
+  }
+
+  if (is_ipv4) {
+    crc = crc_update(type, hdr + 2, 4, crc);  // Total Length, Identification
+    crc = crc_update(type, hdr + 10, 2, crc); // Header Checksum
+  } else {
+    crc = crc_update(type, hdr + 4, 2, crc); // Payload Length
+  }
+  if (has_udp) {
+    crc = crc_update(type, udp + 4, 4, crc); // Length, Checksum
+  }
+  if (profile == ROHC_PROFILE_RTP) {
+    crc = crc_update(type, rtp + 1, 7, crc); // M, PT, SN, TS
+  }
+  return crc;
+}
+
+uint16_t read16(const uint8_t* p)
+{
+  return (uint16_t)p[0] << 8 | p[1];
+}
+
+uint32_t read32(const uint8_t* p)
+{
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+void write16(uint8_t*& p, uint16_t v)
+{
+  *p++ = v >> 8;
+  *p++ = v & 0xff;
+}
+
+void write32(uint8_t*& p, uint32_t v)
+{
+  write16(p, v >> 16);
+  write16(p, v & 0xffff);
+}
+
+/// Self-describing variable length encoding, for values below 2^29 (RFC 3095 Sec. 4.5.6)
+void write_sdvl(uint8_t*& p, uint32_t v)
+{
+  if (v < (1U << 7)) {
+    *p++ = v;
+  } else if (v < (1U << 14)) {
+    *p++ = 0x80 | (v >> 8);
+    *p++ = v & 0xff;
+  } else if (v < (1U << 21)) {
+    *p++ = 0xc0 | (v >> 16);
+    write16(p, v & 0xffff);
+  } else {
+    *p++ = 0xe0 | (v >> 24);
+    *p++ = (v >> 16) & 0xff;
+    write16(p, v & 0xffff);
+  }
+}
+
+uint16_t ipv4_checksum(const uint8_t* hdr)
+{
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ipv4_hdr_len; i += 2) {
+    sum += read16(hdr + i);
+  }
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return ~sum & 0xffff;
+}
+
+/// Bounds-checked reader of the received ROHC headers
+struct rohc_reader_t {
+  const uint8_t* data;
+  uint32_t       len;
+  uint32_t       pos;
+  bool           ok = true;
+
+  bool has(uint32_t n)
+  {
+    ok = ok and pos + n <= len;
+    return ok;
+  }
+  uint8_t u8() { return has(1) ? data[pos++] : 0; }
+  uint16_t u16()
+  {
+    uint16_t v = has(2) ? read16(data + pos) : 0;
+    pos += ok ? 2 : 0;
+    return v;
+  }
+  uint32_t u32()
+  {
+    uint32_t v = has(4) ? read32(data + pos) : 0;
+    pos += ok ? 4 : 0;
+    return v;
+  }
+  void bytes(uint8_t* out, uint32_t n)
+  {
+    if (has(n)) {
+      memcpy(out, data + pos, n);
+      pos += n;
+    }
+  }
+  uint32_t sdvl()
+  {
+    uint8_t  first      = u8();
+    uint32_t nof_octets = (first & 0x80) == 0 ? 0 : ((first & 0x40) == 0 ? 1 : ((first & 0x20) == 0 ? 2 : 3));
+    uint32_t v          = first & (nof_octets < 3 ? 0x7f >> nof_octets : 0x1f);
+    for (uint32_t i = 0; i < nof_octets; ++i) {
+      v = v << 8 | u8();
+    }
+    return v;
+  }
+};
+
+/// W-LSB: true if the k LSBs of v identify it unambiguously in the interpretation interval of ref with offset p
+bool lsb_fits(uint32_t v, uint32_t ref, uint32_t k, int32_t p, uint32_t width_mask)
+{
+  return ((v - (ref - p)) & width_mask) < (1U << k);
+}
+
+uint32_t lsb_decode(uint32_t bits, uint32_t ref, uint32_t k, int32_t p, uint32_t width_mask)
+{
+  uint32_t low = ref - p;
+  return (low + ((bits - low) & ((1U << k) - 1))) & width_mask;
+}
+
+const int32_t  sn_p    = -1;
+const uint32_t sn_mask = 0xffff;
+const uint32_t ts_mask = 0xffffffff;
+
+int32_t ts_p(uint32_t k)
+{
+  return (1 << (k - 2)) - 1;
+}
+
+/// TS_SCALED inferred from the SN of the packet when the TS is not sent
+uint32_t infer_ts_scaled(const rohc_ts_state_t& ts_state, uint16_t ref_sn, uint32_t ref_ts_scaled, uint16_t sn)
+{
+  return ts_state.stride != 0 ? ref_ts_scaled + (uint16_t)(sn - ref_sn) : ref_ts_scaled;
+}
+
+/// In contexts with a sequential IPv4 IP-ID, UO-1 and UOR-2 have a T bit and carry one TS bit less
+bool has_seq_ipv4(const rohc_hdr_fields_t& ref, bool rnd)
+{
+  return ref.ip_version == 4 and not rnd;
+}
+
+/*******************************************************************************
+ * Uncompressed headers
+ ******************************************************************************/
+
+bool is_ip_extension(uint8_t proto)
+{
+  // Hop-by-hop, IP-in-IP, IPv6, Routing, Fragment, GRE, AH, MINE and Destination Options headers are left to the
+  // uncompressed profile
+  return proto == 0 or proto == 4 or proto == 41 or proto == 43 or proto == 44 or proto == 47 or proto == 51 or
+         proto == 55 or proto == 60;
+}
+
+/// Parses the headers of the packet and selects the profile to compress them
+uint16_t
+parse_headers(const uint8_t* p, uint32_t len, const pdcp_rohc_config_t& cfg, rohc_hdr_fields_t& f, uint32_t& hdr_len)
+{
+  hdr_len = 0;
+  if (len == 0) {
+    return ROHC_PROFILE_UNCOMPRESSED;
+  }
+
+  uint32_t ip_len = 0;
+  if ((p[0] >> 4) == 4) {
+    // IPv4 without options nor fragmentation. The checksum must be right, as the decompressor recomputes it
+    if (len < ipv4_hdr_len or p[0] != 0x45 or read16(p + 2) != len or (read16(p + 6) & 0xbfff) != 0 or
+        ipv4_checksum(p) != 0) {
+      return ROHC_PROFILE_UNCOMPRESSED;
+    }
+    f.ip_version = 4;
+    f.tos        = p[1];
+    f.ip_id      = read16(p + 4);
+    f.df         = (p[6] & 0x40) != 0;
+    f.ttl        = p[8];
+    f.protocol   = p[9];
+    memcpy(f.src_addr.data(), p + 12, 4);
+    memcpy(f.dst_addr.data(), p + 16, 4);
+    ip_len = ipv4_hdr_len;
+  } else if ((p[0] >> 4) == 6) {
+    if (len < ipv6_hdr_len or read16(p + 4) != len - ipv6_hdr_len) {
+      return ROHC_PROFILE_UNCOMPRESSED;
+    }
+    f.ip_version = 6;
+    f.tos        = (p[0] & 0x0f) << 4 | p[1] >> 4;
+    f.flow_label = (uint32_t)(p[1] & 0x0f) << 16 | read16(p + 2);
+    f.protocol   = p[6];
+    f.ttl        = p[7];
+    memcpy(f.src_addr.data(), p + 8, 16);
+    memcpy(f.dst_addr.data(), p + 24, 16);
+    ip_len = ipv6_hdr_len;
+  } else {
+    return ROHC_PROFILE_UNCOMPRESSED;
+  }
+  if (is_ip_extension(f.protocol)) {
+    return ROHC_PROFILE_UNCOMPRESSED;
+  }
+
+  const uint8_t* udp = p + ip_len;
+  if (f.protocol == ip_proto_udp and (cfg.profile_rtp or cfg.profile_udp) and len >= ip_len + udp_hdr_len and
+      read16(udp + 4) == len - ip_len) {
+    f.src_port     = read16(udp);
+    f.dst_port     = read16(udp + 2);
+    f.udp_checksum = read16(udp + 6);
+
+    // RTP is identified heuristically: version 2 without padding, extension nor CSRCs, on an even port
+    const uint8_t* rtp = udp + udp_hdr_len;
+    if (cfg.profile_rtp and len >= ip_len + udp_hdr_len + rtp_hdr_len and rtp[0] == 0x80 and f.dst_port >= 1024 and
+        f.dst_port % 2 == 0) {
+      uint8_t pt = rtp[1] & 0x7f;
+      // Payload types 72-76 belong to RTCP packets sharing the port
+      if (pt < 72 or pt > 76) {
+        f.rtp_flags  = rtp[0];
+        f.rtp_marker = (rtp[1] & 0x80) != 0;
+        f.rtp_pt     = pt;
+        f.sn         = read16(rtp + 2);
+        f.ts         = read32(rtp + 4);
+        f.ssrc       = read32(rtp + 8);
+        hdr_len      = ip_len + udp_hdr_len + rtp_hdr_len;
+        return ROHC_PROFILE_RTP;
+      }
+    }
+    if (cfg.profile_udp) {
+      hdr_len = ip_len + udp_hdr_len;
+      return ROHC_PROFILE_UDP;
+    }
+    f.src_port     = 0;
+    f.dst_port     = 0;
+    f.udp_checksum = 0;
+  }
+  if (cfg.profile_ip) {
+    hdr_len = ip_len;
+    return ROHC_PROFILE_IP;
+  }
+  return ROHC_PROFILE_UNCOMPRESSED;
+}
+
+/// Writes the uncompressed headers of a packet with the given payload length. Returns the length of the headers
+uint32_t build_headers(uint16_t profile, const rohc_hdr_fields_t& f, uint32_t payload_len, uint8_t* out)
+{
+  uint32_t ip_len  = f.ip_version == 4 ? ipv4_hdr_len : ipv6_hdr_len;
+  uint32_t hdr_len = ip_len;
+  hdr_len += (profile == ROHC_PROFILE_RTP or profile == ROHC_PROFILE_UDP) ? udp_hdr_len : 0;
+  hdr_len += profile == ROHC_PROFILE_RTP ? rtp_hdr_len : 0;
+  uint32_t total_len = hdr_len + payload_len;
+
+  uint8_t* p = out;
+  if (f.ip_version == 4) {
+    *p++ = 0x45;
+    *p++ = f.tos;
+    write16(p, total_len);
+    write16(p, f.ip_id);
+    write16(p, f.df ? 0x4000 : 0);
+    *p++ = f.ttl;
+    *p++ = f.protocol;
+    write16(p, 0);
+    memcpy(p, f.src_addr.data(), 4);
+    memcpy(p + 4, f.dst_addr.data(), 4);
+    p += 8;
+    uint16_t checksum = ipv4_checksum(out);
+    out[10]           = checksum >> 8;
+    out[11]           = checksum & 0xff;
+  } else {
+    *p++ = 0x60 | f.tos >> 4;
+    *p++ = (f.tos & 0x0f) << 4 | f.flow_label >> 16;
+    write16(p, f.flow_label & 0xffff);
+    write16(p, total_len - ipv6_hdr_len);
+    *p++ = f.protocol;
+    *p++ = f.ttl;
+    memcpy(p, f.src_addr.data(), 16);
+    memcpy(p + 16, f.dst_addr.data(), 16);
+    p += 32;
+  }
+  if (profile == ROHC_PROFILE_RTP or profile == ROHC_PROFILE_UDP) {
+    write16(p, f.src_port);
+    write16(p, f.dst_port);
+    write16(p, total_len - ip_len);
+    write16(p, f.udp_checksum);
+  }
+  if (profile == ROHC_PROFILE_RTP) {
+    *p++ = f.rtp_flags;
+    *p++ = (f.rtp_marker ? 0x80 : 0) | f.rtp_pt;
+    write16(p, f.sn);
+    write32(p, f.ts);
+    write32(p, f.ssrc);
+  }
+  return hdr_len;
+}
+
+bool same_flow(uint16_t profile, const rohc_hdr_fields_t& a, const rohc_hdr_fields_t& b)
+{
+  if (profile == ROHC_PROFILE_UNCOMPRESSED) {
+    return true;
+  }
+  return a.ip_version == b.ip_version and a.protocol == b.protocol and a.flow_label == b.flow_label and
+         a.src_addr == b.src_addr and a.dst_addr == b.dst_addr and a.src_port == b.src_port and
+         a.dst_port == b.dst_port and a.ssrc == b.ssrc;
+}
+
+/// Writes the type octet with the CID, either as Add-CID octet in front (small CIDs) or after it (large CIDs)
+uint32_t write_type_and_cid(uint16_t max_cid, uint16_t cid, uint8_t type, uint8_t* out)
+{
+  uint8_t* p = out;
+  if (max_cid <= ROHC_SMALL_CID_MAX) {
+    if (cid != 0) {
+      *p++ = rohc_type_add_cid | cid;
+    }
+    *p++ = type;
+  } else {
+    *p++ = type;
+    write_sdvl(p, cid);
+  }
+  return p - out;
+}
+
+} // namespace
+
+uint8_t rohc_crc(rohc_crc_type_t type, const uint8_t* data, uint32_t len)
+{
+  return crc_update(type, data, len, crc_init(type));
+}
+
+/*******************************************************************************
+ * Compressor
+ ******************************************************************************/
+
+void rohc_compressor::configure(const pdcp_rohc_config_t& cfg_)
+{
+  cfg         = cfg_;
+  cfg.max_cid = std::min(cfg.max_cid, (uint16_t)ROHC_LARGE_CID_MAX);
+  reset();
+  if (not cfg.enabled()) {
+    contexts.shrink_to_fit();
+  }
+}
+
+void rohc_compressor::reset()
+{
+  contexts.clear();
+}
+
+rohc_compressor::context_t&
+rohc_compressor::find_context(uint16_t profile, const rohc_hdr_fields_t& fields, uint16_t& cid, bool& is_new)
+{
+  uint32_t lru = 0;
+  for (uint32_t i = 0; i < contexts.size(); ++i) {
+    const context_t& ctx = contexts[i];
+    if (ctx.in_use and ctx.profile == profile and same_flow(profile, ctx.ref, fields)) {
+      cid    = i;
+      is_new = false;
+      return contexts[i];
+    }
+    if (contexts[lru].in_use and (not ctx.in_use or ctx.last_used < contexts[lru].last_used)) {
+      lru = i;
+    }
+  }
+
+  // Take a new CID while below MAX_CID, otherwise reuse a released or the least recently used context
+  if (contexts.size() <= cfg.max_cid and (contexts.empty() or contexts[lru].in_use)) {
+    lru = contexts.size();
+    contexts.emplace_back();
+  }
+  cid            = lru;
+  is_new         = true;
+  contexts[lru]  = {};
+  context_t& ctx = contexts[lru];
+  ctx.in_use     = true;
+  ctx.profile    = profile;
+  ctx.ir_left    = rohc_ir_repetitions;
+  ctx.ref        = fields;
+  logger.debug("ROHC: new context CID=%d for profile 0x%04x", cid, profile);
+  return ctx;
+}
+
+bool rohc_compressor::update_dynamic_state(context_t& ctx, const rohc_hdr_fields_t& f)
+{
+  const rohc_hdr_fields_t& ref     = ctx.ref;
+  bool                     changed = f.tos != ref.tos or f.ttl != ref.ttl or f.df != ref.df or
+                 (f.udp_checksum != 0) != (ref.udp_checksum != 0) or f.rtp_flags != ref.rtp_flags or
+                 f.rtp_pt != ref.rtp_pt;
+
+  if (f.ip_version == 4 and not ctx.rnd and (uint16_t)(f.ip_id - f.sn) != ctx.ip_id_offset) {
+    // The IP-ID does not follow the SN, send it as is from now on
+    ctx.rnd = true;
+    changed = true;
+  }
+
+  if (ctx.profile == ROHC_PROFILE_RTP and
+      (not ctx.ts_state.is_scalable(f.ts) or (ctx.ts_state.stride == 0 and f.ts != ref.ts))) {
+    // Learn TS_STRIDE from the TS and SN increments with respect to the previous packet
+    uint16_t delta_sn = f.sn - ref.sn;
+    uint32_t delta_ts = f.ts - ref.ts;
+    uint32_t stride   = 0;
+    if (delta_sn != 0 and delta_ts != 0 and delta_ts % delta_sn == 0 and delta_ts / delta_sn < (1U << 29)) {
+      stride = delta_ts / delta_sn;
+    }
+    ctx.ts_state.stride = stride;
+    ctx.ts_state.offset = stride != 0 ? f.ts % stride : 0;
+    changed             = true;
+  }
+  return changed;
+}
+
+uint32_t rohc_compressor::write_ir(uint16_t cid, const context_t& ctx, const rohc_hdr_fields_t& f, uint8_t* out) const
+{
+  bool     has_dynamic = ctx.profile != ROHC_PROFILE_UNCOMPRESSED;
+  uint8_t* p           = out + write_type_and_cid(cfg.max_cid, cid, rohc_type_ir | (has_dynamic ? 1 : 0), out);
+  *p++                 = ctx.profile & 0xff;
+  uint8_t* crc_pos     = p;
+  *p++                 = 0;
+  if (not has_dynamic) {
+    *crc_pos = rohc_crc(rohc_crc_type_t::crc8, out, p - out);
+    return p - out;
+  }
+
+  // Static chain
+  if (f.ip_version == 4) {
+    *p++ = 0x40;
+    *p++ = f.protocol;
+    memcpy(p, f.src_addr.data(), 4);
+    memcpy(p + 4, f.dst_addr.data(), 4);
+    p += 8;
+  } else {
+    *p++ = 0x60 | f.flow_label >> 16;
+    write16(p, f.flow_label & 0xffff);
+    *p++ = f.protocol;
+    memcpy(p, f.src_addr.data(), 16);
+    memcpy(p + 16, f.dst_addr.data(), 16);
+    p += 32;
+  }
+  if (ctx.profile == ROHC_PROFILE_RTP or ctx.profile == ROHC_PROFILE_UDP) {
+    write16(p, f.src_port);
+    write16(p, f.dst_port);
+  }
+  if (ctx.profile == ROHC_PROFILE_RTP) {
+    write32(p, f.ssrc);
+  }
+
+  // Dynamic chain. IP-ID is sent in network byte order and extension header lists are empty
+  *p++ = f.tos;
+  *p++ = f.ttl;
+  if (f.ip_version == 4) {
+    write16(p, f.ip_id);
+    *p++ = (f.df ? 0x80 : 0) | (ctx.rnd ? 0x40 : 0) | 0x20;
+  }
+  *p++ = 0;
+  if (ctx.profile == ROHC_PROFILE_RTP or ctx.profile == ROHC_PROFILE_UDP) {
+    write16(p, f.udp_checksum);
+  }
+  if (ctx.profile == ROHC_PROFILE_RTP) {
+    bool rx = ctx.ts_state.stride != 0;
+    *p++    = (f.rtp_flags & 0xef) | (rx ? 0x10 : 0);
+    *p++    = (f.rtp_marker ? 0x80 : 0) | f.rtp_pt;
+    write16(p, f.sn);
+    write32(p, f.ts);
+    *p++ = 0; // empty CSRC list
+    if (rx) {
+      // X, Mode = U-mode, TIS = 0, TSS = 1
+      *p++ = (f.rtp_flags & 0x10) | 0x08 | 0x01;
+      write_sdvl(p, ctx.ts_state.stride);
+    }
+  } else {
+    write16(p, f.sn);
+  }
+
+  *crc_pos = rohc_crc(rohc_crc_type_t::crc8, out, p - out);
+  return p - out;
+}
+
+uint32_t rohc_compressor::write_uo(uint16_t                 cid,
+                                   const context_t&         ctx,
+                                   const rohc_hdr_fields_t& f,
+                                   const uint8_t*           hdr,
+                                   uint8_t*                 out) const
+{
+  if (ctx.window_len == 0) {
+    return 0;
+  }
+
+  // The packet must be decodable with any of the references in the window
+  bool     seq_ipv4  = has_seq_ipv4(ctx.ref, ctx.rnd);
+  uint32_t ts_k      = seq_ipv4 ? 5 : 6;
+  uint32_t ts_scaled = ctx.ts_state.scale(f.ts);
+  bool     sn_fits4 = true, sn_fits6 = true, sn_fits9 = true;
+  bool     ts_fits = true, ts_fits_ext = true, ts_inferred = true;
+  for (uint32_t i = 0; i < ctx.window_len; ++i) {
+    uint16_t ref_sn = ctx.window[i].first;
+    uint32_t ref_ts = ctx.window[i].second;
+    sn_fits4        = sn_fits4 and lsb_fits(f.sn, ref_sn, 4, sn_p, sn_mask);
+    sn_fits6        = sn_fits6 and lsb_fits(f.sn, ref_sn, 6, sn_p, sn_mask);
+    sn_fits9        = sn_fits9 and lsb_fits(f.sn, ref_sn, 9, sn_p, sn_mask);
+    ts_fits         = ts_fits and lsb_fits(ts_scaled, ref_ts, ts_k, ts_p(ts_k), ts_mask);
+    ts_fits_ext     = ts_fits_ext and lsb_fits(ts_scaled, ref_ts, ts_k + 3, ts_p(ts_k + 3), ts_mask);
+    ts_inferred     = ts_inferred and ts_scaled == infer_ts_scaled(ctx.ts_state, ref_sn, ref_ts, f.sn);
+  }
+
+  uint8_t  base[4];
+  uint32_t base_len = 0;
+  if (ctx.profile != ROHC_PROFILE_RTP or (sn_fits4 and ts_inferred and not f.rtp_marker)) {
+    if (not sn_fits4) {
+      return 0;
+    }
+    // UO-0
+    base[base_len++] = (f.sn & 0x0f) << 3 | header_crc(rohc_crc_type_t::crc3, ctx.profile, hdr);
+  } else if (sn_fits4 and ts_fits) {
+    // UO-1, or UO-1-TS with T = 1
+    uint8_t ts_lsb   = ts_scaled & ((1U << ts_k) - 1);
+    base[base_len++] = 0x80 | (seq_ipv4 ? 0x20 : 0) | ts_lsb;
+    uint8_t crc      = header_crc(rohc_crc_type_t::crc3, ctx.profile, hdr);
+    base[base_len++] = (f.rtp_marker ? 0x80 : 0) | (f.sn & 0x0f) << 3 | crc;
+  } else if ((sn_fits6 and ts_fits) or (sn_fits9 and ts_fits_ext)) {
+    // UOR-2, or UOR-2-TS with T = 1. Extension 0 carries 3 more bits of SN and TS
+    bool     ext     = not(sn_fits6 and ts_fits);
+    uint32_t sn_lsb  = ext ? f.sn >> 3 : f.sn;
+    uint32_t ts_lsb  = (ext ? ts_scaled >> 3 : ts_scaled) & ((1U << ts_k) - 1);
+    base[base_len++] = 0xc0 | (seq_ipv4 ? ts_lsb : ts_lsb >> 1);
+    base[base_len++] = (seq_ipv4 ? 0x80 : (ts_lsb & 1) << 7) | (f.rtp_marker ? 0x40 : 0) | (sn_lsb & 0x3f);
+    base[base_len++] = (ext ? 0x80 : 0) | header_crc(rohc_crc_type_t::crc7, ctx.profile, hdr);
+    if (ext) {
+      base[base_len++] = (f.sn & 0x07) << 3 | (ts_scaled & 0x07);
+    }
+  } else {
+    return 0;
+  }
+
+  // The first octet goes before a large CID and the rest after it
+  uint8_t* p = out + write_type_and_cid(cfg.max_cid, cid, base[0], out);
+  memcpy(p, base + 1, base_len - 1);
+  p += base_len - 1;
+
+  // Fields sent uncompressed
+  if (f.ip_version == 4 and ctx.rnd) {
+    write16(p, f.ip_id);
+  }
+  if (ctx.ref.udp_checksum != 0) {
+    write16(p, f.udp_checksum);
+  }
+  return p - out;
+}
+
+void rohc_compressor::push_window(context_t& ctx, const rohc_hdr_fields_t& f)
+{
+  if (ctx.window_len < ctx.window.size()) {
+    ctx.window_len++;
+  }
+  std::move_backward(ctx.window.begin(), ctx.window.begin() + ctx.window_len - 1, ctx.window.begin() + ctx.window_len);
+  ctx.window[0] = {f.sn, ctx.ts_state.scale(f.ts)};
+}
+
+bool rohc_compressor::compress(byte_buffer_t& pkt)
+{
+  if (not cfg.enabled()) {
+    return true;
+  }
+  metrics.nof_packets++;
+  metrics.uncompressed_bytes += pkt.N_bytes;
+
+  rohc_hdr_fields_t f;
+  uint32_t          hdr_len = 0;
+  uint16_t          profile = parse_headers(pkt.msg, pkt.N_bytes, cfg, f, hdr_len);
+  uint16_t          cid     = 0;
+  bool              is_new  = false;
+  context_t&        ctx     = find_context(profile, f, cid, is_new);
+  ctx.last_used             = ++nof_packets;
+
+  uint8_t  out[rohc_max_hdr_len];
+  uint32_t out_len = 0;
+  bool     is_ir   = true;
+  if (profile == ROHC_PROFILE_UNCOMPRESSED) {
+    // Packets whose first octet could be mistaken for a ROHC packet type are sent in IR packets
+    is_ir = ctx.ir_left > 0 or ctx.pkts_since_ir >= rohc_ir_refresh or pkt.N_bytes == 0 or
+            pkt.msg[0] >= rohc_type_padding;
+    if (is_ir) {
+      // Nothing to write yet
+    } else if (cfg.max_cid <= ROHC_SMALL_CID_MAX) {
+      out_len = write_type_and_cid(cfg.max_cid, cid, pkt.msg[0], out) - 1;
+    } else {
+      // The first octet of the packet is followed by the large CID
+      out_len = write_type_and_cid(cfg.max_cid, cid, pkt.msg[0], out);
+      hdr_len = 1;
+    }
+  } else {
+    if (profile != ROHC_PROFILE_RTP) {
+      f.sn = ctx.next_sn++;
+    }
+    if (is_new) {
+      ctx.ip_id_offset = f.ip_id - f.sn;
+    } else if (update_dynamic_state(ctx, f)) {
+      ctx.ir_left = rohc_ir_repetitions;
+    }
+    if (ctx.ir_left == 0 and ctx.pkts_since_ir < rohc_ir_refresh) {
+      out_len = write_uo(cid, ctx, f, pkt.msg, out);
+      is_ir   = out_len == 0;
+      if (is_ir) {
+        // The change can not be expressed with the available packet types, reinitialize the context
+        ctx.ir_left = rohc_ir_repetitions;
+      }
+    }
+  }
+
+  if (is_ir) {
+    out_len = write_ir(cid, ctx, f, out);
+    if (profile != ROHC_PROFILE_UNCOMPRESSED) {
+      // The reference of the decompressor is the IR packet from now on
+      ctx.window_len = 0;
+    }
+    metrics.nof_ir_packets++;
+    ctx.ir_left -= ctx.ir_left > 0 ? 1 : 0;
+    ctx.pkts_since_ir = 0;
+  } else {
+    ctx.pkts_since_ir++;
+  }
+  if (profile != ROHC_PROFILE_UNCOMPRESSED) {
+    push_window(ctx, f);
+    ctx.ref = f;
+  }
+
+  // Replace the uncompressed headers with the ROHC header
+  if (out_len > hdr_len) {
+    uint32_t extra = out_len - hdr_len;
+    if (pkt.get_headroom() < extra) {
+      logger.error("ROHC: not enough headroom to compress packet. Headroom=%d, required=%d", pkt.get_headroom(), extra);
+      metrics.nof_errors++;
+      ctx.in_use = false;
+      return false;
+    }
+    pkt.msg -= extra;
+    pkt.N_bytes += extra;
+  } else {
+    pkt.msg += hdr_len - out_len;
+    pkt.N_bytes -= hdr_len - out_len;
+  }
+  memcpy(pkt.msg, out, out_len);
+  metrics.compressed_bytes += pkt.N_bytes;
+
+  logger.debug("ROHC: compressed %s packet, profile 0x%04x, CID=%d, SN=%d, header %d -> %d bytes",
+               is_ir ? "IR" : "UO",
+               profile,
+               cid,
+               f.sn,
+               hdr_len,
+               out_len);
+  return true;
+}
+
+/*******************************************************************************
+ * Decompressor
+ ******************************************************************************/
+
+void rohc_decompressor::configure(const pdcp_rohc_config_t& cfg_)
+{
+  cfg         = cfg_;
+  cfg.max_cid = std::min(cfg.max_cid, (uint16_t)ROHC_LARGE_CID_MAX);
+  reset();
+  if (not cfg.enabled()) {
+    contexts.shrink_to_fit();
+  }
+}
+
+void rohc_decompressor::reset()
+{
+  contexts.clear();
+}
+
+bool rohc_decompressor::profile_enabled(uint16_t profile) const
+{
+  return profile == ROHC_PROFILE_UNCOMPRESSED or (profile == ROHC_PROFILE_RTP and cfg.profile_rtp) or
+         (profile == ROHC_PROFILE_UDP and cfg.profile_udp) or (profile == ROHC_PROFILE_IP and cfg.profile_ip);
+}
+
+bool rohc_decompressor::decompress(byte_buffer_t& pkt)
+{
+  if (not cfg.enabled()) {
+    return true;
+  }
+  metrics.nof_packets++;
+  metrics.compressed_bytes += pkt.N_bytes;
+
+  // Skip padding and read the CID
+  const uint8_t* p     = pkt.msg;
+  uint32_t       start = 0;
+  while (start < pkt.N_bytes and p[start] == rohc_type_padding) {
+    start++;
+  }
+  uint32_t first = start;
+  uint16_t cid   = 0;
+  if (cfg.max_cid <= ROHC_SMALL_CID_MAX and first < pkt.N_bytes and (p[first] & 0xf0) == rohc_type_add_cid) {
+    cid = p[first++] & 0x0f;
+  }
+  rohc_reader_t reader = {p, pkt.N_bytes, first};
+  uint8_t       type   = reader.u8();
+  if (cfg.max_cid > ROHC_SMALL_CID_MAX) {
+    cid = reader.sdvl();
+  }
+  if (not reader.ok or cid > cfg.max_cid) {
+    logger.warning("ROHC: discarding malformed packet of %d bytes", pkt.N_bytes);
+    metrics.nof_errors++;
+    return false;
+  }
+
+  bool success = false;
+  if ((type & 0xfe) == rohc_type_ir) {
+    success = decompress_ir(pkt, cid, start, first, reader.pos);
+  } else if ((type & 0xf8) == rohc_type_feedback) {
+    // There is no feedback channel in U-mode
+    logger.info("ROHC: discarding feedback packet");
+  } else if (type == rohc_type_ir_dyn or (type & 0xfe) == 0xfe) {
+    logger.warning("ROHC: discarding unsupported packet type 0x%02x", type);
+  } else if (cid >= contexts.size() or not contexts[cid].valid) {
+    logger.warning("ROHC: discarding packet for CID=%d without context", cid);
+  } else if (contexts[cid].profile == ROHC_PROFILE_UNCOMPRESSED) {
+    // Normal packet. Remove the Add-CID octet or move the first octet over the large CID
+    pkt.msg[reader.pos - 1] = type;
+    pkt.msg += reader.pos - 1;
+    pkt.N_bytes -= reader.pos - 1;
+    success = true;
+  } else {
+    success = decompress_uo(pkt, contexts[cid], first, reader.pos);
+  }
+
+  if (not success) {
+    metrics.nof_errors++;
+    return false;
+  }
+  metrics.uncompressed_bytes += pkt.N_bytes;
+  return true;
+}
+
+bool rohc_decompressor::decompress_ir(byte_buffer_t& pkt, uint16_t cid, uint32_t start, uint32_t first, uint32_t next)
+{
+  rohc_reader_t reader  = {pkt.msg, pkt.N_bytes, next};
+  bool          has_dyn = (pkt.msg[first] & 1) != 0;
+  uint16_t      profile = reader.u8();
+  uint32_t      crc_pos = reader.pos;
+  uint8_t       crc     = reader.u8();
+  if (not reader.ok or not profile_enabled(profile) or has_dyn != (profile != ROHC_PROFILE_UNCOMPRESSED)) {
+    logger.warning("ROHC: discarding IR packet with unsupported profile 0x%04x for CID=%d", profile, cid);
+    return false;
+  }
+
+  context_t ctx;
+  ctx.profile          = profile;
+  rohc_hdr_fields_t& f = ctx.ref;
+  if (profile != ROHC_PROFILE_UNCOMPRESSED) {
+    // Static chain
+    uint8_t version = reader.u8() >> 4;
+    f.ip_version    = version;
+    if (version == 4) {
+      f.protocol = reader.u8();
+      reader.bytes(f.src_addr.data(), 4);
+      reader.bytes(f.dst_addr.data(), 4);
+    } else if (version == 6) {
+      f.flow_label = (uint32_t)(pkt.msg[reader.pos - 1] & 0x0f) << 16 | reader.u16();
+      f.protocol   = reader.u8();
+      reader.bytes(f.src_addr.data(), 16);
+      reader.bytes(f.dst_addr.data(), 16);
+    } else {
+      reader.ok = false;
+    }
+    if (profile == ROHC_PROFILE_RTP or profile == ROHC_PROFILE_UDP) {
+      f.src_port = reader.u16();
+      f.dst_port = reader.u16();
+    }
+    if (profile == ROHC_PROFILE_RTP) {
+      f.ssrc = reader.u32();
+    }
+
+    // Dynamic chain
+    f.tos = reader.u8();
+    f.ttl = reader.u8();
+    if (version == 4) {
+      f.ip_id       = reader.u16();
+      uint8_t flags = reader.u8();
+      f.df          = (flags & 0x80) != 0;
+      ctx.rnd       = (flags & 0x40) != 0;
+      // Only network byte order IP-IDs are supported
+      reader.ok = reader.ok and (flags & 0x20) != 0;
+    }
+    // Extension header lists are not supported
+    reader.ok = reader.u8() == 0 and reader.ok;
+    if (profile == ROHC_PROFILE_RTP or profile == ROHC_PROFILE_UDP) {
+      f.udp_checksum = reader.u16();
+    }
+    if (profile == ROHC_PROFILE_RTP) {
+      uint8_t flags = reader.u8();
+      bool    rx    = (flags & 0x10) != 0;
+      f.rtp_flags   = flags & 0xef;
+      uint8_t m_pt  = reader.u8();
+      f.rtp_marker  = (m_pt & 0x80) != 0;
+      f.rtp_pt      = m_pt & 0x7f;
+      f.sn          = reader.u16();
+      f.ts          = reader.u32();
+      // CSRC lists are not supported
+      reader.ok = reader.u8() == 0 and (f.rtp_flags & 0xc0) == 0x80 and (f.rtp_flags & 0x0f) == 0 and reader.ok;
+      if (rx) {
+        uint8_t rtp_ext = reader.u8();
+        f.rtp_flags |= rtp_ext & 0x10;
+        if (rtp_ext & 0x01) {
+          ctx.ts_state.stride = reader.sdvl();
+          ctx.ts_state.offset = ctx.ts_state.stride != 0 ? f.ts % ctx.ts_state.stride : 0;
+        }
+        if (rtp_ext & 0x02) {
+          reader.sdvl(); // TIME_STRIDE
+        }
+      }
+    } else {
+      f.sn = reader.u16();
+    }
+    ctx.ip_id_offset = f.ip_id - f.sn;
+  }
+  if (not reader.ok) {
+    logger.warning("ROHC: discarding malformed IR packet for CID=%d", cid);
+    return false;
+  }
+
+  // The CRC covers the IR header, from the Add-CID octet up to the end of the dynamic chain
+  const uint8_t zero         = 0;
+  uint8_t       computed_crc = crc_update(rohc_crc_type_t::crc8, pkt.msg + start, crc_pos - start, 0xff);
+  computed_crc               = crc_update(rohc_crc_type_t::crc8, &zero, 1, computed_crc);
+  computed_crc = crc_update(rohc_crc_type_t::crc8, pkt.msg + crc_pos + 1, reader.pos - crc_pos - 1, computed_crc);
+  if (computed_crc != crc) {
+    logger.warning("ROHC: discarding IR packet with wrong CRC for CID=%d", cid);
+    return false;
+  }
+
+  uint8_t  hdr[max_hdr_len];
+  uint32_t hdr_len = 0;
+  if (profile != ROHC_PROFILE_UNCOMPRESSED) {
+    hdr_len = build_headers(profile, f, pkt.N_bytes - reader.pos, hdr);
+  }
+  if (hdr_len > reader.pos and pkt.get_headroom() < hdr_len - reader.pos) {
+    logger.error("ROHC: not enough headroom to decompress packet");
+    return false;
+  }
+  if (cid >= contexts.size()) {
+    contexts.resize(cid + 1);
+  }
+  contexts[cid]       = ctx;
+  contexts[cid].valid = true;
+  metrics.nof_ir_packets++;
+
+  pkt.msg += reader.pos;
+  pkt.N_bytes -= reader.pos;
+  pkt.msg -= hdr_len;
+  pkt.N_bytes += hdr_len;
+  memcpy(pkt.msg, hdr, hdr_len);
+  return true;
+}
+
+bool rohc_decompressor::decompress_uo(byte_buffer_t& pkt, context_t& ctx, uint32_t first, uint32_t next)
+{
+  rohc_reader_t reader   = {pkt.msg, pkt.N_bytes, next};
+  uint8_t       type     = pkt.msg[first];
+  bool          seq_ipv4 = has_seq_ipv4(ctx.ref, ctx.rnd);
+  bool          marker   = false;
+  uint32_t      sn_bits = 0, sn_k = 0, ts_bits = 0, ts_k = 0;
+  uint8_t       crc      = 0;
+  auto          crc_type = rohc_crc_type_t::crc3;
+
+  if ((type & 0x80) == 0) {
+    // UO-0
+    sn_bits = (type >> 3) & 0x0f;
+    sn_k    = 4;
+    crc     = type & 0x07;
+  } else if ((type & 0xc0) == 0x80 and ctx.profile == ROHC_PROFILE_RTP and (not seq_ipv4 or (type & 0x20) != 0)) {
+    // UO-1, or UO-1-TS
+    ts_k          = seq_ipv4 ? 5 : 6;
+    ts_bits       = type & ((1U << ts_k) - 1);
+    uint8_t octet = reader.u8();
+    marker        = (octet & 0x80) != 0;
+    sn_bits       = (octet >> 3) & 0x0f;
+    sn_k          = 4;
+    crc           = octet & 0x07;
+  } else if ((type & 0xe0) == 0xc0 and ctx.profile == ROHC_PROFILE_RTP) {
+    // UOR-2, or UOR-2-TS
+    uint8_t octet1 = reader.u8();
+    uint8_t octet2 = reader.u8();
+    ts_k           = seq_ipv4 ? 5 : 6;
+    ts_bits        = seq_ipv4 ? type & 0x1f : (type & 0x1f) << 1 | octet1 >> 7;
+    marker         = (octet1 & 0x40) != 0;
+    sn_bits        = octet1 & 0x3f;
+    sn_k           = 6;
+    crc            = octet2 & 0x7f;
+    crc_type       = rohc_crc_type_t::crc7;
+    if (seq_ipv4 and (octet1 & 0x80) == 0) {
+      logger.warning("ROHC: discarding unsupported UOR-2-ID packet");
+      return false;
+    }
+    if ((octet2 & 0x80) != 0) {
+      // Only extension 0 is supported
+      uint8_t ext = reader.u8();
+      if ((ext & 0xc0) != 0) {
+        logger.warning("ROHC: discarding UOR-2 packet with unsupported extension %d", ext >> 6);
+        return false;
+      }
+      sn_bits = sn_bits << 3 | ((ext >> 3) & 0x07);
+      sn_k += 3;
+      ts_bits = ts_bits << 3 | (ext & 0x07);
+      ts_k += 3;
+    }
+  } else {
+    logger.warning("ROHC: discarding unsupported packet type 0x%02x for profile 0x%04x", type, ctx.profile);
+    return false;
+  }
+
+  rohc_hdr_fields_t f      = ctx.ref;
+  uint32_t          ref_ts = ctx.ts_state.scale(ctx.ref.ts);
+  f.sn                     = lsb_decode(sn_bits, ctx.ref.sn, sn_k, sn_p, sn_mask);
+  f.rtp_marker             = marker;
+  if (ctx.profile == ROHC_PROFILE_RTP) {
+    uint32_t ts_scaled = ts_k != 0 ? lsb_decode(ts_bits, ref_ts, ts_k, ts_p(ts_k), ts_mask)
+                                   : infer_ts_scaled(ctx.ts_state, ctx.ref.sn, ref_ts, f.sn);
+    f.ts = ctx.ts_state.unscale(ts_scaled);
+  }
+
+  // Fields sent uncompressed
+  if (f.ip_version == 4) {
+    f.ip_id = ctx.rnd ? reader.u16() : f.sn + ctx.ip_id_offset;
+  }
+  if (ctx.ref.udp_checksum != 0) {
+    f.udp_checksum = reader.u16();
+  }
+  if (not reader.ok) {
+    logger.warning("ROHC: discarding truncated packet");
+    return false;
+  }
+
+  uint8_t  hdr[max_hdr_len];
+  uint32_t hdr_len = build_headers(ctx.profile, f, pkt.N_bytes - reader.pos, hdr);
+  if (header_crc(crc_type, ctx.profile, hdr) != crc) {
+    logger.warning("ROHC: discarding packet with wrong CRC, SN=%d", f.sn);
+    return false;
+  }
+  if (hdr_len > reader.pos and pkt.get_headroom() < hdr_len - reader.pos) {
+    logger.error("ROHC: not enough headroom to decompress packet");
+    return false;
+  }
+  ctx.ref = f;
+
+  pkt.msg += reader.pos;
+  pkt.N_bytes -= reader.pos;
+  pkt.msg -= hdr_len;
+  pkt.N_bytes += hdr_len;
+  memcpy(pkt.msg, hdr, hdr_len);
+  return true;
+}
+
+} // namespace srsran
@@ -639,6 +639,42 @@ static float chest_estimate_cfo(srsran_chest_dl_t* q)
   return -cargf(sum) * n / (ns * (n + ng)) / 2 / M_PI;
 }
 
+/* Computes the smoothing filter of the configuration. Fixed filters do not change between ports, antennas and
+ * subframes, so they are only computed again when the configuration changes. The automatic Gaussian filter depends on
+ * the noise estimate and is always computed.
+ */
+static uint32_t chest_dl_smooth_filter(srsran_chest_dl_t* q, srsran_chest_dl_cfg_t* cfg, float noise_estimate)
+{
+  if (cfg->filter_type == SRSRAN_CHEST_FILTER_GAUSS && cfg->filter_coef[0] <= 0) {
+    q->smooth_filter_valid = false;
+    return srsran_chest_set_smooth_filter_gauss(q->smooth_filter, 4, noise_estimate * 200.0f);
+  }
+
+  if (q->smooth_filter_valid && q->smooth_filter_type == cfg->filter_type &&
+      q->smooth_filter_coef[0] == cfg->filter_coef[0] && q->smooth_filter_coef[1] == cfg->filter_coef[1]) {
+    return q->smooth_filter_len;
+  }
+
+  switch (cfg->filter_type) {
+    case SRSRAN_CHEST_FILTER_GAUSS:
+      q->smooth_filter_len =
+          srsran_chest_set_smooth_filter_gauss(q->smooth_filter, (uint32_t)cfg->filter_coef[0], cfg->filter_coef[1]);
+      break;
+    case SRSRAN_CHEST_FILTER_TRIANGLE:
+      q->smooth_filter_len = srsran_chest_set_smooth_filter3_coeff(q->smooth_filter, cfg->filter_coef[0]);
+      break;
+    default:
+      q->smooth_filter_len = 0;
+      break;
+  }
+  q->smooth_filter_type    = cfg->filter_type;
+  q->smooth_filter_coef[0] = cfg->filter_coef[0];
+  q->smooth_filter_coef[1] = cfg->filter_coef[1];
+  q->smooth_filter_valid   = true;
+
+  return q->smooth_filter_len;
+}
+
 static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
                                         srsran_dl_sf_cfg_t*    sf,
                                         srsran_chest_dl_cfg_t* cfg,
@@ -647,7 +683,6 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
                                         uint32_t               port_id,
                                         uint32_t               rxant_id)
 {
-  float       filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
   uint32_t    filter_len = 0;
   uint32_t    sf_idx     = sf->tti % 10;
   srsran_sf_t ch_mode    = sf->sf_type;
@@ -698,23 +733,10 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
   }
 
   if (ce != NULL) {
-    switch (cfg->filter_type) {
-      case SRSRAN_CHEST_FILTER_GAUSS:
-        if (ch_mode == SRSRAN_SF_MBSFN) {
-          ERROR("Warning: Gauss filter not supported in MBSFN subframes");
-        }
-        if (cfg->filter_coef[0] <= 0) {
-          filter_len = srsran_chest_set_smooth_filter_gauss(filter, 4, q->noise_estimate[rxant_id][port_id] * 200.0f);
-        } else {
-          filter_len = srsran_chest_set_smooth_filter_gauss(filter, (uint32_t)cfg->filter_coef[0], cfg->filter_coef[1]);
-        }
-        break;
-      case SRSRAN_CHEST_FILTER_TRIANGLE:
-        filter_len = srsran_chest_set_smooth_filter3_coeff(filter, cfg->filter_coef[0]);
-        break;
-      default:
-        break;
+    if (cfg->filter_type == SRSRAN_CHEST_FILTER_GAUSS && ch_mode == SRSRAN_SF_MBSFN) {
+      ERROR("Warning: Gauss filter not supported in MBSFN subframes");
     }
+    filter_len = chest_dl_smooth_filter(q, cfg, q->noise_estimate[rxant_id][port_id]);
 
     if (cfg->estimator_alg != SRSRAN_ESTIMATOR_ALG_INTERPOLATE && ch_mode == SRSRAN_SF_MBSFN) {
       ERROR("Warning: Subframe interpolation must be enabled in MBSFN subframes");
@@ -724,7 +746,7 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
     if (cfg->filter_type == SRSRAN_CHEST_FILTER_NONE) {
       interpolate_pilots(q, sf, cfg, q->pilot_estimates, ce, port_id);
     } else {
-      average_pilots(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id, filter, filter_len);
+      average_pilots(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id, q->smooth_filter, filter_len);
       interpolate_pilots(q, sf, cfg, q->pilot_estimates_average, ce, port_id);
     }
 
@@ -826,7 +848,13 @@ static int estimate_port(srsran_chest_dl_t*     q,
     q->rsrp_corr[rxant_id][port_id] = energy * energy;
   }
   q->rsrp[rxant_id][port_id] = srsran_vec_avg_power_cf(q->pilot_recv_signal, npilots);
-  q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
+
+  /* Ports 1 and 3 have references in the same symbols as ports 0 and 2, which are estimated first */
+  if (port_id % 2 == 0) {
+    q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
+  } else {
+    q->rssi[rxant_id][port_id] = q->rssi[rxant_id][port_id - 1];
+  }
 
   chest_interpolate_noise_est(q, sf, cfg, input, ce, port_id, rxant_id);
 
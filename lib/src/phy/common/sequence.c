@@ -127,6 +127,66 @@ static inline uint32_t sequence_gen_LTE_pr_memless_step_x2(uint32_t state)
   return state;
 }
 
+/**
+ * Word-parallel x1 and x2 sequences generation
+ * --------------------------------------------
+ *
+ * Each register is extended to a window of 128 consecutive bits held in two 64 bit words, where the bit i of the
+ * window is x(n + i). Squaring twice the characteristic polynomials over GF(2) results in the recursions:
+ *     x1(n + 124) = x1(n + 12) ^ x1(n)
+ *     x2(n + 124) = x2(n + 12) ^ x2(n + 8) ^ x2(n + 4) ^ x2(n)
+ *
+ * As the feedback is 124 bits apart, the next 64 bits of both sequences are computed from the window in a single step.
+ */
+typedef struct {
+  uint64_t x1[2];
+  uint64_t x2[2];
+} sequence_state64_t;
+
+static uint64_t sequence_x1_init64[2]                    = {};
+static uint64_t sequence_x2_init64[SEQUENCE_SEED_LEN][2] = {};
+
+/**
+ * Extracts the 64 bits of a 128 bit window that start at the bit offset S, with 0 < S < 64
+ */
+#define SEQUENCE_WIN64(W, S) (((W)[0] >> (S)) | ((W)[1] << (64U - (S))))
+
+static inline void sequence_state64_init(sequence_state64_t* s, uint32_t seed)
+{
+  s->x1[0] = sequence_x1_init64[0];
+  s->x1[1] = sequence_x1_init64[1];
+  s->x2[0] = 0;
+  s->x2[1] = 0;
+
+  // The x2 window is linear with the seed too
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    if ((seed >> i) & 1U) {
+      s->x2[0] ^= sequence_x2_init64[i][0];
+      s->x2[1] ^= sequence_x2_init64[i][1];
+    }
+  }
+}
+
+/**
+ * Gets the next 64 bits of the sequence and advances the windows
+ * @param s Word-parallel state
+ * @return The sequence bits, the first one in the LSB
+ */
+static inline uint64_t sequence_state64_step(sequence_state64_t* s)
+{
+  uint64_t c  = s->x1[0] ^ s->x2[0];
+  uint64_t x1 = SEQUENCE_WIN64(s->x1, 4U) ^ SEQUENCE_WIN64(s->x1, 16U);
+  uint64_t x2 = SEQUENCE_WIN64(s->x2, 4U) ^ SEQUENCE_WIN64(s->x2, 8U) ^ SEQUENCE_WIN64(s->x2, 12U) ^
+                SEQUENCE_WIN64(s->x2, 16U);
+
+  s->x1[0] = s->x1[1];
+  s->x1[1] = x1;
+  s->x2[0] = s->x2[1];
+  s->x2[1] = x2;
+
+  return c;
+}
+
 /**
  * Static precomputed x1 and x2 states after Nc shifts
  * -------------------------------------------------------
@@ -165,6 +225,20 @@ __attribute__((constructor)) __attribute__((unused)) static void srsran_lte_pr_p
       sequence_x2_init[i] = sequence_gen_LTE_pr_memless_step_x2(sequence_x2_init[i]);
     }
   }
+
+  // Compute the 128 bit windows for the word-parallel generation
+  uint32_t x1 = sequence_x1_init;
+  for (uint32_t n = 0; n < 128; n++) {
+    sequence_x1_init64[n / 64] |= (uint64_t)(x1 & 1U) << (n % 64);
+    x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
+  }
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    uint32_t x2 = sequence_x2_init[i];
+    for (uint32_t n = 0; n < 128; n++) {
+      sequence_x2_init64[i][n / 64] |= (uint64_t)(x2 & 1U) << (n % 64);
+      x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
+    }
+  }
 }
 
 static uint32_t sequence_get_x2_init(uint32_t seed)
@@ -182,36 +256,16 @@ static uint32_t sequence_get_x2_init(uint32_t seed)
 
 static void sequence_gen_LTE_pr(uint8_t* pr, uint32_t len, uint32_t seed)
 {
-  int      n  = 0;
-  uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
-  uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
-
-  // Parallel stage
-  if (len >= SEQUENCE_PAR_BITS) {
-    for (; n < len - (SEQUENCE_PAR_BITS - 1); n += SEQUENCE_PAR_BITS) {
-      // XOR x1 and x2
-      uint32_t c = (uint32_t)(x1 ^ x2);
-
-      // Save state
-      for (uint32_t i = 0; i < SEQUENCE_PAR_BITS; i++) {
-        pr[n + i] = (uint8_t)((c >> i) & 1U);
-      }
-
-      // Parallel step
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t n = 0; n < len; n += 64) {
+    uint64_t c        = sequence_state64_step(&s);
+    uint32_t nof_bits = SRSRAN_MIN(64, len - n);
+    for (uint32_t i = 0; i < nof_bits; i++) {
+      pr[n + i] = (uint8_t)((c >> i) & 1U);
     }
   }
-
-  // Single step
-  for (; n < len; n++) {
-    // Save current state
-    pr[n] = (uint8_t)((x1 ^ x2) & 1U);
-
-    // Single step
-    x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
-  }
 }
 
 void srsran_sequence_state_init(srsran_sequence_state_t* s, uint32_t seed)
@@ -504,62 +558,6 @@ void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint3
   srsran_sequence_state_apply_f(&seq, in, out, length);
 }
 
-void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
-{
-  const int16_t s[2] = {+1, -1};
-  uint32_t      x1   = sequence_x1_init;           // X1 initial state is fix
-  uint32_t      x2   = sequence_get_x2_init(seed); // loads x2 initial state
-
-  uint32_t i = 0;
-
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-
-      uint32_t j = 0;
-#ifdef LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS - 7; j += 8) {
-        // Preloads bits of interest in the 8 LSB
-        __m128i mask = _mm_set1_epi16((c >> j) & 0xff);
-
-        // Masks each bit
-        mask = _mm_and_si128(mask, _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80));
-
-        // Get non zero mask
-        mask = _mm_cmpgt_epi16(mask, _mm_set1_epi16(0));
-
-        // Load input
-        __m128i v = _mm_loadu_si128((__m128i*)(in + i + j));
-
-        // Negate
-        v = _mm_xor_si128(v, mask);
-
-        // Add one
-        mask = _mm_and_si128(mask, _mm_set1_epi16(1));
-        v    = _mm_add_epi16(v, mask);
-
-        _mm_storeu_si128((__m128i*)(out + i + j), v);
-      }
-#endif // LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        out[i + j] = in[i + j] * s[(c >> j) & 1U];
-      }
-
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
-    }
-  }
-
-  for (; i < length; i++) {
-    out[i] = in[i] * s[(x1 ^ x2) & 1U];
-
-    // Step sequences
-    x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
-  }
-}
-
 void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in, int8_t* out, uint32_t length)
 {
   uint32_t i = 0;
@@ -617,13 +615,6 @@ void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in,
   }
 }
 
-void srsran_sequence_apply_c(const int8_t* in, int8_t* out, uint32_t length, uint32_t seed)
-{
-  srsran_sequence_state_t sequence_state;
-  srsran_sequence_state_init(&sequence_state, seed);
-  srsran_sequence_state_apply_c(&sequence_state, in, out, length);
-}
-
 void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length)
 {
   uint32_t i = 0;
@@ -680,120 +671,289 @@ void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t*
   }
 }
 
-void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
+
+/*
+ * Word-parallel sequence application
+ * ----------------------------------
+ *
+ * The following functions apply the sequence 64 bits at a time. The bits are either generated on the fly from the seed
+ * or read from a packed sequence, which is a vector of 64 bit words with the first sequence bit in the LSB of the
+ * first word.
+ */
+
+static const uint8_t sequence_reverse_lut[256] = {
+    0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
+    0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
+    0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
+    0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
+    0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
+    0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
+    0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
+    0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
+    0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
+    0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
+    0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
+    0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
+    0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
+    0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
+    0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
+    0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
+    0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
+    0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
+    0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
+    0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
+    0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
+    0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
+    0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
+    0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
+    0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
+    0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
+    0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
+    0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
+    0b00111111, 0b10111111, 0b01111111, 0b11111111,
+};
+
+/**
+ * Negates the 8 bit values whose sequence bit is one
+ * @param c Sequence bits, the first one in the LSB
+ * @param nof_bits Number of values to process, up to 64
+ */
+static inline void sequence_word_apply_c(uint64_t c, const int8_t* in, int8_t* out, uint32_t nof_bits)
 {
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, seed);
-  srsran_sequence_state_apply_bit(&sequence_state, in, out, length);
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= nof_bits; i += 32) {
+    // Broadcast the bits of interest, one byte of the sequence for every 8 values
+    const __m256i idx  = _mm256_setr_epi64x(0, 0x0101010101010101, 0x0202020202020202, 0x0303030303030303);
+    __m256i       mask = _mm256_shuffle_epi8(_mm256_set1_epi32((int32_t)(uint32_t)(c >> i)), idx);
+
+    // Get non zero mask
+    const __m256i bits = _mm256_set1_epi64x(0x8040201008040201);
+    mask               = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits), bits);
+
+    // Negate
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_sub_epi8(_mm256_xor_si256(v, mask), mask);
+
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_SSE
+  for (; i + 16 <= nof_bits; i += 16) {
+    // Preloads bits of interest in the 16 LSB
+    __m128i mask = _mm_set1_epi32((int32_t)(uint32_t)(c >> i));
+    mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+
+    // Get non zero mask
+    const __m128i bits = _mm_set1_epi64x(0x8040201008040201);
+    mask               = _mm_cmpeq_epi8(_mm_and_si128(mask, bits), bits);
+
+    // Negate
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_sub_epi8(_mm_xor_si128(v, mask), mask);
+
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif // LV_HAVE_SSE
+  for (; i < nof_bits; i++) {
+    out[i] = in[i] * (((c >> i) & 1U) ? -1 : +1);
+  }
 }
 
-void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
+/**
+ * Negates the 16 bit values whose sequence bit is one
+ * @param c Sequence bits, the first one in the LSB
+ * @param nof_bits Number of values to process, up to 64
+ */
+static inline void sequence_word_apply_s(uint64_t c, const int16_t* in, int16_t* out, uint32_t nof_bits)
 {
-  uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
-  uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
-
-  const uint8_t reverse_lut[256] = {
-      0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
-      0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
-      0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
-      0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
-      0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
-      0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
-      0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
-      0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
-      0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
-      0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
-      0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
-      0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
-      0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
-      0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
-      0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
-      0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
-      0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
-      0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
-      0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
-      0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
-      0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
-      0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
-      0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
-      0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
-      0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
-      0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
-      0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
-      0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
-      0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
-
   uint32_t i = 0;
-#if SEQUENCE_PAR_BITS % 8 != 0
-  uint64_t buffer = 0;
-  uint32_t count  = 0;
 
-  for (; i < length / 8; i++) {
-    // Generate sequence bits
-    while (count < 8) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-      buffer     = buffer | ((SEQUENCE_MASK & c) << count);
+#ifdef LV_HAVE_AVX2
+  for (; i + 16 <= nof_bits; i += 16) {
+    // Masks each bit
+    const __m256i bits = _mm256_setr_epi64x(0x0008000400020001,
+                                            0x0080004000200010,
+                                            0x0800040002000100,
+                                            (int64_t)0x8000400020001000ULL);
+    __m256i       mask = _mm256_set1_epi16((int16_t)(uint16_t)(c >> i));
+    mask               = _mm256_cmpeq_epi16(_mm256_and_si256(mask, bits), bits);
 
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+    // Negate
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_sub_epi16(_mm256_xor_si256(v, mask), mask);
 
-      // Increase count
-      count += SEQUENCE_PAR_BITS;
-    }
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_SSE
+  for (; i + 8 <= nof_bits; i += 8) {
+    // Masks each bit
+    const __m128i bits = _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+    __m128i       mask = _mm_set1_epi16((int16_t)((c >> i) & 0xff));
+    mask               = _mm_cmpeq_epi16(_mm_and_si128(mask, bits), bits);
 
-    // Apply XOR
-    out[i] = in[i] ^ reverse_lut[buffer & 255UL];
-    buffer = buffer >> 8UL;
-    count -= 8;
+    // Negate
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_sub_epi16(_mm_xor_si128(v, mask), mask);
+
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif // LV_HAVE_SSE
+  for (; i < nof_bits; i++) {
+    out[i] = in[i] * (((c >> i) & 1U) ? -1 : +1);
   }
+}
 
-  // Process spare bits
-  uint32_t rem8 = length % 8;
-  if (rem8 != 0) {
-    // Generate sequence bits
-    while (count < rem8) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-      buffer     = buffer | ((SEQUENCE_MASK & c) << count);
+/**
+ * Applies the XOR of the sequence to unpacked bits
+ * @param c Sequence bits, the first one in the LSB
+ * @param nof_bits Number of bits to process, up to 64
+ */
+static inline void sequence_word_apply_bit(uint64_t c, const uint8_t* in, uint8_t* out, uint32_t nof_bits)
+{
+  uint32_t i = 0;
 
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+#ifdef LV_HAVE_SSE
+  for (; i + 16 <= nof_bits; i += 16) {
+    // Preloads bits of interest in the 16 LSB
+    __m128i mask = _mm_set1_epi32((int32_t)(uint32_t)(c >> i));
+    mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
 
-      // Increase count
-      count += SEQUENCE_PAR_BITS;
-    }
+    // Get non zero mask and reduce it to 1s and 0s
+    const __m128i bits = _mm_set1_epi64x(0x8040201008040201);
+    mask               = _mm_cmpeq_epi8(_mm_and_si128(mask, bits), bits);
+    mask               = _mm_and_si128(mask, _mm_set1_epi8(1));
+
+    // Apply XOR
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_xor_si128(mask, v);
 
-    out[i] = in[i] ^ reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
+    _mm_storeu_si128((__m128i*)(out + i), v);
   }
-#else  // SEQUENCE_PAR_BITS % 8 == 0
-  while (i < (length / 8 - (SEQUENCE_PAR_BITS - 1) / 8)) {
-    uint32_t c = (uint32_t)(x1 ^ x2);
+#endif // LV_HAVE_SSE
+  for (; i < nof_bits; i++) {
+    out[i] = in[i] ^ ((c >> i) & 1U);
+  }
+}
 
-    for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
-      out[i] = in[i] ^ reverse_lut[c & 255U];
-      c      = c >> 8U;
-      i++;
-    }
+/**
+ * Applies the XOR of the sequence to packed bits, the first bit in the MSB of the first byte
+ * @param c Sequence bits, the first one in the LSB
+ * @param nof_bits Number of bits to process, up to 64
+ */
+static inline void sequence_word_apply_packed(uint64_t c, const uint8_t* in, uint8_t* out, uint32_t nof_bits)
+{
+  uint32_t i = 0;
 
-    // Step sequences
-    x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  if (nof_bits == 64) {
+    // Reverse the bits of every byte
+    c = ((c >> 1U) & 0x5555555555555555ULL) | ((c & 0x5555555555555555ULL) << 1U);
+    c = ((c >> 2U) & 0x3333333333333333ULL) | ((c & 0x3333333333333333ULL) << 2U);
+    c = ((c >> 4U) & 0x0f0f0f0f0f0f0f0fULL) | ((c & 0x0f0f0f0f0f0f0f0fULL) << 4U);
+
+    // Apply XOR to the 8 bytes at once
+    uint64_t v;
+    memcpy(&v, in, sizeof(uint64_t));
+    v ^= c;
+    memcpy(out, &v, sizeof(uint64_t));
+    return;
   }
+#endif // __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 
-  // Process spare bytes
-  uint32_t c = (uint32_t)(x1 ^ x2);
-  while (i < length / 8) {
-    out[i] = in[i] ^ reverse_lut[c & 255U];
+  for (; i < nof_bits / 8; i++) {
+    out[i] = in[i] ^ sequence_reverse_lut[c & 255U];
     c      = c >> 8U;
-    i++;
   }
 
   // Process spare bits
-  uint32_t rem8 = length % 8;
+  uint32_t rem8 = nof_bits % 8;
   if (rem8 != 0) {
-    out[i] = in[i] ^ reverse_lut[c & ((1U << rem8) - 1U) & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[c & ((1U << rem8) - 1U)];
+  }
+}
+
+void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
+{
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_s(sequence_state64_step(&s), &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_apply_c(const int8_t* in, int8_t* out, uint32_t length, uint32_t seed)
+{
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_c(sequence_state64_step(&s), &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
+{
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_bit(sequence_state64_step(&s), &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
+{
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_packed(sequence_state64_step(&s), &in[i / 8], &out[i / 8], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_gen_packed64(uint64_t* c, uint32_t length, uint32_t seed)
+{
+  sequence_state64_t s;
+  sequence_state64_init(&s, seed);
+
+  for (uint32_t i = 0; i < length / 64; i++) {
+    c[i] = sequence_state64_step(&s);
+  }
+
+  // Clear the bits beyond the sequence length
+  if (length % 64 != 0) {
+    c[length / 64] = sequence_state64_step(&s) & ((1ULL << (length % 64)) - 1ULL);
+  }
+}
+
+void srsran_sequence_packed64_apply_s(const uint64_t* c, const int16_t* in, int16_t* out, uint32_t length)
+{
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_s(c[i / 64], &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_packed64_apply_c(const uint64_t* c, const int8_t* in, int8_t* out, uint32_t length)
+{
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_c(c[i / 64], &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_packed64_apply_bit(const uint64_t* c, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_bit(c[i / 64], &in[i], &out[i], SRSRAN_MIN(64, length - i));
+  }
+}
+
+void srsran_sequence_packed64_apply_packed(const uint64_t* c, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  for (uint32_t i = 0; i < length; i += 64) {
+    sequence_word_apply_packed(c[i / 64], &in[i / 8], &out[i / 8], SRSRAN_MIN(64, length - i));
   }
-#endif // SEQUENCE_PAR_BITS % 8 == 0
 }
@@ -0,0 +1,209 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/common/sequence_cache.h"
+#include "srsran/phy/common/sequence.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries)
+{
+  if (q == NULL || nof_entries == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+
+  q->nof_sets = SRSRAN_CEIL(nof_entries, SRSRAN_SEQUENCE_CACHE_NOF_WAYS);
+  q->entries  = SRSRAN_MEM_ALLOC(srsran_sequence_cache_entry_t, q->nof_sets * SRSRAN_SEQUENCE_CACHE_NOF_WAYS);
+  if (q->entries == NULL) {
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->entries, srsran_sequence_cache_entry_t, q->nof_sets * SRSRAN_SEQUENCE_CACHE_NOF_WAYS);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entries != NULL) {
+    for (uint32_t i = 0; i < q->nof_sets * SRSRAN_SEQUENCE_CACHE_NOF_WAYS; i++) {
+      if (q->entries[i].c != NULL) {
+        free(q->entries[i].c);
+      }
+    }
+    free(q->entries);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+}
+
+void srsran_sequence_cache_reset(srsran_sequence_cache_t* q)
+{
+  if (q == NULL || q->entries == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_sets * SRSRAN_SEQUENCE_CACHE_NOF_WAYS; i++) {
+    q->entries[i].len      = 0;
+    q->entries[i].last_use = 0;
+  }
+  q->access_count = 0;
+  SRSRAN_MEM_ZERO(&q->metrics, srsran_sequence_cache_metrics_t, 1);
+}
+
+/**
+ * Selects the set of a seed. The seeds of the physical channels differ in few bits, the multiplicative hash spreads
+ * them before mapping the result to the number of sets.
+ */
+static inline uint32_t sequence_cache_set_idx(const srsran_sequence_cache_t* q, uint32_t seed)
+{
+  uint32_t hash = seed * 2654435761U;
+  return (uint32_t)(((uint64_t)hash * (uint64_t)q->nof_sets) >> 32U);
+}
+
+const uint64_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t length)
+{
+  if (q == NULL || q->entries == NULL || length == 0) {
+    return NULL;
+  }
+
+  srsran_sequence_cache_entry_t* set   = &q->entries[sequence_cache_set_idx(q, seed) * SRSRAN_SEQUENCE_CACHE_NOF_WAYS];
+  srsran_sequence_cache_entry_t* entry = NULL;
+  q->access_count++;
+
+  // Look for the seed, otherwise select an empty entry or the least recently used
+  for (uint32_t i = 0; i < SRSRAN_SEQUENCE_CACHE_NOF_WAYS; i++) {
+    if (set[i].len != 0 && set[i].seed == seed) {
+      entry = &set[i];
+      break;
+    }
+    if (entry == NULL || (entry->len != 0 && (set[i].len == 0 || set[i].last_use < entry->last_use))) {
+      entry = &set[i];
+    }
+  }
+
+  // Hit, as long as the cached sequence is long enough
+  if (entry->len != 0 && entry->seed == seed && entry->len >= length) {
+    entry->last_use = q->access_count;
+    q->metrics.nof_hits++;
+    return entry->c;
+  }
+
+  q->metrics.nof_misses++;
+  if (entry->len != 0 && entry->seed != seed) {
+    q->metrics.nof_evictions++;
+  }
+
+  // Grow the entry if required
+  uint32_t nof_words = SRSRAN_CEIL(length, 64);
+  if (entry->nof_words < nof_words) {
+    if (entry->c != NULL) {
+      free(entry->c);
+    }
+    entry->nof_words = 0;
+    entry->len       = 0;
+    entry->c         = SRSRAN_MEM_ALLOC(uint64_t, nof_words);
+    if (entry->c == NULL) {
+      return NULL;
+    }
+    entry->nof_words = nof_words;
+  }
+
+  srsran_sequence_gen_packed64(entry->c, length, seed);
+  entry->seed     = seed;
+  entry->len      = length;
+  entry->last_use = q->access_count;
+
+  return entry->c;
+}
+
+void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                   const int16_t*           in,
+                                   int16_t*                 out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint64_t* c = srsran_sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_s(in, out, length, seed);
+    return;
+  }
+  srsran_sequence_packed64_apply_s(c, in, out, length);
+}
+
+void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                   const int8_t*            in,
+                                   int8_t*                  out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint64_t* c = srsran_sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_c(in, out, length, seed);
+    return;
+  }
+  srsran_sequence_packed64_apply_c(c, in, out, length);
+}
+
+void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                     const uint8_t*           in,
+                                     uint8_t*                 out,
+                                     uint32_t                 length,
+                                     uint32_t                 seed)
+{
+  const uint64_t* c = srsran_sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_bit(in, out, length, seed);
+    return;
+  }
+  srsran_sequence_packed64_apply_bit(c, in, out, length);
+}
+
+void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                        const uint8_t*           in,
+                                        uint8_t*                 out,
+                                        uint32_t                 length,
+                                        uint32_t                 seed)
+{
+  const uint64_t* c = srsran_sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_packed(in, out, length, seed);
+    return;
+  }
+  srsran_sequence_packed64_apply_packed(c, in, out, length);
+}
+
+void srsran_sequence_cache_get_metrics(const srsran_sequence_cache_t* q, srsran_sequence_cache_metrics_t* metrics)
+{
+  if (q == NULL || metrics == NULL) {
+    return;
+  }
+
+  *metrics              = q->metrics;
+  uint64_t nof_accesses = metrics->nof_hits + metrics->nof_misses;
+  metrics->hit_rate     = nof_accesses > 0 ? (float)metrics->nof_hits / (float)nof_accesses : 0.0f;
+}
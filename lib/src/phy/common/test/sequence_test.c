@@ -20,9 +20,11 @@
  */
 
 #include "srsran/phy/common/sequence.h"
+#include "srsran/phy/common/sequence_cache.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include <inttypes.h>
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -43,6 +45,13 @@ static int8_t  ones_char[Nc + MAX_SEQ_LEN + 31];
 static uint8_t ones_packed[(MAX_SEQ_LEN * 7) / 8];
 static uint8_t ones_unpacked[MAX_SEQ_LEN];
 
+static int16_t c_short_cached[MAX_SEQ_LEN];
+static int8_t  c_char_cached[MAX_SEQ_LEN];
+static uint8_t c_packed_cached[MAX_SEQ_LEN / 8];
+static uint8_t c_unpacked_cached[MAX_SEQ_LEN];
+
+static srsran_sequence_cache_t cache = {};
+
 static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t length, uint32_t repetitions)
 {
   int            ret                      = SRSRAN_SUCCESS;
@@ -178,6 +187,34 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
     ret = SRSRAN_ERROR;
   }
 
+  // Test cached XOR, the first application misses and the second hits
+  for (uint32_t r = 0; r < 2; r++) {
+    srsran_sequence_cache_apply_s(&cache, ones_short, c_short_cached, length, seed);
+    srsran_sequence_cache_apply_c(&cache, ones_char, c_char_cached, length, seed);
+    srsran_sequence_cache_apply_bit(&cache, ones_unpacked, c_unpacked_cached, length, seed);
+    srsran_sequence_cache_apply_packed(&cache, ones_packed, c_packed_cached, length, seed);
+
+    if (memcmp(c_short, c_short_cached, length * sizeof(int16_t)) != 0) {
+      ERROR("Unmatched cached c_short");
+      ret = SRSRAN_ERROR;
+    }
+
+    if (memcmp(c_char, c_char_cached, length * sizeof(int8_t)) != 0) {
+      ERROR("Unmatched cached c_char");
+      ret = SRSRAN_ERROR;
+    }
+
+    if (memcmp(c, c_unpacked_cached, length) != 0) {
+      ERROR("Unmatched cached c_unpacked");
+      ret = SRSRAN_ERROR;
+    }
+
+    if (memcmp(c_packed_gold, c_packed_cached, (length + 7) / 8) != 0) {
+      ERROR("Unmatched cached c_packed");
+      ret = SRSRAN_ERROR;
+    }
+  }
+
   printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
          seed,
          length,
@@ -189,6 +226,50 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
          (double)(length * repetitions) / (double)interval_xor_packed_us,
          ret == SRSRAN_SUCCESS ? 'y' : 'n');
 
+  return ret;
+}
+
+static int test_sequence_cache_metrics()
+{
+  srsran_sequence_cache_t         q       = {};
+  srsran_sequence_cache_metrics_t metrics = {};
+
+  // A single set, so that the replacement order is known
+  if (srsran_sequence_cache_init(&q, SRSRAN_SEQUENCE_CACHE_NOF_WAYS) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising cache");
+    return SRSRAN_ERROR;
+  }
+
+  // Fill the set and access it again
+  for (uint32_t r = 0; r < 2; r++) {
+    for (uint32_t seed = 1; seed <= SRSRAN_SEQUENCE_CACHE_NOF_WAYS; seed++) {
+      srsran_sequence_cache_get(&q, seed, 100);
+    }
+  }
+
+  // Evicts seed 1, the least recently used
+  srsran_sequence_cache_get(&q, SRSRAN_SEQUENCE_CACHE_NOF_WAYS + 1, 100);
+  srsran_sequence_cache_get(&q, 2, 100);
+  srsran_sequence_cache_get(&q, 1, 100);
+
+  // A longer sequence for a cached seed is generated again
+  srsran_sequence_cache_get(&q, 2, 1000);
+
+  srsran_sequence_cache_get_metrics(&q, &metrics);
+  srsran_sequence_cache_free(&q);
+
+  printf("Cache hits=%" PRIu64 "; misses=%" PRIu64 "; evictions=%" PRIu64 "; hit_rate=%.2f;\n",
+         metrics.nof_hits,
+         metrics.nof_misses,
+         metrics.nof_evictions,
+         metrics.hit_rate);
+
+  if (metrics.nof_hits != SRSRAN_SEQUENCE_CACHE_NOF_WAYS + 1 ||
+      metrics.nof_misses != SRSRAN_SEQUENCE_CACHE_NOF_WAYS + 3 || metrics.nof_evictions != 2) {
+    ERROR("Unexpected cache metrics");
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -198,6 +279,7 @@ int main(int argc, char** argv)
   uint32_t min_length  = 16;
   uint32_t max_length  = MAX_SEQ_LEN;
 
+  int               ret        = SRSRAN_SUCCESS;
   srsran_sequence_t sequence   = {};
   srsran_random_t   random_gen = srsran_random_init(0);
 
@@ -218,6 +300,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (srsran_sequence_cache_init(&cache, 16) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error initializing sequence cache\n");
+    return SRSRAN_ERROR;
+  }
+
   printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
          "seed",
          "length",
@@ -230,12 +317,20 @@ int main(int argc, char** argv)
          "Passed");
 
   for (uint32_t length = min_length; length <= max_length; length = (length * 5) / 4) {
-    test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
+    uint32_t seed = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX);
+    if (test_sequence(&sequence, seed, length, repetitions) < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  if (test_sequence_cache_metrics() < SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
   }
 
   // Free sequence object
   srsran_sequence_free(&sequence);
+  srsran_sequence_cache_free(&cache);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
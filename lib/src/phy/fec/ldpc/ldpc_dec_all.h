@@ -383,6 +383,31 @@ int update_ldpc_soft_bits_c_avx2(void* p, int i_layer, const int8_t (*these_var_
  */
 int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK);
 
+/*!
+ * Initializes the inner registers of the optimized 8-bit integer-based LDPC decoder before carrying out the decoding
+ * of a batch of code blocks (LS <= \ref SRSRAN_AVX2_B_SIZE / 2). The registers must have been created with a lifting
+ * size equal to the batch size times \b ls: lifted node \b j of code block \b b is stored in lane
+ * \b j * batch size + \b b, so that the node rotations of all code blocks are carried out at once.
+ * \param[in,out] p      A pointer to the decoder registers (an ldpc_regs_c_avx2 structure).
+ * \param[in]     llrs   An array of pointers to the LLR values of each code block.
+ * \param[in]     nof_cb The number of code blocks, not larger than the batch size.
+ * \param[in]     ls     The lifting size of the code blocks.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_ldpc_dec_c_avx2_batch(void* p, const int8_t* const* llrs, uint32_t nof_cb, uint16_t ls);
+
+/*!
+ * Returns the decoded message (hard bits) of one code block of the batch from the current soft bits (optimized 8-bit
+ * version, LS <= \ref SRSRAN_AVX2_B_SIZE / 2).
+ * \param[in]  p       A pointer to the decoder registers (an ldpc_regs_c_avx2 structure).
+ * \param[out] message A pointer to the decoded message.
+ * \param[in]  cb_idx  The index of the code block within the batch.
+ * \param[in]  liftK   The length of the decoded message.
+ * \param[in]  ls      The lifting size of the code blocks.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int extract_ldpc_message_c_avx2_batch(void* p, uint8_t* message, uint32_t cb_idx, uint16_t liftK, uint16_t ls);
+
 /*!
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder (LS > \ref
  * SRSRAN_AVX2_B_SIZE).
@@ -738,6 +763,31 @@ int update_ldpc_soft_bits_c_avx512(void* p, int i_layer, const int8_t (*these_va
  */
 int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK);
 
+/*!
+ * Initializes the inner registers of the optimized 8-bit integer-based LDPC decoder before carrying out the decoding
+ * of a batch of code blocks (LS <= \ref SRSRAN_AVX512_B_SIZE / 2). The registers must have been created with a lifting
+ * size equal to the batch size times \b ls: lifted node \b j of code block \b b is stored in lane
+ * \b j * batch size + \b b, so that the node rotations of all code blocks are carried out at once.
+ * \param[in,out] p      A pointer to the decoder registers (an ldpc_regs_c_avx512 structure).
+ * \param[in]     llrs   An array of pointers to the LLR values of each code block.
+ * \param[in]     nof_cb The number of code blocks, not larger than the batch size.
+ * \param[in]     ls     The lifting size of the code blocks.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_ldpc_dec_c_avx512_batch(void* p, const int8_t* const* llrs, uint32_t nof_cb, uint16_t ls);
+
+/*!
+ * Returns the decoded message (hard bits) of one code block of the batch from the current soft bits (optimized 8-bit
+ * version, LS <= \ref SRSRAN_AVX512_B_SIZE / 2).
+ * \param[in]  p       A pointer to the decoder registers (an ldpc_regs_c_avx512 structure).
+ * \param[out] message A pointer to the decoded message.
+ * \param[in]  cb_idx  The index of the code block within the batch.
+ * \param[in]  liftK   The length of the decoded message.
+ * \param[in]  ls      The lifting size of the code blocks.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int extract_ldpc_message_c_avx512_batch(void* p, uint8_t* message, uint32_t cb_idx, uint16_t liftK, uint16_t ls);
+
 /*!
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder
  * (flooded scheduling, LS > \ref SRSRAN_AVX512_B_SIZE).
@@ -237,6 +237,35 @@ int init_ldpc_dec_c_avx2(void* p, const int8_t* llrs, uint16_t ls)
   return 0;
 }
 
+int init_ldpc_dec_c_avx2_batch(void* p, const int8_t* const* llrs, uint32_t nof_cb, uint16_t ls)
+{
+  struct ldpc_regs_c_avx2* vp = p;
+
+  if (p == NULL || ls == 0 || nof_cb > vp->ls / ls) {
+    return -1;
+  }
+
+  uint32_t batch_size = vp->ls / ls;
+
+  // the first 2 x LS bits of the codeword are not sent
+  vp->soft_bits.v[0] = _mm256_set1_epi8(0);
+  vp->soft_bits.v[1] = _mm256_set1_epi8(0);
+  for (int i = 2; i < vp->bgN; i++) {
+    int8_t* node = &vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE];
+    SRSRAN_MEM_ZERO(node, int8_t, SRSRAN_AVX2_B_SIZE);
+    for (uint32_t b = 0; b < nof_cb; b++) {
+      const int8_t* cb_llrs = llrs[b] + (i - 2) * ls;
+      for (int j = 0; j < ls; j++) {
+        node[j * batch_size + b] = cb_llrs[j];
+      }
+    }
+  }
+
+  SRSRAN_MEM_ZERO(vp->check_to_var, __m256i, (vp->hrr + 1) * (uint32_t)vp->bgM);
+  SRSRAN_MEM_ZERO(vp->var_to_check, __m256i, vp->hrr + 1);
+  return 0;
+}
+
 int update_ldpc_var_to_check_c_avx2(void* p, int i_layer)
 {
   struct ldpc_regs_c_avx2* vp = p;
@@ -403,6 +432,26 @@ int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK)
   return 0;
 }
 
+int extract_ldpc_message_c_avx2_batch(void* p, uint8_t* message, uint32_t cb_idx, uint16_t liftK, uint16_t ls)
+{
+  if (p == NULL || ls == 0) {
+    return -1;
+  }
+
+  struct ldpc_regs_c_avx2* vp = p;
+
+  uint32_t batch_size = vp->ls / ls;
+
+  for (int i = 0; i < liftK / ls; i++) {
+    const int8_t* node = &vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE + cb_idx];
+    for (int j = 0; j < ls; j++) {
+      message[i * ls + j] = (node[j * batch_size] < 0);
+    }
+  }
+
+  return 0;
+}
+
 static void
 inner_var_to_check_c_avx2(const __m256i* x, const __m256i* y, __m256i* z, const uint8_t clip, const uint32_t len)
 {
@@ -248,6 +248,55 @@ int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK)
   return 0;
 }
 
+int init_ldpc_dec_c_avx512_batch(void* p, const int8_t* const* llrs, uint32_t nof_cb, uint16_t ls)
+{
+  struct ldpc_regs_c_avx512* vp = p;
+
+  if (p == NULL || ls == 0 || nof_cb > vp->ls / ls) {
+    return -1;
+  }
+
+  uint32_t batch_size = vp->ls / ls;
+
+  // First 2 punctured bits
+  srsran_vec_i8_zero(vp->soft_bits.c, SRSRAN_AVX512_B_SIZE + SRSRAN_AVX512_B_SIZE);
+
+  for (int i = 2; i < vp->bgN; i++) {
+    int8_t* node = &vp->soft_bits.c[i * SRSRAN_AVX512_B_SIZE];
+    srsran_vec_i8_zero(node, SRSRAN_AVX512_B_SIZE);
+    for (uint32_t b = 0; b < nof_cb; b++) {
+      const int8_t* cb_llrs = llrs[b] + (i - 2) * ls;
+      for (int k = 0; k < ls; k++) {
+        node[k * batch_size + b] = cb_llrs[k];
+      }
+    }
+  }
+
+  SRSRAN_MEM_ZERO(vp->check_to_var, __m512i, (vp->hrr + 1) * vp->bgM);
+  SRSRAN_MEM_ZERO(vp->var_to_check, __m512i, vp->hrr + 1);
+
+  return 0;
+}
+
+int extract_ldpc_message_c_avx512_batch(void* p, uint8_t* message, uint32_t cb_idx, uint16_t liftK, uint16_t ls)
+{
+  if (p == NULL || ls == 0) {
+    return -1;
+  }
+  struct ldpc_regs_c_avx512* vp = p;
+
+  uint32_t batch_size = vp->ls / ls;
+
+  for (int i = 0; i < liftK / ls; i++) {
+    const int8_t* node = &vp->soft_bits.c[i * SRSRAN_AVX512_B_SIZE + cb_idx];
+    for (int k = 0; k < ls; k++) {
+      message[i * ls + k] = (node[k * batch_size] < 0);
+    }
+  }
+
+  return 0;
+}
+
 int update_ldpc_var_to_check_c_avx512(void* p, int i_layer)
 {
   struct ldpc_regs_c_avx512* vp = p;
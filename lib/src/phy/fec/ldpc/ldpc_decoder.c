@@ -167,6 +167,111 @@
     return q->max_nof_iter;                                                                                            \
   }
 
+#define LDPC_DECODER_BATCH_TEMPLATE(SUFFIX)                                                                            \
+  static int decode_batch_##SUFFIX(void*                o,                                                             \
+                                   const int8_t* const* llrs,                                                          \
+                                   uint8_t* const*      messages,                                                      \
+                                   uint32_t             nof_cb,                                                        \
+                                   uint32_t             cdwd_rm_length,                                                \
+                                   srsran_crc_t*        crc,                                                           \
+                                   int*                 results)                                                       \
+  {                                                                                                                    \
+    srsran_ldpc_decoder_t* q = o;                                                                                      \
+                                                                                                                       \
+    /* it must be smaller than the codeword size */                                                                    \
+    if (cdwd_rm_length > q->liftN - 2 * q->ls) {                                                                       \
+      cdwd_rm_length = q->liftN - 2 * q->ls;                                                                           \
+    }                                                                                                                  \
+    /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/                            \
+    /* 2 variable nodes are systematically punctured by the encoder. */                                                \
+    if (cdwd_rm_length < (q->bgK + 2) * q->ls) {                                                                       \
+      cdwd_rm_length = (q->bgK + 2) * q->ls;                                                                           \
+    }                                                                                                                  \
+    if (cdwd_rm_length % q->ls) {                                                                                      \
+      cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;                                                           \
+    }                                                                                                                  \
+    if (init_ldpc_dec_##SUFFIX##_batch(q->ptr_batch, llrs, nof_cb, q->ls) != 0) {                                      \
+      return -1;                                                                                                       \
+    }                                                                                                                  \
+                                                                                                                       \
+    uint16_t* this_pcm                   = NULL;                                                                       \
+    int8_t(*these_var_indices)[MAX_CNCT] = NULL;                                                                       \
+                                                                                                                       \
+    /* When computing the number of layers, we need to recall that the standard always removes */                      \
+    /* the first two variable nodes from the final codeword.*/                                                         \
+    uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;                                                            \
+                                                                                                                       \
+    /* Number of code blocks that have not matched the CRC yet */                                                      \
+    uint32_t nof_pending = nof_cb;                                                                                     \
+    for (uint32_t b = 0; b < nof_cb; b++) {                                                                            \
+      results[b] = 0;                                                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    for (int i_iteration = 0; i_iteration < q->max_nof_iter; i_iteration++) {                                          \
+      for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
+        update_ldpc_var_to_check_##SUFFIX(q->ptr_batch, i_layer);                                                      \
+                                                                                                                       \
+        this_pcm          = q->pcm_batch + i_layer * q->bgN;                                                           \
+        these_var_indices = q->var_indices + i_layer;                                                                  \
+                                                                                                                       \
+        update_ldpc_check_to_var_##SUFFIX(q->ptr_batch, i_layer, this_pcm, these_var_indices);                         \
+                                                                                                                       \
+        update_ldpc_soft_bits_##SUFFIX(q->ptr_batch, i_layer, these_var_indices);                                      \
+      }                                                                                                                \
+                                                                                                                       \
+      if (crc != NULL) {                                                                                               \
+        /* Once a code block matches the CRC, its message is kept while the rest keep iterating */                     \
+        for (uint32_t b = 0; b < nof_cb; b++) {                                                                        \
+          if (results[b] != 0) {                                                                                       \
+            continue;                                                                                                  \
+          }                                                                                                            \
+          extract_ldpc_message_##SUFFIX##_batch(q->ptr_batch, messages[b], b, q->liftK, q->ls);                        \
+                                                                                                                       \
+          if (srsran_crc_match(crc, messages[b], q->liftK - crc->order)) {                                             \
+            results[b] = i_iteration + 1;                                                                              \
+            nof_pending--;                                                                                             \
+          }                                                                                                            \
+        }                                                                                                              \
+                                                                                                                       \
+        if (nof_pending == 0) {                                                                                        \
+          return 0;                                                                                                    \
+        }                                                                                                              \
+      }                                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    /* Without CRC, extract messages and return the maximum number of iterations */                                    \
+    if (crc == NULL) {                                                                                                 \
+      for (uint32_t b = 0; b < nof_cb; b++) {                                                                          \
+        extract_ldpc_message_##SUFFIX##_batch(q->ptr_batch, messages[b], b, q->liftK, q->ls);                          \
+        results[b] = (int)q->max_nof_iter;                                                                             \
+      }                                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    return 0;                                                                                                          \
+  }
+
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+/*!
+ * Creates the compact parity check matrix of the batched decoders: the lifted nodes of the code blocks of a batch are
+ * interleaved, so every shift is scaled by the batch size.
+ */
+static int init_pcm_batch(srsran_ldpc_decoder_t* q, uint32_t batch_size)
+{
+  q->pcm_batch = srsran_vec_u16_malloc(q->bgM * q->bgN);
+  if (!q->pcm_batch) {
+    perror("malloc");
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < (uint32_t)q->bgM * q->bgN; i++) {
+    q->pcm_batch[i] = (q->pcm[i] == NO_CNCT) ? NO_CNCT : (uint16_t)(q->pcm[i] * batch_size);
+  }
+  q->batch_size = batch_size;
+
+  return 0;
+}
+#endif // LV_HAVE_AVX2 || LV_HAVE_AVX512
+
 /*! Carries out the actual destruction of the memory allocated to the decoder, float-LLR case. */
 static void free_dec_f(void* o)
 {
@@ -306,12 +411,19 @@ static void free_dec_c_avx2(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->pcm_batch) {
+    free(q->pcm_batch);
+  }
+  delete_ldpc_dec_c_avx2(q->ptr_batch);
   delete_ldpc_dec_c_avx2(q->ptr);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2);
 
+/*! Carries out the decoding of a batch of code blocks with 8-bit integer-valued LLRs (AVX2 implementation). */
+LDPC_DECODER_BATCH_TEMPLATE(c_avx2)
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation). */
 static int init_c_avx2(srsran_ldpc_decoder_t* q)
 {
@@ -325,6 +437,18 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx2;
 
+  // Decode several code blocks at once if at least two fit in a register
+  uint32_t batch_size = SRSRAN_MIN(SRSRAN_AVX2_B_SIZE / q->ls, SRSRAN_LDPC_DECODER_MAX_BATCH);
+  if (batch_size > 1) {
+    if (init_pcm_batch(q, batch_size) != 0 ||
+        (q->ptr_batch = create_ldpc_dec_c_avx2(q->bgN, q->bgM, batch_size * q->ls, q->scaling_fctr)) == NULL) {
+      ERROR("Create_ldpc_dec failed");
+      free_dec_c_avx2(q);
+      return -1;
+    }
+    q->decode_batch_c = decode_batch_c_avx2;
+  }
+
   return 0;
 }
 
@@ -445,12 +569,19 @@ static void free_dec_c_avx512(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->pcm_batch) {
+    free(q->pcm_batch);
+  }
+  delete_ldpc_dec_c_avx512(q->ptr_batch);
   delete_ldpc_dec_c_avx512(q->ptr);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx512)
 
+/*! Carries out the decoding of a batch of code blocks with 8-bit integer-valued LLRs (AVX512 implementation). */
+LDPC_DECODER_BATCH_TEMPLATE(c_avx512)
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX512 implementation). */
 static int init_c_avx512(srsran_ldpc_decoder_t* q)
 {
@@ -464,6 +595,18 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+  // Decode several code blocks at once if at least two fit in a register
+  uint32_t batch_size = SRSRAN_MIN(SRSRAN_AVX512_B_SIZE / q->ls, SRSRAN_LDPC_DECODER_MAX_BATCH);
+  if (batch_size > 1) {
+    if (init_pcm_batch(q, batch_size) != 0 ||
+        (q->ptr_batch = create_ldpc_dec_c_avx512(q->bgN, q->bgM, batch_size * q->ls, q->scaling_fctr)) == NULL) {
+      ERROR("Create_ldpc_dec failed");
+      free_dec_c_avx512(q);
+      return -1;
+    }
+    q->decode_batch_c = decode_batch_c_avx512;
+  }
+
   return 0;
 }
 
@@ -578,6 +721,12 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
 
   q->max_nof_iter = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
 
+  // The batched decoder is only created by the SIMD decoders for small lifting sizes
+  q->ptr_batch      = NULL;
+  q->pcm_batch      = NULL;
+  q->batch_size     = 1;
+  q->decode_batch_c = NULL;
+
   q->pcm = srsran_vec_u16_malloc(q->bgM * q->bgN);
   if (!q->pcm) {
     perror("malloc");
@@ -683,3 +832,37 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch_crc_c(srsran_ldpc_decoder_t* q,
+                                           const int8_t* const*   llrs,
+                                           uint8_t* const*        messages,
+                                           uint32_t               nof_cb,
+                                           uint32_t               cdwd_rm_length,
+                                           srsran_crc_t*          crc,
+                                           int*                   results)
+{
+  if (q == NULL || llrs == NULL || messages == NULL || results == NULL) {
+    return -1;
+  }
+
+  uint32_t cb_idx = 0;
+  while (cb_idx < nof_cb) {
+    uint32_t n = SRSRAN_MIN(q->batch_size, nof_cb - cb_idx);
+
+    // A single code block is decoded faster without interleaving
+    if (n > 1 && q->decode_batch_c != NULL) {
+      if (q->decode_batch_c(q, &llrs[cb_idx], &messages[cb_idx], n, cdwd_rm_length, crc, &results[cb_idx]) != 0) {
+        return -1;
+      }
+    } else {
+      n               = 1;
+      results[cb_idx] = q->decode_c(q, llrs[cb_idx], messages[cb_idx], cdwd_rm_length, crc);
+      if (results[cb_idx] < 0) {
+        return -1;
+      }
+    }
+    cb_idx += n;
+  }
+
+  return 0;
+}
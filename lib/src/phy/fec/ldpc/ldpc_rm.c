@@ -40,6 +40,10 @@
 
 #include "srsran/phy/utils/debug.h"
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
 //#define debug
 /*!
  * \brief Look-up table: k0 indices
@@ -99,12 +103,23 @@ struct pRM_rx_s {
   uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
 };
 
+/*!
+ * \brief Maximum modulation order supported by the rate dematcher (char version).
+ */
+#define RM_RX_C_MAX_QM 8
+
 /*!
  * \brief Describes an rate dematcher (char version).
+ *
+ * The deinterleaving, the bit selection and the combining with previous redundancy versions are done in a single pass,
+ * so there are no temporal buffers.
  */
 struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  /*!
+   * \brief Byte shuffles that deinterleave a row: for an even modulation order Qm, entry [Qm / 2 - 1][row][m] moves
+   * the symbols of the given row found in the m-th 16 bytes of 16 consecutive columns to their column index.
+   */
+  int8_t row_shuffle[RM_RX_C_MAX_QM / 2][RM_RX_C_MAX_QM][RM_RX_C_MAX_QM][16];
 };
 
 /*!
@@ -289,56 +304,141 @@ static void bit_selection_rm_rx_s(const int16_t* input,
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block (int8_t).
+ * Saturating combination of the deinterleaved soft bits of a row with the ones already in the codeword (int8_t).
+ * output[i] is combined with input[i * mod_order + row], for i < len. Messages use a 7-bit quantization, the soft bits
+ * use the remaining bit to denote infinity.
+ */
+static void rm_rx_c_combine_row(const struct pRM_rx_c* pp,
+                                const int8_t*          input,
+                                int8_t*                output,
+                                const uint32_t         len,
+                                const uint32_t         mod_order,
+                                const uint32_t         row)
+{
+  const int8_t infinity7 = (1U << 6U) - 1;
+  uint32_t     i         = 0;
+
+#ifdef LV_HAVE_AVX2
+  const int8_t(*shuffle)[16] = (mod_order > 1) ? pp->row_shuffle[mod_order / 2 - 1][row] : NULL;
+#endif // LV_HAVE_AVX2
+
+#ifdef LV_HAVE_AVX512
+  const __m512i infinity7_512  = _mm512_set1_epi8(infinity7);
+  const __m512i minfinity7_512 = _mm512_set1_epi8(-infinity7);
+  for (; i + 64 <= len; i += 64) {
+    __m512i llr = _mm512_setzero_si512();
+    if (mod_order == 1) {
+      llr = _mm512_loadu_si512(input + i);
+    } else {
+      // Each 128-bit lane deinterleaves 16 columns
+      const int8_t* in = input + i * mod_order;
+      for (uint32_t m = 0; m < mod_order; m++) {
+        __m512i sym = _mm512_castsi128_si512(_mm_loadu_si128((__m128i*)(in + 16 * m)));
+        sym         = _mm512_inserti32x4(sym, _mm_loadu_si128((__m128i*)(in + 16 * (mod_order + m))), 1);
+        sym         = _mm512_inserti32x4(sym, _mm_loadu_si128((__m128i*)(in + 16 * (2 * mod_order + m))), 2);
+        sym         = _mm512_inserti32x4(sym, _mm_loadu_si128((__m128i*)(in + 16 * (3 * mod_order + m))), 3);
+        __m512i shf = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)shuffle[m]));
+        llr         = _mm512_or_si512(llr, _mm512_shuffle_epi8(sym, shf));
+      }
+    }
+    __m512i out = _mm512_adds_epi8(_mm512_loadu_si512(output + i), llr);
+    out         = _mm512_max_epi8(_mm512_min_epi8(out, infinity7_512), minfinity7_512);
+    _mm512_storeu_si512(output + i, out);
+  }
+#endif // LV_HAVE_AVX512
+
+#ifdef LV_HAVE_AVX2
+  const __m256i infinity7_256  = _mm256_set1_epi8(infinity7);
+  const __m256i minfinity7_256 = _mm256_set1_epi8(-infinity7);
+  for (; i + 32 <= len; i += 32) {
+    __m256i llr = _mm256_setzero_si256();
+    if (mod_order == 1) {
+      llr = _mm256_loadu_si256((__m256i*)(input + i));
+    } else {
+      // Each 128-bit lane deinterleaves 16 columns
+      const int8_t* in = input + i * mod_order;
+      for (uint32_t m = 0; m < mod_order; m++) {
+        __m256i sym = _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(in + 16 * m)));
+        sym         = _mm256_inserti128_si256(sym, _mm_loadu_si128((__m128i*)(in + 16 * (mod_order + m))), 1);
+        __m256i shf = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)shuffle[m]));
+        llr         = _mm256_or_si256(llr, _mm256_shuffle_epi8(sym, shf));
+      }
+    }
+    __m256i out = _mm256_adds_epi8(_mm256_loadu_si256((__m256i*)(output + i)), llr);
+    out         = _mm256_max_epi8(_mm256_min_epi8(out, infinity7_256), minfinity7_256);
+    _mm256_storeu_si256((__m256i*)(output + i), out);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < len; i++) {
+    int16_t tmp = (int16_t)output[i] + input[i * mod_order + row];
+    if (tmp > infinity7) {
+      tmp = infinity7;
+    }
+    if (tmp < -infinity7) {
+      tmp = -infinity7;
+    }
+    output[i] = (int8_t)tmp;
+  }
+}
+
+/*!
+ * Undoes the bit interleaving and the bit selection for the rate-dematching block (int8_t) in a single pass.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
  * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
+ *
+ * The k-th deinterleaved soft bit is the symbol in row k / cols and column k % cols of the interleaver, and the
+ * selected codeword positions are runs of consecutive indices between the filler bits and the end of the circular
+ * buffer. Every run is combined row by row, in the same order as the soft bits are selected.
  */
-static void bit_selection_rm_rx_c(const int8_t*  input,
-                                  const uint32_t in_len,
-                                  int8_t*        output,
-                                  uint32_t*      indices,
-                                  const uint32_t ini_exclude,
-                                  const uint32_t end_exclude,
-                                  const uint32_t k0,
-                                  const uint32_t Ncb)
+static void bit_selection_deinterleaver_rm_rx_c(const struct pRM_rx_c* pp,
+                                                const int8_t*          input,
+                                                const uint32_t         in_len,
+                                                int8_t*                output,
+                                                const uint32_t         mod_order,
+                                                const uint32_t         ini_exclude,
+                                                const uint32_t         end_exclude,
+                                                const uint32_t         k0,
+                                                const uint32_t         Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+  uint32_t E    = in_len;
+  uint32_t cols = E / mod_order;
 
   // set filler bits to INFINITY
-  const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
+  const int8_t infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = infinity8;
   }
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
+  // avoid filler bits
+  uint32_t icwd = k0;
+  if (icwd >= ini_exclude && icwd < end_exclude) {
+    icwd = end_exclude;
+  }
+  if (icwd >= Ncb) {
+    icwd = 0;
+  }
+
+  uint32_t k = 0;
+  while (k < E) {
+    uint32_t run_end = (icwd < ini_exclude) ? SRSRAN_MIN(ini_exclude, Ncb) : Ncb;
+    uint32_t row     = k / cols;
+    uint32_t col     = k % cols;
+    uint32_t len     = SRSRAN_MIN(run_end - icwd, cols - col);
+
+    rm_rx_c_combine_row(pp, input + col * mod_order, output + icwd, len, mod_order, row);
+
+    k    = k + len;
+    icwd = icwd + len;
+    if (icwd == ini_exclude) {
+      icwd = end_exclude;
     }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
+    if (icwd >= Ncb) {
+      icwd = (ini_exclude == 0) ? end_exclude : 0;
     }
-    output[indices[i]] = (int8_t)tmp;
   }
 }
 
@@ -393,23 +493,6 @@ bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in
   }
 }
 
-/*!
- * Bit deinterleaver (short)
- */
-static void
-bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
-}
-
 int srsran_ldpc_rm_tx_init(srsran_ldpc_rm_t* p)
 {
   if (p == NULL) {
@@ -503,16 +586,17 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
   }
   p->ptr = pp;
 
-  // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
+  // the symbol of column c and row r is the (c * Qm + r)-th soft bit
+  for (uint32_t mod_order = 2; mod_order <= RM_RX_C_MAX_QM; mod_order += 2) {
+    for (uint32_t row = 0; row < mod_order; row++) {
+      for (uint32_t m = 0; m < mod_order; m++) {
+        int8_t* shuffle = pp->row_shuffle[mod_order / 2 - 1][row][m];
+        for (uint32_t col = 0; col < 16; col++) {
+          uint32_t idx = col * mod_order + row;
+          shuffle[col] = (idx / 16 == m) ? (int8_t)(idx % 16) : (int8_t)0x80;
+        }
+      }
+    }
   }
 
   return 0;
@@ -568,12 +652,6 @@ void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
   if (q != NULL) {
     struct pRM_rx_c* qq = q->ptr;
     if (qq != NULL) {
-      if (qq->tmp_rm_symbol != NULL) {
-        free(qq->tmp_rm_symbol);
-      }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -688,19 +766,18 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_c* pp            = q->ptr;
-  int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
-  uint32_t         end_exclude   = q->K - 2 * q->ls;
-  uint32_t         ini_exclude   = end_exclude - q->F;
-
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+  // The row shuffles cover BPSK and the even modulation orders
+  if (q->mod_order != 1 && (q->mod_order % 2 != 0 || q->mod_order > RM_RX_C_MAX_QM)) {
+    ERROR("Unsupported modulation order %d", q->mod_order);
+    return -1;
   }
 
+  struct pRM_rx_c* pp          = q->ptr;
+  uint32_t         end_exclude = q->K - 2 * q->ls;
+  uint32_t         ini_exclude = end_exclude - q->F;
+
+  bit_selection_deinterleaver_rm_rx_c(pp, input, q->E, output, q->mod_order, ini_exclude, end_exclude, q->k0, q->Ncb);
+
   // Return the number of useful LLR
   return (int)SRSRAN_MIN(q->k0 + q->E, q->Ncb);
 }
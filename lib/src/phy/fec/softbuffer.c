@@ -46,7 +46,20 @@ int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
   return srsran_softbuffer_rx_init_guru(q, max_cb, max_cb_size);
 }
 
-int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+int srsran_softbuffer_rx_init_8bit(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
+{
+  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+
+  if (ret == SRSRAN_ERROR) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t max_cb      = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+  uint32_t max_cb_size = SOFTBUFFER_SIZE;
+
+  return srsran_softbuffer_rx_init_guru_8bit(q, max_cb, max_cb_size);
+}
+
+static int softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size, bool llr_is_8bit)
 {
   int ret = SRSRAN_ERROR;
 
@@ -61,6 +74,7 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   // Set internal attributes
   q->max_cb      = max_cb;
   q->max_cb_size = max_cb_size;
+  q->llr_is_8bit = llr_is_8bit;
 
   q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
   if (!q->buffer_f) {
@@ -83,7 +97,11 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   }
 
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
+    if (q->llr_is_8bit) {
+      q->buffer_f[i] = (int16_t*)srsran_vec_i8_malloc(q->max_cb_size);
+    } else {
+      q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
+    }
     if (!q->buffer_f[i]) {
       perror("malloc");
       goto clean_exit;
@@ -109,6 +127,26 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, false);
+}
+
+int srsran_softbuffer_rx_init_guru_8bit(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, true);
+}
+
+uint32_t srsran_softbuffer_rx_nof_bytes(const srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+
+  uint32_t llr_size = q->llr_is_8bit ? sizeof(int8_t) : sizeof(int16_t);
+  return q->max_cb * (q->max_cb_size * llr_size + q->max_cb_size / 8);
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
@@ -155,7 +193,11 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
     }
     for (uint32_t i = 0; i < nof_cb; i++) {
       if (q->buffer_f[i]) {
-        srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        if (q->llr_is_8bit) {
+          srsran_vec_i8_zero((int8_t*)q->buffer_f[i], q->max_cb_size);
+        } else {
+          srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        }
       }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
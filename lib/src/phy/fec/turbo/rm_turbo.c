@@ -67,6 +67,14 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
 #define NCOLS 32
 #define NROWS_MAX NCOLS
 
+/* Soft-combines 8-bit LLRs saturating to +/-127, so that a retransmission never wraps around and flips the sign of an
+ * already reliable LLR stored in an 8-bit soft-buffer */
+#define RM_TURBO_COMBINE_8BIT(llr, x)                                                                                  \
+  do {                                                                                                                 \
+    int16_t rm_sum_ = (int16_t)(llr) + (int16_t)(x);                                                                   \
+    (llr)           = (int8_t)SRSRAN_MAX(-INT8_MAX, SRSRAN_MIN(INT8_MAX, rm_sum_));                                    \
+  } while (0)
+
 static uint8_t RM_PERM_TC[NCOLS] = {0, 16, 8, 24, 4, 20, 12, 28, 2, 18, 10, 26, 6, 22, 14, 30,
                                     1, 17, 9, 25, 5, 21, 13, 29, 3, 19, 11, 27, 7, 23, 15, 31};
 
@@ -472,7 +480,7 @@ int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
     uint32_t  out_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
 
     for (int i = 0; i < in_len; i++) {
-      output[deinter[i % out_len]] += input[i];
+      RM_TURBO_COMBINE_8BIT(output[deinter[i % out_len]], input[i]);
     }
     return 0;
 #endif
@@ -576,12 +584,12 @@ int srsran_rm_turbo_rx_lut_sse(int16_t*  input,
 #define SAVE_OUTPUT_SSE_8(j)                                                                                           \
   x = (int8_t)_mm_extract_epi8(xVal, j);                                                                               \
   l = (uint16_t)_mm_extract_epi16(lutVal1, j);                                                                         \
-  output[l] += x;
+  RM_TURBO_COMBINE_8BIT(output[l], x);
 
 #define SAVE_OUTPUT_SSE_8_2(j)                                                                                         \
   x = (int8_t)_mm_extract_epi8(xVal, j + 8);                                                                           \
   l = (uint16_t)_mm_extract_epi16(lutVal2, j);                                                                         \
-  output[l] += x;
+  RM_TURBO_COMBINE_8BIT(output[l], x);
 
 int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -629,7 +637,7 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         SAVE_OUTPUT_SSE_8_2(7);
       }
       for (int i = 16 * (in_len / 16); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        RM_TURBO_COMBINE_8BIT(output[deinter[i % out_len]], input[i]);
       }
     } else {
       int intCnt   = 16;
@@ -667,12 +675,12 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
           /* Copy last elements */
           if ((out_len % 16) == 12) {
             for (int j = (nwrapps + 1) * out_len - 12; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              RM_TURBO_COMBINE_8BIT(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           } else {
             for (int j = (nwrapps + 1) * out_len - 4; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              RM_TURBO_COMBINE_8BIT(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           }
@@ -684,7 +692,7 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        RM_TURBO_COMBINE_8BIT(output[deinter[i % out_len]], input[i]);
       }
     }
 
@@ -813,12 +821,12 @@ int srsran_rm_turbo_rx_lut_avx(int16_t*  input,
 #define SAVE_OUTPUT8(j)                                                                                                \
   x = (int8_t)_mm256_extract_epi8(xVal, j);                                                                            \
   l = (uint16_t)_mm256_extract_epi16(lutVal1, j);                                                                      \
-  output[l] += x;
+  RM_TURBO_COMBINE_8BIT(output[l], x);
 
 #define SAVE_OUTPUT8_2(j)                                                                                              \
   x = (int8_t)_mm256_extract_epi8(xVal, j + 8);                                                                        \
   l = (uint16_t)_mm256_extract_epi16(lutVal2, j);                                                                      \
-  output[l] += x;
+  RM_TURBO_COMBINE_8BIT(output[l], x);
 
 int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -884,7 +892,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         SAVE_OUTPUT8_2(15);
       }
       for (int i = 32 * (in_len / 32); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        RM_TURBO_COMBINE_8BIT(output[deinter[i % out_len]], input[i]);
       }
     } else {
       printf("wraps not implemented!\n");
@@ -942,7 +950,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
           printf("warning rate matching wrapping remainder %d\n", out_len % 32);
           /* Copy last elements */
           for (int j = (nwrapps + 1) * out_len - (out_len % 32); j < (nwrapps + 1) * out_len; j++) {
-            output[deinter[j % out_len]] += input[j];
+            RM_TURBO_COMBINE_8BIT(output[deinter[j % out_len]], input[j]);
             inputCnt++;
           }
           /* And wrap pointers */
@@ -953,7 +961,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        RM_TURBO_COMBINE_8BIT(output[deinter[i % out_len]], input[i]);
       }
 #endif
     }
@@ -1925,6 +1925,388 @@ int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
   }
 }
 
+/************************************************
+ *
+ * LINEAR DETECTION WITH ONE FILTER PER PRB
+ *
+ **************************************************/
+
+#define PREDECODING_PRB_MIN 1e-9f
+
+#if SRSRAN_SIMD_CF_SIZE == 0
+
+/* Computes the ZF/MMSE filter W = inv(H' x H + No) x H' of a PRB, scaled so that the detected symbols are unbiased,
+ * and the SINR of every layer after detection */
+static void srsran_predecoding_prb_filter_gen(cf_t                  h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS],
+                                              cf_t                  w[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS],
+                                              float                 sinr[SRSRAN_MAX_LAYERS],
+                                              uint32_t              nof_rxant,
+                                              uint32_t              nof_layers,
+                                              srsran_mimo_decoder_t decoder,
+                                              float                 noise_estimate,
+                                              float                 norm)
+{
+  cf_t  a[SRSRAN_MAX_LAYERS][SRSRAN_MAX_LAYERS];
+  float no = (decoder == SRSRAN_MIMO_DECODER_MMSE) ? noise_estimate : 0.0f;
+
+  /* 1. A = H' x H + No, W = H' */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      a[i][j] = 0.0f;
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        a[i][j] += conjf(h[i][r]) * h[j][r];
+      }
+    }
+    a[i][i] += no;
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      w[i][r] = conjf(h[i][r]);
+    }
+  }
+
+  /* 2. W = inv(A) x W, by Gauss-Jordan elimination. A is Hermitian positive definite, no pivoting is needed */
+  for (uint32_t k = 0; k < nof_layers; k++) {
+    float p = 1.0f / SRSRAN_MAX(crealf(a[k][k]), PREDECODING_PRB_MIN);
+    for (uint32_t j = k + 1; j < nof_layers; j++) {
+      a[k][j] *= p;
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      w[k][r] *= p;
+    }
+    for (uint32_t i = 0; i < nof_layers; i++) {
+      if (i != k) {
+        cf_t f = a[i][k];
+        for (uint32_t j = k + 1; j < nof_layers; j++) {
+          a[i][j] -= f * a[k][j];
+        }
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          w[i][r] -= f * w[k][r];
+        }
+      }
+    }
+  }
+
+  /* 3. SINR and bias: the MMSE gain of layer l is (W x H)_ll = 1 - No * inv(A)_ll, ZF noise is No * |W_l|^2 */
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    float s = 0.0f;
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      s += (decoder == SRSRAN_MIMO_DECODER_MMSE) ? crealf(w[l][r] * h[l][r]) : crealf(w[l][r] * conjf(w[l][r]));
+    }
+    float scale = norm;
+    if (decoder == SRSRAN_MIMO_DECODER_MMSE) {
+      s       = SRSRAN_MIN(SRSRAN_MAX(s, PREDECODING_PRB_MIN), 1.0f - PREDECODING_PRB_MIN);
+      sinr[l] = s / (1.0f - s);
+      scale /= s;
+    } else {
+      sinr[l] = 1.0f / SRSRAN_MAX(noise_estimate * s, PREDECODING_PRB_MIN);
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      w[l][r] *= scale;
+    }
+  }
+}
+
+#endif /* SRSRAN_SIMD_CF_SIZE == 0 */
+
+#if SRSRAN_SIMD_CF_SIZE
+
+/* Reciprocal with one Newton-Raphson iteration, the plain estimate has 12 bits of precision at most */
+static inline simd_f_t srsran_predecoding_prb_rcp(simd_f_t a)
+{
+  simd_f_t r = srsran_simd_f_rcp(a);
+  return srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(a, r)));
+}
+
+/* The filters are computed with every lane in memory order, so srsran_simd_cf_re() and srsran_simd_cf_mul(), which
+ * follow the AVX2 lane order of srsran_simd_cfi_load(), cannot be used */
+static inline simd_f_t srsran_predecoding_prb_re(simd_cf_t a)
+{
+#ifdef HAVE_NEON
+  return a.val[0];
+#else  /* HAVE_NEON */
+  return a.re;
+#endif /* HAVE_NEON */
+}
+
+static inline simd_cf_t srsran_predecoding_prb_mul(simd_cf_t a, simd_f_t b)
+{
+#ifdef HAVE_NEON
+  a.val[0] = srsran_simd_f_mul(a.val[0], b);
+  a.val[1] = srsran_simd_f_mul(a.val[1], b);
+#else  /* HAVE_NEON */
+  a.re = srsran_simd_f_mul(a.re, b);
+  a.im = srsran_simd_f_mul(a.im, b);
+#endif /* HAVE_NEON */
+  return a;
+}
+
+static inline simd_f_t srsran_predecoding_prb_max(simd_f_t a, simd_f_t b)
+{
+  return srsran_simd_f_select(b, a, srsran_simd_f_max(a, b));
+}
+
+static inline simd_f_t srsran_predecoding_prb_min(simd_f_t a, simd_f_t b)
+{
+  return srsran_simd_f_select(b, a, srsran_simd_f_min(a, b));
+}
+
+/* Same as srsran_predecoding_prb_filter_gen for SRSRAN_SIMD_CF_SIZE PRBs at once, one per lane. The filters are
+ * stored as real and imaginary planes with one value per lane */
+static void srsran_predecoding_prb_filter_simd(const float*          h_re,
+                                               const float*          h_im,
+                                               float*                w_re,
+                                               float*                w_im,
+                                               float*                sinr,
+                                               uint32_t              nof_rxant,
+                                               uint32_t              nof_layers,
+                                               srsran_mimo_decoder_t decoder,
+                                               float                 noise_estimate,
+                                               float                 norm)
+{
+  simd_cf_t h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+  simd_cf_t w[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+  simd_cf_t a[SRSRAN_MAX_LAYERS][SRSRAN_MAX_LAYERS];
+  simd_f_t  noise = srsran_simd_f_set1(noise_estimate);
+  simd_f_t  no    = (decoder == SRSRAN_MIMO_DECODER_MMSE) ? noise : srsran_simd_f_zero();
+  simd_f_t  min   = srsran_simd_f_set1(PREDECODING_PRB_MIN);
+  simd_f_t  max   = srsran_simd_f_set1(1.0f - PREDECODING_PRB_MIN);
+  simd_f_t  one   = srsran_simd_f_set1(1.0f);
+  simd_f_t  zero  = srsran_simd_f_zero();
+
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      uint32_t offset = (l * SRSRAN_MAX_PORTS + r) * SRSRAN_SIMD_CF_SIZE;
+      h[l][r]         = srsran_simd_cf_load(&h_re[offset], &h_im[offset]);
+    }
+  }
+
+  /* 1. A = H' x H, W = H'. No is added to the diagonal when it is taken as pivot, it is not used before */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      a[i][j] = srsran_simd_cf_zero();
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        a[i][j] = srsran_simd_cf_add(a[i][j], srsran_simd_cf_conjprod(h[j][r], h[i][r]));
+      }
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      w[i][r] = srsran_simd_cf_conj(h[i][r]);
+    }
+  }
+
+  /* 2. W = inv(A) x W, by Gauss-Jordan elimination */
+  for (uint32_t k = 0; k < nof_layers; k++) {
+    simd_f_t p = srsran_simd_f_add(srsran_predecoding_prb_re(a[k][k]), no);
+    p          = srsran_predecoding_prb_rcp(srsran_predecoding_prb_max(p, min));
+    for (uint32_t j = k + 1; j < nof_layers; j++) {
+      a[k][j] = srsran_predecoding_prb_mul(a[k][j], p);
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      w[k][r] = srsran_predecoding_prb_mul(w[k][r], p);
+    }
+    for (uint32_t i = 0; i < nof_layers; i++) {
+      if (i != k) {
+        simd_cf_t f = a[i][k];
+        for (uint32_t j = k + 1; j < nof_layers; j++) {
+          a[i][j] = srsran_simd_cf_sub(a[i][j], srsran_simd_cf_prod(f, a[k][j]));
+        }
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          w[i][r] = srsran_simd_cf_sub(w[i][r], srsran_simd_cf_prod(f, w[k][r]));
+        }
+      }
+    }
+  }
+
+  /* 3. SINR and bias */
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    simd_f_t s = zero;
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      simd_cf_t p = (decoder == SRSRAN_MIMO_DECODER_MMSE) ? srsran_simd_cf_prod(w[l][r], h[l][r])
+                                                          : srsran_simd_cf_conjprod(w[l][r], w[l][r]);
+      s           = srsran_simd_f_add(s, srsran_predecoding_prb_re(p));
+    }
+    simd_f_t scale = srsran_simd_f_set1(norm);
+    simd_f_t snr;
+    if (decoder == SRSRAN_MIMO_DECODER_MMSE) {
+      s     = srsran_predecoding_prb_min(srsran_predecoding_prb_max(s, min), max);
+      snr   = srsran_simd_f_mul(s, srsran_predecoding_prb_rcp(srsran_simd_f_sub(one, s)));
+      scale = srsran_simd_f_mul(scale, srsran_predecoding_prb_rcp(s));
+    } else {
+      snr = srsran_predecoding_prb_rcp(srsran_predecoding_prb_max(srsran_simd_f_mul(noise, s), min));
+    }
+    srsran_simd_f_store(&sinr[l * SRSRAN_SIMD_CF_SIZE], snr);
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      uint32_t offset = (l * SRSRAN_MAX_PORTS + r) * SRSRAN_SIMD_CF_SIZE;
+      srsran_simd_cf_store(&w_re[offset], &w_im[offset], srsran_predecoding_prb_mul(w[l][r], scale));
+    }
+  }
+}
+
+/* Spreads the per PRB coefficients of a batch over the lanes of its vector v, lane j takes PRB idx[j]. AVX2 and
+ * AVX512 permute the lanes in a register, narrower vectors fall within one PRB and take a broadcast */
+static inline simd_cf_t srsran_predecoding_prb_spread(const float* re, const float* im, const int32_t* idx)
+{
+#ifdef LV_HAVE_AVX512
+  __m512i   i = _mm512_load_si512(idx);
+  simd_cf_t ret;
+  ret.re = _mm512_permutexvar_ps(i, _mm512_load_ps(re));
+  ret.im = _mm512_permutexvar_ps(i, _mm512_load_ps(im));
+  return ret;
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  __m256i   i = _mm256_load_si256((__m256i*)idx);
+  simd_cf_t ret;
+  ret.re = _mm256_permutevar8x32_ps(_mm256_load_ps(re), i);
+  ret.im = _mm256_permutevar8x32_ps(_mm256_load_ps(im), i);
+  return ret;
+#else  /* LV_HAVE_AVX2 */
+  return srsran_simd_cf_set1(re[idx[0]] + I * im[idx[0]]);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_f_t srsran_predecoding_prb_spread_f(const float* f, const int32_t* idx)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_permutexvar_ps(_mm512_load_si512(idx), _mm512_load_ps(f));
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_permutevar8x32_ps(_mm256_load_ps(f), _mm256_load_si256((__m256i*)idx));
+#else  /* LV_HAVE_AVX2 */
+  return srsran_simd_f_set1(f[idx[0]]);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+int srsran_predecoding_prb(cf_t*                 y[SRSRAN_MAX_PORTS],
+                           cf_t*                 h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS],
+                           cf_t*                 x[SRSRAN_MAX_LAYERS],
+                           float*                sinr[SRSRAN_MAX_LAYERS],
+                           uint32_t              nof_rxant,
+                           uint32_t              nof_layers,
+                           uint32_t              nof_re,
+                           srsran_mimo_decoder_t decoder,
+                           float                 scaling,
+                           float                 noise_estimate)
+{
+  if (y == NULL || h == NULL || x == NULL || scaling == 0.0f) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (nof_layers == 0 || nof_layers > SRSRAN_MAX_LAYERS || nof_rxant < nof_layers || nof_rxant > SRSRAN_MAX_PORTS) {
+    ERROR("Invalid number of layers %d for %d receive antennas", nof_layers, nof_rxant);
+    return SRSRAN_ERROR;
+  }
+
+  float norm     = 1.0f / scaling;
+  noise_estimate = SRSRAN_MAX(noise_estimate, PREDECODING_PRB_MIN);
+
+#if SRSRAN_SIMD_CF_SIZE
+  /* PRB of every lane of the vectors of a batch of SRSRAN_SIMD_CF_SIZE PRBs, in the lane order of
+   * srsran_simd_cfi_load(), which interleaves both halves of AVX2 vectors, and in memory order */
+  srsran_simd_aligned int32_t idx_cf[SRSRAN_NRE][SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned int32_t idx_f[SRSRAN_NRE][SRSRAN_SIMD_CF_SIZE];
+  for (uint32_t v = 0; v < SRSRAN_NRE; v++) {
+    for (uint32_t j = 0; j < SRSRAN_SIMD_CF_SIZE; j++) {
+      uint32_t k = j;
+#if defined(LV_HAVE_AVX2) && !defined(LV_HAVE_AVX512)
+      k = j / 2 + (j % 2) * (SRSRAN_SIMD_CF_SIZE / 2);
+#endif /* LV_HAVE_AVX2 && !LV_HAVE_AVX512 */
+      idx_cf[v][j] = (int32_t)((v * SRSRAN_SIMD_CF_SIZE + k) / SRSRAN_NRE);
+      idx_f[v][j]  = (int32_t)((v * SRSRAN_SIMD_CF_SIZE + j) / SRSRAN_NRE);
+    }
+  }
+
+  const uint32_t            batch_re = SRSRAN_NRE * SRSRAN_SIMD_CF_SIZE;
+  srsran_simd_aligned float h_re[SRSRAN_MAX_LAYERS * SRSRAN_MAX_PORTS * SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float h_im[SRSRAN_MAX_LAYERS * SRSRAN_MAX_PORTS * SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float w_re[SRSRAN_MAX_LAYERS * SRSRAN_MAX_PORTS * SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float w_im[SRSRAN_MAX_LAYERS * SRSRAN_MAX_PORTS * SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float s[SRSRAN_MAX_LAYERS * SRSRAN_SIMD_CF_SIZE];
+  for (uint32_t re0 = 0; re0 < nof_re; re0 += batch_re) {
+    /* 1. Take the channel of every PRB from its central RE, unused lanes see no channel at all */
+    for (uint32_t p = 0; p < SRSRAN_SIMD_CF_SIZE; p++) {
+      uint32_t k = SRSRAN_MIN(re0 + p * SRSRAN_NRE + SRSRAN_NRE / 2, nof_re - 1);
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          cf_t     v      = (re0 + p * SRSRAN_NRE < nof_re) ? h[l][r][k] : 0.0f;
+          uint32_t offset = (l * SRSRAN_MAX_PORTS + r) * SRSRAN_SIMD_CF_SIZE + p;
+          h_re[offset]    = crealf(v);
+          h_im[offset]    = cimagf(v);
+        }
+      }
+    }
+
+    /* 2. Compute the filters of the batch */
+    srsran_predecoding_prb_filter_simd(h_re, h_im, w_re, w_im, s, nof_rxant, nof_layers, decoder, noise_estimate, norm);
+
+    /* 3. X = W x Y, with the filter of every RE spread from its PRB lane */
+    uint32_t nof_vec = SRSRAN_MIN(SRSRAN_NRE, (nof_re - re0) / SRSRAN_SIMD_CF_SIZE);
+    for (uint32_t v = 0; v < nof_vec; v++) {
+      uint32_t  i = re0 + v * SRSRAN_SIMD_CF_SIZE;
+      simd_cf_t _y[SRSRAN_MAX_PORTS];
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        _y[r] = srsran_simd_cfi_loadu(&y[r][i]);
+      }
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        simd_cf_t _x = srsran_simd_cf_zero();
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          uint32_t  offset = (l * SRSRAN_MAX_PORTS + r) * SRSRAN_SIMD_CF_SIZE;
+          simd_cf_t _w     = srsran_predecoding_prb_spread(&w_re[offset], &w_im[offset], idx_cf[v]);
+          _x               = srsran_simd_cf_add(_x, srsran_simd_cf_prod(_w, _y[r]));
+        }
+        srsran_simd_cfi_storeu(&x[l][i], _x);
+        if (sinr != NULL) {
+          srsran_simd_f_storeu(&sinr[l][i], srsran_predecoding_prb_spread_f(&s[l * SRSRAN_SIMD_CF_SIZE], idx_f[v]));
+        }
+      }
+    }
+
+    /* 4. Remaining REs of the last batch */
+    for (uint32_t i = re0 + nof_vec * SRSRAN_SIMD_CF_SIZE; i < SRSRAN_MIN(re0 + batch_re, nof_re); i++) {
+      uint32_t p = (i - re0) / SRSRAN_NRE;
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        cf_t _x = 0.0f;
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          uint32_t offset = (l * SRSRAN_MAX_PORTS + r) * SRSRAN_SIMD_CF_SIZE + p;
+          _x += (w_re[offset] + I * w_im[offset]) * y[r][i];
+        }
+        x[l][i] = _x;
+        if (sinr != NULL) {
+          sinr[l][i] = s[l * SRSRAN_SIMD_CF_SIZE + p];
+        }
+      }
+    }
+  }
+#else  /* SRSRAN_SIMD_CF_SIZE */
+  for (uint32_t re0 = 0; re0 < nof_re; re0 += SRSRAN_NRE) {
+    cf_t     _h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+    cf_t     w[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+    float    s[SRSRAN_MAX_LAYERS];
+    uint32_t k = SRSRAN_MIN(re0 + SRSRAN_NRE / 2, nof_re - 1);
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        _h[l][r] = h[l][r][k];
+      }
+    }
+    srsran_predecoding_prb_filter_gen(_h, w, s, nof_rxant, nof_layers, decoder, noise_estimate, norm);
+    for (uint32_t i = re0; i < SRSRAN_MIN(re0 + SRSRAN_NRE, nof_re); i++) {
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        cf_t _x = 0.0f;
+        for (uint32_t r = 0; r < nof_rxant; r++) {
+          _x += w[l][r] * y[r][i];
+        }
+        x[l][i] = _x;
+        if (sinr != NULL) {
+          sinr[l][i] = s[l];
+        }
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  return SRSRAN_SUCCESS;
+}
+
 /************************************************
  *
  * TRANSMITTER SIDE FUNCTIONS
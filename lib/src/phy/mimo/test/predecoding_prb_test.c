@@ -0,0 +1,210 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+/* Bounds of the mean squared error of the detected symbols normalised by the SINR they are reported with */
+#define NORM_ERROR_MIN 0.9f
+#define NORM_ERROR_MAX 1.1f
+
+static uint32_t              nof_re          = 273 * SRSRAN_NRE;
+static uint32_t              nof_layers      = 2;
+static uint32_t              nof_rxant       = 2;
+static uint32_t              nof_repetitions = 1;
+static srsran_mimo_decoder_t decoder         = SRSRAN_MIMO_DECODER_MMSE;
+static float                 snr_db          = 10.0f;
+static float                 scaling         = 0.5f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [lrndsgR]\n", prog);
+  printf("\t-l nof_layers [Default %d]\n", nof_layers);
+  printf("\t-r nof_rxant [Default %d]\n", nof_rxant);
+  printf("\t-n nof_re [Default %d]\n", nof_re);
+  printf("\t-d decoder type [zf|mmse] [Default mmse]\n");
+  printf("\t-s SNR in dB [Default %.1fdB]\n", snr_db);
+  printf("\t-g Scaling [Default %.1f]\n", scaling);
+  printf("\t-R Number of repetitions for measuring the throughput [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "lrndsgR")) != -1) {
+    switch (opt) {
+      case 'l':
+        nof_layers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_rxant = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_re = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        if (strcmp(argv[optind], "zf") == 0) {
+          decoder = SRSRAN_MIMO_DECODER_ZF;
+        } else if (strcmp(argv[optind], "mmse") == 0) {
+          decoder = SRSRAN_MIMO_DECODER_MMSE;
+        } else {
+          usage(argv[0]);
+          exit(-1);
+        }
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'g':
+        scaling = strtof(argv[optind], NULL);
+        break;
+      case 'R':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int    ret                                    = SRSRAN_ERROR;
+  cf_t*  x[SRSRAN_MAX_LAYERS]                   = {};
+  cf_t*  xr[SRSRAN_MAX_LAYERS]                  = {};
+  cf_t*  y[SRSRAN_MAX_PORTS]                    = {};
+  cf_t*  h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS] = {};
+  float* sinr[SRSRAN_MAX_LAYERS]                = {};
+
+  parse_args(argc, argv);
+
+  if (nof_layers == 0 || nof_layers > SRSRAN_MAX_LAYERS || nof_rxant < nof_layers || nof_rxant > SRSRAN_MAX_PORTS) {
+    ERROR("Invalid number of layers (%d) or receive antennas (%d)", nof_layers, nof_rxant);
+    exit(-1);
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    x[l]    = srsran_vec_cf_malloc(nof_re);
+    xr[l]   = srsran_vec_cf_malloc(nof_re);
+    sinr[l] = srsran_vec_f_malloc(nof_re);
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      h[l][r] = srsran_vec_cf_malloc(nof_re);
+    }
+  }
+  for (uint32_t r = 0; r < nof_rxant; r++) {
+    y[r] = srsran_vec_cf_malloc(nof_re);
+  }
+
+  /* Generate QPSK symbols and a Rayleigh channel which is flat within every PRB */
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    for (uint32_t i = 0; i < nof_re; i++) {
+      __real__ x[l][i] = (2 * srsran_random_uniform_int_dist(random_gen, 0, 1) - 1) * M_SQRT1_2;
+      __imag__ x[l][i] = (2 * srsran_random_uniform_int_dist(random_gen, 0, 1) - 1) * M_SQRT1_2;
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      for (uint32_t i = 0; i < nof_re; i += SRSRAN_NRE) {
+        cf_t hprb     = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+        __imag__ hprb = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+        for (uint32_t k = i; k < SRSRAN_MIN(i + SRSRAN_NRE, nof_re); k++) {
+          h[l][r][k] = hprb;
+        }
+      }
+    }
+  }
+
+  /* Pass the signal through the channel and add noise */
+  float noise_estimate = srsran_convert_dB_to_power(-snr_db);
+  for (uint32_t r = 0; r < nof_rxant; r++) {
+    for (uint32_t i = 0; i < nof_re; i++) {
+      y[r][i] = 0.0f;
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        y[r][i] += h[l][r][i] * x[l][i] * scaling;
+      }
+    }
+    srsran_ch_awgn_c(y[r], y[r], noise_estimate * scaling * scaling, nof_re);
+  }
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (uint32_t n = 0; n < nof_repetitions; n++) {
+    if (srsran_predecoding_prb(y, h, xr, sinr, nof_rxant, nof_layers, nof_re, decoder, scaling, noise_estimate) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error in predecoding");
+      goto quit;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  /* The detection error of every RE is normalised by the noise variance 1 / SINR reported for it */
+  double norm_error = 0.0;
+  double mse        = 0.0;
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    for (uint32_t i = 0; i < nof_re; i++) {
+      float e = crealf((xr[l][i] - x[l][i]) * conjf(xr[l][i] - x[l][i]));
+      mse        += e;
+      norm_error += e * sinr[l][i];
+    }
+  }
+  mse        /= nof_layers * nof_re;
+  norm_error /= nof_layers * nof_re;
+
+  double elapsed_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+  printf("%dx%d %s; SNR: %4.1fdB; MSE: %.4f; Normalised error: %.3f; Throughput: %.1f MRE/s\n",
+         nof_rxant,
+         nof_layers,
+         decoder == SRSRAN_MIMO_DECODER_ZF ? "zf" : "mmse",
+         snr_db,
+         mse,
+         norm_error,
+         (double)nof_re * nof_repetitions / elapsed_us);
+
+  if (norm_error >= NORM_ERROR_MIN && norm_error <= NORM_ERROR_MAX) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+quit:
+  srsran_random_free(random_gen);
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    free(x[l]);
+    free(xr[l]);
+    free(sinr[l]);
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      free(h[l][r]);
+    }
+  }
+  for (uint32_t r = 0; r < nof_rxant; r++) {
+    free(y[r]);
+  }
+
+  exit(ret);
+}
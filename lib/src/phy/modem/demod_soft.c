@@ -76,6 +76,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -777,6 +781,217 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 #endif
 }
 
+/*
+ * Maximum number of amplitude bits per dimension of the square QAM demappers below, 5 for 1024QAM
+ */
+#define DEMOD_QAM_MAX_LEVELS 5
+
+/*
+ * Smallest noise variance used to scale the LLRs, it avoids dividing by zero
+ */
+#define DEMOD_QAM_MIN_NOISE_VAR 1e-9f
+
+/*
+ * Layered demapper of the square QAM constellations with nof_levels amplitude bits per dimension. As in the float
+ * demodulators above, the first level is -y and every following one is the absolute value of the previous level minus
+ * offset[level]. Every LLR is multiplied by gain, divided by the noise variance of its RE if noise_var is not NULL,
+ * rounded and saturated to int8.
+ */
+static inline int8_t demod_qam_llr_b(float v, float g)
+{
+  float llr = v * g;
+  llr       = SRSRAN_MIN(SRSRAN_MAX(llr, -127.0f), 127.0f);
+  return (int8_t)rintf(llr);
+}
+
+static void demod_qam_b_generic(const cf_t*  symbols,
+                                const float* noise_var,
+                                float        gain,
+                                const float* offset,
+                                uint32_t     nof_levels,
+                                int8_t*      llr,
+                                int          nsymbols)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    float g    = (noise_var != NULL) ? gain / SRSRAN_MAX(noise_var[i], DEMOD_QAM_MIN_NOISE_VAR) : gain;
+    float real = -__real__ symbols[i];
+    float imag = -__imag__ symbols[i];
+    *(llr++)   = demod_qam_llr_b(real, g);
+    *(llr++)   = demod_qam_llr_b(imag, g);
+    for (uint32_t level = 1; level < nof_levels; level++) {
+      real     = fabsf(real) - offset[level];
+      imag     = fabsf(imag) - offset[level];
+      *(llr++) = demod_qam_llr_b(real, g);
+      *(llr++) = demod_qam_llr_b(imag, g);
+    }
+  }
+}
+
+/*
+ * The SIMD demappers compute the LLRs in their output order, for blocks of as many symbols as lanes. The LLRs of the
+ * first and the second half of a block fill a whole number of registers, so every register of LLRs takes its symbol
+ * components from one of the two halves with a permutation and applies to every lane the levels up to its own. They
+ * return the number of demodulated symbols.
+ */
+#ifdef LV_HAVE_AVX512
+static int demod_qam_b_avx512(const cf_t*  symbols,
+                              const float* noise_var,
+                              float        gain,
+                              const float* offset,
+                              uint32_t     nof_levels,
+                              int8_t*      llr,
+                              int          nsymbols)
+{
+  uint32_t nof_llr_symbol = 2 * nof_levels;
+  uint32_t nof_chunks     = nof_llr_symbol;
+
+  __m512i   idx_y[2 * DEMOD_QAM_MAX_LEVELS];
+  __m512i   idx_g[2 * DEMOD_QAM_MAX_LEVELS];
+  __mmask16 mask[2 * DEMOD_QAM_MAX_LEVELS][DEMOD_QAM_MAX_LEVELS] = {};
+  for (uint32_t c = 0; c < nof_chunks; c++) {
+    int32_t y[16];
+    int32_t g[16];
+    for (uint32_t l = 0; l < 16; l++) {
+      uint32_t o     = 16 * c + l;
+      uint32_t s     = o / nof_llr_symbol;
+      uint32_t level = (o % nof_llr_symbol) / 2;
+      y[l]           = (int32_t)((2 * s + o % 2) % 16);
+      g[l]           = (int32_t)s;
+      for (uint32_t t = 1; t <= level; t++) {
+        mask[c][t] |= (__mmask16)(1U << l);
+      }
+    }
+    idx_y[c] = _mm512_loadu_si512(y);
+    idx_g[c] = _mm512_loadu_si512(g);
+  }
+
+  const __m512i sign     = _mm512_set1_epi32((int32_t)0x80000000);
+  const __m512  max_llr  = _mm512_set1_ps(127.0f);
+  const __m512  min_llr  = _mm512_set1_ps(-127.0f);
+  const __m512  min_nvar = _mm512_set1_ps(DEMOD_QAM_MIN_NOISE_VAR);
+  const __m512  gain_v   = _mm512_set1_ps(gain);
+  int           i        = 0;
+  for (; i + 16 <= nsymbols; i += 16) {
+    __m512  y[2] = {_mm512_loadu_ps((const float*)(symbols + i)), _mm512_loadu_ps((const float*)(symbols + i + 8))};
+    __m512  g    = gain_v;
+    int8_t* out  = llr + i * nof_llr_symbol;
+    if (noise_var != NULL) {
+      g = _mm512_div_ps(gain_v, _mm512_max_ps(_mm512_loadu_ps(noise_var + i), min_nvar));
+    }
+    for (uint32_t c = 0; c < nof_chunks; c++) {
+      __m512 v = _mm512_permutexvar_ps(idx_y[c], y[c / nof_levels]);
+      v        = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(v), sign));
+      for (uint32_t t = 1; t < nof_levels; t++) {
+        v = _mm512_mask_blend_ps(mask[c][t], v, _mm512_sub_ps(_mm512_abs_ps(v), _mm512_set1_ps(offset[t])));
+      }
+      v = _mm512_mul_ps(v, _mm512_permutexvar_ps(idx_g[c], g));
+      v = _mm512_min_ps(_mm512_max_ps(v, min_llr), max_llr);
+      _mm_storeu_si128((__m128i*)(out + 16 * c), _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(v)));
+    }
+  }
+
+  return i;
+}
+#endif // LV_HAVE_AVX512
+
+#ifdef LV_HAVE_AVX2
+static int demod_qam_b_avx2(const cf_t*  symbols,
+                            const float* noise_var,
+                            float        gain,
+                            const float* offset,
+                            uint32_t     nof_levels,
+                            int8_t*      llr,
+                            int          nsymbols)
+{
+  uint32_t nof_llr_symbol = 2 * nof_levels;
+  uint32_t nof_chunks     = nof_llr_symbol;
+
+  __m256i idx_y[2 * DEMOD_QAM_MAX_LEVELS];
+  __m256i idx_g[2 * DEMOD_QAM_MAX_LEVELS];
+  __m256  mask[2 * DEMOD_QAM_MAX_LEVELS][DEMOD_QAM_MAX_LEVELS];
+  for (uint32_t c = 0; c < nof_chunks; c++) {
+    int32_t y[8];
+    int32_t g[8];
+    int32_t m[DEMOD_QAM_MAX_LEVELS][8];
+    for (uint32_t l = 0; l < 8; l++) {
+      uint32_t o     = 8 * c + l;
+      uint32_t s     = o / nof_llr_symbol;
+      uint32_t level = (o % nof_llr_symbol) / 2;
+      y[l]           = (int32_t)((2 * s + o % 2) % 8);
+      g[l]           = (int32_t)s;
+      for (uint32_t t = 1; t < nof_levels; t++) {
+        m[t][l] = (t <= level) ? -1 : 0;
+      }
+    }
+    idx_y[c] = _mm256_loadu_si256((__m256i*)y);
+    idx_g[c] = _mm256_loadu_si256((__m256i*)g);
+    for (uint32_t t = 1; t < nof_levels; t++) {
+      mask[c][t] = _mm256_castsi256_ps(_mm256_loadu_si256((__m256i*)m[t]));
+    }
+  }
+
+  const __m256 sign     = _mm256_set1_ps(-0.0f);
+  const __m256 max_llr  = _mm256_set1_ps(127.0f);
+  const __m256 min_llr  = _mm256_set1_ps(-127.0f);
+  const __m256 min_nvar = _mm256_set1_ps(DEMOD_QAM_MIN_NOISE_VAR);
+  const __m256 gain_v   = _mm256_set1_ps(gain);
+  int          i        = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m256  y[2] = {_mm256_loadu_ps((const float*)(symbols + i)), _mm256_loadu_ps((const float*)(symbols + i + 4))};
+    __m256  g    = gain_v;
+    int8_t* out  = llr + i * nof_llr_symbol;
+    if (noise_var != NULL) {
+      g = _mm256_div_ps(gain_v, _mm256_max_ps(_mm256_loadu_ps(noise_var + i), min_nvar));
+    }
+    for (uint32_t c = 0; c < nof_chunks; c++) {
+      __m256 v = _mm256_xor_ps(_mm256_permutevar8x32_ps(y[c / nof_levels], idx_y[c]), sign);
+      for (uint32_t t = 1; t < nof_levels; t++) {
+        v = _mm256_blendv_ps(v, _mm256_sub_ps(_mm256_andnot_ps(sign, v), _mm256_set1_ps(offset[t])), mask[c][t]);
+      }
+      v           = _mm256_mul_ps(v, _mm256_permutevar8x32_ps(g, idx_g[c]));
+      v           = _mm256_min_ps(_mm256_max_ps(v, min_llr), max_llr);
+      __m256i v32 = _mm256_cvtps_epi32(v);
+      __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v32), _mm256_extracti128_si256(v32, 1));
+      _mm_storel_epi64((__m128i*)(out + 8 * c), _mm_packs_epi16(v16, v16));
+    }
+  }
+
+  return i;
+}
+#endif // LV_HAVE_AVX2
+
+static void
+demod_qam_b(const cf_t* symbols, const float* noise_var, float gain, uint32_t nof_levels, int8_t* llr, int nsymbols)
+{
+  // Half of the amplitude range of every level, for unit average power
+  float offset[DEMOD_QAM_MAX_LEVELS] = {};
+  float norm                         = 2.0f * (float)((1U << (2 * nof_levels)) - 1) / 3.0f;
+  for (uint32_t level = 1; level < nof_levels; level++) {
+    offset[level] = (float)(1U << (nof_levels - level)) / sqrtf(norm);
+  }
+
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_qam_b_avx512(symbols, noise_var, gain, offset, nof_levels, llr, nsymbols);
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  i += demod_qam_b_avx2(symbols + i,
+                        (noise_var != NULL) ? noise_var + i : NULL,
+                        gain,
+                        offset,
+                        nof_levels,
+                        llr + 2 * nof_levels * i,
+                        nsymbols - i);
+#endif // LV_HAVE_AVX2
+  demod_qam_b_generic(symbols + i,
+                      (noise_var != NULL) ? noise_var + i : NULL,
+                      gain,
+                      offset,
+                      nof_levels,
+                      llr + 2 * nof_levels * i,
+                      nsymbols - i);
+}
+
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
@@ -801,24 +1016,7 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 
 void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-  }
+  demod_qam_b(symbols, NULL, SCALE_BYTE_CONV_QAM256, 4, llr, nsymbols);
 }
 
 void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
@@ -917,3 +1115,46 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+int srsran_demod_soft_demodulate_nvar_b(srsran_mod_t modulation,
+                                        const cf_t*  symbols,
+                                        const float* noise_var,
+                                        int8_t*      llr,
+                                        int          nsymbols)
+{
+  if (symbols == NULL || noise_var == NULL || llr == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The max-log LLR of a bit is 4 * a * d / noise_var, where d is the layered distance of the float demodulators and
+  // 2 * a the distance between two consecutive amplitudes
+  uint32_t nof_levels = 0;
+  switch (modulation) {
+    case SRSRAN_MOD_BPSK:
+      for (int i = 0; i < nsymbols; i++) {
+        float g = 4.0f * SRSRAN_DEMOD_SOFT_LLR_SCALE / SRSRAN_MAX(noise_var[i], DEMOD_QAM_MIN_NOISE_VAR);
+        llr[i]  = demod_qam_llr_b(-(crealf(symbols[i]) + cimagf(symbols[i])) * (float)M_SQRT1_2, g);
+      }
+      return SRSRAN_SUCCESS;
+    case SRSRAN_MOD_QPSK:
+      nof_levels = 1;
+      break;
+    case SRSRAN_MOD_16QAM:
+      nof_levels = 2;
+      break;
+    case SRSRAN_MOD_64QAM:
+      nof_levels = 3;
+      break;
+    case SRSRAN_MOD_256QAM:
+      nof_levels = 4;
+      break;
+    default:
+      ERROR("Invalid modulation %d", modulation);
+      return SRSRAN_ERROR;
+  }
+
+  float norm = 2.0f * (float)((1U << (2 * nof_levels)) - 1) / 3.0f;
+  demod_qam_b(symbols, noise_var, 4.0f * SRSRAN_DEMOD_SOFT_LLR_SCALE / sqrtf(norm), nof_levels, llr, nsymbols);
+
+  return SRSRAN_SUCCESS;
+}
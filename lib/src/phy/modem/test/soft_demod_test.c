@@ -36,7 +36,7 @@ static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
   printf("\t-v srsran_verbose [Default None]\n");
@@ -118,6 +118,8 @@ int main(int argc, char** argv)
   float*               llr;
   short*               llr_s;
   int8_t*              llr_b;
+  int8_t*              llr_nvar;
+  float*               noise_var;
 
   parse_args(argc, argv);
 
@@ -165,6 +167,26 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  llr_nvar = srsran_vec_i8_malloc(num_bits);
+  if (!llr_nvar) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  noise_var = srsran_vec_f_malloc(num_bits / mod.nbits_x_symbol);
+  if (!noise_var) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  // Gain of the max-log LLR over the float demodulator output
+  float nvar_gain = 4.0f * SRSRAN_DEMOD_SOFT_LLR_SCALE;
+  if (modulation == SRSRAN_MOD_QPSK) {
+    nvar_gain *= 0.5f;
+  } else if (modulation != SRSRAN_MOD_BPSK) {
+    nvar_gain /= sqrtf(2.0f * (float)((1U << mod.nbits_x_symbol) - 1) / 3.0f);
+  }
+
   /* generate random data */
   srand(0);
 
@@ -173,6 +195,7 @@ int main(int argc, char** argv)
   float          mean_texec   = 0.0;
   float          mean_texec_s = 0.0;
   float          mean_texec_b = 0.0;
+  float          mean_texec_n = 0.0;
   for (int n = 0; n < nof_frames; n++) {
     for (i = 0; i < num_bits; i++) {
       input[i] = rand() % 2;
@@ -181,6 +204,10 @@ int main(int argc, char** argv)
     /* modulate */
     srsran_mod_modulate(&mod, input, symbols, num_bits);
 
+    for (i = 0; i < num_bits / mod.nbits_x_symbol; i++) {
+      noise_var[i] = 0.01f + (float)rand() / (float)RAND_MAX;
+    }
+
     gettimeofday(&t[1], NULL);
     srsran_demod_soft_demodulate(modulation, symbols, llr, num_bits / mod.nbits_x_symbol);
     gettimeofday(&t[2], NULL);
@@ -209,6 +236,15 @@ int main(int argc, char** argv)
       mean_texec_b = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec_b, n - 1);
     }
 
+    gettimeofday(&t[1], NULL);
+    srsran_demod_soft_demodulate_nvar_b(modulation, symbols, noise_var, llr_nvar, num_bits / mod.nbits_x_symbol);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    if (n > 0) {
+      mean_texec_n = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec_n, n - 1);
+    }
+
     if (SRSRAN_VERBOSE_ISDEBUG()) {
       printf("bits=");
       srsran_vec_fprint_b(stdout, input, num_bits);
@@ -224,6 +260,9 @@ int main(int argc, char** argv)
 
       printf("llr_b=");
       srsran_vec_fprint_bs(stdout, llr_b, num_bits);
+
+      printf("llr_nvar=");
+      srsran_vec_fprint_bs(stdout, llr_nvar, num_bits);
     }
 
     // Check demodulation errors
@@ -233,10 +272,22 @@ int main(int argc, char** argv)
         goto clean_exit;
       }
     }
+
+    // Check the LLR scaled by the noise variance against the float demodulator, up to the rounding
+    for (int i = 0; i < num_bits; i++) {
+      float expected = nvar_gain * llr[i] / noise_var[i / mod.nbits_x_symbol];
+      expected       = roundf(SRSRAN_MIN(SRSRAN_MAX(expected, -127.0f), 127.0f));
+      if (fabsf(expected - llr_nvar[i]) > 1.0f) {
+        printf("Error in LLR %d: %d, expected %.0f\n", i, llr_nvar[i], expected);
+        goto clean_exit;
+      }
+    }
   }
   ret = 0;
 
 clean_exit:
+  free(noise_var);
+  free(llr_nvar);
   free(llr_b);
   free(llr_s);
   free(llr);
@@ -246,12 +297,15 @@ clean_exit:
 
   srsran_modem_table_free(&mod);
 
-  printf("Mean Throughput: %.2f/%.2f/%.2f. Mbps ExTime: %.2f/%.2f/%.2f us\n",
+  printf("Mean Throughput (float/short/byte/byte with noise variance): %.2f/%.2f/%.2f/%.2f. Mbps ExTime: "
+         "%.2f/%.2f/%.2f/%.2f us\n",
          num_bits / mean_texec,
          num_bits / mean_texec_s,
          num_bits / mean_texec_b,
+         num_bits / mean_texec_n,
          mean_texec,
          mean_texec_s,
-         mean_texec_b);
+         mean_texec_b,
+         mean_texec_n);
   exit(ret);
 }
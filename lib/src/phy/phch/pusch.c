@@ -160,6 +160,11 @@ static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
         ERROR("Allocating EVM buffer");
         goto clean;
       }
+
+      if (srsran_sequence_cache_init(&q->scrambling_cache, SRSRAN_PUSCH_SCRAMBLING_CACHE_SIZE) < SRSRAN_SUCCESS) {
+        ERROR("Error initiating scrambling cache");
+        goto clean;
+      }
     }
     q->z = srsran_vec_cf_malloc(q->max_re);
     if (!q->z) {
@@ -207,6 +212,7 @@ void srsran_pusch_free(srsran_pusch_t* q)
   if (q->evm_buffer) {
     srsran_evm_free(q->evm_buffer);
   }
+  srsran_sequence_cache_free(&q->scrambling_cache);
   srsran_dft_precoding_free(&q->dft_precoding);
 
   for (i = 0; i < SRSRAN_MOD_NITEMS; i++) {
@@ -432,19 +438,18 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
       out->evm = NAN;
     }
 
-    // Descrambling
+    // Descrambling, the sequence is cached as it is used twice and repeats every radio frame for every UE
+    uint32_t seed = srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_c(&q->scrambling_cache, q->q, q->q, cfg->grant.tb.nof_bits, seed);
     } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_s(&q->scrambling_cache, q->q, q->q, cfg->grant.tb.nof_bits, seed);
     }
 
     // Generate packed sequence for UCI decoder
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    srsran_vec_u8_zero(c, cfg->grant.tb.nof_bits);
+    srsran_sequence_cache_apply_bit(&q->scrambling_cache, c, c, cfg->grant.tb.nof_bits, seed);
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
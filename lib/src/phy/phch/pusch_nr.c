@@ -139,6 +139,11 @@ int srsran_pusch_nr_init_gnb(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t*
     }
   }
 
+  if (srsran_sequence_cache_init(&q->scrambling_cache, SRSRAN_PUSCH_NR_SCRAMBLING_CACHE_SIZE) < SRSRAN_SUCCESS) {
+    ERROR("Initialising scrambling cache");
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -246,6 +251,8 @@ void srsran_pusch_nr_free(srsran_pusch_nr_t* q)
     srsran_evm_free(q->evm_buffer);
   }
 
+  srsran_sequence_cache_free(&q->scrambling_cache);
+
   SRSRAN_MEM_ZERO(q, srsran_pusch_nr_t, 1);
 }
 
@@ -852,7 +859,8 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  srsran_sequence_cache_apply_c(&q->scrambling_cache, llr, llr, nof_bits, cinit);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -385,6 +385,12 @@ bool decode_tb_cb(srsran_sch_t*           q,
     return false;
   }
 
+  // 8-bit soft-buffers can only be combined with 8-bit LLRs
+  if (softbuffer->llr_is_8bit && !q->llr_is_8bit) {
+    ERROR("Error 8-bit soft-buffer requires 8-bit LLR decoding");
+    return false;
+  }
+
   q->avg_iterations = 0;
 
   for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
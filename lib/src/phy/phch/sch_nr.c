@@ -28,10 +28,54 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <semaphore.h>
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
 #define SCH_INFO_RX(...) INFO("SCH Rx: " __VA_ARGS__)
 
+/**
+ * @brief Code blocks of a transport block that need decoding
+ */
+typedef struct {
+  const srsran_sch_nr_tb_info_t* cfg;
+  const srsran_sch_tb_t*         tb;
+  uint32_t                       nof_cb;                                ///< Number of code blocks to decode
+  uint32_t                       cb_idx[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];  ///< Code block index within the TB
+  int8_t*                        cb_llr[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];  ///< Rate matched code block LLRs
+  uint32_t                       cb_E[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];    ///< Rate matched code block length
+  uint32_t                       cb_iter[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC]; ///< Resulting number of LDPC iterations
+} sch_nr_decoder_job_t;
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t pthread;
+  uint32_t  idx;
+  void*     pool_ptr;
+
+  /* Decoder with its own LDPC decoders, rate matcher, CRCs and temporal buffer */
+  srsran_sch_nr_t sch;
+
+  /* Execution status */
+  int ret_status;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} sch_nr_decoder_worker_t;
+
+typedef struct {
+  uint32_t                 nof_workers;
+  sch_nr_decoder_worker_t* workers;
+
+  /* Code blocks being decoded: it must be set before posting the start semaphores */
+  sch_nr_decoder_job_t* job;
+} sch_nr_decoder_pool_t;
+
 srsran_basegraph_t srsran_sch_nr_select_basegraph(uint32_t tbs, double R)
 {
   // if A ≤ 292 , or if A ≤ 3824 and R ≤ 0.67 , or if R ≤ 0 . 25 , LDPC base graph 2 is used;
@@ -280,6 +324,203 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+static int sch_nr_decode_cb(srsran_sch_nr_t*               q,
+                            const srsran_sch_nr_tb_info_t* cfg,
+                            const srsran_sch_tb_t*         tb,
+                            uint32_t                       r,
+                            int8_t*                        input_ptr,
+                            uint32_t                       E,
+                            uint32_t*                      n_iter)
+{
+  srsran_ldpc_decoder_t* decoder   = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+  int8_t*                rm_buffer = (int8_t*)tb->softbuffer.rx->buffer_f[r];
+
+  // LDPC Rate matching
+  SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+              r,
+              E,
+              cfg->F,
+              cfg->bg == BG1 ? 1 : 2,
+              cfg->Z,
+              tb->rv,
+              cfg->Qm,
+              cfg->Nref);
+  int n_llr =
+      srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return SRSRAN_ERROR;
+  }
+
+  // Select CB or TB early stop CRC
+  srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+  if (cfg->L_cb) {
+    crc = &q->crc_cb;
+  }
+
+  // Decode. if CRC=KO, then ret=0
+  int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  // Compute number of iterations
+  *n_iter = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+
+  // Check if CB is all zeros
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  tb->softbuffer.rx->cb_crc[r] = (ret != 0);
+  SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, *n_iter, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+  // CB Debug trace
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("CB %d/%d:", r, cfg->C);
+    srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
+  }
+
+  // Pack only if CRC is match
+  if (tb->softbuffer.rx->cb_crc[r]) {
+    srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Decodes every nof_shares-th code block of a job, starting from share_idx
+ */
+static int
+sch_nr_decode_cb_share(srsran_sch_nr_t* q, sch_nr_decoder_job_t* job, uint32_t share_idx, uint32_t nof_shares)
+{
+  for (uint32_t k = share_idx; k < job->nof_cb; k += nof_shares) {
+    if (sch_nr_decode_cb(q, job->cfg, job->tb, job->cb_idx[k], job->cb_llr[k], job->cb_E[k], &job->cb_iter[k]) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void* sch_nr_decoder_worker_thread(void* arg)
+{
+  sch_nr_decoder_worker_t* w    = (sch_nr_decoder_worker_t*)arg;
+  sch_nr_decoder_pool_t*   pool = (sch_nr_decoder_pool_t*)w->pool_ptr;
+
+  sem_wait(&w->start);
+  while (!w->quit) {
+    // The calling thread takes the first share
+    w->ret_status = sch_nr_decode_cb_share(&w->sch, pool->job, w->idx + 1, pool->nof_workers + 1);
+
+    /* Post finish semaphore */
+    sem_post(&w->finish);
+
+    /* Wait for next job */
+    sem_wait(&w->start);
+  }
+
+  return NULL;
+}
+
+static void sch_nr_decoder_pool_free(srsran_sch_nr_t* q)
+{
+  sch_nr_decoder_pool_t* pool = (sch_nr_decoder_pool_t*)q->workers_ptr;
+  if (pool == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    sch_nr_decoder_worker_t* w = &pool->workers[i];
+    if (w->started) {
+      /* Stop thread */
+      w->quit = true;
+      sem_post(&w->start);
+      pthread_join(w->pthread, NULL);
+
+      sem_destroy(&w->start);
+      sem_destroy(&w->finish);
+    }
+    srsran_sch_nr_free(&w->sch);
+  }
+
+  free(pool->workers);
+  free(pool);
+  q->workers_ptr = NULL;
+}
+
+static int sch_nr_decoder_pool_init(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+{
+  sch_nr_decoder_pool_t* pool = calloc(1, sizeof(sch_nr_decoder_pool_t));
+  if (pool == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  q->workers_ptr = pool;
+
+  pool->workers = calloc(args->nof_decoder_workers, sizeof(sch_nr_decoder_worker_t));
+  if (pool->workers == NULL) {
+    ERROR("Error: calloc");
+    return SRSRAN_ERROR;
+  }
+  pool->nof_workers = args->nof_decoder_workers;
+
+  // Workers decode sequentially with the same decoder configuration
+  srsran_sch_nr_args_t worker_args = *args;
+  worker_args.nof_decoder_workers  = 0;
+
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    sch_nr_decoder_worker_t* w = &pool->workers[i];
+    w->idx                     = i;
+    w->pool_ptr                = pool;
+
+    if (srsran_sch_nr_init_rx(&w->sch, &worker_args) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising SCH decoder worker %d", i);
+      return SRSRAN_ERROR;
+    }
+
+    if (sem_init(&w->start, 0, 0) || sem_init(&w->finish, 0, 0)) {
+      ERROR("Error: creating semaphore");
+      return SRSRAN_ERROR;
+    }
+
+    if (pthread_create(&w->pthread, NULL, sch_nr_decoder_worker_thread, w)) {
+      ERROR("Error: creating SCH decoder worker %d", i);
+      sem_destroy(&w->start);
+      sem_destroy(&w->finish);
+      return SRSRAN_ERROR;
+    }
+    w->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int sch_nr_decoder_pool_run(srsran_sch_nr_t* q, sch_nr_decoder_pool_t* pool, sch_nr_decoder_job_t* job)
+{
+  // Wake up only as many workers as there are code blocks to share
+  uint32_t nof_workers = SRSRAN_MIN(pool->nof_workers, job->nof_cb - 1);
+
+  pool->job = job;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    sem_post(&pool->workers[i].start);
+  }
+
+  // Decode the first share in the calling thread
+  int ret = sch_nr_decode_cb_share(q, job, 0, pool->nof_workers + 1);
+
+  // Join before the TB CRC
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    sem_wait(&pool->workers[i].finish);
+    if (pool->workers[i].ret_status < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  return ret;
+}
+
 int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 {
   int ret = sch_nr_init_common(q);
@@ -356,6 +597,13 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  if (args->nof_decoder_workers > 0 && q->workers_ptr == NULL) {
+    if (sch_nr_decoder_pool_init(q, args) < SRSRAN_SUCCESS) {
+      ERROR("Error: initialising %d SCH decoder workers", args->nof_decoder_workers);
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -377,6 +625,8 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  sch_nr_decoder_pool_free(q);
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -603,25 +853,20 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
-  // Counter of code blocks that have matched CRC
-  uint32_t cb_ok = 0;
-  res->crc       = false;
-
-  // For each code block...
-  uint32_t j = 0;
+  // Select the code blocks to decode and their input LLRs
+  sch_nr_decoder_job_t job = {};
+  job.cfg                  = &cfg;
+  job.tb                   = tb;
+  uint32_t j               = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
-    bool    decoded   = tb->softbuffer.rx->cb_crc[r];
-    int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
-    if (!rm_buffer) {
+    bool decoded = tb->softbuffer.rx->cb_crc[r];
+    if (!tb->softbuffer.rx->buffer_f[r]) {
       ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
       return SRSRAN_ERROR;
     }
 
     // Skip CB if mask indicates no transmission of the CB
     if (!cfg.mask[r]) {
-      if (decoded) {
-        cb_ok++;
-      }
       SCH_INFO_RX("RM CB %d: Disabled, CRC %s ... Skipping", r, decoded ? "OK" : "KO");
       continue;
     }
@@ -633,66 +878,39 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     // Skip CB if it has a matched CRC
     if (decoded) {
       SCH_INFO_RX("RM CB %d: CRC OK ... Skipping", r);
-      cb_ok++;
+      input_ptr += E;
       continue;
     }
 
-    // LDPC Rate matching
-    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    if (n_llr < SRSRAN_SUCCESS) {
-      ERROR("Error in LDPC rate mateching");
-      return SRSRAN_ERROR;
-    }
+    job.cb_idx[job.nof_cb] = r;
+    job.cb_llr[job.nof_cb] = input_ptr;
+    job.cb_E[job.nof_cb]   = E;
+    job.nof_cb++;
 
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
-    }
+    input_ptr += E;
+  }
 
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
+  // Decode the code blocks, in parallel if there are workers and more than one code block
+  sch_nr_decoder_pool_t* pool = (sch_nr_decoder_pool_t*)q->workers_ptr;
+  if (pool != NULL && job.nof_cb > 1) {
+    if (sch_nr_decoder_pool_run(q, pool, &job) < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
+  } else if (sch_nr_decode_cb_share(q, &job, 0, 1) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
 
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
-    }
-
-    // Pack and count CRC OK only if CRC is match
+  // Count the code blocks that have matched CRC, including the ones decoded in previous transmissions
+  uint32_t cb_ok = 0;
+  res->crc       = false;
+  for (uint32_t r = 0; r < cfg.C; r++) {
     if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
       cb_ok++;
     }
-
-    input_ptr += E;
   }
-  // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+  for (uint32_t k = 0; k < job.nof_cb; k++) {
+    nof_iter_sum += job.cb_iter[k];
+  }
 
   // Set average number of iterations
   if (cfg.C > 0) {
@@ -28,13 +28,15 @@
 #include <complex.h>
 #include <getopt.h>
 #include <math.h>
+#include <sys/time.h>
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
-static uint32_t            n_prb     = 0;  // Set to 0 for steering
-static uint32_t            mcs       = 30; // Set to 30 for steering
-static srsran_sch_cfg_nr_t pdsch_cfg = {};
-static uint16_t            rnti      = 0x1234;
+static uint32_t            n_prb       = 0;  // Set to 0 for steering
+static uint32_t            mcs         = 30; // Set to 30 for steering
+static srsran_sch_cfg_nr_t pdsch_cfg   = {};
+static uint16_t            rnti        = 0x1234;
+static uint32_t            nof_workers = 0;
 
 void usage(char* prog)
 {
@@ -44,13 +46,14 @@ void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-W Number of code block decoder workers, set to 0 for sequential decoding [Default %d]\n", nof_workers);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLWv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,6 +67,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'W':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -89,6 +95,11 @@ int main(int argc, char** argv)
   uint8_t* data_rx[SRSRAN_MAX_CODEWORDS]    = {};
   cf_t*    sf_symbols[SRSRAN_MAX_LAYERS_NR] = {};
 
+  // Slot decoding latency
+  uint32_t nof_slots          = 0;
+  uint64_t decode_time_us_sum = 0;
+  uint32_t decode_time_us_max = 0;
+
   // Set default PDSCH configuration
   pdsch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
 
@@ -96,9 +107,10 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  srsran_pdsch_nr_args_t pdsch_args = {};
-  pdsch_args.sch.disable_simd       = false;
-  pdsch_args.measure_evm            = true;
+  srsran_pdsch_nr_args_t pdsch_args  = {};
+  pdsch_args.sch.disable_simd        = false;
+  pdsch_args.measure_evm             = true;
+  pdsch_args.sch.nof_decoder_workers = nof_workers;
 
   if (srsran_pdsch_nr_init_enb(&pdsch_tx, &pdsch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PDSCH for Tx");
@@ -148,8 +160,8 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  if (srsran_softbuffer_rx_init_guru_8bit(
+          &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
@@ -223,11 +235,21 @@ int main(int argc, char** argv)
       }
       chest.nof_re = pdsch_cfg.grant.tb->nof_re;
 
+      struct timeval t[3] = {};
+      gettimeofday(&t[1], NULL);
       if (srsran_pdsch_nr_decode(&pdsch_rx, &pdsch_cfg, &pdsch_cfg.grant, &chest, sf_symbols, &pdsch_res) <
           SRSRAN_SUCCESS) {
         ERROR("Error encoding");
         goto clean_exit;
       }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+
+      // Account the slot decoding latency
+      uint32_t decode_time_us = (uint32_t)(t[0].tv_sec * 1000000L + t[0].tv_usec);
+      decode_time_us_sum     += decode_time_us;
+      decode_time_us_max      = SRSRAN_MAX(decode_time_us_max, decode_time_us);
+      nof_slots++;
 
       if (pdsch_res.evm[0] > 0.001f) {
         ERROR("Error PDSCH EVM is too high %f", pdsch_res.evm[0]);
@@ -273,6 +295,14 @@ int main(int argc, char** argv)
     }
   }
 
+  if (nof_slots > 0) {
+    printf("Decoded %d slots with %d workers; latency mean=%.1f us, max=%d us\n",
+           nof_slots,
+           nof_workers,
+           (double)decode_time_us_sum / (double)nof_slots,
+           decode_time_us_max);
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
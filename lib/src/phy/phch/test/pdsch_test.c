@@ -349,13 +349,19 @@ int main(int argc, char** argv)
       goto quit;
     }
 
-    if (srsran_softbuffer_rx_init(softbuffers_rx[i], cell.nof_prb)) {
+    // 8-bit LLRs are stored in 8-bit soft-buffers, which halves the LLR memory
+    int sb_ret = use_8_bit ? srsran_softbuffer_rx_init_8bit(softbuffers_rx[i], cell.nof_prb)
+                           : srsran_softbuffer_rx_init(softbuffers_rx[i], cell.nof_prb);
+    if (sb_ret) {
       ERROR("Error initiating RX soft buffer");
       goto quit;
     }
 
     srsran_softbuffer_rx_reset(softbuffers_rx[i]);
   }
+  printf("RX soft-buffer memory: %.1f kB per codeword (%s LLR)\n",
+         srsran_softbuffer_rx_nof_bytes(softbuffers_rx[0]) / 1024.0,
+         use_8_bit ? "8-bit" : "16-bit");
 
   if (input_file) {
     srsran_filesource_t fsrc;
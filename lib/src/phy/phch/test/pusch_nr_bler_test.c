@@ -37,6 +37,8 @@
  *  - <tt>-N num</tt>: sets the maximum number of simulated transport blocks to \c num.
  *  - <tt>-s val</tt>: sets the nominal SNR to \c val (in dB).
  *  - <tt>-f </tt>: activates full BLER simulations (Tx--Rx comparison as opposed to CRC-verification only).
+ *  - <tt>-H num</tt>: sets the maximum number of HARQ transmissions per transport block to \c num (soft-combined).
+ *  - <tt>-W </tt>: stores the received LLRs in a 16-bit soft-buffer instead of the default 8-bit one.
  *  - <tt>-v </tt>: activates verbose output.
  *
  * Example:
@@ -65,10 +67,14 @@ static uint32_t            nof_csi_bits = 0;
 static uint32_t            max_blocks   = 2e6; // max number of simulated transport blocks
 static float               snr          = 10;
 static bool                full_check   = false;
+static uint32_t            max_harq_tx  = 1;     // max number of HARQ transmissions per transport block
+static bool                wide_llr     = false; // store LLRs in a 16-bit soft-buffer
+
+static const uint32_t harq_rv_seq[4] = {0, 2, 3, 1};
 
 void usage(char* prog)
 {
-  printf("Usage: %s [pmTLACNsfv] \n", prog);
+  printf("Usage: %s [pmTLACNsfHWv] \n", prog);
   printf("\t-p Number of grant PRB [Default %d]\n", n_prb);
   printf("\t-m MCS PRB [Default %d]\n", mcs);
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
@@ -79,13 +85,15 @@ void usage(char* prog)
   printf("\t-N Maximum number of simulated transport blocks [Default %d]\n", max_blocks);
   printf("\t-s Signal-to-Noise Ratio in dB [Default %.1f]\n", snr);
   printf("\t-f Perform full BLER check instead of CRC only [Default %s]\n", full_check ? "true" : "false");
+  printf("\t-H Maximum number of HARQ transmissions per transport block [Default %d]\n", max_harq_tx);
+  printf("\t-W Store LLRs in a 16-bit soft-buffer instead of 8-bit [Default %s]\n", wide_llr ? "true" : "false");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "p:m:T:L:A:C:N:s:fv")) != -1) {
+  while ((opt = getopt(argc, argv, "p:m:T:L:A:C:N:s:fH:Wv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(optarg, NULL, 10);
@@ -114,6 +122,12 @@ int parse_args(int argc, char** argv)
       case 'f':
         full_check = true;
         break;
+      case 'H':
+        max_harq_tx = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'W':
+        wide_llr = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -198,8 +212,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  int sb_ret = wide_llr ? srsran_softbuffer_rx_init_guru(
+                               &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB)
+                         : srsran_softbuffer_rx_init_guru_8bit(
+                               &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+  if (sb_ret < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
@@ -255,11 +272,12 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  uint32_t n_blocks      = 0;
-  uint32_t n_errors      = 0;
-  uint32_t crc_false_pos = 0;
-  uint32_t crc_false_neg = 0;
-  float    evm           = 0;
+  uint32_t n_blocks        = 0;
+  uint32_t n_transmissions = 0;
+  uint32_t n_errors        = 0;
+  uint32_t crc_false_pos   = 0;
+  uint32_t crc_false_neg   = 0;
+  float    evm             = 0;
   for (; n_blocks < max_blocks && n_errors < 100; n_blocks++) {
     // Generate SCH payload
     for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
@@ -303,58 +321,72 @@ int main(int argc, char** argv)
       goto clean_exit;
     }
 
-    if (srsran_pusch_nr_encode(&pusch_tx, &pusch_cfg, &pusch_cfg.grant, &data_tx, sf_symbols_tx) < SRSRAN_SUCCESS) {
-      ERROR("Error encoding");
-      goto clean_exit;
-    }
+    // Transmit the TB until its CRC matches or the maximum number of HARQ transmissions is reached. Retransmissions are
+    // soft-combined in the Rx soft-buffer
+    for (uint32_t harq_tx = 0; harq_tx < max_harq_tx; harq_tx++) {
+      // The soft-buffer pointers share storage, so the Tx soft-buffer has to be selected again before encoding
+      pusch_cfg.grant.tb[0].rv            = harq_rv_seq[harq_tx % 4];
+      pusch_cfg.grant.tb[0].softbuffer.tx = &softbuffer_tx;
+      if (srsran_pusch_nr_encode(&pusch_tx, &pusch_cfg, &pusch_cfg.grant, &data_tx, sf_symbols_tx) < SRSRAN_SUCCESS) {
+        ERROR("Error encoding");
+        goto clean_exit;
+      }
 
-    float noise_var = srsran_convert_dB_to_power(-snr);
-    for (uint32_t i = 0; i < carrier.max_mimo_layers; i++) {
-      srsran_ch_awgn_c(sf_symbols_tx[i], sf_symbols_rx[i], noise_var, slot_length);
-      // memcpy(sf_symbols_rx[i], sf_symbols_tx[i], slot_length * sizeof(cf_t));
-    }
+      float noise_var = srsran_convert_dB_to_power(-snr);
+      for (uint32_t i = 0; i < carrier.max_mimo_layers; i++) {
+        srsran_ch_awgn_c(sf_symbols_tx[i], sf_symbols_rx[i], noise_var, slot_length);
+        // memcpy(sf_symbols_rx[i], sf_symbols_tx[i], slot_length * sizeof(cf_t));
+      }
 
-    if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
-      uint32_t nof_re_total = carrier.nof_prb * SRSRAN_NRE;
-      uint32_t nof_re_used  = pusch_cfg.grant.nof_prb * SRSRAN_NRE;
-      for (int i_layer = 0; i_layer < carrier.max_mimo_layers; i_layer++) {
-        INFO("Layer %d", i_layer);
-        float   tx_power  = 0;
-        float   rx_power  = 0;
-        uint8_t n_symbols = 0;
-        for (int i = 0; i < SRSRAN_NSYMB_PER_SLOT_NR; i++) {
-          if (!pusch_tx.dmrs_re_pattern.symbol[i]) {
-            n_symbols++;
-            tx_power += srsran_vec_avg_power_cf(sf_symbols_tx[0] + i * nof_re_total, nof_re_total);
-            rx_power += srsran_vec_avg_power_cf(sf_symbols_rx[0] + i * nof_re_total, nof_re_total);
+      if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
+        uint32_t nof_re_total = carrier.nof_prb * SRSRAN_NRE;
+        uint32_t nof_re_used  = pusch_cfg.grant.nof_prb * SRSRAN_NRE;
+        for (int i_layer = 0; i_layer < carrier.max_mimo_layers; i_layer++) {
+          INFO("Layer %d", i_layer);
+          float   tx_power  = 0;
+          float   rx_power  = 0;
+          uint8_t n_symbols = 0;
+          for (int i = 0; i < SRSRAN_NSYMB_PER_SLOT_NR; i++) {
+            if (!pusch_tx.dmrs_re_pattern.symbol[i]) {
+              n_symbols++;
+              tx_power += srsran_vec_avg_power_cf(sf_symbols_tx[0] + i * nof_re_total, nof_re_total);
+              rx_power += srsran_vec_avg_power_cf(sf_symbols_rx[0] + i * nof_re_total, nof_re_total);
+            }
           }
+          tx_power *= (float)nof_re_total / nof_re_used; // compensate for unused REs
+          INFO("    Tx power: %.3f", tx_power / n_symbols);
+          INFO("    Rx power: %.3f", rx_power / n_symbols);
+          INFO("    SNR: %.3f dB", srsran_convert_power_to_dB(tx_power / (rx_power - tx_power)));
         }
-        tx_power *= (float)nof_re_total / nof_re_used; // compensate for unused REs
-        INFO("    Tx power: %.3f", tx_power / n_symbols);
-        INFO("    Rx power: %.3f", rx_power / n_symbols);
-        INFO("    SNR: %.3f dB", srsran_convert_power_to_dB(tx_power / (rx_power - tx_power)));
       }
-    }
 
-    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
-      pusch_cfg.grant.tb[tb].softbuffer.rx = &softbuffer_rx;
-      srsran_softbuffer_rx_reset(pusch_cfg.grant.tb[tb].softbuffer.rx);
-    }
+      for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+        pusch_cfg.grant.tb[tb].softbuffer.rx = &softbuffer_rx;
+        if (harq_tx == 0) {
+          srsran_softbuffer_rx_reset(pusch_cfg.grant.tb[tb].softbuffer.rx);
+        }
+      }
 
-    // assume perfect channel estimation (including noise variance)
-    for (uint32_t i = 0; i < pusch_cfg.grant.tb->nof_re; i++) {
-      chest.ce[0][0][i] = 1.0F;
-    }
-    chest.nof_re         = pusch_cfg.grant.tb->nof_re;
-    chest.noise_estimate = 2 * noise_var;
+      // assume perfect channel estimation (including noise variance)
+      for (uint32_t i = 0; i < pusch_cfg.grant.tb->nof_re; i++) {
+        chest.ce[0][0][i] = 1.0F;
+      }
+      chest.nof_re         = pusch_cfg.grant.tb->nof_re;
+      chest.noise_estimate = 2 * noise_var;
 
-    if (srsran_pusch_nr_decode(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &chest, sf_symbols_rx, &data_rx) <
-        SRSRAN_SUCCESS) {
-      ERROR("Error decoding");
-      goto clean_exit;
+      if (srsran_pusch_nr_decode(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &chest, sf_symbols_rx, &data_rx) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error decoding");
+        goto clean_exit;
+      }
+
+      evm += data_rx.evm[0];
+      n_transmissions++;
+      if (data_rx.tb[0].crc) {
+        break;
+      }
     }
 
-    evm += data_rx.evm[0];
     // Validate UL-SCH CRC check
     if (!data_rx.tb[0].crc) {
       n_errors++;
@@ -387,7 +419,11 @@ int main(int argc, char** argv)
   printf("\nPUSCH: %s\n%s", str, str_extra);
 
   printf("\nNominal SNR: %.1f dB\n", snr);
-  printf("Average EVM: %.3f\n", evm / n_blocks);
+  printf("Average EVM: %.3f\n", evm / n_transmissions);
+  printf("Average HARQ transmissions: %.2f (max %d)\n", (double)n_transmissions / n_blocks, max_harq_tx);
+  printf("Rx soft-buffer memory: %.1f kB (%s LLR)\n",
+         srsran_softbuffer_rx_nof_bytes(&softbuffer_rx) / 1024.0,
+         wide_llr ? "16-bit" : "8-bit");
 
   printf("BLER: %.3e (%d errors out of %d blocks)\n", (double)n_errors / n_blocks, n_errors, n_blocks);
   printf("Tx Throughput: %.3e Mbps -- Rx Throughput: %.3e Mbps (%.2f%%)\n",
@@ -27,6 +27,7 @@
 #include "srsran/phy/utils/vector.h"
 #include <complex.h>
 #include <getopt.h>
+#include <sys/time.h>
 
 static srsran_carrier_nr_t carrier      = SRSRAN_DEFAULT_CARRIER_NR;
 static uint32_t            n_prb        = 0;  // Set to 0 for steering
@@ -35,6 +36,7 @@ static srsran_sch_cfg_nr_t pusch_cfg    = {};
 static uint16_t            rnti         = 0x1234;
 static uint32_t            nof_ack_bits = 0;
 static uint32_t            nof_csi_bits = 0;
+static uint32_t            nof_workers  = 0;
 
 void usage(char* prog)
 {
@@ -46,13 +48,14 @@ void usage(char* prog)
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
   printf("\t-A Provide a number of HARQ-ACK bits [Default %d]\n", nof_ack_bits);
   printf("\t-C Provide a number of CSI bits [Default %d]\n", nof_csi_bits);
+  printf("\t-W Number of code block decoder workers, set to 0 for sequential decoding [Default %d]\n", nof_workers);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLACv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLACWv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -72,6 +75,9 @@ int parse_args(int argc, char** argv)
       case 'C':
         nof_csi_bits = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'W':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -96,6 +102,11 @@ int main(int argc, char** argv)
   srsran_pusch_res_nr_t  data_rx                          = {};
   cf_t*                  sf_symbols[SRSRAN_MAX_LAYERS_NR] = {};
 
+  // Slot decoding latency
+  uint32_t nof_slots          = 0;
+  uint64_t decode_time_us_sum = 0;
+  uint32_t decode_time_us_max = 0;
+
   // Set default PUSCH configuration
   pusch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
 
@@ -103,9 +114,10 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  srsran_pusch_nr_args_t pusch_args = {};
-  pusch_args.sch.disable_simd       = false;
-  pusch_args.measure_evm            = true;
+  srsran_pusch_nr_args_t pusch_args  = {};
+  pusch_args.sch.disable_simd        = false;
+  pusch_args.measure_evm             = true;
+  pusch_args.sch.nof_decoder_workers = nof_workers;
 
   if (srsran_pusch_nr_init_ue(&pusch_tx, &pusch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PUSCH for Tx");
@@ -153,8 +165,8 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  if (srsran_softbuffer_rx_init_guru_8bit(
+          &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
@@ -265,11 +277,21 @@ int main(int argc, char** argv)
       }
       chest.nof_re = pusch_cfg.grant.tb->nof_re;
 
+      struct timeval t[3] = {};
+      gettimeofday(&t[1], NULL);
       if (srsran_pusch_nr_decode(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &chest, sf_symbols, &data_rx) <
           SRSRAN_SUCCESS) {
         ERROR("Error encoding");
         goto clean_exit;
       }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+
+      // Account the slot decoding latency
+      uint32_t decode_time_us = (uint32_t)(t[0].tv_sec * 1000000L + t[0].tv_usec);
+      decode_time_us_sum     += decode_time_us;
+      decode_time_us_max      = SRSRAN_MAX(decode_time_us_max, decode_time_us);
+      nof_slots++;
 
       if (data_rx.evm[0] > 0.001f) {
         ERROR("Error PUSCH EVM is too high %f", data_rx.evm[0]);
@@ -382,6 +404,14 @@ int main(int argc, char** argv)
     }
   }
 
+  if (nof_slots > 0) {
+    printf("Decoded %d slots with %d workers; latency mean=%.1f us, max=%d us\n",
+           nof_slots,
+           nof_workers,
+           (double)decode_time_us_sum / (double)nof_slots,
+           decode_time_us_max);
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
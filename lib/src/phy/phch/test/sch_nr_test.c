@@ -139,8 +139,8 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  if (srsran_softbuffer_rx_init_guru_8bit(
+          &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
@@ -0,0 +1,240 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/channelizer.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Channel filter cut-off frequency, normalised to the output sampling rate
+ */
+#define CHANNELIZER_CUTOFF 0.39
+
+/**
+ * Number of input samples shared by consecutive input DFT windows, the filter spans one more sample
+ */
+#define CHANNELIZER_OVERLAP(N) ((N) / 4)
+
+/* Copies len bins of a DFT of size N starting at bin start, wrapping around the end of the DFT */
+static void channelizer_copy_bins(const cf_t* in, uint32_t N, uint32_t start, cf_t* out, uint32_t len)
+{
+  uint32_t n = SRSRAN_MIN(len, N - start);
+  srsran_vec_cf_copy(out, &in[start], n);
+  srsran_vec_cf_copy(&out[n], in, len - n);
+}
+
+/* Shifts the input DFT bins around the channel centre to baseband, in output DFT order */
+static void channelizer_extract(const cf_t* in, uint32_t N, uint32_t k0, cf_t* out)
+{
+  uint32_t M = SRSRAN_CHANNELIZER_FFT_SIZE;
+  channelizer_copy_bins(in, N, k0, out, M / 2);
+  channelizer_copy_bins(in, N, (k0 + N - M / 2) % N, &out[M / 2], M / 2);
+}
+
+int srsran_channelizer_init(srsran_channelizer_t* q, uint32_t ratio, const double* freq_offset, uint32_t nof_channels)
+{
+  if (q == NULL || freq_offset == NULL || ratio == 0 || nof_channels == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_channelizer_t));
+
+  uint32_t M = SRSRAN_CHANNELIZER_FFT_SIZE;
+  uint32_t N = M * ratio;
+  uint32_t O = CHANNELIZER_OVERLAP(N);
+
+  q->ratio        = ratio;
+  q->nof_channels = nof_channels;
+
+  q->in_buffer  = srsran_vec_cf_malloc(N);
+  q->fft_buffer = srsran_vec_cf_malloc(N);
+  q->ifft_in    = srsran_vec_cf_malloc(M);
+  q->ifft_out   = srsran_vec_cf_malloc(M);
+  q->filter     = srsran_vec_cf_malloc(M);
+  q->channels   = calloc(nof_channels, sizeof(srsran_channelizer_channel_t));
+  if (q->in_buffer == NULL || q->fft_buffer == NULL || q->ifft_in == NULL || q->ifft_out == NULL ||
+      q->filter == NULL || q->channels == NULL) {
+    srsran_channelizer_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dft_plan_guru_c(&q->fft, N, SRSRAN_DFT_FORWARD, q->in_buffer, q->fft_buffer, 1, 1, 1, 1, 1) ||
+      srsran_dft_plan_guru_c(&q->ifft, M, SRSRAN_DFT_BACKWARD, q->ifft_in, q->ifft_out, 1, 1, 1, 1, 1)) {
+    ERROR("Initialising DFT");
+    srsran_channelizer_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Blackman windowed sinc spanning the overlap, its transition band ends well before the edge of the output DFT, so
+  // that discarding the bins outside the channel does not alias in time
+  double fc  = CHANNELIZER_CUTOFF / ratio;
+  double sum = 0.0;
+  srsran_vec_cf_zero(q->in_buffer, N);
+  for (uint32_t i = 0; i <= O; i++) {
+    double t = (double)i - (double)O / 2.0;
+    double h = (t == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+    h *= 0.42 - 0.5 * cos(2.0 * M_PI * i / O) + 0.08 * cos(4.0 * M_PI * i / O);
+    q->in_buffer[i] = (float)h;
+    sum += h;
+  }
+  srsran_dft_run_guru_c(&q->fft);
+
+  // Keep the bins within the output bandwidth, normalise the DC gain and the input DFT gain
+  channelizer_extract(q->fft_buffer, N, 0, q->filter);
+  srsran_vec_sc_prod_cfc(q->filter, (float)(1.0 / (sum * N)), q->filter, M);
+
+  // The nearest input DFT bin shifts the channel to baseband, the residual is corrected after decimation. Outputs are
+  // made phase continuous by rotating every window by the phase the channel centre accumulates between windows
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    srsran_channelizer_channel_t* ch = &q->channels[c];
+
+    int32_t k0 = (int32_t)round(freq_offset[c] * N);
+    double  r  = (freq_offset[c] - (double)k0 / N) * ratio;
+    ch->k0     = (uint32_t)((k0 % (int32_t)N + (int32_t)N) % (int32_t)N);
+    ch->step   = fmod(-2.0 * M_PI * freq_offset[c] * (N - O), 2.0 * M_PI);
+
+    ch->nco = srsran_vec_cf_malloc(SRSRAN_CHANNELIZER_WINDOW_SZ);
+    if (ch->nco == NULL) {
+      srsran_channelizer_free(q);
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t i = 0; i < SRSRAN_CHANNELIZER_WINDOW_SZ; i++) {
+      ch->nco[i] = cexpf(-I * (float)(2.0 * M_PI * r * i));
+    }
+  }
+
+  srsran_channelizer_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_channelizer_reset(srsran_channelizer_t* q)
+{
+  if (q == NULL || q->in_buffer == NULL) {
+    return;
+  }
+
+  // The first window starts with an overlap of zeros
+  q->state_len = CHANNELIZER_OVERLAP(q->fft.size);
+  srsran_vec_cf_zero(q->in_buffer, q->state_len);
+
+  for (uint32_t c = 0; c < q->nof_channels; c++) {
+    q->channels[c].phase = fmod(2.0 * M_PI * q->channels[c].k0 * q->state_len / q->fft.size, 2.0 * M_PI);
+  }
+}
+
+uint32_t srsran_channelizer_get_delay(const srsran_channelizer_t* q)
+{
+  if (q == NULL || q->ratio == 0) {
+    return 0;
+  }
+  return CHANNELIZER_OVERLAP(q->fft.size) / 2 / q->ratio;
+}
+
+uint32_t srsran_channelizer_run(srsran_channelizer_t* q, const cf_t* input, cf_t** output, uint32_t nsamples)
+{
+  if (q == NULL || input == NULL || output == NULL) {
+    return 0;
+  }
+
+  uint32_t N       = q->fft.size;
+  uint32_t M       = q->ifft.size;
+  uint32_t O       = CHANNELIZER_OVERLAP(N);
+  uint32_t count   = 0;
+  uint32_t nof_out = 0;
+
+  while (count < nsamples) {
+    uint32_t n = SRSRAN_MIN(N - q->state_len, nsamples - count);
+    srsran_vec_cf_copy(&q->in_buffer[q->state_len], &input[count], n);
+    q->state_len += n;
+    count += n;
+
+    // Wait for a complete window
+    if (q->state_len < N) {
+      break;
+    }
+
+    srsran_dft_run_guru_c(&q->fft);
+
+    for (uint32_t c = 0; c < q->nof_channels; c++) {
+      srsran_channelizer_channel_t* ch  = &q->channels[c];
+      cf_t*                         out = &output[c][nof_out];
+
+      // Filter the channel bins and decimate
+      channelizer_extract(q->fft_buffer, N, ch->k0, q->ifft_in);
+      srsran_vec_prod_ccc(q->ifft_in, q->filter, q->ifft_in, M);
+      srsran_dft_run_guru_c(&q->ifft);
+
+      // Discard the aliased samples and correct the phase
+      srsran_vec_prod_ccc(&q->ifft_out[M - SRSRAN_CHANNELIZER_WINDOW_SZ], ch->nco, out, SRSRAN_CHANNELIZER_WINDOW_SZ);
+      srsran_vec_sc_prod_ccc(out, cexpf(I * (float)ch->phase), out, SRSRAN_CHANNELIZER_WINDOW_SZ);
+      ch->phase = fmod(ch->phase + ch->step, 2.0 * M_PI);
+    }
+    nof_out += SRSRAN_CHANNELIZER_WINDOW_SZ;
+
+    // Keep the overlap for the next window
+    srsran_vec_cf_copy(q->in_buffer, &q->in_buffer[N - O], O);
+    q->state_len = O;
+  }
+
+  return nof_out;
+}
+
+void srsran_channelizer_free(srsran_channelizer_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_dft_plan_free(&q->fft);
+  srsran_dft_plan_free(&q->ifft);
+
+  if (q->channels) {
+    for (uint32_t c = 0; c < q->nof_channels; c++) {
+      if (q->channels[c].nco) {
+        free(q->channels[c].nco);
+      }
+    }
+    free(q->channels);
+  }
+  if (q->in_buffer) {
+    free(q->in_buffer);
+  }
+  if (q->fft_buffer) {
+    free(q->fft_buffer);
+  }
+  if (q->ifft_in) {
+    free(q->ifft_in);
+  }
+  if (q->ifft_out) {
+    free(q->ifft_out);
+  }
+  if (q->filter) {
+    free(q->filter);
+  }
+
+  memset(q, 0, sizeof(srsran_channelizer_t));
+}
@@ -22,13 +22,19 @@
 #include "srsran/srsran.h"
 #include <complex.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <strings.h>
 
 #include "srsran/phy/resampling/interp.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif /* LV_HAVE_AVX2 */
+
 /*************** STATIC FUNCTIONS ***********************/
 
 cf_t srsran_interp_linear_onesample(cf_t input0, cf_t input1)
@@ -165,24 +171,74 @@ void srsran_interp_linear_vector3(srsran_interp_linsrsran_vec_t* q,
                                   bool                           to_right,
                                   uint32_t                       len)
 {
-  uint32_t i;
+  uint32_t  i      = 0;
+  float     scale  = (float)1 / in1_in0_d;
+  cf_t*     base   = start ? start : in0;
+  ptrdiff_t stride = to_right ? (ptrdiff_t)q->vector_len : -(ptrdiff_t)q->vector_len;
 
-  srsran_vec_sub_ccc(in1, in0, q->diff_vec, len);
-  srsran_vec_sc_prod_cfc(q->diff_vec, (float)1 / in1_in0_d, q->diff_vec, len);
+  // Operations are done to len samples but pointers are moved the full vector length. The inputs are read once and
+  // the M vectors in between are accumulated in registers.
+#if SRSRAN_SIMD_F_SIZE
+  for (; i + SRSRAN_SIMD_F_SIZE / 2 <= len; i += SRSRAN_SIMD_F_SIZE / 2) {
+    simd_f_t a0   = srsran_simd_f_loadu((float*)&in0[i]);
+    simd_f_t a1   = srsran_simd_f_loadu((float*)&in1[i]);
+    simd_f_t diff = srsran_simd_f_mul(srsran_simd_f_sub(a1, a0), srsran_simd_f_set1(scale));
+    simd_f_t y    = srsran_simd_f_loadu((float*)&base[i]);
+    cf_t*    ptr  = &between[i];
+    for (uint32_t m = 0; m < M; m++, ptr += stride) {
+      y = srsran_simd_f_add(y, diff);
+      srsran_simd_f_storeu((float*)ptr, y);
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
 
-  if (start) {
-    srsran_vec_sum_ccc(start, q->diff_vec, between, len);
-  } else {
-    srsran_vec_sum_ccc(in0, q->diff_vec, between, len);
+  for (; i < len; i++) {
+    cf_t  diff = (in1[i] - in0[i]) * scale;
+    cf_t  y    = base[i];
+    cf_t* ptr  = &between[i];
+    for (uint32_t m = 0; m < M; m++, ptr += stride) {
+      y += diff;
+      *ptr = y;
+    }
   }
-  for (i = 0; i < M - 1; i++) {
-    // Operations are done to len samples but pointers are moved the full vector length
-    if (to_right) {
-      srsran_vec_sum_ccc(between, q->diff_vec, &between[q->vector_len], len);
-      between += q->vector_len;
-    } else {
-      between -= q->vector_len;
-      srsran_vec_sum_ccc(&between[q->vector_len], q->diff_vec, between, len);
+}
+
+/* Precomputes the ramp and, for the AVX2 implementation, the weights and input indexes of a group of intervals that
+ * produces a whole number of registers of 4 complex samples. The samples of each register are interpolated between
+ * at most 4 consecutive inputs for M >= 2, which are permuted from a single unaligned load.
+ */
+static void interp_linear_precompute(srsran_interp_lin_t* q)
+{
+  uint32_t M = q->M;
+
+  for (uint32_t i = 0; i < M; i++) {
+    q->ramp[i] = (float)i;
+  }
+
+  q->simd_nof_regs      = 0;
+  q->simd_nof_intervals = 0;
+  if (M < 2) {
+    return;
+  }
+
+  uint32_t nof_samples = M;
+  while (nof_samples % 4 != 0) {
+    nof_samples += M;
+  }
+  q->simd_nof_regs      = nof_samples / 4;
+  q->simd_nof_intervals = nof_samples / M;
+
+  for (uint32_t r = 0; r < q->simd_nof_regs; r++) {
+    uint32_t first    = (4 * r) / M;
+    q->simd_offset[r] = first;
+    for (uint32_t n = 0; n < 4; n++) {
+      uint32_t k = 4 * r + n;
+      uint32_t a = k / M - first;
+      for (uint32_t c = 0; c < 2; c++) {
+        q->simd_idx[16 * r + 2 * n + c]     = (int32_t)(2 * a + c);
+        q->simd_idx[16 * r + 8 + 2 * n + c] = (int32_t)(2 * (a + 1) + c);
+        q->simd_weight[8 * r + 2 * n + c]   = (float)(k % M) / (float)M;
+      }
     }
   }
 }
@@ -198,28 +254,22 @@ int srsran_interp_linear_init(srsran_interp_lin_t* q, uint32_t vector_len, uint3
       perror("malloc");
       return SRSRAN_ERROR;
     }
-    q->diff_vec2 = srsran_vec_cf_malloc(M * vector_len);
-    if (!q->diff_vec2) {
+    q->ramp        = srsran_vec_f_malloc(M);
+    q->simd_idx    = srsran_vec_i32_malloc(16 * M);
+    q->simd_weight = srsran_vec_f_malloc(8 * M);
+    q->simd_offset = srsran_vec_u32_malloc(M);
+    if (!q->ramp || !q->simd_idx || !q->simd_weight || !q->simd_offset) {
       perror("malloc");
-      free(q->diff_vec);
+      srsran_interp_linear_free(q);
       return SRSRAN_ERROR;
     }
-    q->ramp = srsran_vec_f_malloc(M);
-    if (!q->ramp) {
-      perror("malloc");
-      free(q->ramp);
-      free(q->diff_vec);
-      return SRSRAN_ERROR;
-    }
-
-    for (int i = 0; i < M; i++) {
-      q->ramp[i] = (float)i;
-    }
 
     q->vector_len     = vector_len;
     q->M              = M;
     q->max_vector_len = vector_len;
     q->max_M          = M;
+
+    interp_linear_precompute(q);
   }
   return ret;
 }
@@ -229,12 +279,18 @@ void srsran_interp_linear_free(srsran_interp_lin_t* q)
   if (q->diff_vec) {
     free(q->diff_vec);
   }
-  if (q->diff_vec2) {
-    free(q->diff_vec2);
-  }
   if (q->ramp) {
     free(q->ramp);
   }
+  if (q->simd_idx) {
+    free(q->simd_idx);
+  }
+  if (q->simd_weight) {
+    free(q->simd_weight);
+  }
+  if (q->simd_offset) {
+    free(q->simd_offset);
+  }
 
   bzero(q, sizeof(srsran_interp_lin_t));
 }
@@ -242,12 +298,10 @@ void srsran_interp_linear_free(srsran_interp_lin_t* q)
 int srsran_interp_linear_resize(srsran_interp_lin_t* q, uint32_t vector_len, uint32_t M)
 {
   if (vector_len <= q->max_vector_len && M <= q->max_M) {
-    for (int i = 0; i < M; i++) {
-      q->ramp[i] = (float)i;
-    }
-
     q->vector_len = vector_len;
     q->M          = M;
+
+    interp_linear_precompute(q);
     return SRSRAN_SUCCESS;
   } else {
     ERROR("Error resizing interp_linear: vector_len and M must be lower or equal than initialized");
@@ -259,21 +313,37 @@ void srsran_interp_linear_offset(srsran_interp_lin_t* q, cf_t* input, cf_t* outp
 {
   uint32_t i, j;
   cf_t     diff;
+  cf_t*    out = &output[off_st];
 
   i = 0;
   for (j = 0; j < off_st; j++) {
     output[off_st - j - 1] = input[i] - (j + 1) * (input[i + 1] - input[i]) / q->M;
   }
-  srsran_vec_sub_ccc(&input[1], input, q->diff_vec, (q->vector_len - 1));
-  srsran_vec_sc_prod_cfc(q->diff_vec, (float)1 / q->M, q->diff_vec, q->vector_len - 1);
-  for (i = 0; i < q->vector_len - 1; i++) {
+
+#ifdef LV_HAVE_AVX2
+  // Every register reads 4 inputs from the first interval it spans
+  for (; q->simd_nof_regs > 0 && i + q->simd_nof_intervals + 3 <= q->vector_len; i += q->simd_nof_intervals) {
+    for (uint32_t r = 0; r < q->simd_nof_regs; r++) {
+      __m256 x   = _mm256_loadu_ps((float*)&input[i + q->simd_offset[r]]);
+      __m256 in0 = _mm256_permutevar8x32_ps(x, _mm256_loadu_si256((__m256i*)&q->simd_idx[16 * r]));
+      __m256 in1 = _mm256_permutevar8x32_ps(x, _mm256_loadu_si256((__m256i*)&q->simd_idx[16 * r + 8]));
+      __m256 w   = _mm256_loadu_ps(&q->simd_weight[8 * r]);
+#ifdef LV_HAVE_FMA
+      __m256 y = _mm256_fmadd_ps(_mm256_sub_ps(in1, in0), w, in0);
+#else /* LV_HAVE_FMA */
+      __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(in1, in0), w), in0);
+#endif /* LV_HAVE_FMA */
+      _mm256_storeu_ps((float*)&out[i * q->M + 4 * r], y);
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < q->vector_len - 1; i++) {
+    diff = (input[i + 1] - input[i]) / q->M;
     for (j = 0; j < q->M; j++) {
-      output[i * q->M + j + off_st] = input[i];
-      q->diff_vec2[i * q->M + j]    = q->diff_vec[i];
+      out[i * q->M + j] = input[i] + q->ramp[j] * diff;
     }
-    srsran_vec_prod_cfc(&q->diff_vec2[i * q->M], q->ramp, &q->diff_vec2[i * q->M], q->M);
   }
-  srsran_vec_sum_ccc(&output[off_st], q->diff_vec2, &output[off_st], q->M * (q->vector_len - 1));
 
   if (q->vector_len > 1) {
     diff = input[q->vector_len - 1] - input[q->vector_len - 2];
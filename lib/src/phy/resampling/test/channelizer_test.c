@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/channelizer.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define NOF_CHANNELS 5
+
+static uint32_t nof_windows = 200;
+static uint32_t factor      = 8;
+static uint32_t chunk_size  = 1000;
+
+// Channel centres and tone offsets within every channel, normalised to the output sampling rate
+static const double channel_freq[NOF_CHANNELS] = {-3.2717, -1.6502, 0.0121, 1.3853, 2.9006};
+static const double tone_freq[NOF_CHANNELS]    = {0.1300, -0.2513, 0.0, 0.3021, -0.0874};
+static const float  tone_ampl[NOF_CHANNELS]    = {1.0f, 0.1f, 0.5f, 2.0f, 0.01f};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [fnc]\n", prog);
+  printf("\t-f Decimation factor [Default %d]\n", factor);
+  printf("\t-n Number of output windows [Default %d]\n", nof_windows);
+  printf("\t-c Input chunk size [Default %d]\n", chunk_size);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "fncv")) != -1) {
+    switch (opt) {
+      case 'f':
+        factor = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_windows = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        chunk_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval       t[3]        = {};
+  srsran_channelizer_t channelizer = {};
+  double               freq_offset[NOF_CHANNELS];
+  cf_t*                output[NOF_CHANNELS];
+  int                  ret = SRSRAN_SUCCESS;
+
+  parse_args(argc, argv);
+
+  // The last window may not complete
+  uint32_t nof_out  = nof_windows * SRSRAN_CHANNELIZER_WINDOW_SZ;
+  uint32_t nsamples = nof_out * factor;
+  cf_t*    input    = srsran_vec_cf_malloc(nsamples);
+  cf_t*    expected = srsran_vec_cf_malloc(nof_out);
+  if (input == NULL || expected == NULL) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    freq_offset[c] = channel_freq[c] / factor;
+    output[c]      = srsran_vec_cf_malloc(nof_out + SRSRAN_CHANNELIZER_WINDOW_SZ);
+    if (output[c] == NULL) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (srsran_channelizer_init(&channelizer, factor, freq_offset, NOF_CHANNELS)) {
+    ERROR("Error initialising channelizer");
+    return SRSRAN_ERROR;
+  }
+
+  // One tone within every channel, the phase is computed in double precision to keep the error floor low
+  srsran_vec_cf_zero(input, nsamples);
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    double f = (channel_freq[c] + tone_freq[c]) / factor;
+    for (uint32_t i = 0; i < nsamples; i++) {
+      input[i] += tone_ampl[c] * cexpf(I * (float)(2.0 * M_PI * fmod(f * i, 1.0)));
+    }
+  }
+
+  // Feed the input in chunks that do not match the window size
+  uint32_t count = 0;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nsamples; i += chunk_size) {
+    uint32_t n = SRSRAN_MIN(chunk_size, nsamples - i);
+    cf_t*    o[NOF_CHANNELS];
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      o[c] = &output[c][count];
+    }
+    count += srsran_channelizer_run(&channelizer, &input[i], o, n);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  if (count != nof_out) {
+    ERROR("Expected %d output samples, got %d", nof_out, count);
+    ret = SRSRAN_ERROR;
+  }
+
+  // Every channel shall only contain its tone, delayed by the filter. Skip the first window, it includes the initial
+  // zeros of the filter state
+  uint32_t delay = srsran_channelizer_get_delay(&channelizer);
+  uint32_t start = SRSRAN_CHANNELIZER_WINDOW_SZ;
+  for (uint32_t c = 0; c < NOF_CHANNELS && ret == SRSRAN_SUCCESS; c++) {
+    double resid = channel_freq[c] - round(channel_freq[c] * SRSRAN_CHANNELIZER_FFT_SIZE) / SRSRAN_CHANNELIZER_FFT_SIZE;
+    cf_t   phase = cexpf(-I * (float)(2.0 * M_PI * (tone_freq[c] + resid) * delay));
+    for (uint32_t i = start; i < count; i++) {
+      expected[i] = tone_ampl[c] * phase * cexpf(I * (float)(2.0 * M_PI * fmod(tone_freq[c] * i, 1.0)));
+    }
+    srsran_vec_sub_ccc(&output[c][start], &expected[start], &expected[start], count - start);
+    float err_dB = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(&expected[start], count - start)) -
+                   srsran_convert_power_to_dB(tone_ampl[c] * tone_ampl[c]);
+    printf("Channel %d: f=%+.4f, error=%+.1f dB\n", c, channel_freq[c], err_dB);
+    if (!isnormal(err_dB) || err_dB > -60.0f) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  printf("Done %.1f Msps, %d channels\n", nsamples / (double)duration_us, NOF_CHANNELS);
+
+  srsran_channelizer_free(&channelizer);
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    free(output[c]);
+  }
+  free(input);
+  free(expected);
+
+  return ret;
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/interp.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define MAX_LEN 1200
+#define MAX_M 12
+#define MAX_NOF_VECTORS 8
+#define ASSERT_ERROR 1e-4f
+
+static srsran_random_t random_gen = NULL;
+
+static int test_linear_offset(srsran_interp_lin_t* q, uint32_t len, uint32_t M, uint32_t off_st, uint32_t off_end)
+{
+  cf_t input[MAX_LEN];
+  cf_t output[MAX_LEN * MAX_M];
+
+  if (srsran_interp_linear_resize(q, len, M) < SRSRAN_SUCCESS) {
+    ERROR("Error resizing interpolator");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_uniform_complex_dist_vector(random_gen, input, len, -1.0f, 1.0f);
+  srsran_vec_cf_zero(output, MAX_LEN * MAX_M);
+  srsran_interp_linear_offset(q, input, output, off_st, off_end);
+
+  // Every output is on the line between the two closest inputs, extrapolated at both ends
+  uint32_t nof_outputs = off_st + (len - 1) * M + off_end;
+  for (uint32_t k = 0; k < nof_outputs; k++) {
+    int32_t pos = (int32_t)k - (int32_t)off_st;
+    int32_t i   = SRSRAN_MIN(SRSRAN_MAX(pos / (int32_t)M, 0), (int32_t)len - 2);
+    if (pos < 0) {
+      i = 0;
+    }
+    float t    = (float)(pos - i * (int32_t)M) / (float)M;
+    cf_t  gold = input[i] + t * (input[i + 1] - input[i]);
+    if (cabsf(output[k] - gold) > ASSERT_ERROR) {
+      ERROR("Error len=%d; M=%d; off_st=%d; off_end=%d; k=%d; output=%+.3f%+.3fi; gold=%+.3f%+.3fi;",
+            len,
+            M,
+            off_st,
+            off_end,
+            k,
+            __real__ output[k],
+            __imag__ output[k],
+            __real__ gold,
+            __imag__ gold);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_linear_vector(srsran_interp_linsrsran_vec_t* q, uint32_t len, uint32_t M, bool to_right)
+{
+  cf_t  buffer[MAX_LEN * (MAX_NOF_VECTORS + 3)];
+  cf_t* in0     = &buffer[0];
+  cf_t* in1     = &buffer[MAX_LEN];
+  cf_t* start   = &buffer[2 * MAX_LEN];
+  cf_t* between = to_right ? &buffer[3 * MAX_LEN] : &buffer[(MAX_NOF_VECTORS + 2) * MAX_LEN];
+
+  srsran_random_uniform_complex_dist_vector(random_gen, buffer, 3 * MAX_LEN, -1.0f, 1.0f);
+  srsran_interp_linear_vector3(q, in0, in1, start, between, M + 1, M, to_right, len);
+
+  for (uint32_t m = 0; m < M; m++) {
+    cf_t* v = to_right ? &between[m * MAX_LEN] : &between[-(int32_t)(m * MAX_LEN)];
+    for (uint32_t i = 0; i < len; i++) {
+      cf_t gold = start[i] + (float)(m + 1) * (in1[i] - in0[i]) / (float)(M + 1);
+      if (cabsf(v[i] - gold) > ASSERT_ERROR) {
+        ERROR("Error len=%d; M=%d; to_right=%c; m=%d; i=%d;", len, M, to_right ? 'y' : 'n', m, i);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                           ret        = SRSRAN_SUCCESS;
+  srsran_interp_lin_t           interp     = {};
+  srsran_interp_linsrsran_vec_t interp_vec = {};
+  const uint32_t                lengths[]  = {2, 3, 5, 13, 50, 200, MAX_LEN};
+
+  random_gen = srsran_random_init(0x1234);
+
+  if (srsran_interp_linear_init(&interp, MAX_LEN, MAX_M) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising interpolator");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_interp_linear_vector_init(&interp_vec, MAX_LEN) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising vector interpolator");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]) && ret == SRSRAN_SUCCESS; l++) {
+    for (uint32_t M = 1; M <= MAX_M && ret == SRSRAN_SUCCESS; M++) {
+      if (test_linear_offset(&interp, lengths[l], M, 0, M) < SRSRAN_SUCCESS ||
+          test_linear_offset(&interp, lengths[l], M, M / 2, M - M / 2) < SRSRAN_SUCCESS ||
+          test_linear_offset(&interp, lengths[l], M, M - 1, 1) < SRSRAN_SUCCESS) {
+        ret = SRSRAN_ERROR;
+      }
+    }
+
+    for (uint32_t M = 1; M <= MAX_NOF_VECTORS && ret == SRSRAN_SUCCESS; M++) {
+      if (test_linear_vector(&interp_vec, lengths[l], M, true) < SRSRAN_SUCCESS ||
+          test_linear_vector(&interp_vec, lengths[l], M, false) < SRSRAN_SUCCESS) {
+        ret = SRSRAN_ERROR;
+      }
+    }
+  }
+
+  srsran_interp_linear_free(&interp);
+  srsran_interp_linear_vector_free(&interp_vec);
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+
+  return ret;
+}
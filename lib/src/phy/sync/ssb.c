@@ -43,6 +43,26 @@
  */
 #define SSB_CORR_SZ(SYMB_SZ) SRSRAN_MIN(1U << (uint32_t)ceil(log2((double)(SYMB_SZ)) + 3.0), 1U << 13U)
 
+/*
+ * Correlation band size for the decimated PSS detection. It selects a power of two number of correlation bins spanning
+ * at least twice the PSS bandwidth, so the decimated correlation is still oversampled by two, but not bigger than the
+ * correlation size.
+ */
+#define SSB_CORR_BAND_SZ(CORR_SZ, SYMB_SZ)                                                                             \
+  SRSRAN_MIN(1U << (uint32_t)ceil(log2(2.0 * SRSRAN_PSS_NR_LEN * (double)(CORR_SZ) / (double)(SYMB_SZ))), (CORR_SZ))
+
+/*
+ * Maximum number of correlation bins steered for the coarse CFO. The correlation size is less than 16 symbols, so a
+ * subcarrier spans less than 16 bins. It also bounds the band size to 2^12 bins.
+ */
+#define SSB_CORR_MAX_SHIFT 16U
+#define SSB_CORR_BAND_MAX_SZ(MAX_CORR_SZ) SRSRAN_MIN(1U << 12U, (MAX_CORR_SZ))
+
+/*
+ * Maximum number of SSB frequencies correlated at once in a sweep
+ */
+#define SSB_SWEEP_MAX_NOF_FREQS 16
+
 /*
  * Default NR-PBCH DMRS normalised correlation (RSRP/EPRE) threshold
  */
@@ -65,6 +85,15 @@ static int ssb_init_corr(srsran_ssb_t* q)
     }
   }
 
+  // Allocate the PSS bands for every frequency of a sweep, and the received band with the CFO steering margin
+  uint32_t nof_freqs = SRSRAN_MIN(SRSRAN_MAX(q->args.max_sweep_freqs, 1), SSB_SWEEP_MAX_NOF_FREQS);
+  q->pss_band        = srsran_vec_cf_malloc(nof_freqs * SRSRAN_NOF_NID_2_NR * SSB_CORR_BAND_MAX_SZ(q->max_corr_sz));
+  q->tmp_band        = srsran_vec_cf_malloc(SSB_CORR_BAND_MAX_SZ(q->max_corr_sz) + 2 * SSB_CORR_MAX_SHIFT);
+  if (q->pss_band == NULL || q->tmp_band == NULL) {
+    ERROR("Malloc");
+    return SRSRAN_ERROR;
+  }
+
   q->sf_buffer = srsran_vec_cf_malloc(q->max_ssb_sz + q->max_sf_sz);
   if (q->sf_buffer == NULL) {
     ERROR("Malloc");
@@ -161,6 +190,14 @@ void srsran_ssb_free(srsran_ssb_t* q)
     }
   }
 
+  if (q->pss_band != NULL) {
+    free(q->pss_band);
+  }
+
+  if (q->tmp_band != NULL) {
+    free(q->tmp_band);
+  }
+
   if (q->sf_buffer != NULL) {
     free(q->sf_buffer);
   }
@@ -169,6 +206,7 @@ void srsran_ssb_free(srsran_ssb_t* q)
   srsran_dft_plan_free(&q->fft);
   srsran_dft_plan_free(&q->fft_corr);
   srsran_dft_plan_free(&q->ifft_corr);
+  srsran_dft_plan_free(&q->ifft_band);
   srsran_pbch_nr_free(&q->pbch);
 
   SRSRAN_MEM_ZERO(q, srsran_ssb_t, 1);
@@ -338,6 +376,19 @@ static void ssb_modulate_symbol(srsran_ssb_t* q, cf_t ssb_grid[SRSRAN_SSB_NOF_RE
   }
 }
 
+// Copies len correlation bins centered at the given bin, wrapping around the correlation size
+static void ssb_corr_band_copy(const srsran_ssb_t* q, const cf_t* in, int32_t center, uint32_t len, cf_t* out)
+{
+  int32_t  corr_sz = (int32_t)q->corr_sz;
+  uint32_t idx     = (uint32_t)(((center - (int32_t)len / 2) % corr_sz + corr_sz) % corr_sz);
+
+  for (uint32_t count = 0; count < len; idx = 0) {
+    uint32_t n = SRSRAN_MIN(len - count, q->corr_sz - idx);
+    srsran_vec_cf_copy(&out[count], &in[idx], n);
+    count += n;
+  }
+}
+
 static int ssb_setup_corr(srsran_ssb_t* q)
 {
   // Skip if disabled
@@ -345,14 +396,9 @@ static int ssb_setup_corr(srsran_ssb_t* q)
     return SRSRAN_SUCCESS;
   }
 
-  // Compute new correlation size
+  // Compute new correlation and band sizes
   uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
-
-  // Skip if the symbol size is unchanged
-  if (q->corr_sz == corr_sz) {
-    return SRSRAN_SUCCESS;
-  }
-  q->corr_sz = corr_sz;
+  uint32_t band_sz = SSB_CORR_BAND_SZ(corr_sz, q->symbol_sz);
 
   // Select correlation window, return error if the correlation window is smaller than a symbol
   if (corr_sz < 2 * q->symbol_sz) {
@@ -360,24 +406,47 @@ static int ssb_setup_corr(srsran_ssb_t* q)
     return SRSRAN_ERROR;
   }
   q->corr_window = corr_sz - q->symbol_sz;
+  q->corr_dec    = corr_sz / band_sz;
+  q->corr_shift  = SRSRAN_CEIL(corr_sz, q->symbol_sz);
+  q->corr_center = (int32_t)round((double)q->f_offset * (double)corr_sz / (double)q->symbol_sz);
+
+  // Replan the correlation DFTs only if the size changed
+  if (q->corr_sz != corr_sz) {
+    q->corr_sz = corr_sz;
+
+    // Free correlation
+    srsran_dft_plan_free(&q->fft_corr);
+    srsran_dft_plan_free(&q->ifft_corr);
+
+    // Prepare correlation FFT
+    if (srsran_dft_plan_guru_c(
+            &q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+  }
 
-  // Free correlation
-  srsran_dft_plan_free(&q->fft_corr);
-  srsran_dft_plan_free(&q->ifft_corr);
+  // Replan the decimated correlation IDFT only if the band size changed
+  if (q->corr_band_sz != band_sz) {
+    q->corr_band_sz = band_sz;
 
-  // Prepare correlation FFT
-  if (srsran_dft_plan_guru_c(&q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
-  }
-  if (srsran_dft_plan_guru_c(
-          &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
+    srsran_dft_plan_free(&q->ifft_band);
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_band, (int)band_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning decimated correlation DFT");
+      return SRSRAN_ERROR;
+    }
   }
 
-  // Zero the time domain signal last samples
+  // The sequences depend on the frequency offset, so they are generated even if the sizes are unchanged. Zero the time
+  // domain signal last samples
   srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
 
   // Temporal grid
@@ -399,6 +468,9 @@ static int ssb_setup_corr(srsran_ssb_t* q)
 
     // Copy frequency domain sequence
     srsran_vec_cf_copy(q->pss_seq[N_id_2], q->tmp_freq, q->corr_sz);
+
+    // Keep the bins around the SSB for the decimated detection
+    ssb_corr_band_copy(q, q->pss_seq[N_id_2], q->corr_center, band_sz, &q->pss_band[N_id_2 * band_sz]);
   }
 
   return SRSRAN_SUCCESS;
@@ -850,134 +922,162 @@ static void ssb_vec_prod_conj_circ_shift(const cf_t* a, const cf_t* b, cf_t* c,
   srsran_vec_prod_conj_ccc(a, b, c, n);
 }
 
-static int ssb_pss_search(srsran_ssb_t* q,
-                          const cf_t*   in,
-                          uint32_t      nof_samples,
-                          uint32_t*     found_N_id_2,
-                          uint32_t*     found_delay,
-                          float*        coarse_cfo_hz)
+// PSS detection candidate
+typedef struct {
+  float    corr;   // Normalised correlation
+  uint32_t delay;  // Delay in the input buffer, a multiple of the decimation if it is coarse
+  uint32_t N_id_2; // PSS sequence
+  int      shift;  // Correlation bins steered for the coarse CFO
+} ssb_pss_candidate_t;
+
+// Loads the input window starting at t_offset into the correlation and converts it to frequency domain in tmp_freq
+static void ssb_corr_load(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t t_offset)
 {
-  // verify it is initialised
-  if (q->corr_sz == 0) {
-    return SRSRAN_ERROR;
-  }
+  // Number of samples taken, detect if the correlation input exceeds the input length
+  uint32_t n = (t_offset < nof_samples) ? SRSRAN_MIN(q->corr_sz, nof_samples - t_offset) : 0;
 
-  // Calculate correlation CFO coarse precision
-  double coarse_cfo_ref_hz = (q->cfg.srate_hz / q->corr_sz);
+  // Copy the amount of samples
+  srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
 
-  // Calculate shift integer range to detect the signal with a maximum CFO equal to the SSB subcarrier spacing
-  int shift_range = (int)ceil(SRSRAN_SUBC_SPACING_NR(q->cfg.scs) / coarse_cfo_ref_hz);
+  // Append zeros if there is space left
+  if (n < q->corr_sz) {
+    srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  }
 
-  // Calculate the coarse shift increment for half of the subcarrier spacing
-  int shift_coarse_inc = shift_range / 2;
+  // Convert to frequency domain
+  srsran_dft_run_guru_c(&q->fft_corr);
+}
 
-  // Correlation best sequence
-  float    best_corr   = 0;
-  uint32_t best_delay  = 0;
-  uint32_t best_N_id_2 = 0;
-  int      best_shift  = 0;
+// Correlates the received band in tmp_band with a PSS band steered by shift bins. As only the bins around the SSB are
+// kept, the correlation in tmp_time is decimated by corr_dec
+static void ssb_pss_corr_band(srsran_ssb_t* q, const cf_t* pss_band, int shift)
+{
+  // Actual correlation in frequency domain
+  srsran_vec_prod_conj_ccc(&q->tmp_band[(int)q->corr_shift - shift], pss_band, q->tmp_corr, q->corr_band_sz);
 
-  // Delay in correlation window
-  uint32_t t_offset = 0;
-  while ((t_offset + q->symbol_sz) < nof_samples) {
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
+  // Convert to time domain
+  srsran_dft_run_guru_c(&q->ifft_band);
+}
 
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (t_offset + q->corr_sz > nof_samples) {
-      n = nof_samples - t_offset;
-    }
+// Detects the PSS in the window loaded in tmp_freq for every N_id_2 and coarse CFO, at the decimated rate
+static void ssb_pss_coarse(srsran_ssb_t*        q,
+                           const cf_t*          pss_band,
+                           int32_t              center,
+                           uint32_t             t_offset,
+                           ssb_pss_candidate_t* best)
+{
+  // Take the received band with the margin for steering the CFO
+  ssb_corr_band_copy(q, q->tmp_freq, center, q->corr_band_sz + 2 * q->corr_shift, q->tmp_band);
 
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+  // Decimated correlation window
+  uint32_t window = SRSRAN_MAX(q->corr_window / q->corr_dec, 1);
 
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
-    }
+  // Calculate the coarse shift increment for half of the subcarrier spacing
+  int shift_range      = (int)q->corr_shift;
+  int shift_coarse_inc = SRSRAN_MAX(shift_range / 2, 1);
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
+  // Try each N_id_2 sequence
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+    // Steer coarse frequency offset
+    for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
+      ssb_pss_corr_band(q, &pss_band[N_id_2 * q->corr_band_sz], shift);
+
+      // Find maximum
+      uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, window);
+
+      // Average power, take total power of the frequency domain signal after filtering, it is negligible outside the
+      // band. Skip correlation window if value is invalid (0.0, nan or inf)
+      float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_band_sz) / (float)q->corr_dec;
+      if (!isnormal(avg_pwr_corr)) {
+        continue;
+      }
 
-    // Try each N_id_2 sequence
-    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
-      // Steer coarse frequency offset
-      for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
-        // Actual correlation in frequency domain
-        ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, shift);
-
-        // Convert to time domain
-        srsran_dft_run_guru_c(&q->ifft_corr);
-
-        // Find maximum
-        uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
-
-        // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
-        // value is invalid (0.0, nan or inf)
-        float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
-        if (!isnormal(avg_pwr_corr)) {
-          continue;
-        }
-
-        // Normalise correlation
-        float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
-
-        // Update if the correlation is better than the current best
-        if (best_corr < corr) {
-          best_corr   = corr;
-          best_delay  = peak_idx + t_offset;
-          best_N_id_2 = N_id_2;
-          best_shift  = shift;
-        }
+      // Normalise correlation
+      float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+
+      // Update if the correlation is better than the current best
+      if (best->corr < corr) {
+        best->corr   = corr;
+        best->delay  = t_offset + peak_idx * q->corr_dec;
+        best->N_id_2 = N_id_2;
+        best->shift  = shift;
       }
     }
+  }
+}
 
-    // Advance time
-    t_offset += q->corr_window;
+// Refines a coarse delay at full rate, the peak is searched within one decimation period around it
+static uint32_t ssb_pss_refine(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, const ssb_pss_candidate_t* c)
+{
+  if (q->corr_dec <= 1) {
+    return c->delay;
   }
 
-  // From the best sequence correlate in frequency domain
-  {
-    // Reset best correlation
-    best_corr = 0.0f;
+  // Correlate the window starting one decimation period before the coarse delay
+  uint32_t t_offset = c->delay - SRSRAN_MIN(c->delay, q->corr_dec);
+  ssb_corr_load(q, in, nof_samples, t_offset);
+  ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[c->N_id_2], q->tmp_corr, q->corr_sz, c->shift);
+  srsran_dft_run_guru_c(&q->ifft_corr);
+
+  // Find maximum
+  return t_offset + srsran_vec_max_abs_ci(q->tmp_time, SRSRAN_MIN(2 * q->corr_dec + 1, q->corr_window));
+}
 
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
+// Estimates the CFO in correlation bins from the best sequence correlated in frequency domain
+static int ssb_pss_fine_cfo(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t delay)
+{
+  float best_corr  = 0.0f;
+  int   best_shift = 0;
 
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (best_delay + q->corr_sz > nof_samples) {
-      n = nof_samples - best_delay;
-    }
+  // Convert to frequency domain the window starting at the delay
+  ssb_corr_load(q, in, nof_samples, delay);
 
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[best_delay], n);
+  for (int shift = -(int)q->corr_shift; shift <= (int)q->corr_shift; shift++) {
+    // Actual correlation in frequency domain
+    ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, shift);
+
+    // Calculate correlation assuming the peak is in the first sample
+    float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
 
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+    // Update if the correlation is better than the current best
+    if (best_corr < corr) {
+      best_corr  = corr;
+      best_shift = shift;
     }
+  }
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
+  return best_shift;
+}
 
-    for (int shift = -shift_range; shift <= shift_range; shift++) {
-      // Actual correlation in frequency domain
-      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[best_N_id_2], q->tmp_corr, q->corr_sz, shift);
+static int ssb_pss_search(srsran_ssb_t* q,
+                          const cf_t*   in,
+                          uint32_t      nof_samples,
+                          uint32_t*     found_N_id_2,
+                          uint32_t*     found_delay,
+                          float*        coarse_cfo_hz)
+{
+  // verify it is initialised
+  if (q->corr_sz == 0) {
+    return SRSRAN_ERROR;
+  }
 
-      // Calculate correlation assuming the peak is in the first sample
-      float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
+  // Calculate correlation CFO coarse precision
+  double coarse_cfo_ref_hz = (q->cfg.srate_hz / q->corr_sz);
 
-      // Update if the correlation is better than the current best
-      if (best_corr < corr) {
-        best_corr  = corr;
-        best_shift = shift;
-      }
-    }
+  // Detect the PSS at the decimated rate in every correlation window
+  ssb_pss_candidate_t best = {};
+  for (uint32_t t_offset = 0; (t_offset + q->symbol_sz) < nof_samples; t_offset += q->corr_window) {
+    ssb_corr_load(q, in, nof_samples, t_offset);
+    ssb_pss_coarse(q, q->pss_band, q->corr_center, t_offset, &best);
   }
 
+  // Refine the delay of the best candidate at full rate, then its CFO
+  uint32_t best_delay = ssb_pss_refine(q, in, nof_samples, &best);
+  int      best_shift = ssb_pss_fine_cfo(q, in, nof_samples, best.N_id_2, best_delay);
+
   // Save findings
   *found_delay   = best_delay;
-  *found_N_id_2  = best_N_id_2;
+  *found_N_id_2  = best.N_id_2;
   *coarse_cfo_hz = -(float)best_shift * coarse_cfo_ref_hz;
 
   return SRSRAN_SUCCESS;
@@ -1267,32 +1367,15 @@ int srsran_ssb_decode_pbch(srsran_ssb_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+// Demodulates the SSB found at the given delay, and decodes its PBCH
+static int ssb_search_decode(srsran_ssb_t*            q,
+                             const cf_t*              in,
+                             uint32_t                 nof_samples,
+                             uint32_t                 N_id_2,
+                             uint32_t                 t_offset,
+                             float                    coarse_cfo_hz,
+                             srsran_ssb_search_res_t* res)
 {
-  // Verify inputs
-  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  if (!q->args.enable_search || !q->args.enable_decode) {
-    ERROR("SSB is not configured to search (%c) and decode (%c)",
-          q->args.enable_search ? 'y' : 'n',
-          q->args.enable_decode ? 'y' : 'n');
-    return SRSRAN_ERROR;
-  }
-
-  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
-  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
-
-  // Search for PSS in time domain
-  uint32_t N_id_2        = 0;
-  uint32_t t_offset      = 0;
-  float    coarse_cfo_hz = 0.0f;
-  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
-    ERROR("Error searching for N_id_2");
-    return SRSRAN_ERROR;
-  }
-
   // Remove CP offset prior demodulation
   if (t_offset >= q->cp_sz) {
     t_offset -= q->cp_sz;
@@ -1366,53 +1449,162 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
   return SRSRAN_SUCCESS;
 }
 
-static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
+int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
 {
-  // verify it is initialised
-  if (q->corr_sz == 0) {
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
     return SRSRAN_ERROR;
   }
 
-  // Correlation best sequence
-  float    best_corr  = 0;
-  uint32_t best_delay = 0;
+  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
+  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
 
-  // Delay in correlation window
-  uint32_t t_offset = 0;
-  while ((t_offset + q->symbol_sz) < nof_samples) {
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
+  // Search for PSS in time domain
+  uint32_t N_id_2        = 0;
+  uint32_t t_offset      = 0;
+  float    coarse_cfo_hz = 0.0f;
+  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_search_decode(q, in, nof_samples, N_id_2, t_offset, coarse_cfo_hz, res);
+}
 
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (t_offset + q->corr_sz > nof_samples) {
-      n = nof_samples - t_offset;
+// Searches a group of frequencies, the PSS bands of all of them are kept so every window is transformed only once
+static int ssb_search_sweep_group(srsran_ssb_t*            q,
+                                  const cf_t*              in,
+                                  uint32_t                 nof_samples,
+                                  srsran_ssb_cfg_t*        cfg,
+                                  const double*            ssb_freq_hz,
+                                  uint32_t                 nof_freqs,
+                                  srsran_ssb_search_res_t* res)
+{
+  int32_t             center[SSB_SWEEP_MAX_NOF_FREQS] = {};
+  ssb_pss_candidate_t best[SSB_SWEEP_MAX_NOF_FREQS]   = {};
+
+  // Generate the PSS bands of every frequency, the last configured is kept in the first position
+  for (uint32_t i = nof_freqs; i > 0; i--) {
+    cfg->ssb_freq_hz = ssb_freq_hz[i - 1];
+    if (srsran_ssb_set_cfg(q, cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error setting SSB frequency %.3f MHz", ssb_freq_hz[i - 1] / 1e6);
+      return SRSRAN_ERROR;
     }
 
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+    uint32_t sz   = SRSRAN_NOF_NID_2_NR * q->corr_band_sz;
+    center[i - 1] = q->corr_center;
+    if (i > 1) {
+      srsran_vec_cf_copy(&q->pss_band[(i - 1) * sz], q->pss_band, sz);
+    }
+  }
 
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  // Detect the PSS at the decimated rate for every frequency in every correlation window
+  for (uint32_t t_offset = 0; (t_offset + q->symbol_sz) < nof_samples; t_offset += q->corr_window) {
+    ssb_corr_load(q, in, nof_samples, t_offset);
+    for (uint32_t i = 0; i < nof_freqs; i++) {
+      ssb_pss_coarse(q, &q->pss_band[i * SRSRAN_NOF_NID_2_NR * q->corr_band_sz], center[i], t_offset, &best[i]);
     }
+  }
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
+  // Refine and decode every frequency
+  for (uint32_t i = 0; i < nof_freqs; i++) {
+    SRSRAN_MEM_ZERO(&res[i], srsran_ssb_search_res_t, 1);
 
-    // Actual correlation in frequency domain
-    srsran_vec_prod_conj_ccc(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz);
+    cfg->ssb_freq_hz = ssb_freq_hz[i];
+    if (srsran_ssb_set_cfg(q, cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error setting SSB frequency %.3f MHz", ssb_freq_hz[i] / 1e6);
+      return SRSRAN_ERROR;
+    }
+
+    uint32_t delay         = ssb_pss_refine(q, in, nof_samples, &best[i]);
+    int      shift         = ssb_pss_fine_cfo(q, in, nof_samples, best[i].N_id_2, delay);
+    float    coarse_cfo_hz = -(float)shift * (float)(q->cfg.srate_hz / q->corr_sz);
+    if (ssb_search_decode(q, in, nof_samples, best[i].N_id_2, delay, coarse_cfo_hz, &res[i]) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ssb_search_sweep(srsran_ssb_t*            q,
+                            const cf_t*              in,
+                            uint32_t                 nof_samples,
+                            const double*            ssb_freq_hz,
+                            uint32_t                 nof_freqs,
+                            srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || ssb_freq_hz == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Frequencies correlated at once, limited by the allocated PSS bands
+  uint32_t group_sz = SRSRAN_MIN(SRSRAN_MAX(q->args.max_sweep_freqs, 1), SSB_SWEEP_MAX_NOF_FREQS);
+
+  // Search each group of frequencies with a copy of the current configuration
+  srsran_ssb_cfg_t cfg             = q->cfg;
+  double           ssb_freq_cfg_hz = q->cfg.ssb_freq_hz;
+  int              ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_freqs && ret == SRSRAN_SUCCESS; i += group_sz) {
+    uint32_t n = SRSRAN_MIN(group_sz, nof_freqs - i);
+    ret        = ssb_search_sweep_group(q, in, nof_samples, &cfg, &ssb_freq_hz[i], n, &res[i]);
+  }
+
+  // Restore the configured SSB frequency
+  if (nof_freqs > 0) {
+    cfg.ssb_freq_hz = ssb_freq_cfg_hz;
+    if (srsran_ssb_set_cfg(q, &cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error restoring SSB configuration");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
+{
+  // verify it is initialised
+  if (q->corr_sz == 0) {
+    return SRSRAN_ERROR;
+  }
 
-    // Convert to time domain
-    srsran_dft_run_guru_c(&q->ifft_corr);
+  // Decimated correlation window, and symbol length for averaging the power
+  uint32_t window  = SRSRAN_MAX(q->corr_window / q->corr_dec, 1);
+  uint32_t avg_len = SRSRAN_MAX(q->symbol_sz / q->corr_dec, 1);
+
+  // Correlation best sequence
+  ssb_pss_candidate_t best = {};
+  best.N_id_2              = N_id_2;
+
+  // Detect the PSS at the decimated rate in every correlation window
+  for (uint32_t t_offset = 0; (t_offset + q->symbol_sz) < nof_samples; t_offset += q->corr_window) {
+    ssb_corr_load(q, in, nof_samples, t_offset);
+    ssb_corr_band_copy(q, q->tmp_freq, q->corr_center, q->corr_band_sz + 2 * q->corr_shift, q->tmp_band);
+    ssb_pss_corr_band(q, &q->pss_band[N_id_2 * q->corr_band_sz], 0);
 
     // Find maximum
-    uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
+    uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, window);
 
     // Average power, skip window if value is invalid (0.0, nan or inf)
-    float avg_pwr_corr = srsran_vec_avg_power_cf(&q->tmp_time[peak_idx], q->symbol_sz);
+    float avg_pwr_corr =
+        srsran_vec_avg_power_cf(&q->tmp_time[peak_idx], SRSRAN_MIN(avg_len, q->corr_band_sz - peak_idx));
     if (!isnormal(avg_pwr_corr)) {
-      // Advance time
-      t_offset += q->corr_window;
       continue;
     }
 
@@ -1420,17 +1612,14 @@ static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, u
     float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
 
     // Update if the correlation is better than the current best
-    if (best_corr < corr) {
-      best_corr  = corr;
-      best_delay = peak_idx + t_offset;
+    if (best.corr < corr) {
+      best.corr  = corr;
+      best.delay = t_offset + peak_idx * q->corr_dec;
     }
-
-    // Advance time
-    t_offset += q->corr_window;
   }
 
-  // Save findings
-  *found_delay = best_delay;
+  // Save findings, refined at full rate
+  *found_delay = ssb_pss_refine(q, in, nof_samples, &best);
 
   return SRSRAN_SUCCESS;
 }
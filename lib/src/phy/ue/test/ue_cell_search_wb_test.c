@@ -0,0 +1,285 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/sync/pss.h"
+#include "srsran/phy/sync/sss.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define MAX_CHANNELS 32
+#define FRAME_LEN (10 * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB))
+
+static uint32_t ratio        = 16;
+static uint32_t nof_channels = 12;
+static uint32_t nof_frames   = 6;
+static uint32_t nof_threads  = 4;
+static float    snr_dB       = 3.0f;
+
+static srsran_random_t random_gen = NULL;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [rcnts]\n", prog);
+  printf("\t-r Capture sampling rate over %.2f MHz [Default %d]\n", SRSRAN_CS_SAMP_FREQ / 1e6, ratio);
+  printf("\t-c Number of channels, cells are placed in every other one [Default %d]\n", nof_channels);
+  printf("\t-n Number of 10 ms frames in the capture [Default %d]\n", nof_frames);
+  printf("\t-t Number of threads, 0 for one per CPU core [Default %d]\n", nof_threads);
+  printf("\t-s SNR of every cell in dB [Default %.1f]\n", snr_dB);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rcntsv")) != -1) {
+    switch (opt) {
+      case 'r':
+        ratio = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        nof_channels = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), MAX_CHANNELS);
+        break;
+      case 'n':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates one FDD frame of a 6 PRB cell with random QPSK data around the PSS and SSS */
+static int gen_cell_frame(uint32_t cell_id, cf_t* frame)
+{
+  srsran_ofdm_t ofdm                       = {};
+  uint32_t      nof_re                     = SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+  cf_t          pss_signal[SRSRAN_PSS_LEN] = {};
+  float         sss_signal0[SRSRAN_SSS_LEN];
+  float         sss_signal5[SRSRAN_SSS_LEN];
+
+  cf_t* grid = srsran_vec_cf_malloc(nof_re);
+  if (grid == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_pss_generate(pss_signal, cell_id % 3);
+  srsran_sss_generate(sss_signal0, sss_signal5, cell_id);
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME && ret == SRSRAN_SUCCESS; sf_idx++) {
+    cf_t* sf = &frame[sf_idx * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB)];
+    if (srsran_ofdm_tx_init(&ofdm, SRSRAN_CP_NORM, grid, sf, SRSRAN_CS_NOF_PRB)) {
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    for (uint32_t i = 0; i < nof_re; i++) {
+      grid[i] = (srsran_random_uniform_int_dist(random_gen, 0, 1) ? M_SQRT1_2 : -M_SQRT1_2) +
+                (srsran_random_uniform_int_dist(random_gen, 0, 1) ? M_SQRT1_2 : -M_SQRT1_2) * I;
+    }
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss_signal, grid, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx == 0 ? sss_signal0 : sss_signal5, grid, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ofdm);
+    srsran_ofdm_tx_free(&ofdm);
+  }
+
+  free(grid);
+  return ret;
+}
+
+/* Adds a cell at the given frequency offset, normalised to the capture sampling rate, and with the given delay */
+static int add_cell(uint32_t cell_id, double freq, uint32_t delay, cf_t* capture, uint32_t nof_samples)
+{
+  srsran_resampler_fft_t interp = {};
+  uint32_t               len    = nof_samples / ratio;
+  cf_t*                  frame  = srsran_vec_cf_malloc(FRAME_LEN);
+  cf_t*                  cell   = srsran_vec_cf_malloc(len);
+  cf_t*                  wide   = srsran_vec_cf_malloc(nof_samples);
+  if (frame == NULL || cell == NULL || wide == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (gen_cell_frame(cell_id, frame) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < len; i++) {
+    cell[i] = frame[(i + delay) % FRAME_LEN];
+  }
+
+  // Normalise the power in the cell bandwidth, so that the SNR does not depend on the capture bandwidth
+  srsran_vec_sc_prod_cfc(cell, 1.0f / sqrtf(srsran_vec_avg_power_cf(cell, len)), cell, len);
+  if (ratio > 1) {
+    if (srsran_resampler_fft_init(&interp, SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    srsran_resampler_fft_run(&interp, cell, wide, len);
+    srsran_resampler_fft_free(&interp);
+  } else {
+    srsran_vec_cf_copy(wide, cell, len);
+  }
+
+  for (uint32_t i = 0; i < nof_samples; i++) {
+    capture[i] += wide[i] * cexpf(I * (float)(2.0 * M_PI * fmod(freq * i, 1.0)));
+  }
+
+  free(frame);
+  free(cell);
+  free(wide);
+  return SRSRAN_SUCCESS;
+}
+
+static int scan(srsran_ue_cellsearch_wb_t* cs, const cf_t* capture, uint32_t nof_samples, uint32_t* nof_found)
+{
+  struct timeval t[3] = {};
+
+  gettimeofday(&t[1], NULL);
+  int n = srsran_ue_cellsearch_wb_scan(cs, capture, nof_samples);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  if (n < SRSRAN_SUCCESS) {
+    ERROR("Error scanning capture");
+    return SRSRAN_ERROR;
+  }
+
+  double duration_s = t[0].tv_sec + t[0].tv_usec * 1e-6;
+  printf("%2d threads: %d channels in %.3f s, found %d cells, %.1f cells/s, %.1f channels/s\n",
+         cs->nof_workers,
+         cs->nof_channels,
+         duration_s,
+         n,
+         n / duration_s,
+         cs->nof_channels / duration_s);
+  *nof_found = (uint32_t)n;
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_ue_cellsearch_wb_t      cs[2] = {};
+  srsran_channel_awgn_t          awgn  = {};
+  srsran_ue_cellsearch_wb_args_t args  = {};
+  double                         channel_freq_hz[MAX_CHANNELS];
+  int32_t                        cell_id[MAX_CHANNELS];
+  int                            ret = SRSRAN_SUCCESS;
+
+  parse_args(argc, argv);
+  random_gen = srsran_random_init(1234);
+
+  args.srate_hz         = ratio * SRSRAN_CS_SAMP_FREQ;
+  args.center_freq_hz   = 2680e6;
+  args.max_samples      = nof_frames * FRAME_LEN * ratio;
+  args.max_frames       = SRSRAN_DEFAULT_MAX_FRAMES_PSS;
+  args.nof_valid_frames = SRSRAN_DEFAULT_NOF_VALID_PSS_FRAMES;
+
+  cf_t* capture = srsran_vec_cf_malloc(args.max_samples);
+  if (capture == NULL) {
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_cf_zero(capture, args.max_samples);
+
+  // Channels on the 100 kHz raster spread over the capture bandwidth, every other one with a cell at a random timing
+  // and a small frequency error
+  double span = args.srate_hz - 2 * SRSRAN_CS_SAMP_FREQ;
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    double offset      = round((-span / 2 + span * c / SRSRAN_MAX(nof_channels - 1, 1)) / 100e3) * 100e3;
+    channel_freq_hz[c] = args.center_freq_hz + offset;
+    cell_id[c]         = -1;
+    if (c % 2 == 0) {
+      cell_id[c]     = srsran_random_uniform_int_dist(random_gen, 0, 503);
+      uint32_t delay = srsran_random_uniform_int_dist(random_gen, 0, FRAME_LEN - 1);
+      double   cfo   = srsran_random_uniform_real_dist(random_gen, -2000.0f, 2000.0f);
+      if (add_cell(cell_id[c], (offset + cfo) / args.srate_hz, delay, capture, args.max_samples)) {
+        ERROR("Error generating cell");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // Every cell has unit power within its bandwidth
+  srsran_channel_awgn_init(&awgn, 1234);
+  srsran_channel_awgn_set_n0(&awgn, -snr_dB + srsran_convert_power_to_dB(args.srate_hz / SRSRAN_CS_SAMP_FREQ));
+  srsran_channel_awgn_run_c(&awgn, capture, capture, args.max_samples);
+
+  // Sequential scan for reference, then the parallel one
+  uint32_t nof_found[2] = {};
+  for (uint32_t i = 0; i < 2 && ret == SRSRAN_SUCCESS; i++) {
+    args.nof_threads = (i == 0) ? 1 : nof_threads;
+    if (srsran_ue_cellsearch_wb_init(&cs[i], &args, channel_freq_hz, nof_channels)) {
+      ERROR("Error initialising wideband cell search");
+      return SRSRAN_ERROR;
+    }
+    ret = scan(&cs[i], capture, args.max_samples, &nof_found[i]);
+  }
+
+  // Both scans shall find every cell in its channel
+  for (uint32_t c = 0; c < nof_channels && ret == SRSRAN_SUCCESS; c++) {
+    for (uint32_t i = 0; i < 2; i++) {
+      const srsran_ue_cellsearch_wb_channel_t* ch = &cs[i].channels[c];
+      if (cell_id[c] < 0) {
+        continue;
+      }
+      const srsran_ue_cellsearch_result_t* res = &ch->found_cells[cell_id[c] % 3];
+      if (ch->nof_cells == 0 || res->cell_id != (uint32_t)cell_id[c]) {
+        ERROR("Channel %.1f MHz: cell %d not found", ch->freq_hz / 1e6, cell_id[c]);
+        ret = SRSRAN_ERROR;
+      }
+    }
+    const srsran_ue_cellsearch_wb_channel_t* ch = &cs[1].channels[c];
+    if (ch->nof_cells > 0) {
+      const srsran_ue_cellsearch_result_t* res = &ch->found_cells[ch->max_N_id_2];
+      printf("%.1f MHz: cell_id=%3d (expected %3d), psr=%.1f, cfo=%+.1f kHz\n",
+             ch->freq_hz / 1e6,
+             res->cell_id,
+             cell_id[c],
+             res->psr,
+             res->cfo / 1e3);
+    }
+  }
+
+  srsran_ue_cellsearch_wb_free(&cs[0]);
+  srsran_ue_cellsearch_wb_free(&cs[1]);
+  srsran_channel_awgn_free(&awgn);
+  srsran_random_free(random_gen);
+  free(capture);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -298,8 +298,8 @@ int main(int argc, char** argv)
     return clean_exit(ret);
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  if (srsran_softbuffer_rx_init_guru_8bit(
+          &softbuffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     return clean_exit(ret);
   }
@@ -0,0 +1,267 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/* Longest stream a scan of one N_id_2 reads, one frame more than the scanned frames to account for the alignment */
+#define CELL_SEARCH_WB_MAX_STREAM_LEN(max_frames) (((max_frames) + 1) * 5 * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB))
+
+/* Reads the stream of the channel being scanned by the worker, wrapping around at its end */
+static int cellsearch_wb_recv(void* h, void* data, uint32_t nsamples, srsran_timestamp_t* t)
+{
+  srsran_ue_cellsearch_wb_worker_t* w     = (srsran_ue_cellsearch_wb_worker_t*)h;
+  srsran_ue_cellsearch_wb_t*        q     = (srsran_ue_cellsearch_wb_t*)w->parent;
+  cf_t*                             out   = (cf_t*)data;
+  uint32_t                          count = 0;
+
+  while (count < nsamples) {
+    uint32_t n = SRSRAN_MIN(nsamples - count, q->stream_len - w->read_idx);
+    if (out != NULL) {
+      srsran_vec_cf_copy(&out[count], &w->stream[w->read_idx], n);
+    }
+    count += n;
+    w->read_idx = (w->read_idx + n) % q->stream_len;
+  }
+
+  return (int)nsamples;
+}
+
+/* Scans all N_id_2 of the next pending channel until there are none left */
+static void* cellsearch_wb_worker(void* arg)
+{
+  srsran_ue_cellsearch_wb_worker_t* w = (srsran_ue_cellsearch_wb_worker_t*)arg;
+  srsran_ue_cellsearch_wb_t*        q = (srsran_ue_cellsearch_wb_t*)w->parent;
+
+  while (true) {
+    pthread_mutex_lock(&q->mutex);
+    uint32_t c = q->next_channel++;
+    pthread_mutex_unlock(&q->mutex);
+    if (c >= q->nof_channels) {
+      break;
+    }
+
+    srsran_ue_cellsearch_wb_channel_t* ch       = &q->channels[c];
+    float                              max_peak = -1.0f;
+    w->stream                                   = q->stream[c];
+    ch->nof_cells                               = 0;
+    ch->max_N_id_2                              = 0;
+    memset(ch->found_cells, 0, sizeof(ch->found_cells));
+
+    for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+      w->read_idx = 0;
+      int n       = srsran_ue_cellsearch_scan_N_id_2(&w->cs, N_id_2, &ch->found_cells[N_id_2]);
+      if (n < 0) {
+        ERROR("Error searching cell at %.1f MHz", ch->freq_hz / 1e6);
+        w->ret = SRSRAN_ERROR;
+        return NULL;
+      }
+      if (n > 0) {
+        ch->nof_cells++;
+        if (ch->found_cells[N_id_2].peak > max_peak) {
+          max_peak       = ch->found_cells[N_id_2].peak;
+          ch->max_N_id_2 = N_id_2;
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t*            q,
+                                 const srsran_ue_cellsearch_wb_args_t* args,
+                                 const double*                         channel_freq_hz,
+                                 uint32_t                              nof_channels)
+{
+  if (q == NULL || args == NULL || channel_freq_hz == NULL || nof_channels == 0 || args->max_frames == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t ratio = (uint32_t)round(args->srate_hz / SRSRAN_CS_SAMP_FREQ);
+  if (ratio == 0 || fabs(ratio * SRSRAN_CS_SAMP_FREQ - args->srate_hz) > 1.0) {
+    ERROR("Invalid sampling rate %.2f MHz, it shall be a multiple of %.2f MHz",
+          args->srate_hz / 1e6,
+          SRSRAN_CS_SAMP_FREQ / 1e6);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_ue_cellsearch_wb_t));
+  q->args = *args;
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    return SRSRAN_ERROR;
+  }
+
+  q->channels = calloc(nof_channels, sizeof(srsran_ue_cellsearch_wb_channel_t));
+  q->stream   = calloc(nof_channels, sizeof(cf_t*));
+  if (q->channels == NULL || q->stream == NULL) {
+    perror("malloc");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->nof_channels = nof_channels;
+
+  // Channel centres normalised to the capture sampling rate
+  double* freq_offset = malloc(sizeof(double) * nof_channels);
+  if (freq_offset == NULL) {
+    perror("malloc");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    q->channels[c].freq_hz = channel_freq_hz[c];
+    freq_offset[c]         = (channel_freq_hz[c] - args->center_freq_hz) / args->srate_hz;
+    if (fabs(freq_offset[c]) >= 0.5) {
+      ERROR("Channel %.1f MHz is out of the capture bandwidth", channel_freq_hz[c] / 1e6);
+      free(freq_offset);
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+  int err = srsran_channelizer_init(&q->channelizer, ratio, freq_offset, nof_channels);
+  free(freq_offset);
+  if (err < SRSRAN_SUCCESS) {
+    ERROR("Error initialising channelizer");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // The streams only need to be as long as the longest scan, they wrap around otherwise
+  uint32_t max_stream_len = SRSRAN_MIN(args->max_samples / ratio, CELL_SEARCH_WB_MAX_STREAM_LEN(args->max_frames));
+  for (uint32_t c = 0; c < nof_channels; c++) {
+    q->stream[c] = srsran_vec_cf_malloc(max_stream_len + SRSRAN_CHANNELIZER_WINDOW_SZ);
+    if (q->stream[c] == NULL) {
+      perror("malloc");
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // More workers than cores would only add context switches
+  uint32_t nof_threads = args->nof_threads;
+  if (nof_threads == 0) {
+    nof_threads = (uint32_t)SRSRAN_MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+  }
+  q->nof_workers = SRSRAN_MIN(nof_threads, nof_channels);
+  q->workers     = calloc(q->nof_workers, sizeof(srsran_ue_cellsearch_wb_worker_t));
+  if (q->workers == NULL) {
+    perror("malloc");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < q->nof_workers; i++) {
+    srsran_ue_cellsearch_wb_worker_t* w = &q->workers[i];
+    w->parent                           = q;
+    if (srsran_ue_cellsearch_init(&w->cs, args->max_frames, cellsearch_wb_recv, w)) {
+      ERROR("Error initiating UE cell detect");
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+    if (args->nof_valid_frames > 0) {
+      srsran_ue_cellsearch_set_nof_valid_frames(&w->cs, args->nof_valid_frames);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->workers) {
+    for (uint32_t i = 0; i < q->nof_workers; i++) {
+      if (q->workers[i].parent) {
+        srsran_ue_cellsearch_free(&q->workers[i].cs);
+      }
+    }
+    free(q->workers);
+  }
+  if (q->stream) {
+    for (uint32_t c = 0; c < q->nof_channels; c++) {
+      if (q->stream[c]) {
+        free(q->stream[c]);
+      }
+    }
+    free(q->stream);
+  }
+  if (q->channels) {
+    free(q->channels);
+  }
+  srsran_channelizer_free(&q->channelizer);
+  pthread_mutex_destroy(&q->mutex);
+
+  memset(q, 0, sizeof(srsran_ue_cellsearch_wb_t));
+}
+
+int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t* q, const cf_t* samples, uint32_t nof_samples)
+{
+  if (q == NULL || samples == NULL || nof_samples > q->args.max_samples) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Channelize the part of the capture that the scans read, all channels share the input DFT
+  uint32_t ratio = q->channelizer.ratio;
+  uint32_t len   = SRSRAN_MIN(nof_samples, CELL_SEARCH_WB_MAX_STREAM_LEN(q->args.max_frames) * ratio);
+  srsran_channelizer_reset(&q->channelizer);
+  q->stream_len = srsran_channelizer_run(&q->channelizer, samples, q->stream, len);
+  if (q->stream_len == 0) {
+    ERROR("Capture of %d samples is too short", nof_samples);
+    return SRSRAN_ERROR;
+  }
+
+  // Every worker scans channels until all of them are done, the started ones finish the channels of any that failed
+  uint32_t nof_started = 0;
+  int      ret         = SRSRAN_SUCCESS;
+  q->next_channel      = 0;
+  for (; nof_started < q->nof_workers; nof_started++) {
+    q->workers[nof_started].ret = SRSRAN_SUCCESS;
+    if (pthread_create(&q->workers[nof_started].thread, NULL, cellsearch_wb_worker, &q->workers[nof_started])) {
+      ERROR("Error creating cell search thread");
+      ret = SRSRAN_ERROR;
+      break;
+    }
+  }
+  for (uint32_t i = 0; i < nof_started; i++) {
+    pthread_join(q->workers[i].thread, NULL);
+    if (q->workers[i].ret < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  uint32_t nof_cells = 0;
+  for (uint32_t c = 0; c < q->nof_channels; c++) {
+    nof_cells += q->channels[c].nof_cells;
+  }
+  return (int)nof_cells;
+}
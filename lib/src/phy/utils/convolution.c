@@ -25,6 +25,7 @@
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 int srsran_conv_fft_cc_init(srsran_conv_fft_cc_t* q, uint32_t input_len, uint32_t filter_len)
@@ -176,6 +177,31 @@ uint32_t srsran_conv_same_cc(cf_t* input, cf_t* filter, cf_t* output, uint32_t i
   return N;
 }
 
+/* Filters the outputs for which the whole filter overlaps the input, computing a SIMD register of outputs at a time
+ * tap by tap instead of one dot product per output. As the filter is real, the interleaved real and imaginary parts
+ * are filtered as independent floats. Returns the number of outputs computed. In-place filtering keeps the sequential
+ * implementation, in which every output is computed from the previous filtered outputs.
+ */
+static uint32_t
+conv_same_cf_simd(const cf_t* input, const float* filter, cf_t* output, uint32_t nof_outputs, uint32_t M)
+{
+  uint32_t i = 0;
+#if SRSRAN_SIMD_F_SIZE
+  const float* in_ptr  = (const float*)input;
+  float*       out_ptr = (float*)output;
+
+  for (; i + SRSRAN_SIMD_F_SIZE / 2 <= nof_outputs; i += SRSRAN_SIMD_F_SIZE / 2) {
+    simd_f_t acc = srsran_simd_f_zero();
+    for (uint32_t k = 0; k < M; k++) {
+      simd_f_t x = srsran_simd_f_loadu(&in_ptr[2 * (i + k)]);
+      acc        = srsran_simd_f_add(acc, srsran_simd_f_mul(x, srsran_simd_f_set1(filter[k])));
+    }
+    srsran_simd_f_storeu(&out_ptr[2 * i], acc);
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+  return i;
+}
+
 #define conv_same_extrapolates_extremes
 
 #ifdef conv_same_extrapolates_extremes
@@ -207,6 +233,9 @@ uint32_t srsran_conv_same_cf(cf_t* input, float* filter, cf_t* output, uint32_t
     output[i] = srsran_vec_dot_prod_cfc(&first[i], filter, M);
   }
 
+  if (N > 2 * (M / 2) && (output + N <= input || input + N <= output)) {
+    i += conv_same_cf_simd(input, filter, &output[i], N - 2 * (M / 2), M);
+  }
   for (; i < N - M / 2; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, M);
   }
@@ -227,6 +256,9 @@ uint32_t srsran_conv_same_cf(cf_t* input, float* filter, cf_t* output, uint32_t
   for (i = 0; i < M / 2; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&input[i], &filter[M / 2 - i], M - M / 2 + i);
   }
+  if (N > 2 * (M / 2) && (output + N <= input || input + N <= output)) {
+    i += conv_same_cf_simd(input, filter, &output[i], N - 2 * (M / 2), M);
+  }
   for (; i < N - M / 2; i++) {
     output[i] = srsran_vec_dot_prod_cfc(&input[i - M / 2], filter, M);
   }
@@ -20,28 +20,25 @@
  */
 
 #include "srsran/rlc/rlc.h"
-#include "srsran/common/rwlock_guard.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_tm.h"
 #include "srsran/rlc/rlc_um_lte.h"
 #include "srsran/rlc/rlc_um_nr.h"
+#include <thread>
 
 namespace srsran {
 
-rlc::rlc(const char* logname) : logger(srslog::fetch_basic_logger(logname)), pool(byte_buffer_pool::get_instance())
-{
-  pthread_rwlock_init(&rwlock, NULL);
-}
+rlc::rlc(const char* logname) : logger(srslog::fetch_basic_logger(logname)), pool(byte_buffer_pool::get_instance()) {}
 
 rlc::~rlc()
 {
   // destroy all remaining entities
-  {
-    srsran::rwlock_write_guard lock(rwlock);
-    rlc_array.clear();
-    rlc_array_mrb.clear();
+  for (bearer_slot& slot : rlc_array) {
+    slot.unpublish();
+  }
+  for (bearer_slot& slot : rlc_array_mrb) {
+    slot.unpublish();
   }
-  pthread_rwlock_destroy(&rwlock);
 }
 
 void rlc::init(srsue::pdcp_interface_rlc* pdcp_,
@@ -72,12 +69,16 @@ void rlc::init(srsue::pdcp_interface_rlc* pdcp_,
 
 void rlc::reset_metrics()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->reset_metrics();
+  for (bearer_slot& slot : rlc_array) {
+    if (slot.entity != nullptr) {
+      slot.entity->reset_metrics();
+    }
   }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->reset_metrics();
+  for (bearer_slot& slot : rlc_array_mrb) {
+    if (slot.entity != nullptr) {
+      slot.entity->reset_metrics();
+    }
   }
 
   metrics_tp = std::chrono::high_resolution_clock::now();
@@ -85,11 +86,15 @@ void rlc::reset_metrics()
 
 void rlc::stop()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->stop();
+  for (bearer_slot& slot : rlc_array) {
+    if (slot.entity != nullptr) {
+      slot.entity->stop();
+    }
   }
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->stop();
+  for (bearer_slot& slot : rlc_array_mrb) {
+    if (slot.entity != nullptr) {
+      slot.entity->stop();
+    }
   }
 }
 
@@ -97,8 +102,11 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 {
   std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - metrics_tp;
 
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    rlc_bearer_metrics_t metrics = it->second->get_metrics();
+  for (uint32_t lcid = 0; lcid < rlc_array.size(); ++lcid) {
+    if (rlc_array[lcid].entity == nullptr) {
+      continue;
+    }
+    rlc_bearer_metrics_t metrics = rlc_array[lcid].entity->get_metrics();
 
     // Rx/Tx rate based on real time
     double rx_rate_mbps_real_time = (metrics.num_rx_pdu_bytes * 8 / (double)1e6) / secs.count();
@@ -109,21 +117,24 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
     double tx_rate_mbps = (nof_tti > 0) ? ((metrics.num_tx_pdu_bytes * 8 / (double)1e6) / (nof_tti / 1000.0)) : 0.0;
 
     logger.debug("lcid=%d, rx_rate_mbps=%4.2f (real=%4.2f), tx_rate_mbps=%4.2f (real=%4.2f)",
-                 it->first,
+                 lcid,
                  rx_rate_mbps,
                  rx_rate_mbps_real_time,
                  tx_rate_mbps,
                  tx_rate_mbps_real_time);
-    m.bearer[it->first] = metrics;
+    m.bearer[lcid] = metrics;
   }
 
   // Add multicast metrics
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    rlc_bearer_metrics_t metrics = it->second->get_metrics();
+  for (uint32_t lcid = 0; lcid < rlc_array_mrb.size(); ++lcid) {
+    if (rlc_array_mrb[lcid].entity == nullptr) {
+      continue;
+    }
+    rlc_bearer_metrics_t metrics = rlc_array_mrb[lcid].entity->get_metrics();
     logger.debug("MCH_LCID=%d, rx_rate_mbps=%4.2f",
-                 it->first,
+                 lcid,
                  (metrics.num_rx_pdu_bytes * 8 / static_cast<double>(1e6)) / secs.count());
-    m.bearer[it->first] = metrics;
+    m.bearer[lcid] = metrics;
   }
 
   reset_metrics();
@@ -132,12 +143,16 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 // Reestablish all RLC bearer
 void rlc::reestablish()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->reestablish();
+  for (bearer_slot& slot : rlc_array) {
+    if (slot.entity != nullptr) {
+      slot.entity->reestablish();
+    }
   }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->reestablish();
+  for (bearer_slot& slot : rlc_array_mrb) {
+    if (slot.entity != nullptr) {
+      slot.entity->reestablish();
+    }
   }
 
   reset_metrics();
@@ -148,7 +163,7 @@ void rlc::reestablish(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
     logger.info("Reestablishing LCID %d", lcid);
-    rlc_array.at(lcid)->reestablish();
+    rlc_array[lcid].entity->reestablish();
   } else {
     logger.warning("RLC LCID %d doesn't exist.", lcid);
   }
@@ -158,12 +173,11 @@ void rlc::reestablish(uint32_t lcid)
 // All LCIDs are removed, except SRB0
 void rlc::reset()
 {
-  {
-    rwlock_write_guard lock(rwlock);
-    rlc_array.clear();
-    // the multicast bearer (MRB) is not removed here because eMBMS services continue to be streamed in idle mode (3GPP
-    // TS 23.246 version 14.1.0 Release 14 section 8)
+  for (bearer_slot& slot : rlc_array) {
+    slot.unpublish();
   }
+  // the multicast bearer (MRB) is not removed here because eMBMS services continue to be streamed in idle mode (3GPP
+  // TS 23.246 version 14.1.0 Release 14 section 8)
 
   // Add SRB0 again
   add_bearer(default_lcid, rlc_config_t());
@@ -172,8 +186,10 @@ void rlc::reset()
 void rlc::empty_queue()
 {
   // Empty Tx queue, not needed for MCH bearers
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->empty_queue();
+  for (bearer_slot& slot : rlc_array) {
+    if (slot.entity != nullptr) {
+      slot.entity->empty_queue();
+    }
   }
 }
 
@@ -190,7 +206,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_sdu_s(std::move(sdu));
+    rlc_array[lcid].entity->write_sdu_s(std::move(sdu));
     update_bsr(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -200,7 +216,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
 void rlc::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_sdu(std::move(sdu));
+    rlc_array_mrb[lcid].entity->write_sdu(std::move(sdu));
     update_bsr_mch(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -212,9 +228,9 @@ bool rlc::rb_is_um(uint32_t lcid)
   bool ret = false;
 
   if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->get_mode() == rlc_mode_t::um;
+    ret = rlc_array[lcid].entity->get_mode() == rlc_mode_t::um;
   } else if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_mode() == rlc_mode_t::um;
+    ret = rlc_array_mrb[lcid].entity->get_mode() == rlc_mode_t::um;
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
   }
@@ -225,7 +241,7 @@ bool rlc::rb_is_um(uint32_t lcid)
 void rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 {
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->discard_sdu(discard_sn);
+    rlc_array[lcid].entity->discard_sdu(discard_sn);
     update_bsr(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Ignoring discard SDU", lcid);
@@ -235,32 +251,32 @@ void rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 bool rlc::sdu_queue_is_full(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    return rlc_array.at(lcid)->sdu_queue_is_full();
+    return rlc_array[lcid].entity->sdu_queue_is_full();
   } else if (valid_lcid_mrb(lcid)) {
-    return rlc_array_mrb.at(lcid)->sdu_queue_is_full();
+    return rlc_array_mrb[lcid].entity->sdu_queue_is_full();
   }
   logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
   return false;
 }
 
 /*******************************************************************************
-  MAC interface (mostly called from PHY workers, lock needs to be hold)
+  MAC interface (mostly called from PHY workers, bearers are accessed through a bearer_guard)
 *******************************************************************************/
 bool rlc::has_data_locked(const uint32_t lcid)
 {
-  rwlock_read_guard lock(rwlock);
-  return has_data(lcid);
+  bearer_guard bearer(rlc_array, lcid);
+  return bearer.get() != nullptr and bearer.get()->has_data();
 }
 
 void rlc::get_buffer_state(uint32_t lcid, uint32_t& tx_queue, uint32_t& prio_tx_queue)
 {
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->is_suspended()) {
+  bearer_guard bearer(rlc_array, lcid);
+  if (bearer.get() != nullptr) {
+    if (bearer.get()->is_suspended()) {
       tx_queue      = 0;
       prio_tx_queue = 0;
     } else {
-      rlc_array.at(lcid)->get_buffer_state(tx_queue, prio_tx_queue);
+      bearer.get()->get_buffer_state(tx_queue, prio_tx_queue);
     }
   }
 }
@@ -276,9 +292,9 @@ uint32_t rlc::get_total_mch_buffer_state(uint32_t lcid)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_buffer_state();
+  bearer_guard bearer(rlc_array_mrb, lcid);
+  if (bearer.get() != nullptr) {
+    ret = bearer.get()->get_buffer_state();
   }
 
   return ret;
@@ -288,9 +304,11 @@ uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->read_pdu(payload, nof_bytes);
+  bearer_guard bearer(rlc_array, lcid);
+  if (bearer.get() != nullptr) {
+    ret = bearer.get()->read_pdu(payload, nof_bytes);
+    // The MAC has taken the PDU out of its own buffer state, so the next report is never filtered
+    bsr_filters[lcid].reset();
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -305,9 +323,9 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->read_pdu(payload, nof_bytes);
+  bearer_guard bearer(rlc_array_mrb, lcid);
+  if (bearer.get() != nullptr) {
+    ret = bearer.get()->read_pdu(payload, nof_bytes);
     update_bsr_mch(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -318,11 +336,11 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   return ret;
 }
 
-// Write PDU methods are called from Stack thread context, no need to acquire the lock
+// Write PDU methods are called from Stack thread context, no need for a bearer_guard
 void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_pdu_s(payload, nof_bytes);
+    rlc_array[lcid].entity->write_pdu_s(payload, nof_bytes);
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist. Dropping PDU.", lcid);
@@ -361,19 +379,19 @@ void rlc::write_pdu_pcch(srsran::unique_byte_buffer_t pdu)
 void rlc::write_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_pdu(payload, nof_bytes);
+    rlc_array_mrb[lcid].entity->write_pdu(payload, nof_bytes);
   }
 }
 
 /*******************************************************************************
-  RRC interface (write-lock ONLY needs to be hold for all calls modifying the RLC array)
+  RRC interface (called from Stack thread, the only one modifying the RLC arrays)
 *******************************************************************************/
 bool rlc::is_suspended(const uint32_t lcid)
 {
   bool ret = false;
 
   if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->is_suspended();
+    ret = rlc_array[lcid].entity->is_suspended();
   }
 
   return ret;
@@ -384,17 +402,19 @@ bool rlc::has_data(uint32_t lcid)
   bool has_data = false;
 
   if (valid_lcid(lcid)) {
-    has_data = rlc_array.at(lcid)->has_data();
+    has_data = rlc_array[lcid].entity->has_data();
   }
 
   return has_data;
 }
 
-// Methods modifying the RLC array need to acquire the write-lock
+// Methods modifying the RLC arrays publish or unpublish the entities used by the MAC
 int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 {
-  rwlock_write_guard lock(rwlock);
-
+  if (lcid >= rlc_array.size()) {
+    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_RADIO_BEARERS, lcid);
+    return SRSRAN_ERROR;
+  }
   if (valid_lcid(lcid)) {
     logger.warning("LCID %d already exists", lcid);
     return SRSRAN_ERROR;
@@ -451,21 +471,33 @@ int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
     }
   }
 
-  rlc_entity->set_bsr_callback(bsr_callback);
-
-  if (not rlc_array.emplace(lcid, std::move(rlc_entity)).second) {
-    logger.error("Error inserting RLC entity in to array.");
-    return SRSRAN_ERROR;
+  if (bsr_callback) {
+    bsr_filters[lcid].reset();
+    rlc_entity->set_bsr_callback([this](uint32_t lcid_, uint32_t tx_queue, uint32_t prio_tx_queue) {
+      report_bsr(lcid_, tx_queue, prio_tx_queue);
+    });
   }
 
+  rlc_array[lcid].publish(std::move(rlc_entity));
+
   logger.info("Added %s radio bearer with LCID %d in %s", to_string(cnfg.rat), lcid, to_string(cnfg.rlc_mode));
+  if (cnfg.aqm.type != rlc_aqm_type_t::none) {
+    logger.info("Enabled %s AQM in LCID %d - target=%d ms, interval=%d ms",
+                to_string(cnfg.aqm.type).c_str(),
+                lcid,
+                cnfg.aqm.target_ms,
+                cnfg.aqm.interval_ms);
+  }
 
   return SRSRAN_SUCCESS;
 }
 
 int rlc::add_bearer_mrb(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
+  if (lcid >= rlc_array_mrb.size()) {
+    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_MCH_LCIDS, lcid);
+    return SRSRAN_ERROR;
+  }
   if (not valid_lcid_mrb(lcid)) {
     std::unique_ptr<rlc_common> rlc_entity =
         std::unique_ptr<rlc_common>(new rlc_um_lte(logger, lcid, pdcp, rrc, timers));
@@ -475,12 +507,7 @@ int rlc::add_bearer_mrb(uint32_t lcid)
       return SRSRAN_ERROR;
     }
     rlc_entity->set_bsr_callback(bsr_callback);
-    if (rlc_array_mrb.count(lcid) == 0) {
-      if (not rlc_array_mrb.emplace(lcid, std::move(rlc_entity)).second) {
-        logger.error("Error inserting RLC entity in to array.");
-        return SRSRAN_ERROR;
-      }
-    }
+    rlc_array_mrb[lcid].publish(std::move(rlc_entity));
     logger.info("Added bearer MRB%d with mode RLC_UM", lcid);
   } else {
     logger.info("Bearer MRB%d already created.", lcid);
@@ -491,12 +518,9 @@ int rlc::add_bearer_mrb(uint32_t lcid)
 
 void rlc::del_bearer(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
-
   if (valid_lcid(lcid)) {
-    rlc_map_t::iterator it = rlc_array.find(lcid);
-    it->second->stop();
-    rlc_array.erase(it);
+    std::unique_ptr<rlc_common> rlc_entity = rlc_array[lcid].unpublish();
+    rlc_entity->stop();
     logger.info("Deleted RLC bearer with LCID %d", lcid);
   } else {
     logger.error("Can't delete bearer with LCID %d. Bearer doesn't exist.", lcid);
@@ -505,12 +529,9 @@ void rlc::del_bearer(uint32_t lcid)
 
 void rlc::del_bearer_mrb(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
-
   if (valid_lcid_mrb(lcid)) {
-    rlc_map_t::iterator it = rlc_array_mrb.find(lcid);
-    it->second->stop();
-    rlc_array_mrb.erase(it);
+    std::unique_ptr<rlc_common> rlc_entity = rlc_array_mrb[lcid].unpublish();
+    rlc_entity->stop();
     logger.info("Deleted RLC MRB bearer with LCID %d", lcid);
   } else {
     logger.error("Can't delete bearer with LCID %d. Bearer doesn't exist.", lcid);
@@ -519,19 +540,12 @@ void rlc::del_bearer_mrb(uint32_t lcid)
 
 void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
 {
-  rwlock_write_guard lock(rwlock);
-
   // make sure old LCID exists and new LCID is still free
-  if (valid_lcid(old_lcid) && not valid_lcid(new_lcid)) {
-    // insert old rlc entity into new LCID
-    rlc_map_t::iterator         it         = rlc_array.find(old_lcid);
-    std::unique_ptr<rlc_common> rlc_entity = std::move(it->second);
-    if (not rlc_array.emplace(new_lcid, std::move(rlc_entity)).second) {
-      logger.error("Error inserting RLC entity into array.");
-      return;
-    }
-    // erase from old position
-    rlc_array.erase(it);
+  if (new_lcid < rlc_array.size() && valid_lcid(old_lcid) && not valid_lcid(new_lcid)) {
+    // move the rlc entity from the old to the new LCID
+    rlc_array[new_lcid].publish(rlc_array[old_lcid].unpublish());
+    bsr_filters[old_lcid].reset();
+    bsr_filters[new_lcid].reset();
 
     if (valid_lcid(new_lcid) && not valid_lcid(old_lcid)) {
       logger.info("Successfully changed LCID of RLC bearer from %d to %d", old_lcid, new_lcid);
@@ -545,11 +559,11 @@ void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
   }
 }
 
-// Further RRC calls executed from Stack thread, no need to hold lock
+// Further RRC calls executed from Stack thread, no need for a bearer_guard
 void rlc::suspend_bearer(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->suspend()) {
+    if (rlc_array[lcid].entity->suspend()) {
       logger.info("Suspended radio bearer with LCID %d", lcid);
     } else {
       logger.error("Error suspending RLC entity: bearer already suspended.");
@@ -563,7 +577,7 @@ void rlc::resume_bearer(uint32_t lcid)
 {
   logger.info("Resuming radio LCID %d", lcid);
   if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->resume()) {
+    if (rlc_array[lcid].entity->resume()) {
       logger.info("Resumed radio LCID %d", lcid);
     } else {
       logger.error("Error resuming RLC entity: bearer not suspended.");
@@ -580,7 +594,7 @@ bool rlc::has_bearer(uint32_t lcid)
 }
 
 /*******************************************************************************
-  Helpers (Lock must be hold when calling those)
+  Helpers (only called from Stack thread)
 *******************************************************************************/
 bool rlc::valid_lcid(uint32_t lcid)
 {
@@ -589,7 +603,7 @@ bool rlc::valid_lcid(uint32_t lcid)
     return false;
   }
 
-  if (rlc_array.find(lcid) == rlc_array.end()) {
+  if (rlc_array[lcid].entity == nullptr) {
     return false;
   }
 
@@ -603,7 +617,7 @@ bool rlc::valid_lcid_mrb(uint32_t lcid)
     return false;
   }
 
-  if (rlc_array_mrb.find(lcid) == rlc_array_mrb.end()) {
+  if (rlc_array_mrb[lcid].entity == nullptr) {
     return false;
   }
 
@@ -618,6 +632,14 @@ void rlc::update_bsr(uint32_t lcid)
   }
 }
 
+// Forwards the buffer state computed by an entity to the MAC, only if the occupancy level changed since the last report
+void rlc::report_bsr(uint32_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue)
+{
+  if (lcid >= bsr_filters.size() or bsr_filters[lcid].update(tx_queue, prio_tx_queue)) {
+    bsr_callback(lcid, tx_queue, prio_tx_queue);
+  }
+}
+
 void rlc::update_bsr_mch(uint32_t lcid)
 {
   if (bsr_callback) {
@@ -625,6 +647,22 @@ void rlc::update_bsr_mch(uint32_t lcid)
   }
 }
 
+void rlc::bearer_slot::publish(std::unique_ptr<rlc_common> entity_)
+{
+  entity = std::move(entity_);
+  published.store(entity.get());
+}
+
+// Hides the entity from the MAC, and waits for the MAC accesses that may still use it to finish
+std::unique_ptr<rlc_common> rlc::bearer_slot::unpublish()
+{
+  published.store(nullptr);
+  while (nof_readers.load() > 0) {
+    std::this_thread::yield();
+  }
+  return std::move(entity);
+}
+
 void rlc_bearer_metrics_print(const rlc_bearer_metrics_t& metrics)
 {
   std::cout << "num_tx_sdus=" << metrics.num_tx_sdus << "\n";
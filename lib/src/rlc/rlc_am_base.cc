@@ -136,9 +136,8 @@ void rlc_am::write_sdu(unique_byte_buffer_t sdu)
 {
   uint32_t nof_bytes = sdu->N_bytes;
   if (tx_base->write_sdu(std::move(sdu)) == SRSRAN_SUCCESS) {
-    std::lock_guard<std::mutex> lock(metrics_mutex);
-    metrics.num_tx_sdus++;
-    metrics.num_tx_sdu_bytes += nof_bytes;
+    hot_metrics.num_tx_sdus.fetch_add(1, std::memory_order_relaxed);
+    hot_metrics.num_tx_sdu_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
   }
 }
 
@@ -146,8 +145,7 @@ void rlc_am::discard_sdu(uint32_t discard_sn)
 {
   tx_base->discard_sdu(discard_sn);
 
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_lost_sdus++;
+  hot_metrics.num_lost_sdus.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool rlc_am::sdu_queue_is_full()
@@ -178,9 +176,10 @@ uint32_t rlc_am::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t read_bytes = tx_base->read_pdu(payload, nof_bytes);
 
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_tx_pdus += read_bytes > 0 ? 1 : 0;
-  metrics.num_tx_pdu_bytes += read_bytes;
+  if (read_bytes > 0) {
+    hot_metrics.num_tx_pdus.fetch_add(1, std::memory_order_relaxed);
+    hot_metrics.num_tx_pdu_bytes.fetch_add(read_bytes, std::memory_order_relaxed);
+  }
   return read_bytes;
 }
 
@@ -188,9 +187,8 @@ void rlc_am::write_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   rx_base->write_pdu(payload, nof_bytes);
 
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_rx_pdus++;
-  metrics.num_rx_pdu_bytes += nof_bytes;
+  hot_metrics.num_rx_pdus.fetch_add(1, std::memory_order_relaxed);
+  hot_metrics.num_rx_pdu_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
 }
 
 /****************************************************************************
@@ -205,6 +203,13 @@ rlc_bearer_metrics_t rlc_am::get_metrics()
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics.rx_latency_ms     = latency;
   metrics.rx_buffered_bytes = buffered_bytes;
+  metrics.num_tx_sdus       = hot_metrics.num_tx_sdus.load(std::memory_order_relaxed);
+  metrics.num_tx_sdu_bytes  = hot_metrics.num_tx_sdu_bytes.load(std::memory_order_relaxed);
+  metrics.num_lost_sdus     = hot_metrics.num_lost_sdus.load(std::memory_order_relaxed);
+  metrics.num_tx_pdus       = hot_metrics.num_tx_pdus.load(std::memory_order_relaxed);
+  metrics.num_tx_pdu_bytes  = hot_metrics.num_tx_pdu_bytes.load(std::memory_order_relaxed);
+  metrics.num_rx_pdus       = hot_metrics.num_rx_pdus.load(std::memory_order_relaxed);
+  metrics.num_rx_pdu_bytes  = hot_metrics.num_rx_pdu_bytes.load(std::memory_order_relaxed);
   return metrics;
 }
 
@@ -212,6 +217,13 @@ void rlc_am::reset_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics = {};
+  hot_metrics.num_tx_sdus.store(0, std::memory_order_relaxed);
+  hot_metrics.num_tx_sdu_bytes.store(0, std::memory_order_relaxed);
+  hot_metrics.num_lost_sdus.store(0, std::memory_order_relaxed);
+  hot_metrics.num_tx_pdus.store(0, std::memory_order_relaxed);
+  hot_metrics.num_tx_pdu_bytes.store(0, std::memory_order_relaxed);
+  hot_metrics.num_rx_pdus.store(0, std::memory_order_relaxed);
+  hot_metrics.num_rx_pdu_bytes.store(0, std::memory_order_relaxed);
 }
 
 /****************************************************************************
@@ -229,8 +241,6 @@ void rlc_am::set_bsr_callback(bsr_callback_t callback)
  *******************************************************/
 int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   if (!tx_enabled) {
     return SRSRAN_ERROR;
   }
@@ -243,6 +253,14 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
   // Get SDU info
   uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
 
+  if (not aqm.enqueue(*sdu, tx_sdu_queue.size_bytes())) {
+    RlcDebug("[AQM] Dropped Tx SDU (%d B, PDCP_SN=%ld, tx_sdu_queue_len=%d)",
+             sdu->N_bytes,
+             sdu_pdcp_sn,
+             tx_sdu_queue.size());
+    return SRSRAN_ERROR;
+  }
+
   // Store SDU
   uint8_t*                                 msg_ptr   = sdu->msg;
   uint32_t                                 nof_bytes = sdu->N_bytes;
@@ -270,19 +288,10 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   if (!tx_enabled) {
     return;
   }
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-      return true;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard(discard_sn);
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -85,6 +85,7 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
   // make sure Tx queue is empty before attempting to resize
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  aqm.configure(cfg_.aqm);
 
   tx_enabled = true;
 
@@ -425,10 +426,7 @@ int rlc_am_lte_tx::build_status_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   RlcDebug("Generating status PDU. Nof bytes %d", nof_bytes);
   int pdu_len = rx->get_status_pdu(&tx_status, nof_bytes);
-  if (pdu_len == SRSRAN_ERROR) {
-    RlcDebug("Deferred Status PDU. Cause: Failed to acquire Rx lock");
-    pdu_len = 0;
-  } else if (pdu_len > 0 && nof_bytes >= static_cast<uint32_t>(pdu_len)) {
+  if (pdu_len > 0 && nof_bytes >= static_cast<uint32_t>(pdu_len)) {
     log_rlc_am_status_pdu_to_string(logger.info, rb_name, "Tx status PDU - %s", &tx_status);
     if (cfg.t_status_prohibit > 0 && status_prohibit_timer.is_valid()) {
       // re-arm timer
@@ -816,7 +814,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     }
 
     do {
-      tx_sdu = tx_sdu_queue.read();
+      tx_sdu = aqm.read(tx_sdu_queue);
     } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
     if (tx_sdu == nullptr) {
       if (header.N_li > 0) {
@@ -1233,6 +1231,7 @@ void rlc_am_lte_rx::stop()
 void rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
+  sync_status();
 
   rlc_amd_pdu_header_t header      = {};
   uint32_t             payload_len = nof_bytes;
@@ -1246,6 +1245,7 @@ void rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   } else {
     handle_data_pdu_full(payload, payload_len, header);
   }
+  publish_status();
 }
 
 /** Called from stack thread when MAC has received a new RLC PDU
@@ -1369,8 +1369,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1412,8 +1410,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.has_sn(header.sn)) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
       do_status = true;
@@ -1421,15 +1418,16 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
     // Add segment to PDU list and check for complete
     // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    // The segments may have been removed already, if the reassembled PDU was delivered
+    if (add_segment_and_check(&rx_segments[header.sn], &segment) && rx_segments.has_sn(header.sn)) {
+      rx_segments.remove_pdu(header.sn);
     }
 
   } else {
     // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
+    rlc_amd_rx_pdu_segments_t& pdu = rx_segments.add_pdu(header.sn);
+    pdu.add_received(segment.header, segment.buf->N_bytes);
     pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1585,19 +1583,16 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     // Move the rx_window
     RlcDebug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
+    if (rx_segments.has_sn(vr_r)) {
       RlcDebug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
+      for (const rlc_amd_rx_pdu& seg : rx_segments[vr_r].segments) {
         RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                 segit->header.sn,
-                 segit->header.so,
-                 segit->buf->N_bytes,
-                 segit->header.N_li);
+                 seg.header.sn,
+                 seg.header.so,
+                 seg.buf->N_bytes,
+                 seg.header.N_li);
       }
-      it->second.segments.clear();
+      rx_segments.remove_pdu(vr_r);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -1611,9 +1606,48 @@ void rlc_am_lte_rx::reset_status()
   poll_received = false;
 }
 
+/**
+ * Clears the pending status report once the Tx entity has sent the last published status.
+ * Caller _must_ hold the mutex when calling the function.
+ */
+void rlc_am_lte_rx::sync_status()
+{
+  if (do_status && status_sent_seq.load(std::memory_order_acquire) == status_seq.load(std::memory_order_relaxed)) {
+    reset_status();
+  }
+}
+
+/**
+ * Makes the current Rx state available to the Tx entity, if a status report is pending.
+ * Caller _must_ hold the mutex when calling the function.
+ */
+void rlc_am_lte_rx::publish_status()
+{
+  if (not do_status) {
+    return;
+  }
+  status_snapshot_t& snapshot = status_buffer.write_buffer();
+  snapshot.seq                = status_seq.load(std::memory_order_relaxed) + 1;
+  snapshot.vr_r               = vr_r;
+  snapshot.vr_ms              = vr_ms;
+  snapshot.missing_sns.clear();
+  for (uint32_t i = vr_r; RX_MOD_BASE(i) < RX_MOD_BASE(vr_ms) && not snapshot.missing_sns.full(); i = (i + 1) % MOD) {
+    if (not rx_window.has_sn(i)) {
+      snapshot.missing_sns.push_back(i);
+    }
+  }
+  rlc_status_pdu_t status = {};
+  status.ack_sn           = vr_ms;
+  status.N_nack           = snapshot.missing_sns.size();
+  snapshot.packed_len     = rlc_am_packed_length(&status);
+  status_buffer.publish();
+  status_seq.store(snapshot.seq, std::memory_order_release);
+}
+
 bool rlc_am_lte_rx::get_do_status()
 {
-  return do_status.load(std::memory_order_relaxed);
+  return do_status.load(std::memory_order_relaxed) and
+         status_seq.load(std::memory_order_acquire) != status_sent_seq.load(std::memory_order_relaxed);
 }
 
 uint32_t rlc_am_lte_rx::get_rx_buffered_bytes()
@@ -1637,6 +1671,7 @@ void rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
 {
   std::lock_guard<std::mutex> lock(mutex);
   if (reordering_timer.is_valid() and reordering_timer.id() == timeout_id) {
+    sync_status();
     RlcDebug("reordering timeout expiry - updating vr_ms (was %d)", vr_ms);
 
     // 36.322 v10 Section 5.1.3.2.4
@@ -1655,30 +1690,31 @@ void rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
     }
 
     debug_state();
+    publish_status();
   }
 }
 
-// Called from Tx object to pack status PDU that doesn't exceed a given size
-// If lock-acquisition fails, return -1. Otherwise it returns the length of the generated PDU.
+// Called from Tx object to pack status PDU that doesn't exceed a given size, based on the last status published by the
+// Rx entity. Returns the length of the generated PDU.
 int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_pdu_size)
 {
-  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
-  if (not lock.owns_lock()) {
-    return SRSRAN_ERROR;
-  }
+  status_buffer.update();
+  const status_snapshot_t& snapshot = status_buffer.read_buffer();
 
   status->N_nack = 0;
-  status->ack_sn = vr_r; // start with lower edge of the rx window
+  status->ack_sn = snapshot.vr_r; // start with lower edge of the rx window
 
   // We don't use segment NACKs - just NACK the full PDU
-  uint32_t i = vr_r;
-  while (RX_MOD_BASE(i) <= RX_MOD_BASE(vr_ms) && status->N_nack < RLC_AM_WINDOW_SIZE) {
-    if (rx_window.has_sn(i) || i == vr_ms) {
-      // only update ACK_SN if this SN has been received, or if we reached the maximum possible SN
-      status->ack_sn = i;
-    } else {
+  uint32_t i        = snapshot.vr_r;
+  uint32_t nack_idx = 0;
+  while ((i - snapshot.vr_r) % MOD <= (snapshot.vr_ms - snapshot.vr_r) % MOD && status->N_nack < RLC_AM_WINDOW_SIZE) {
+    if (nack_idx < snapshot.missing_sns.size() && snapshot.missing_sns[nack_idx] == i) {
       status->nacks[status->N_nack].nack_sn = i;
       status->N_nack++;
+      nack_idx++;
+    } else {
+      // only update ACK_SN if this SN has been received, or if we reached the maximum possible SN
+      status->ack_sn = i;
     }
 
     // make sure we don't exceed grant size
@@ -1688,10 +1724,10 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
         RlcDebug("Removing last NACK SN=%d", status->nacks[status->N_nack].nack_sn);
         status->N_nack--;
         // make sure we don't have the current ACK_SN in the NACK list
-        if (rlc_am_is_valid_status_pdu(*status, vr_r) == false) {
+        if (rlc_am_is_valid_status_pdu(*status, snapshot.vr_r) == false) {
           // No space to send any NACKs, play safe and just ack lower edge
           RlcWarning("Resetting ACK_SN and N_nack to initial state");
-          status->ack_sn = vr_r;
+          status->ack_sn = snapshot.vr_r;
           status->N_nack = 0;
         }
       } else {
@@ -1706,8 +1742,8 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
     i = (i + 1) % MOD;
   }
 
-  // valid PDU could be generated
-  reset_status();
+  // valid PDU could be generated. The Rx entity clears the pending status on its next event
+  status_sent_seq.store(snapshot.seq, std::memory_order_release);
 
   return rlc_am_packed_length(status);
 }
@@ -1715,30 +1751,20 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
 // Called from Tx object to obtain length of the full status PDU
 int rlc_am_lte_rx::get_status_pdu_length()
 {
-  std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
-  if (not lock.owns_lock()) {
-    return 0;
-  }
-  rlc_status_pdu_t status = {};
-  status.ack_sn           = vr_ms;
-  uint32_t i              = vr_r;
-  while (RX_MOD_BASE(i) < RX_MOD_BASE(vr_ms) && status.N_nack < RLC_AM_WINDOW_SIZE) {
-    if (not rx_window.has_sn(i)) {
-      status.N_nack++;
-    }
-    i = (i + 1) % MOD;
-  }
-  return rlc_am_packed_length(&status);
+  status_buffer.update();
+  return status_buffer.read_buffer().packed_len;
 }
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
+  for (uint32_t sn = vr_r; sn != vr_mr; sn = (sn + 1) % MOD) {
+    if (not rx_segments.has_sn(sn)) {
+      continue;
+    }
     std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
+    for (segit = rx_segments[sn].segments.begin(); segit != rx_segments[sn].segments.end(); segit++) {
       ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
          << " N_li: " << segit->header.N_li << std::endl;
     }
@@ -1749,6 +1775,8 @@ void rlc_am_lte_rx::print_rx_segments()
 // NOTE: Preference would be to capture by value, and then move; but header is stack allocated
 bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment)
 {
+  pdu->add_received(segment->header, segment->buf->N_bytes);
+
   // Find segment insertion point in the list of segments
   auto it1 = pdu->segments.begin();
   while (it1 != pdu->segments.end() && (*it1).header.so < segment->header.so) {
@@ -1777,15 +1805,14 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
   }
 
   // Check for complete
+  if (not pdu->is_complete()) {
+    return false;
+  }
+
+  // Drop the segments that are fully overlapped by the previous ones
   uint32_t                            so = 0;
   std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
   for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
-    // Check that there is no gap between last segment and current; overlap allowed
-    if (so < it->header.so) {
-      // return
-      return false;
-    }
-
     // Check if segment is overlapped
     if (it->header.so + it->buf->N_bytes <= so) {
       // completely overlapped with previous segments, erase
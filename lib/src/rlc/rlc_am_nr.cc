@@ -26,6 +26,7 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_am_nr_packing.h"
 #include "srsran/srslog/event_trace.h"
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -73,12 +74,15 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
       RlcError("attempt to configure unsupported tx_sn_field_length %s", to_string(cfg.tx_sn_field_length));
       return false;
   }
+  retx_queue_sns.resize(mod_nr);
+  retx_queue_sns.reset();
 
   max_hdr_size = min_hdr_size + so_size;
 
   // make sure Tx queue is empty before attempting to resize
   empty_queue_no_lock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  aqm.configure(cfg_.aqm);
 
   // Check timers are valid
   if (not poll_retransmit_timer.is_valid()) {
@@ -196,7 +200,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
   unique_byte_buffer_t tx_sdu;
   RlcDebug("Reading from RLC SDU queue. Queue size %d", tx_sdu_queue.size());
   do {
-    tx_sdu = tx_sdu_queue.read();
+    tx_sdu = aqm.read(tx_sdu_queue);
   } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
 
   if (tx_sdu != nullptr) {
@@ -452,19 +456,16 @@ uint32_t rlc_am_nr_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  rlc_amd_retx_nr_t& retx = retx_queue.front();
-
   // Sanity check - drop any retx SNs not present in tx_window
-  while (not tx_window->has_sn(retx.sn)) {
-    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx.sn);
+  while (not tx_window->has_sn(retx_queue.front().sn)) {
+    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx_queue.front().sn);
     retx_queue.pop();
-    if (!retx_queue.empty()) {
-      retx = retx_queue.front();
-    } else {
+    if (retx_queue.empty()) {
       RlcInfo("empty retx queue, cannot provide any retx PDU");
       return 0;
     }
   }
+  rlc_amd_retx_nr_t& retx = retx_queue.front();
 
   RlcDebug("RETX - SN=%d, is_segment=%s, current_so=%d, so_start=%d, segment_length=%d",
            retx.sn,
@@ -858,35 +859,48 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   RlcDebug("Processed status report ACKs. ACK_SN=%d. Tx_Next_Ack=%d", status.ack_sn, st.tx_next_ack);
 
   // Process N_nacks
-  std::set<uint32_t> retx_sn_set; // Set of PDU SNs added for retransmission (no duplicates)
+  // Index the SNs already queued for retransmission once, instead of searching the queue for every NACK
+  for (const rlc_amd_retx_nr_t& retx : retx_queue.get_inner_queue()) {
+    retx_queue_sns.set(retx.sn);
+  }
+  retx_sn_vec.clear();
   for (uint32_t nack_idx = 0; nack_idx < status.nacks.size(); nack_idx++) {
     if (status.nacks[nack_idx].has_nack_range) {
-      for (uint32_t range_sn = status.nacks[nack_idx].nack_sn;
-           range_sn < status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range;
-           range_sn++) {
+      for (uint32_t range_idx = 0; range_idx < status.nacks[nack_idx].nack_range; range_idx++) {
         rlc_status_nack_t nack = {};
-        nack.nack_sn           = range_sn;
+        nack.nack_sn           = (status.nacks[nack_idx].nack_sn + range_idx) % mod_nr;
         if (status.nacks[nack_idx].has_so) {
           // Apply so_start to first range item
-          if (range_sn == status.nacks[nack_idx].nack_sn) {
+          if (range_idx == 0) {
             nack.so_start = status.nacks[nack_idx].so_start;
           }
           // Apply so_end to last range item
-          if (range_sn == (status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range - 1)) {
+          if (range_idx == status.nacks[nack_idx].nack_range - 1U) {
             nack.so_end = status.nacks[nack_idx].so_end;
           }
           // Enable has_so only if the offsets do not span the whole SDU
           nack.has_so = (nack.so_start != 0) || (nack.so_end != rlc_status_nack_t::so_end_of_sdu);
         }
-        handle_nack(nack, retx_sn_set);
+        handle_nack(nack, retx_sn_vec);
       }
     } else {
-      handle_nack(status.nacks[nack_idx], retx_sn_set);
+      handle_nack(status.nacks[nack_idx], retx_sn_vec);
     }
   }
 
+  // Clear the index, all its bits belong to SNs in the queue
+  for (const rlc_amd_retx_nr_t& retx : retx_queue.get_inner_queue()) {
+    retx_queue_sns.reset(retx.sn);
+  }
+
+  // A malformed or repeated NACK list may name the same SN more than once, but retx_count is increased once per SN
+  std::sort(retx_sn_vec.begin(), retx_sn_vec.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return tx_mod_base_nr(lhs) < tx_mod_base_nr(rhs);
+  });
+  retx_sn_vec.erase(std::unique(retx_sn_vec.begin(), retx_sn_vec.end()), retx_sn_vec.end());
+
   // Process retx_count and inform upper layers if needed
-  for (uint32_t retx_sn : retx_sn_set) {
+  for (uint32_t retx_sn : retx_sn_vec) {
     auto& pdu = (*tx_window)[retx_sn];
     // Increment retx_count
     if (pdu.retx_count == RETX_COUNT_NOT_STARTED) {
@@ -908,8 +922,17 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   notify_info_vec.clear();
 }
 
-void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set)
+/*
+ * Must be called after retx_queue_sns was filled with the SNs of retx_queue.
+ * An SN may be added to retx_sns several times (e.g. once per NACKed segment), the caller removes the duplicates.
+ */
+void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sns)
 {
+  auto add_retx_sn = [this, &retx_sns](uint32_t sn) {
+    retx_queue_sns.set(sn);
+    retx_sns.push_back(sn);
+  };
+
   if (tx_mod_base_nr(st.tx_next_ack) <= tx_mod_base_nr(nack.nack_sn) &&
       tx_mod_base_nr(nack.nack_sn) <= tx_mod_base_nr(st.tx_next)) {
     RlcDebug("Handling NACK for SN=%d", nack.nack_sn);
@@ -925,14 +948,14 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         bool segment_found = false;
         for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
-            if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
+            if (not retx_queue_sns.test(nack.nack_sn) || not retx_queue.has_sn(nack.nack_sn, segm.so)) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
-              retx_sn_set.insert(nack.nack_sn);
+              add_retx_sn(nack.nack_sn);
               RlcInfo("Scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
                       retx.sn,
                       retx.so_start,
@@ -958,7 +981,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
       } else {
         // NACK'ing full SDU.
         // add to retx queue if it's not already there
-        if (not retx_queue.has_sn(nack.nack_sn)) {
+        if (not retx_queue_sns.test(nack.nack_sn)) {
           // Have we segmented the SDU already?
           if ((*tx_window)[nack.nack_sn].segment_list.empty()) {
             rlc_amd_retx_nr_t& retx = retx_queue.push();
@@ -967,11 +990,11 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
             retx.so_start           = 0;
             retx.current_so         = 0;
             retx.segment_length     = pdu.sdu_buf->N_bytes;
-            retx_sn_set.insert(nack.nack_sn);
+            add_retx_sn(nack.nack_sn);
             RlcInfo("Scheduled RETX of SDU SN=%d", retx.sn);
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
-            retx_sn_set.insert(nack.nack_sn);
+            add_retx_sn(nack.nack_sn);
             for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
               retx.sn                 = nack.nack_sn;
@@ -1406,6 +1429,8 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
       RlcError("attempt to configure unsupported rx_sn_field_length %s", to_string(cfg.rx_sn_field_length));
       return false;
   }
+  rx_sdu_received.resize(mod_nr);
+  rx_sdu_received.reset();
 
   RlcDebug("RLC AM NR configured rx entity.");
 
@@ -1430,6 +1455,7 @@ void rlc_am_nr_rx::stop()
 
   // Drop all messages in RX window
   rx_window->clear();
+  rx_sdu_received.reset();
 }
 
 void rlc_am_nr_rx::reestablish()
@@ -1536,20 +1562,9 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      * all bytes have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_highest_status)) {
-      uint32_t sn_upd = 0;
-      for (sn_upd = (st.rx_highest_status + 1) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_highest_status = sn_upd;
+      st.rx_highest_status = find_first_not_received((st.rx_highest_status + 1) % mod_nr, st.rx_next_highest);
     }
     /*
      * - if x = RX_Next:
@@ -1557,24 +1572,15 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      *     have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_next)) {
-      uint32_t sn_upd = 0;
-      // move rx_next forward and remove all fully received SDUs from rx_window
-      for (sn_upd = (st.rx_next) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-          // RX_Next serves as the lower edge of the receiving window
-          // As such, we remove any SDU from the window if we update this value
-          rx_window->remove_pdu(sn_upd);
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_next = sn_upd;
+      uint32_t sn_upd = find_first_not_received(st.rx_next, st.rx_next_highest);
+      // RX_Next serves as the lower edge of the receiving window
+      // As such, we remove all fully received SDUs from the window when we update this value
+      for (; st.rx_next != sn_upd; st.rx_next = (st.rx_next + 1) % mod_nr) {
+        rx_window->remove_pdu(st.rx_next);
+        rx_sdu_received.reset(st.rx_next);
+      }
     }
   }
 
@@ -1656,6 +1662,7 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   rx_sdu.buf->N_bytes   = nof_bytes - hdr_len;
   rx_sdu.fully_received = true;
   rx_sdu.has_gap        = false;
+  rx_sdu_received.set(header.sn);
   return SRSRAN_SUCCESS;
 }
 
@@ -1711,6 +1718,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
       memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
       rx_sdu.buf->N_bytes += it.buf->N_bytes;
     }
+    rx_sdu_received.set(header.sn);
   }
   return SRSRAN_SUCCESS;
 }
@@ -1734,75 +1742,76 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    *   PDU(s) indicated by lower layer:
    */
   RlcDebug("Generating status PDU");
-  for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
-        rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
-        status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
-        // Some segments were received, but not all.
-        // NACK non consecutive missing bytes
-        RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
-        uint32_t last_so         = 0;
-        bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
-            // Some bytes were not received
-            rlc_status_nack_t nack;
-            nack.nack_sn  = i;
-            nack.has_so   = true;
-            nack.so_start = last_so;
-            nack.so_end   = segm->header.so - 1; // set to last missing byte
-            status->push_nack(nack);
-            if (nack.so_start > nack.so_end) {
-              // Print segment list
-              for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
-              }
-              RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
-                       nack.so_start,
-                       nack.so_end,
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end,
-                       segm->header.so);
-              srsran_assert(nack.so_start <= nack.so_end,
-                            "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
-                            nack.so_start,
-                            nack.so_end,
-                            nack.nack_sn);
-            } else {
-              RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end);
-            }
-          }
-          if (segm->header.si == rlc_nr_si_field_t::last_segment) {
-            last_segment_rx = true;
-          }
-          last_so = segm->header.so + segm->buf->N_bytes;
-        } // Segment loop
-        if (not last_segment_rx) {
+  // Fully received SDUs are skipped a word of the bitmap at a time
+  uint32_t i = find_first_not_received(st.rx_next, st.rx_highest_status);
+  for (; i != st.rx_highest_status; i = find_first_not_received((i + 1) % mod_nr, st.rx_highest_status)) {
+    if (not rx_window->has_sn(i)) {
+      // No segment received, NACK the whole SDU
+      RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
+      rlc_status_nack_t nack;
+      nack.nack_sn = i;
+      nack.has_so  = false;
+      status->push_nack(nack);
+    } else if (not(*rx_window)[i].fully_received) {
+      // Some segments were received, but not all.
+      // NACK non consecutive missing bytes
+      RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
+      uint32_t last_so         = 0;
+      bool     last_segment_rx = false;
+      for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
+        if (segm->header.so != last_so) {
+          // Some bytes were not received
           rlc_status_nack_t nack;
           nack.nack_sn  = i;
           nack.has_so   = true;
           nack.so_start = last_so;
-          nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+          nack.so_end   = segm->header.so - 1; // set to last missing byte
           status->push_nack(nack);
-          RlcDebug(
-              "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
-          srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
+          if (nack.so_start > nack.so_end) {
+            // Print segment list
+            for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
+                 segm_it++) {
+              RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
+            }
+            RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
+                     nack.so_start,
+                     nack.so_end,
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end,
+                     segm->header.so);
+            srsran_assert(nack.so_start <= nack.so_end,
+                          "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
+                          nack.so_start,
+                          nack.so_end,
+                          nack.nack_sn);
+          } else {
+            RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end);
+          }
         }
+        if (segm->header.si == rlc_nr_si_field_t::last_segment) {
+          last_segment_rx = true;
+        }
+        last_so = segm->header.so + segm->buf->N_bytes;
+      } // Segment loop
+      if (not last_segment_rx) {
+        rlc_status_nack_t nack;
+        nack.nack_sn  = i;
+        nack.has_so   = true;
+        nack.so_start = last_so;
+        nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+        status->push_nack(nack);
+        RlcDebug("Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
+        srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
       }
     }
+    // NACKs are added in increasing SN order, so once the PDU exceeds max_len the remaining ones would be trimmed
+    if (status->packed_size > max_len) {
+      break;
+    }
   } // NACK loop
 
   /*
@@ -1873,14 +1882,7 @@ void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
      *   - start t-Reassembly;
      *   - set RX_Next_Status_Trigger to RX_Next_Highest.
      */
-    uint32_t sn_upd = {};
-    for (sn_upd = st.rx_next_status_trigger; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-         sn_upd = (sn_upd + 1) % mod_nr) {
-      if (not rx_window->has_sn(sn_upd) || (rx_window->has_sn(sn_upd) && not(*rx_window)[sn_upd].fully_received)) {
-        break;
-      }
-    }
-    st.rx_highest_status = sn_upd;
+    st.rx_highest_status = find_first_not_received(st.rx_next_status_trigger, st.rx_next_highest);
     if (not valid_ack_sn(st.rx_highest_status)) {
       RlcError("Rx_Highest_Status not inside RX window");
       debug_state();
@@ -1980,6 +1982,26 @@ bool rlc_am_nr_rx::inside_rx_window(uint32_t sn) const
   return rx_mod_base_nr(sn) < rx_window_size();
 }
 
+/*
+ * Returns the first SN in [start_sn, stop_sn) of an SDU that was not fully received yet, or stop_sn if all SDUs in
+ * the range were received. The range may wrap around the SN space, in which case it is scanned in two parts.
+ */
+uint32_t rlc_am_nr_rx::find_first_not_received(uint32_t start_sn, uint32_t stop_sn) const
+{
+  if (rx_mod_base_nr(start_sn) >= rx_mod_base_nr(stop_sn)) {
+    return start_sn;
+  }
+  if (start_sn < stop_sn) {
+    int pos = rx_sdu_received.find_lowest(start_sn, stop_sn, false);
+    return pos < 0 ? stop_sn : pos;
+  }
+  int pos = rx_sdu_received.find_lowest(start_sn, mod_nr, false);
+  if (pos < 0) {
+    pos = rx_sdu_received.find_lowest(0, stop_sn, false);
+  }
+  return pos < 0 ? stop_sn : pos;
+}
+
 /*
  * This function is used to check if the Rx_Highest_Status is
  * valid when t-Reasseambly expires.
@@ -71,7 +71,9 @@ void rlc_am_nr_status_pdu_t::push_nack(const rlc_status_nack_t& nack)
   }
 
   rlc_status_nack_t& prev = nacks_.back();
-  if (is_continuous_sequence(prev, nack) == false) {
+  // NACK_range is an 8-bit field, longer sequences of lost SDUs are split over several NACKs
+  uint32_t merged_range = (prev.has_nack_range ? prev.nack_range : 1) + (nack.has_nack_range ? nack.nack_range : 1);
+  if (is_continuous_sequence(prev, nack) == false || merged_range > UINT8_MAX) {
     nacks_.push_back(nack);
     packed_size_ += nack_size(nack);
     return;
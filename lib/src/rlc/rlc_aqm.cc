@@ -0,0 +1,187 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/rlc/rlc_aqm.h"
+#include <cmath>
+
+namespace srsran {
+
+// PIE parameters of RFC 8033, in Hz
+const static double                    pie_alpha     = 0.125;
+const static double                    pie_beta      = 1.25;
+const static std::chrono::microseconds pie_max_burst = std::chrono::milliseconds(150);
+
+void rlc_aqm::configure(const rlc_aqm_config_t& cfg_)
+{
+  cfg      = cfg_;
+  target   = std::chrono::milliseconds(cfg.target_ms);
+  interval = std::chrono::milliseconds(cfg.interval_ms);
+
+  first_above_time = {};
+  drop_next        = {};
+  count            = 0;
+  last_count       = 0;
+  dropping         = false;
+
+  qdelay_us.store(0, std::memory_order_relaxed);
+  qdelay_old      = {};
+  burst_allowance = pie_max_burst;
+  next_update     = {};
+  drop_prob       = 0;
+}
+
+bool rlc_aqm::enqueue(byte_buffer_t& sdu, uint32_t queue_bytes, clock::time_point now)
+{
+  sdu.md.queue_tp = now;
+  if (cfg.type != rlc_aqm_type_t::pie) {
+    return true;
+  }
+  if (now >= next_update) {
+    pie_update(now, queue_bytes);
+  }
+  if (pie_drop(queue_bytes)) {
+    nof_drops.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+unique_byte_buffer_t rlc_aqm::read(spsc_byte_buffer_queue& queue, clock::time_point now)
+{
+  unique_byte_buffer_t sdu = queue.read();
+  if (sdu == nullptr) {
+    return sdu;
+  }
+
+  // SDUs queued before the AQM was configured have no arrival time
+  clock::duration sojourn_time{0};
+  if (sdu->md.queue_tp != clock::time_point{}) {
+    sojourn_time = now - sdu->md.queue_tp;
+  }
+
+  if (cfg.type == rlc_aqm_type_t::pie) {
+    qdelay_us.store(std::chrono::duration_cast<std::chrono::microseconds>(sojourn_time).count(),
+                    std::memory_order_relaxed);
+  } else if (cfg.type == rlc_aqm_type_t::codel and codel_drop(sojourn_time, queue.size_bytes(), now)) {
+    nof_drops.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return sdu;
+}
+
+bool rlc_aqm::codel_ok_to_drop(clock::duration sojourn_time, uint32_t queue_bytes, clock::time_point now)
+{
+  if (sojourn_time < target or queue_bytes <= mtu_bytes) {
+    first_above_time = {};
+    return false;
+  }
+  if (first_above_time == clock::time_point{}) {
+    first_above_time = now + interval;
+    return false;
+  }
+  return now >= first_above_time;
+}
+
+bool rlc_aqm::codel_drop(clock::duration sojourn_time, uint32_t queue_bytes, clock::time_point now)
+{
+  bool ok_to_drop = codel_ok_to_drop(sojourn_time, queue_bytes, now);
+  if (dropping) {
+    if (not ok_to_drop) {
+      // The sojourn time went below the target
+      dropping = false;
+      return false;
+    }
+    if (now < drop_next) {
+      return false;
+    }
+    count++;
+    drop_next += std::chrono::duration_cast<clock::duration>(interval / std::sqrt(count));
+    return true;
+  }
+  if (not ok_to_drop) {
+    return false;
+  }
+
+  // Enter the dropping state, resuming the previous drop rate if it was left recently
+  dropping       = true;
+  uint32_t delta = count - last_count;
+  count          = (delta > 1 and now - drop_next < 16 * interval) ? delta : 1;
+  drop_next      = now + std::chrono::duration_cast<clock::duration>(interval / std::sqrt(count));
+  last_count     = count;
+  return true;
+}
+
+void rlc_aqm::pie_update(clock::time_point now, uint32_t queue_bytes)
+{
+  // The last measured delay is stale once the queue is drained
+  std::chrono::microseconds qdelay{queue_bytes > 0 ? qdelay_us.load(std::memory_order_relaxed) : 0};
+  std::chrono::microseconds target_us = std::chrono::duration_cast<std::chrono::microseconds>(target);
+
+  double p = pie_alpha * (qdelay - target_us).count() * 1e-6 + pie_beta * (qdelay - qdelay_old).count() * 1e-6;
+
+  // Scale the adjustment to the current drop probability, so that it stays stable when it is low
+  if (drop_prob < 0.000001) {
+    p /= 2048;
+  } else if (drop_prob < 0.00001) {
+    p /= 512;
+  } else if (drop_prob < 0.0001) {
+    p /= 128;
+  } else if (drop_prob < 0.001) {
+    p /= 32;
+  } else if (drop_prob < 0.01) {
+    p /= 8;
+  } else if (drop_prob < 0.1) {
+    p /= 2;
+  } else if (p > 0.02) {
+    p = 0.02;
+  }
+  drop_prob += p;
+
+  // Decay when the queue stays empty
+  if (qdelay.count() == 0 and qdelay_old.count() == 0) {
+    drop_prob *= 0.98;
+  }
+  drop_prob = std::min(std::max(drop_prob, 0.0), 1.0);
+
+  std::chrono::microseconds t_update = std::chrono::duration_cast<std::chrono::microseconds>(interval);
+  burst_allowance                    = std::max(burst_allowance - t_update, std::chrono::microseconds{0});
+  if (drop_prob == 0 and qdelay < target_us / 2 and qdelay_old < target_us / 2) {
+    burst_allowance = pie_max_burst;
+  }
+  qdelay_old  = qdelay;
+  next_update = now + interval;
+}
+
+bool rlc_aqm::pie_drop(uint32_t queue_bytes)
+{
+  if (burst_allowance.count() > 0) {
+    return false;
+  }
+  if (qdelay_old < std::chrono::duration_cast<std::chrono::microseconds>(target) / 2 and drop_prob < 0.2) {
+    return false;
+  }
+  if (queue_bytes <= 2 * mtu_bytes) {
+    return false;
+  }
+  return uniform_dist(rng) < drop_prob;
+}
+
+} // namespace srsran
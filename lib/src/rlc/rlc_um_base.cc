@@ -254,17 +254,16 @@ void rlc_um_base::rlc_um_base_tx::empty_queue()
   std::lock_guard<std::mutex> lock(mutex);
 
   // deallocate all SDUs in transmit queue
-  while (not tx_sdu_queue.is_empty()) {
-    unique_byte_buffer_t buf = tx_sdu_queue.read();
-  }
+  tx_sdu_queue.clear();
 
   // deallocate SDU that is currently processed
   tx_sdu.reset();
+  update_tx_sdu_bytes();
 }
 
 bool rlc_um_base::rlc_um_base_tx::has_data()
 {
-  return (tx_sdu != nullptr || !tx_sdu_queue.is_empty());
+  return tx_sdu_bytes.load(std::memory_order_relaxed) > 0 || tx_sdu_queue.get_n_sdus() > 0;
 }
 
 void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
@@ -272,19 +271,13 @@ void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
   bsr_callback = callback;
 }
 
-void rlc_um_base::rlc_um_base_tx::write_sdu(unique_byte_buffer_t sdu)
-{
-  if (sdu) {
-    RlcHexInfo(sdu->msg, sdu->N_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", sdu->N_bytes, tx_sdu_queue.size());
-    tx_sdu_queue.write(std::move(sdu));
-  } else {
-    RlcWarning("NULL SDU pointer in write_sdu()");
-  }
-}
-
 int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 {
   if (sdu) {
+    if (not aqm.enqueue(*sdu, tx_sdu_queue.size_bytes())) {
+      RlcDebug("[AQM] Dropped Tx SDU (%d B, tx_sdu_queue_len=%d)", sdu->N_bytes, tx_sdu_queue.size());
+      return SRSRAN_ERROR;
+    }
     uint8_t*                                 msg_ptr   = sdu->msg;
     uint32_t                                 nof_bytes = sdu->N_bytes;
     srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
@@ -307,15 +300,8 @@ int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-    }
-    return false;
-  });
+  // Called from the same thread that writes SDUs, no need to lock the mutex
+  bool discarded = tx_sdu_queue.discard(discard_sn);
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -333,7 +319,7 @@ uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
 
-    if (tx_sdu == nullptr && tx_sdu_queue.is_empty()) {
+    if (tx_sdu == nullptr && tx_sdu_queue.get_n_sdus() == 0) {
       RlcInfo("No data available to be sent");
       return 0;
     }
@@ -87,14 +87,13 @@ rlc_um_nr::rlc_um_nr_tx::rlc_um_nr_tx(rlc_um_base* parent_) : rlc_um_base_tx(par
 
 uint32_t rlc_um_nr::rlc_um_nr_tx::get_buffer_state()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   // Bytes needed for tx SDUs
-  uint32_t n_sdus  = tx_sdu_queue.get_n_sdus();
-  uint32_t n_bytes = tx_sdu_queue.size_bytes();
-  if (tx_sdu) {
+  uint32_t sdu_bytes = tx_sdu_bytes.load(std::memory_order_relaxed);
+  uint32_t n_sdus    = tx_sdu_queue.get_n_sdus();
+  uint32_t n_bytes   = tx_sdu_queue.size_bytes();
+  if (sdu_bytes > 0) {
     n_sdus++;
-    n_bytes += tx_sdu->N_bytes;
+    n_bytes += sdu_bytes;
   }
 
   // Room needed for header extensions? (integer rounding)
@@ -130,6 +129,7 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   head_len_segment = rlc_um_nr_packed_length(header);
 
   tx_sdu_queue.resize(cnfg_.tx_queue_length);
+  aqm.configure(cnfg_.aqm);
 
   rb_name = rb_name_;
 
@@ -156,12 +156,13 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   if (tx_sdu == nullptr) {
     // Read a new SDU
     do {
-      tx_sdu = tx_sdu_queue.read();
+      tx_sdu = aqm.read(tx_sdu_queue);
     } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
     if (tx_sdu == nullptr) {
       RlcDebug("Cannot build any PDU, tx_sdu_queue has no non-null SDU.");
       return 0;
     }
+    update_tx_sdu_bytes();
     next_so = 0;
 
     // Check for full SDU case
@@ -206,6 +207,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   if (tx_sdu->N_bytes == 0) {
     tx_sdu.reset();
   }
+  update_tx_sdu_bytes();
 
   // advance SO offset
   next_so += to_move;
@@ -261,6 +263,14 @@ bool rlc_um_nr::rlc_um_nr_rx::configure(const rlc_config_t& cnfg_, std::string r
   mod            = (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) ? 64 : 4096;
   UM_Window_Size = (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) ? 32 : 2048;
 
+  if (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) {
+    rx_window =
+        std::unique_ptr<rlc_ringbuffer_base<rlc_umd_rx_sdu_nr_t> >(new rlc_ringbuffer_t<rlc_umd_rx_sdu_nr_t, 32>);
+  } else {
+    rx_window =
+        std::unique_ptr<rlc_ringbuffer_base<rlc_umd_rx_sdu_nr_t> >(new rlc_ringbuffer_t<rlc_umd_rx_sdu_nr_t, 2048>);
+  }
+
   rb_name = rb_name_;
 
   // check timer
@@ -294,7 +304,9 @@ void rlc_um_nr::rlc_um_nr_rx::reset()
   rx_sdu.reset();
 
   // Drop all messages in RX window
-  rx_window.clear();
+  if (rx_window != nullptr) {
+    rx_window->clear();
+  }
 
   // stop timer
   if (reassembly_timer.is_valid()) {
@@ -330,11 +342,9 @@ void rlc_um_nr::rlc_um_nr_rx::timer_expired(uint32_t timeout_id)
     }
 
     // discard all segments with SN < updated RX_Next_Reassembly
-    for (auto it = rx_window.begin(); it != rx_window.end();) {
-      if (RX_MOD_NR_BASE(it->first) < RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-        it = rx_window.erase(it);
-      } else {
-        ++it;
+    for (uint32_t sn = (RX_Next_Highest - UM_Window_Size) % mod; sn != RX_Next_Reassembly; sn = (sn + 1) % mod) {
+      if (rx_window->has_sn(sn)) {
+        rx_window->remove_pdu(sn);
       }
     }
 
@@ -388,121 +398,97 @@ bool rlc_um_nr::rlc_um_nr_rx::has_missing_byte_segment(const uint32_t sn)
 {
   // is at least one missing byte segment of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of
   // all received segments of this RLC SDU
-  return (rx_window.find(sn) != rx_window.end());
+  return rx_window->has_sn(sn);
+}
+
+bool rlc_um_nr::rlc_um_nr_rx::add_segment(rlc_umd_rx_sdu_nr_t&          rx_sdu_nr,
+                                          const rlc_um_nr_pdu_header_t& header,
+                                          const uint8_t*                payload,
+                                          const uint32_t                nof_bytes)
+{
+  uint32_t header_len = rlc_um_nr_packed_length(header);
+  if (nof_bytes <= header_len) {
+    RlcError("Discarding segment of SN=%d without payload (%d B)", header.sn, nof_bytes);
+    return false;
+  }
+  uint32_t len = nof_bytes - header_len;
+
+  if (rx_sdu_nr.sdu == nullptr) {
+    rx_sdu_nr.sdu = make_byte_buffer();
+    if (rx_sdu_nr.sdu == nullptr) {
+      RlcError("Couldn't allocate SDU in %s().", __FUNCTION__);
+      return false;
+    }
+  }
+  if (header.so + len > rx_sdu_nr.sdu->get_tailroom()) {
+    RlcError("Cannot fit RLC PDU in SDU buffer (tailroom=%d, SO=%d, len=%d), dropping SN=%d.",
+             rx_sdu_nr.sdu->get_tailroom(),
+             header.so,
+             len,
+             header.sn);
+    return false;
+  }
+  rx_sdu_nr.received.add(header.so, header.so + len);
+
+  // segments are copied in place, so the SDU is ready to be delivered once all its bytes are received
+  memcpy(rx_sdu_nr.sdu->msg + header.so, payload + header_len, len);
+  RlcDebug("Placed %s segment with SO=%d of SN=%d", to_string_short(header.si).c_str(), header.so, header.sn);
+
+  if (header.si == rlc_nr_si_field_t::last_segment) {
+    rx_sdu_nr.total_sdu_length = header.so + len;
+    RlcDebug("updating total SDU length for SN=%d to %d B", header.sn, rx_sdu_nr.total_sdu_length);
+  }
+  return true;
 }
 
 // Sect 5.2.2.2.3
 void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
 {
-  if (rx_window.find(sn) != rx_window.end()) {
-    bool sdu_complete = false;
-
-    // iterate over received segments and try to assemble full SDU
-    auto& pdu = rx_window.at(sn);
-    for (auto it = pdu.segments.begin(); it != pdu.segments.end();) {
-      RlcDebug("Have %s segment with SO=%d for SN=%d",
-               to_string_short(it->second.header.si).c_str(),
-               it->second.header.so,
-               it->second.header.sn);
-      if (it->second.header.so == pdu.next_expected_so) {
-        if (pdu.next_expected_so == 0) {
-          if (pdu.sdu == nullptr) {
-            // reuse buffer of first segment for final SDU
-            pdu.sdu              = std::move(it->second.buf);
-            pdu.next_expected_so = pdu.sdu->N_bytes;
-            RlcDebug("Reusing first segment of SN=%d for final SDU", it->second.header.sn);
-            it = pdu.segments.erase(it);
-          } else {
-            RlcDebug("SDU buffer already allocated. Possible retransmission of first segment.");
-            if (it->second.header.so != pdu.next_expected_so) {
-              RlcError("Invalid PDU. SO doesn't match. Discarding all segments of SN=%d.", sn);
-              rx_window.erase(sn);
-              return;
-            }
-          }
-        } else {
-          if (it->second.buf->N_bytes > pdu.sdu->get_tailroom()) {
-            RlcError("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.",
-                     rx_sdu->get_tailroom(),
-                     it->second.buf->N_bytes,
-                     it->second.header.sn);
-            rx_window.erase(sn);
-            metrics.num_lost_pdus++;
-            return;
-          }
-
-          // add this segment to the end of the SDU buffer
-          memcpy(pdu.sdu->msg + pdu.sdu->N_bytes, it->second.buf->msg, it->second.buf->N_bytes);
-          pdu.sdu->N_bytes += it->second.buf->N_bytes;
-          pdu.next_expected_so += it->second.buf->N_bytes;
-          RlcDebug("Appended SO=%d of SN=%d", it->second.header.so, it->second.header.sn);
-          it = pdu.segments.erase(it);
-
-          if (pdu.next_expected_so == pdu.total_sdu_length) {
-            // entire SDU has been received, it will be passed up the stack outside the loop
-            sdu_complete = true;
-            break;
-          }
-        }
-      } else {
-        // handle next segment
-        ++it;
-      }
-    }
+  if (rx_window->has_sn(sn)) {
+    rlc_umd_rx_sdu_nr_t& rx_sdu_nr = (*rx_window)[sn];
+
+    bool sdu_complete = rx_sdu_nr.total_sdu_length > 0 && rx_sdu_nr.received.contains(0, rx_sdu_nr.total_sdu_length);
 
     if (sdu_complete) {
       // deliver full SDU to upper layers
-      RlcInfo("Rx SDU (%d B)", pdu.sdu->N_bytes);
-      pdcp->write_pdu(lcid, std::move(pdu.sdu));
+      rx_sdu_nr.sdu->N_bytes = rx_sdu_nr.total_sdu_length;
+      RlcInfo("Rx SDU (%d B)", rx_sdu_nr.sdu->N_bytes);
+      pdcp->write_pdu(lcid, std::move(rx_sdu_nr.sdu));
 
       // delete PDU from rx_window
-      rx_window.erase(sn);
+      rx_window->remove_pdu(sn);
 
-      // find next SN in rx buffer
+      // find next SN in rx buffer, or RX_Next_Highest if no further segments were received
       if (sn == RX_Next_Reassembly) {
-        if (rx_window.empty()) {
-          // no further segments received
-          RX_Next_Reassembly = RX_Next_Highest;
-        } else {
-          for (auto it = rx_window.begin(); it != rx_window.end(); ++it) {
-            RlcDebug("SN=%d has %zd segments", it->first, it->second.segments.size());
-            if (RX_MOD_NR_BASE(it->first) > RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-              RX_Next_Reassembly = it->first;
-              break;
-            }
-          }
-        }
+        do {
+          RX_Next_Reassembly = (RX_Next_Reassembly + 1) % mod;
+        } while (RX_Next_Reassembly != RX_Next_Highest && not rx_window->has_sn(RX_Next_Reassembly));
         RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
       }
     } else if (not sn_in_reassembly_window(sn)) {
       // SN outside of rx window
+      uint32_t old_window_start = (RX_Next_Highest - UM_Window_Size) % mod;
 
       RX_Next_Highest = (sn + 1) % mod; // update RX_Next_highest
       RlcDebug("Updating RX_Next_Highest=%d", RX_Next_Highest);
 
-      // drop all SNs outside of new rx window
-      for (auto it = rx_window.begin(); it != rx_window.end();) {
-        if (not sn_in_reassembly_window(it->first)) {
-          RlcInfo("SN=%d outside rx window [%d:%d] - discarding",
-                  it->first,
-                  RX_Next_Highest - UM_Window_Size,
-                  RX_Next_Highest);
-          it = rx_window.erase(it);
+      // drop all SNs outside of new rx window, i.e. the ones the lower edge of the window moved past
+      uint32_t window_start = (RX_Next_Highest - UM_Window_Size) % mod;
+      for (uint32_t i = old_window_start; i != window_start; i = (i + 1) % mod) {
+        if (rx_window->has_sn(i)) {
+          RlcInfo("SN=%d outside rx window [%d:%d] - discarding", i, window_start, RX_Next_Highest);
+          rx_window->remove_pdu(i);
           metrics.num_lost_pdus++;
-        } else {
-          ++it;
         }
       }
 
       if (not sn_in_reassembly_window(RX_Next_Reassembly)) {
         // update RX_Next_Reassembly to first SN that has not been reassembled and delivered
-        for (const auto& rx_pdu : rx_window) {
-          if (rx_pdu.first >= RX_MOD_NR_BASE(RX_Next_Highest - UM_Window_Size)) {
-            RX_Next_Reassembly = rx_pdu.first;
-            RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
-            break;
-          }
+        RX_Next_Reassembly = window_start;
+        while (not rx_window->has_sn(RX_Next_Reassembly)) {
+          RX_Next_Reassembly = (RX_Next_Reassembly + 1) % mod;
         }
+        RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
       }
     }
 
@@ -529,15 +515,6 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
   }
 }
 
-inline void rlc_um_nr::rlc_um_nr_rx::update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments,
-                                                             const rlc_umd_pdu_nr_t&    rx_pdu)
-{
-  if (rx_pdu.header.si == rlc_nr_si_field_t::last_segment) {
-    pdu_segments.total_sdu_length = rx_pdu.header.so + rx_pdu.buf->N_bytes;
-    RlcDebug("updating total SDU length for SN=%d to %d B", rx_pdu.header.sn, pdu_segments.total_sdu_length);
-  }
-};
-
 // Section 5.2.2.2.2
 void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
@@ -560,39 +537,42 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
     // Nothing else to do here ..
   } else {
     // place PDU in receive buffer
-    rlc_umd_pdu_nr_t rx_pdu = {};
-    rx_pdu.header           = header;
-    rx_pdu.buf              = rlc_um_nr_strip_pdu_header(header, payload, nof_bytes);
+    uint32_t header_len = rlc_um_nr_packed_length(header);
 
     // check if this SN is already present in rx buffer
-    if (rx_window.find(header.sn) == rx_window.end()) {
+    if (not rx_window->has_sn(header.sn)) {
       // first received segment of this SN, add to rx buffer
-      RlcHexDebug(rx_pdu.buf->msg,
-                  rx_pdu.buf->N_bytes,
+      RlcHexDebug(payload + header_len,
+                  nof_bytes - header_len,
                   "placing %s segment of SN=%d (%d B) in Rx buffer",
                   to_string_short(header.si).c_str(),
                   header.sn,
-                  rx_pdu.buf->N_bytes);
-      rlc_umd_pdu_segments_nr_t pdu_segments = {};
-      update_total_sdu_length(pdu_segments, rx_pdu);
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
-      rx_window[header.sn] = std::move(pdu_segments);
+                  nof_bytes - header_len);
+      // The SN that shares the slot is outside the window set by this PDU, see handle_rx_buffer_update()
+      uint32_t aliased_sn = (header.sn + UM_Window_Size) % mod;
+      if (rx_window->has_sn(aliased_sn)) {
+        RlcInfo("SN=%d outside rx window [%d:%d] - discarding",
+                aliased_sn,
+                (header.sn + 1 - UM_Window_Size) % mod,
+                (header.sn + 1) % mod);
+        rx_window->remove_pdu(aliased_sn);
+        metrics.num_lost_pdus++;
+      }
+      rx_window->add_pdu(header.sn);
     } else {
       // other segment for this SN already present, update received data
-      RlcHexDebug(rx_pdu.buf->msg,
-                  rx_pdu.buf->N_bytes,
+      RlcHexDebug(payload + header_len,
+                  nof_bytes - header_len,
                   "updating SN=%d at SO=%d with %d B",
-                  rx_pdu.header.sn,
-                  rx_pdu.header.so,
-                  rx_pdu.buf->N_bytes);
-
-      auto& pdu_segments = rx_window.at(header.sn);
-
-      // calculate total SDU length
-      update_total_sdu_length(pdu_segments, rx_pdu);
+                  header.sn,
+                  header.so,
+                  nof_bytes - header_len);
+    }
 
-      // append to list of segments
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
+    if (not add_segment((*rx_window)[header.sn], header, payload, nof_bytes)) {
+      rx_window->remove_pdu(header.sn);
+      metrics.num_lost_pdus++;
+      return;
     }
 
     // handle received segments
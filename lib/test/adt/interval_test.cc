@@ -20,6 +20,7 @@
  */
 
 #include "srsran/adt/interval.h"
+#include "srsran/adt/interval_set.h"
 #include "srsran/common/test_common.h"
 
 int test_interval_init()
@@ -91,6 +92,45 @@ int test_interval_expand()
   return SRSRAN_SUCCESS;
 }
 
+int test_interval_set()
+{
+  srsran::interval_set<uint32_t> S;
+  TESTASSERT(S.empty());
+
+  S.add(10, 20);
+  S.add(0, 5);
+  TESTASSERT(S.nof_intervals() == 2);
+  TESTASSERT(S.contains(12, 20) and not S.contains(4, 11));
+  TESTASSERT(*S.begin() == srsran::interval<uint32_t>(0, 5));
+
+  // Disjoint intervals are kept sorted
+  S.add(6, 7);
+  S.add(30, 40);
+  S.add(25, 26);
+  TESTASSERT(S.nof_intervals() == 5);
+  uint32_t prev_stop = 0;
+  for (const srsran::interval<uint32_t>& i : S) {
+    TESTASSERT(i.start() >= prev_stop);
+    prev_stop = i.stop();
+  }
+
+  // Adjacent and overlapping intervals are merged
+  S.add(5, 8);
+  S.add(7, 11);
+  S.add(20, 30);
+  TESTASSERT(S.nof_intervals() == 1);
+  TESTASSERT(S.contains(0, 40) and not S.contains(0, 41));
+
+  // Duplicates leave the set unchanged
+  S.add(3, 15);
+  TESTASSERT(S.nof_intervals() == 1 and *S.begin() == srsran::interval<uint32_t>(0, 40));
+
+  S.clear();
+  TESTASSERT(S.empty());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   TESTASSERT(test_interval_init() == SRSRAN_SUCCESS);
@@ -98,5 +138,6 @@ int main()
   TESTASSERT(test_interval_contains() == SRSRAN_SUCCESS);
   TESTASSERT(test_interval_intersect() == SRSRAN_SUCCESS);
   TESTASSERT(test_interval_expand() == SRSRAN_SUCCESS);
+  TESTASSERT(test_interval_set() == SRSRAN_SUCCESS);
   return 0;
 }
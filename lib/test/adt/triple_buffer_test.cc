@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/triple_buffer.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+int test_triple_buffer_single_thread()
+{
+  srsran::triple_buffer<int> buf;
+
+  // Nothing published yet
+  TESTASSERT(not buf.update());
+
+  buf.write_buffer() = 1;
+  buf.publish();
+  TESTASSERT(buf.update());
+  TESTASSERT(buf.read_buffer() == 1);
+  // The value is only fetched once, and stays readable
+  TESTASSERT(not buf.update());
+  TESTASSERT(buf.read_buffer() == 1);
+
+  // The reader skips intermediate values and gets the last one
+  for (int i = 2; i <= 10; ++i) {
+    buf.write_buffer() = i;
+    buf.publish();
+  }
+  TESTASSERT(buf.update());
+  TESTASSERT(buf.read_buffer() == 10);
+  TESTASSERT(not buf.update());
+
+  // Cycle through the three buffers several times
+  for (int i = 11; i < 100; ++i) {
+    buf.write_buffer() = i;
+    buf.publish();
+    TESTASSERT(buf.update());
+    TESTASSERT(buf.read_buffer() == i);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_triple_buffer_concurrent()
+{
+  // Every field of a published value holds the same sequence number, so a torn read is detected
+  struct value_t {
+    std::array<uint32_t, 16> seq;
+  };
+  const uint32_t                 nof_values = 1000000;
+  srsran::triple_buffer<value_t> buf;
+
+  std::thread writer([&buf, nof_values]() {
+    for (uint32_t i = 1; i <= nof_values; ++i) {
+      buf.write_buffer().seq.fill(i);
+      buf.publish();
+    }
+  });
+
+  uint32_t last = 0, nof_updates = 0;
+  while (last != nof_values) {
+    if (not buf.update()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const value_t& v = buf.read_buffer();
+    for (uint32_t s : v.seq) {
+      TESTASSERT(s == v.seq[0]);
+    }
+    // Values are observed in order of publication
+    TESTASSERT(v.seq[0] > last);
+    last = v.seq[0];
+    nof_updates++;
+  }
+  writer.join();
+
+  TESTASSERT(not buf.update());
+  TESTASSERT(nof_updates > 0 and nof_updates <= nof_values);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_triple_buffer_single_thread() == SRSRAN_SUCCESS);
+  TESTASSERT(test_triple_buffer_concurrent() == SRSRAN_SUCCESS);
+  return 0;
+}
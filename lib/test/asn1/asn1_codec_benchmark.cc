@@ -0,0 +1,234 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap.h"
+#include "srsran/asn1/rrc.h"
+#include "srsran/asn1/rrc_nr.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+
+using namespace asn1;
+
+/*
+ * Throughput benchmark of the ASN.1 PER codec. A corpus of messages taken from the RRC, S1AP and NGAP unit tests is
+ * decoded and re-encoded in a loop. Decoding is measured both with heap-allocated dyn_arrays and with a per-message
+ * dyn_array_arena, which is reset after each message.
+ */
+
+namespace {
+
+uint32_t nof_iterations = 10000;
+
+const uint8_t lte_rrc_conn_recfg_ho[] = {
+    0x20, 0x1b, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x01, 0xa9, 0x08, 0x80, 0x00, 0x00, 0x29, 0x00, 0x97, 0x80, 0x00, 0x00,
+    0x00, 0x01, 0x04, 0x22, 0x14, 0x00, 0xf8, 0x02, 0x0a, 0xc0, 0x60, 0x00, 0xa0, 0x0c, 0x80, 0x42, 0x02, 0x9f, 0x43,
+    0x07, 0xda, 0xbc, 0xf8, 0x4b, 0x32, 0x18, 0x34, 0xc0, 0x00, 0x2d, 0x68, 0x08, 0x5e, 0x18, 0x00, 0x16, 0x80, 0x00};
+
+const uint8_t nr_rrc_recfg[] = "\x08\x81\x7c\x5c\x40\xb1\xc0\x7d\x48\x3a\x04\xc0\x3e\x01\x04\x54"
+                               "\x1e\xb5\x00\x02\xe8\x53\x98\xdf\x46\x93\x4b\x80\x04\xd2\x69\x34"
+                               "\x00\x00\x08\xc9\x8d\x6d\x8c\xa2\x01\xff\x00\x00\x00\x00\x01\x1b"
+                               "\x82\x21\x00\x00\x04\x04\x00\xd1\x14\x0e\x70\x00\x00\x08\xc9\xc6"
+                               "\xb6\xc6\x44\xa0\x00\x1e\xb8\x95\x63\xe0\x24\x94\x22\x0d\xb8\x44"
+                               "\x70\x0c\x02\x10\xb0\x1d\x80\x48\xf1\x18\x06\xea\x00\x08\x0e\x01"
+                               "\x25\xc0\xc8\x80\x37\x08\x42\x00\x00\x88\x16\x50\x02\x0c\x82\x00"
+                               "\x00\x20\x69\x81\x01\x45\x0a\x00\x0e\x48\x18\x00\x01\x33\x55\x64"
+                               "\x84\x1c\x00\x10\x40\xc2\x05\x0c\x1c\x9c\x40\x91\x42\xc6\x0d\x1c"
+                               "\x3c\x8e\x00\x00\x32\x21\x40\x30\x20\x01\x91\x4a\x01\x82\x00\x0c"
+                               "\x8c\x50\x0c\x18\x00\x64\x42\x80\xe1\x00\x03\x22\x94\x07\x0a\x00"
+                               "\x19\x18\xa0\x38\x60\x00\xc8\x85\x02\xc3\x80\x06\x45\x28\x16\x20"
+                               "\x64\x00\x41\x6c\x48\x04\x62\x82\x18\xa0\x08\xc5\x04\xb1\x60\x11"
+                               "\x8a\x0a\x63\x00\x23\x14\x16\xc6\x80\x46\x28\x31\x8e\x00\x8c\x50"
+                               "\x6b\x1e\x01\x18\xa0\xe6\x40\x00\x32\x31\x40\xb2\x23\x10\x0a\x08"
+                               "\x40\x90\x86\x05\x10\x43\xcc\x3b\x2a\x6e\x4d\x01\xa4\x92\x1e\x2e"
+                               "\xe0\x0c\x10\xe0\x00\x00\x01\x8f\xfd\x29\x49\x8c\x63\x72\x81\x60"
+                               "\x00\x02\x19\x70\x00\x00\x00\x00\x00\x00\x52\xf0\x0f\xa0\x84\x8a"
+                               "\xd5\x45\x00\x47\x00\x18\x00\x08\x20\x00\xe2\x10\x02\x40\x80\x70"
+                               "\x10\x10\x84\x00\x0e\x21\x00\x1c\xb0\x0e\x04\x02\x20\x80\x01\xc4"
+                               "\x20\x03\x96\x01\xc0\xc0\x42\x10\x00\x38\x84\x00\x73\x00\x38\x20"
+                               "\x08\x82\x00\x07\x10\x80\x0e\x60\x00\x40\x00\x00\x04\x10\xc0\x40"
+                               "\x80\xc1\x00\xe0\xd0\x00\x0e\x48\x10\x00\x00\x02\x00\x40\x00\x80"
+                               "\x60\x00\x80\x90\x02\x20\x0a\x40\x00\x02\x38\x90\x11\x31\xc8";
+
+const uint8_t s1ap_init_ctxt_setup_req[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+const uint8_t s1ap_ho_request[] = {
+    0x00, 0x01, 0x00, 0x80, 0xe6, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x01, 0x00, 0x01, 0x00,
+    0x00, 0x02, 0x40, 0x02, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca,
+    0x00, 0x00, 0x35, 0x00, 0x19, 0x00, 0x00, 0x1b, 0x00, 0x14, 0x4a, 0x1f, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c,
+    0x56, 0x00, 0x09, 0x3c, 0x00, 0x00, 0x00, 0x8f, 0x40, 0x01, 0x00, 0x00, 0x68, 0x00, 0x75, 0x74, 0x00, 0x5f, 0x0a,
+    0x10, 0x0c, 0x81, 0xa0, 0x00, 0x00, 0x18, 0x00, 0x02, 0xe8, 0x7f, 0xe4, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x05,
+    0x91, 0x00, 0x00, 0x02, 0x90, 0x09, 0x78, 0x00, 0x00, 0x00, 0x62, 0x7c, 0x1f, 0x50, 0x29, 0x8f, 0x00, 0xe9, 0xce,
+    0x02, 0x13, 0x00, 0x00, 0x95, 0x01, 0x00, 0x46, 0x40, 0x00, 0x00, 0x01, 0x90, 0x13, 0x84, 0x00, 0x1c, 0x00, 0x67,
+    0x00, 0xa0, 0x51, 0x80, 0x41, 0x40, 0x06, 0x70, 0xdf, 0xbc, 0x44, 0x00, 0x6b, 0x01, 0x40, 0x00, 0x80, 0x02, 0x08,
+    0x00, 0xc1, 0x4c, 0xa2, 0xd5, 0x4e, 0x28, 0x03, 0x51, 0x72, 0x40, 0xe0, 0x59, 0x14, 0x01, 0x21, 0x7b, 0x00, 0x00,
+    0x09, 0xf1, 0x07, 0x00, 0x19, 0xb0, 0x10, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x19, 0xc0, 0x21, 0x00, 0x00, 0x1f, 0x00,
+    0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x28, 0x00, 0x21, 0x10, 0x8b, 0x0d, 0xab, 0xd7, 0xe5, 0x98,
+    0x34, 0xb3, 0xef, 0x6c, 0xc1, 0xaa, 0xa7, 0x27, 0xfb, 0xf4, 0x53, 0x08, 0xff, 0x74, 0x94, 0x7c, 0xa7, 0x1b, 0xd9,
+    0xb4, 0x37, 0xb9, 0x02, 0x78, 0x62, 0x12};
+
+const uint8_t ngap_init_ue_msg[] = {
+    0x00, 0x0f, 0x40, 0x80, 0xa2, 0x00, 0x00, 0x04, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01, 0x00, 0x26, 0x00, 0x7d, 0x7c,
+    0x7e, 0x00, 0x41, 0x71, 0x00, 0x76, 0x01, 0x00, 0xf1, 0x10, 0x00, 0x00, 0x01, 0x01, 0x4d, 0x43, 0x6f, 0x77, 0x42,
+    0x51, 0x59, 0x44, 0x4b, 0x32, 0x56, 0x75, 0x41, 0x79, 0x45, 0x41, 0x6e, 0x36, 0x36, 0x48, 0x39, 0x6b, 0x7a, 0x48,
+    0x54, 0x61, 0x46, 0x5a, 0x4b, 0x30, 0x35, 0x37, 0x41, 0x49, 0x72, 0x37, 0x41, 0x2b, 0x6e, 0x6c, 0x73, 0x61, 0x49,
+    0x58, 0x78, 0x52, 0x33, 0x4e, 0x69, 0x73, 0x36, 0x4c, 0x56, 0x6f, 0x75, 0x46, 0x69, 0x42, 0x34, 0x3d, 0xdf, 0xab,
+    0xf5, 0xcd, 0x65, 0x2e, 0xb2, 0x54, 0x14, 0x91, 0x48, 0x4d, 0x41, 0x43, 0x2d, 0x53, 0x48, 0x41, 0x00, 0x85, 0x8b,
+    0xbb, 0x1f, 0x42, 0xf1, 0x25, 0x6f, 0x9a, 0x37, 0x53, 0x1a, 0x77, 0x2a, 0x2c, 0xf2, 0xb7, 0x8f, 0xf1, 0x60, 0x48,
+    0x84, 0x02, 0xed, 0x48, 0x93, 0x99, 0xb6, 0xb7, 0x37, 0x42, 0x00, 0x79, 0x00, 0x0f, 0x40, 0x00, 0xf1, 0x10, 0x00,
+    0x00, 0x00, 0x00, 0x10, 0x00, 0xf1, 0x10, 0x00, 0x00, 0x75, 0x00, 0x5a, 0x40, 0x01, 0x18};
+
+double msgs_per_sec(std::chrono::high_resolution_clock::time_point tp)
+{
+  auto usec =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp).count();
+  return usec > 0 ? nof_iterations * 1e6 / usec : 0;
+}
+
+template <typename Msg>
+int decode_msg(const uint8_t* buf, uint32_t len)
+{
+  Msg      msg;
+  cbit_ref bref(buf, len);
+  TESTASSERT(msg.unpack(bref) == SRSASN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+template <typename Msg>
+int run_benchmark(const char* name, const uint8_t* buf, uint32_t len)
+{
+  using std::chrono::high_resolution_clock;
+
+  // Decode with dyn_arrays allocated from the heap
+  auto tp = high_resolution_clock::now();
+  for (uint32_t i = 0; i < nof_iterations; ++i) {
+    TESTASSERT(decode_msg<Msg>(buf, len) == SRSRAN_SUCCESS);
+  }
+  double dec_heap = msgs_per_sec(tp);
+
+  // Decode with dyn_arrays allocated from an arena that is recycled after each message
+  dyn_array_arena arena;
+  size_t          arena_bytes = 0;
+  tp                          = high_resolution_clock::now();
+  for (uint32_t i = 0; i < nof_iterations; ++i) {
+    {
+      dyn_array_arena_scope scope(arena);
+      TESTASSERT(decode_msg<Msg>(buf, len) == SRSRAN_SUCCESS);
+    }
+    arena_bytes = arena.nof_bytes_used();
+    arena.reset();
+  }
+  double dec_arena = msgs_per_sec(tp);
+
+  // Encode
+  Msg      msg;
+  cbit_ref cbref(buf, len);
+  TESTASSERT(msg.unpack(cbref) == SRSASN_SUCCESS);
+  uint8_t  out[2048];
+  uint32_t out_len = 0;
+  tp               = high_resolution_clock::now();
+  for (uint32_t i = 0; i < nof_iterations; ++i) {
+    bit_ref bref(out, sizeof(out));
+    TESTASSERT(msg.pack(bref) == SRSASN_SUCCESS);
+    out_len = bref.distance_bytes();
+  }
+  double enc = msgs_per_sec(tp);
+
+  // The corpus messages are not all canonically encoded, so check that the encoding is stable instead
+  Msg      msg2;
+  cbit_ref cbref2(out, out_len);
+  TESTASSERT(msg2.unpack(cbref2) == SRSASN_SUCCESS);
+  uint8_t out2[2048];
+  bit_ref bref2(out2, sizeof(out2));
+  TESTASSERT(msg2.pack(bref2) == SRSASN_SUCCESS);
+  TESTASSERT(bref2.distance_bytes() == (int)out_len);
+  TESTASSERT(memcmp(out, out2, out_len) == 0);
+
+  fmt::print("{:<28} {:>4} bytes | decode: {:>9.0f} msg/s (heap), {:>9.0f} msg/s (arena, {} bytes) | encode: {:>9.0f} "
+             "msg/s\n",
+             name,
+             len,
+             dec_heap,
+             dec_arena,
+             arena_bytes,
+             enc);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n number of iterations per message [Default %d]\n", nof_iterations);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_iterations = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+
+  TESTASSERT(run_benchmark<rrc::dl_dcch_msg_s>(
+                 "LTE RRCConnReconfiguration", lte_rrc_conn_recfg_ho, sizeof(lte_rrc_conn_recfg_ho)) == SRSRAN_SUCCESS);
+  // The NR message is stored as a string literal, so the terminating null character is not part of it
+  TESTASSERT(run_benchmark<rrc_nr::rrc_recfg_s>("NR RRCReconfiguration", nr_rrc_recfg, sizeof(nr_rrc_recfg) - 1) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<s1ap::s1ap_pdu_c>("S1AP InitialContextSetupReq",
+                                             s1ap_init_ctxt_setup_req,
+                                             sizeof(s1ap_init_ctxt_setup_req)) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<s1ap::s1ap_pdu_c>("S1AP HandoverRequest", s1ap_ho_request, sizeof(s1ap_ho_request)) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark<ngap::ngap_pdu_c>("NGAP InitialUEMessage", ngap_init_ue_msg, sizeof(ngap_init_ue_msg)) ==
+             SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
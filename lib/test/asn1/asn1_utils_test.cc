@@ -195,6 +195,106 @@ int test_bit_ref()
   return 0;
 }
 
+int test_bit_ref_random_fields()
+{
+  // Pack fields of random sizes and compare the result with a bit-by-bit reference encoding
+  std::uniform_int_distribution<uint32_t>     size_dist(1, 63);
+  std::vector<std::pair<uint64_t, uint32_t> > fields;
+  uint8_t                                     buf[1024];
+  uint8_t                                     ref[1024] = {};
+  uint32_t                                    nof_bits  = 0;
+  bit_ref                                     bref(&buf[0], sizeof(buf));
+  while (nof_bits + 64 < 8 * sizeof(buf)) {
+    uint32_t n_bits = size_dist(g);
+    uint64_t val    = (((uint64_t)g() << 32u) | g()) & ((1ul << n_bits) - 1ul);
+    TESTASSERT(bref.pack(val, n_bits) == SRSASN_SUCCESS);
+    for (uint32_t i = 0; i < n_bits; ++i, ++nof_bits) {
+      if ((val >> (n_bits - 1 - i)) & 1u) {
+        ref[nof_bits / 8] |= 1u << (7 - nof_bits % 8);
+      }
+    }
+    fields.emplace_back(val, n_bits);
+  }
+  TESTASSERT(bref.distance() == (int)nof_bits);
+  TESTASSERT(memcmp(buf, ref, ceil_frac(nof_bits, 8u)) == 0);
+
+  cbit_ref bref2(&buf[0], sizeof(buf));
+  for (const auto& field : fields) {
+    uint64_t val;
+    TESTASSERT(bref2.unpack(val, field.second) == SRSASN_SUCCESS);
+    TESTASSERT(val == field.first);
+  }
+  TESTASSERT(bref2.distance() == (int)nof_bits);
+
+  // 64-bit values spanning 9 bytes
+  bref2 = cbit_ref(&buf[0], sizeof(buf));
+  uint64_t val64;
+  TESTASSERT(bref2.advance_bits(3) == SRSASN_SUCCESS);
+  TESTASSERT(bref2.unpack(val64, 64) == SRSASN_SUCCESS);
+  TESTASSERT(bref2.distance() == 67);
+  uint64_t ref64 = 0;
+  for (uint32_t i = 3; i < 67; ++i) {
+    ref64 = (ref64 << 1u) | ((ref[i / 8] >> (7 - i % 8)) & 1u);
+  }
+  TESTASSERT(val64 == ref64);
+
+  // Fields that do not fit in the buffer are rejected
+  test_spy->reset_counters();
+  bref = bit_ref(&buf[0], 2);
+  TESTASSERT(bref.pack(0, 9) == SRSASN_SUCCESS);
+  TESTASSERT(bref.pack(0, 8) == SRSASN_ERROR_ENCODE_FAIL);
+  TESTASSERT(bref.pack(0, 7) == SRSASN_SUCCESS);
+  TESTASSERT(bref.distance_bytes_end() == 0);
+  bref2 = cbit_ref(&buf[0], 2);
+  TESTASSERT(bref2.unpack(val64, 17) == SRSASN_ERROR_DECODE_FAIL);
+  TESTASSERT(bref2.unpack(val64, 16) == SRSASN_SUCCESS);
+  TESTASSERT(test_spy->get_error_counter() == 2);
+  test_spy->reset_counters();
+
+  return 0;
+}
+
+int test_dyn_array_arena()
+{
+  dyn_array_arena arena(256);
+  {
+    dyn_array_arena_scope          scope(arena);
+    dyn_array<uint32_t>            a(10);
+    dyn_array<dyn_array<uint8_t> > nested(4);
+    for (uint32_t i = 0; i < nested.size(); ++i) {
+      nested[i].resize(100 + i);
+      std::fill(nested[i].begin(), nested[i].end(), i);
+    }
+    TESTASSERT(arena.nof_bytes_used() >= 10 * sizeof(uint32_t) + 4 * 100);
+    TESTASSERT(arena.nof_blocks() > 1);
+
+    // Growth and copies within the scope also use the arena
+    a.push_back(5);
+    TESTASSERT(a.size() == 11 and a.back() == 5);
+    dyn_array<dyn_array<uint8_t> > nested_copy = nested;
+    TESTASSERT(nested_copy == nested);
+    TESTASSERT(nested_copy[3].size() == 103 and nested_copy[3][102] == 3);
+  }
+  size_t nof_blocks = arena.nof_blocks();
+  arena.reset();
+  TESTASSERT(arena.nof_bytes_used() == 0);
+
+  // Arena memory is reused after a reset
+  {
+    dyn_array_arena_scope scope(arena);
+    dyn_array<uint8_t>    b(64);
+    TESTASSERT(arena.nof_bytes_used() == 64);
+  }
+  TESTASSERT(arena.nof_blocks() == nof_blocks);
+
+  // Out of the scope, dyn_arrays are allocated from the heap
+  size_t             nof_bytes = arena.nof_bytes_used();
+  dyn_array<uint8_t> c(64);
+  TESTASSERT(arena.nof_bytes_used() == nof_bytes);
+
+  return 0;
+}
+
 int test_oct_string()
 {
   uint8_t  buf[1024];
@@ -695,6 +795,8 @@ int main()
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
   TESTASSERT(test_enum() == 0);
+  TESTASSERT(test_bit_ref_random_fields() == 0);
+  TESTASSERT(test_dyn_array_arena() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
   //  TESTASSERT(test_json_writer()==0);
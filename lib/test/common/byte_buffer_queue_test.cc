@@ -22,6 +22,7 @@
 #define NMSGS 1000000
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <stdio.h>
 
@@ -80,7 +81,175 @@ int test_concurrent_writeread()
   return result;
 }
 
+unique_byte_buffer_t make_sdu(uint32_t sn, uint32_t nof_bytes = 4)
+{
+  unique_byte_buffer_t b = srsran::make_byte_buffer();
+  memcpy(b->msg, &sn, 4);
+  b->N_bytes    = nof_bytes;
+  b->md.pdcp_sn = sn;
+  return b;
+}
+
+uint32_t sdu_sn(const unique_byte_buffer_t& b)
+{
+  uint32_t sn = 0;
+  memcpy(&sn, b->msg, 4);
+  return sn;
+}
+
+int test_spsc_full_empty()
+{
+  spsc_byte_buffer_queue q(4);
+  TESTASSERT(q.is_empty() and not q.is_full());
+  TESTASSERT(q.read() == nullptr);
+  unique_byte_buffer_t b;
+  TESTASSERT(not q.try_read(&b));
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    TESTASSERT(not q.try_write(make_sdu(i, 10)).is_error());
+  }
+  TESTASSERT(q.is_full() and q.size() == 4 and q.get_n_sdus() == 4 and q.size_bytes() == 40);
+
+  // A full queue hands the SDU back
+  srsran::error_type<unique_byte_buffer_t> ret = q.try_write(make_sdu(4, 10));
+  TESTASSERT(ret.is_error() and ret.error() != nullptr and sdu_sn(ret.error()) == 4);
+  TESTASSERT(q.size() == 4 and q.size_bytes() == 40);
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    TESTASSERT(q.try_read(&b));
+    TESTASSERT(b != nullptr and sdu_sn(b) == i);
+  }
+  TESTASSERT(q.is_empty() and q.get_n_sdus() == 0 and q.size_bytes() == 0);
+  TESTASSERT(not q.try_read(&b));
+
+  // Clear drops everything
+  TESTASSERT(not q.try_write(make_sdu(0)).is_error());
+  TESTASSERT(not q.try_write(make_sdu(1)).is_error());
+  q.clear();
+  TESTASSERT(q.is_empty() and q.get_n_sdus() == 0 and q.size_bytes() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_spsc_wraparound()
+{
+  spsc_byte_buffer_queue q(3);
+  uint32_t               next_write = 0, next_read = 0;
+
+  // Keep the queue partially filled while the indexes go around the ring many times
+  for (uint32_t round = 0; round < 100; ++round) {
+    while (not q.is_full()) {
+      TESTASSERT(not q.try_write(make_sdu(next_write++)).is_error());
+    }
+    for (uint32_t i = 0; i < 1 + round % 3; ++i) {
+      unique_byte_buffer_t b = q.read();
+      TESTASSERT(b != nullptr and sdu_sn(b) == next_read++);
+    }
+    TESTASSERT(q.size() == next_write - next_read and q.get_n_sdus() == q.size());
+  }
+
+  // Resizing keeps the pending SDUs in order
+  q.resize(8);
+  TESTASSERT(q.size() == next_write - next_read and not q.is_full());
+  while (not q.is_full()) {
+    TESTASSERT(not q.try_write(make_sdu(next_write++)).is_error());
+  }
+  while (not q.is_empty()) {
+    unique_byte_buffer_t b = q.read();
+    TESTASSERT(b != nullptr and sdu_sn(b) == next_read++);
+  }
+  TESTASSERT(next_read == next_write);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_spsc_discard()
+{
+  spsc_byte_buffer_queue q(4);
+  for (uint32_t i = 0; i < 4; ++i) {
+    TESTASSERT(not q.try_write(make_sdu(i, 10)).is_error());
+  }
+
+  // A discarded SDU leaves an empty slot, and is no longer accounted
+  TESTASSERT(q.discard(1));
+  TESTASSERT(not q.discard(1));
+  TESTASSERT(not q.discard(7));
+  TESTASSERT(q.size() == 4 and q.get_n_sdus() == 3 and q.size_bytes() == 30);
+
+  unique_byte_buffer_t b = q.read();
+  TESTASSERT(b != nullptr and sdu_sn(b) == 0);
+  TESTASSERT(q.read() == nullptr);
+  b = q.read();
+  TESTASSERT(b != nullptr and sdu_sn(b) == 2);
+
+  // SDUs already read cannot be discarded
+  TESTASSERT(not q.discard(2));
+  TESTASSERT(q.get_n_sdus() == 1 and q.size_bytes() == 10);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_spsc_concurrent_writeread()
+{
+  const uint32_t         nof_sdus = NMSGS / 10;
+  spsc_byte_buffer_queue q(16);
+  std::atomic<uint32_t>  nof_discarded = {0};
+
+  // The producer discards some of the SDUs it wrote, while the consumer may be reading them
+  std::thread t([&q, &nof_discarded, nof_sdus]() {
+    for (uint32_t i = 0; i < nof_sdus; i++) {
+      unique_byte_buffer_t b;
+      do {
+        b = srsran::make_byte_buffer();
+        if (b == nullptr) {
+          std::this_thread::yield();
+        }
+      } while (b == nullptr);
+      memcpy(b->msg, &i, 4);
+      b->N_bytes    = 4;
+      b->md.pdcp_sn = i;
+      srsran::error_type<unique_byte_buffer_t> ret = q.try_write(std::move(b));
+      while (ret.is_error()) {
+        std::this_thread::yield();
+        ret = q.try_write(std::move(ret.error()));
+      }
+      if (i % 7 == 0 and q.discard(i - 3)) {
+        nof_discarded++;
+      }
+    }
+  });
+
+  uint32_t nof_read = 0, nof_empty = 0;
+  int64_t  last_sn  = -1;
+  while (nof_read + nof_empty < nof_sdus) {
+    if (q.is_empty()) {
+      std::this_thread::yield();
+      continue;
+    }
+    unique_byte_buffer_t b = q.read();
+    if (b == nullptr) {
+      nof_empty++;
+      continue;
+    }
+    // SDUs are read in order of writing
+    TESTASSERT(sdu_sn(b) > last_sn);
+    last_sn = sdu_sn(b);
+    nof_read++;
+  }
+  t.join();
+
+  TESTASSERT(q.is_empty() and q.get_n_sdus() == 0 and q.size_bytes() == 0);
+  TESTASSERT(nof_empty == nof_discarded);
+  TESTASSERT(nof_read + nof_discarded == nof_sdus);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
+  TESTASSERT(test_spsc_full_empty() == SRSRAN_SUCCESS);
+  TESTASSERT(test_spsc_wraparound() == SRSRAN_SUCCESS);
+  TESTASSERT(test_spsc_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_spsc_concurrent_writeread() == SRSRAN_SUCCESS);
   return test_concurrent_writeread();
 }
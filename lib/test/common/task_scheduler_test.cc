@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/common/offload_executor.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/test_common.h"
 
@@ -78,8 +79,79 @@ int test_task_scheduler_with_pool()
   return SRSRAN_SUCCESS;
 }
 
+int test_offload_executor()
+{
+  srsran::task_scheduler   task_sched;
+  srsran::offload_executor executor;
+  std::vector<int>         results;
+  std::thread::id          main_id = std::this_thread::get_id();
+
+  // TEST: job and completion run inline while the executor is not started
+  executor.execute([]() { return 1; }, [&results](int val) { results.push_back(val); });
+  TESTASSERT(results.size() == 1 and results[0] == 1);
+
+  // TEST: jobs run outside the scheduler thread, and their completions are run by the scheduler in submission order
+  results.clear();
+  executor.start(&task_sched);
+  const int nof_jobs = 100;
+  for (int i = 0; i < nof_jobs; ++i) {
+    std::unique_ptr<int> val(new int(i));
+    executor.execute(
+        [main_id, val = std::move(val)]() mutable {
+          return std::this_thread::get_id() != main_id ? std::move(val) : nullptr;
+        },
+        [&results](std::unique_ptr<int> val) { results.push_back(val != nullptr ? *val : -1); });
+  }
+  while (results.size() < nof_jobs) {
+    task_sched.run_pending_tasks();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  for (int i = 0; i < nof_jobs; ++i) {
+    TESTASSERT(results[i] == i);
+  }
+  executor.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_offload_executor_overflow()
+{
+  srsran::task_scheduler   task_sched;
+  srsran::offload_executor executor;
+  std::vector<int>         results;
+
+  // TEST: submitting more jobs than the queue size without running the scheduler neither discards nor reorders jobs
+  const uint32_t queue_size = 8;
+  const int      nof_jobs   = 100;
+  executor.start(&task_sched, -1, queue_size);
+  for (int i = 0; i < nof_jobs; ++i) {
+    executor.execute(
+        [i]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(10));
+          return i;
+        },
+        [&results](int val) { results.push_back(val); });
+    TESTASSERT(results.size() + queue_size >= (size_t)i + 1);
+  }
+  while (results.size() < nof_jobs) {
+    task_sched.run_pending_tasks();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  // Let any leftover drain task run, to check that no completion is run twice
+  task_sched.run_pending_tasks();
+  TESTASSERT(results.size() == nof_jobs);
+  for (int i = 0; i < nof_jobs; ++i) {
+    TESTASSERT(results[i] == i);
+  }
+  executor.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   TESTASSERT(test_task_scheduler_no_pool() == SRSRAN_SUCCESS);
   TESTASSERT(test_task_scheduler_with_pool() == SRSRAN_SUCCESS);
+  TESTASSERT(test_offload_executor() == SRSRAN_SUCCESS);
+  TESTASSERT(test_offload_executor_overflow() == SRSRAN_SUCCESS);
 }
@@ -0,0 +1,283 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_gw_interfaces.h"
+#include "srsran/interfaces/ue_rlc_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/upper/pdcp_entity_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+
+using namespace srsran;
+
+/*
+ * Throughput benchmark of the NR PDCP entity bookkeeping, with security disabled.
+ * TX: SDUs are written with the discard timer running. RLC notifies the delivery of each SDU after a fixed delay,
+ * except for the lost ones, which are discarded once the discard timer expires.
+ * RX: PDUs are delivered out of order and with random losses, so that the reordering window and t-Reordering are
+ * exercised. Only the time spent by the receiving entity handling the PDUs is measured.
+ */
+
+namespace {
+
+uint32_t nof_sdus       = 1000000;
+uint32_t sdu_size       = 1500;
+uint32_t sdus_per_tti   = 16;
+uint32_t delivery_delay = 20;
+uint32_t reorder_depth  = 8;
+float    loss_rate      = 0.01;
+
+const pdcp_config_t bench_cfg = {1,
+                                 PDCP_RB_IS_DRB,
+                                 SECURITY_DIRECTION_UPLINK,
+                                 SECURITY_DIRECTION_DOWNLINK,
+                                 PDCP_SN_LEN_18,
+                                 pdcp_t_reordering_t::ms50,
+                                 pdcp_discard_timer_t::ms100,
+                                 false,
+                                 srsran_rat_t::nr};
+
+class benchmark_tester : public srsue::rlc_interface_pdcp,
+                         public srsue::rrc_interface_pdcp,
+                         public srsue::gw_interface_pdcp
+{
+public:
+  // RLC interface
+  void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    tx_sns.push_back(sdu->md.pdcp_sn);
+    if (keep_pdus) {
+      tx_pdus.push_back(std::move(sdu));
+    }
+  }
+  void discard_sdu(uint32_t lcid, uint32_t discard_sn) final { nof_discards++; }
+  bool rb_is_um(uint32_t lcid) final { return false; }
+  bool sdu_queue_is_full(uint32_t lcid) final { return false; }
+  bool is_suspended(uint32_t lcid) final { return false; }
+
+  // RRC and GW interfaces
+  void        write_pdu(uint32_t lcid, unique_byte_buffer_t pdu) final { nof_rx_sdus++; }
+  void        write_pdu_bcch_bch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_bcch_dlsch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_pcch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_mch(uint32_t lcid, unique_byte_buffer_t pdu) final {}
+  void        notify_pdcp_integrity_error(uint32_t lcid) final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  bool                              keep_pdus = false;
+  pdcp_sn_vector_t                  tx_sns;
+  std::vector<unique_byte_buffer_t> tx_pdus;
+  uint32_t                          nof_discards = 0;
+  uint32_t                          nof_rx_sdus  = 0;
+};
+
+unique_byte_buffer_t make_sdu()
+{
+  unique_byte_buffer_t sdu = make_byte_buffer();
+  TESTASSERT(sdu != nullptr);
+  sdu->N_bytes = sdu_size;
+  return sdu;
+}
+
+void print_result(const char* name, uint32_t nof_items, std::chrono::nanoseconds time)
+{
+  double secs = std::chrono::duration<double>(time).count();
+  fmt::print("{:<3} {:>8} SDUs in {:>7.3f} s | {:>10.0f} SDU/s | {:>6.1f} ns/SDU\n",
+             name,
+             nof_items,
+             secs,
+             nof_items / secs,
+             secs * 1e9 / nof_items);
+}
+
+int run_tx_benchmark()
+{
+  benchmark_tester tester;
+  task_scheduler   task_sched;
+  pdcp_entity_nr   pdcp(&tester, &tester, &tester, &task_sched, srslog::fetch_basic_logger("PDCP"), 4);
+  TESTASSERT(pdcp.configure(bench_cfg));
+
+  std::mt19937                          rng(0);
+  std::uniform_real_distribution<float> loss_dist(0.0, 1.0);
+  std::vector<pdcp_sn_vector_t>         delivery_queue(delivery_delay + 1);
+  std::chrono::nanoseconds              tx_time{0};
+  uint32_t                              nof_tx_sdus = 0, nof_lost = 0;
+
+  // Keep running until all the discard timers expired
+  uint32_t nof_ttis = (nof_sdus + sdus_per_tti - 1) / sdus_per_tti + delivery_delay;
+  nof_ttis += static_cast<uint32_t>(bench_cfg.discard_timer) + 1;
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    pdcp_sn_vector_t& delivered = delivery_queue[tti % delivery_queue.size()];
+
+    auto t_start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < sdus_per_tti and nof_tx_sdus < nof_sdus; ++i, ++nof_tx_sdus) {
+      pdcp.write_sdu(make_sdu());
+    }
+    if (not delivered.empty()) {
+      pdcp.notify_delivery(delivered);
+    }
+    task_sched.tic();
+    tx_time += std::chrono::steady_clock::now() - t_start;
+
+    // RLC notifies the delivery of the SDUs written in this TTI after delivery_delay TTIs
+    delivered.clear();
+    for (uint32_t sn : tester.tx_sns) {
+      if (loss_dist(rng) < loss_rate) {
+        nof_lost++;
+      } else {
+        delivered.push_back(sn);
+      }
+    }
+    tester.tx_sns.clear();
+  }
+
+  print_result("TX", nof_sdus, tx_time);
+  TESTASSERT(tester.nof_discards == nof_lost);
+  TESTASSERT(pdcp.nof_discard_timers() == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int run_rx_benchmark()
+{
+  benchmark_tester tester;
+  task_scheduler   task_sched;
+  pdcp_entity_nr   pdcp_tx(&tester, &tester, &tester, &task_sched, srslog::fetch_basic_logger("PDCP"), 4);
+  pdcp_entity_nr   pdcp_rx(&tester, &tester, &tester, &task_sched, srslog::fetch_basic_logger("PDCP"), 4);
+  pdcp_config_t    cfg = bench_cfg;
+  cfg.discard_timer    = pdcp_discard_timer_t::infinity;
+  TESTASSERT(pdcp_tx.configure(cfg));
+  TESTASSERT(pdcp_rx.configure(cfg));
+  tester.keep_pdus = true;
+
+  std::mt19937                          rng(0);
+  std::uniform_real_distribution<float> loss_dist(0.0, 1.0);
+  std::vector<unique_byte_buffer_t>     reorder_buffer;
+  std::chrono::nanoseconds              rx_time{0};
+  uint32_t                              nof_tx_sdus = 0, nof_lost = 0;
+
+  auto deliver_pdu = [&](unique_byte_buffer_t pdu) {
+    auto t_start = std::chrono::steady_clock::now();
+    pdcp_rx.write_pdu(std::move(pdu));
+    rx_time += std::chrono::steady_clock::now() - t_start;
+  };
+
+  // Keep running until t-Reordering stops, once all the PDUs were delivered
+  while (nof_tx_sdus < nof_sdus or pdcp_rx.is_reordering_timer_running()) {
+    for (uint32_t i = 0; i < sdus_per_tti and nof_tx_sdus < nof_sdus; ++i, ++nof_tx_sdus) {
+      pdcp_tx.write_sdu(make_sdu());
+    }
+    for (unique_byte_buffer_t& pdu : tester.tx_pdus) {
+      if (loss_dist(rng) < loss_rate) {
+        nof_lost++;
+        continue;
+      }
+      // Deliver a random PDU among the last "reorder_depth" ones
+      reorder_buffer.push_back(std::move(pdu));
+      if (reorder_buffer.size() >= reorder_depth) {
+        uint32_t idx = std::uniform_int_distribution<uint32_t>(0, reorder_buffer.size() - 1)(rng);
+        std::swap(reorder_buffer[idx], reorder_buffer.back());
+        deliver_pdu(std::move(reorder_buffer.back()));
+        reorder_buffer.pop_back();
+      }
+    }
+    tester.tx_pdus.clear();
+    tester.tx_sns.clear();
+    if (nof_tx_sdus == nof_sdus) {
+      // Flush the PDUs still being reordered
+      for (unique_byte_buffer_t& pdu : reorder_buffer) {
+        deliver_pdu(std::move(pdu));
+      }
+      reorder_buffer.clear();
+    }
+
+    auto t_start = std::chrono::steady_clock::now();
+    task_sched.tic();
+    rx_time += std::chrono::steady_clock::now() - t_start;
+  }
+
+  print_result("RX", nof_sdus - nof_lost, rx_time);
+  TESTASSERT(tester.nof_rx_sdus == nof_sdus - nof_lost);
+  TESTASSERT(not pdcp_rx.is_reordering_timer_running());
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nstdrl]\n", prog);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-t number of SDUs per TTI [Default %d]\n", sdus_per_tti);
+  printf("\t-d delay of the RLC delivery notifications in TTIs [Default %d]\n", delivery_delay);
+  printf("\t-r reordering depth in PDUs [Default %d]\n", reorder_depth);
+  printf("\t-l SDU loss rate [Default %.3f]\n", loss_rate);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:s:t:d:r:l:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 't':
+        sdus_per_tti = std::min(std::max(1L, strtol(argv[optind - 1], nullptr, 10)), (long)MAX_SDUS_TO_NOTIFY);
+        break;
+      case 'd':
+        delivery_delay = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'r':
+        reorder_depth = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      case 'l':
+        loss_rate = strtof(argv[optind - 1], nullptr);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("PDCP").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  TESTASSERT(run_tx_benchmark() == SRSRAN_SUCCESS);
+  TESTASSERT(run_rx_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -79,6 +79,66 @@ int test_tx_sdu_discard(const pdcp_initial_state&    init_state,
   return 0;
 }
 
+/*
+ * Test discard of SDUs written at different times, some of them being notified as delivered by RLC in between
+ */
+int test_tx_sdu_discard_staggered(const pdcp_initial_state& init_state, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::ms50,
+                               false,
+                               srsran::srsran_rat_t::nr};
+
+  pdcp_nr_test_helper      pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_nr*  pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+
+  pdcp_hlp.set_pdcp_initial_state(init_state);
+  uint32_t first_count = init_state.tx_next;
+
+  // Write one SDU every 10 ms
+  const uint32_t nof_sdus = 4;
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    sdu->append_bytes(sdu1, sizeof(sdu1));
+    pdcp->write_sdu(std::move(sdu));
+    TESTASSERT(pdcp->nof_discard_timers() == i + 1);
+    for (uint32_t t = 0; t < 10; ++t) {
+      stack->run_tti();
+    }
+  }
+
+  // RLC notifies the delivery of the first and the third SDUs, 40 ms after the first SDU was written
+  pdcp->notify_delivery({first_count, first_count + 2});
+  TESTASSERT(pdcp->nof_discard_timers() == 2);
+
+  // The second SDU expires 60 ms after the first SDU was written
+  for (uint32_t t = 0; t < 19; ++t) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 0);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 1);
+  TESTASSERT(pdcp->nof_discard_timers() == 1);
+
+  // The last SDU expires 80 ms after the first SDU was written
+  for (uint32_t t = 0; t < 19; ++t) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 1);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 2);
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+
+  return 0;
+}
+
 /*
  * TX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -96,6 +156,12 @@ int test_tx_discard_all(srslog::basic_logger& logger)
    * Test TX PDU discard.
    */
   // TESTASSERT(test_tx_sdu_discard(normal_init_state, srsran::pdcp_discard_timer_t::ms50, true, logger) == 0);
+
+  /*
+   * TX Test 3: PDCP Entity with SN LEN = 12
+   * Test TX PDU discard of SDUs written at different times.
+   */
+  TESTASSERT(test_tx_sdu_discard_staggered(normal_init_state, logger) == 0);
   return 0;
 }
 
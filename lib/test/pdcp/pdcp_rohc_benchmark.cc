@@ -0,0 +1,172 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "pdcp_rohc_test.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+
+using namespace srsran;
+
+/*
+ * Throughput benchmark of the ROHC compressor and decompressor, with VoIP calls multiplexed on one bearer.
+ * Packets are built in batches outside of the measured time.
+ */
+
+namespace {
+
+uint32_t nof_packets = 1000000;
+uint32_t nof_flows   = 4;
+uint32_t batch_size  = 1024;
+
+struct bench_result_t {
+  std::chrono::nanoseconds compress_time{0};
+  std::chrono::nanoseconds decompress_time{0};
+  uint64_t                 hdr_bytes_in  = 0;
+  uint64_t                 hdr_bytes_out = 0;
+};
+
+void print_result(const char* name, const char* op, std::chrono::nanoseconds time)
+{
+  double secs = std::chrono::duration<double>(time).count();
+  fmt::print("{:<10} {:<10} {:>8} packets in {:>7.3f} s | {:>10.0f} packets/s | {:>6.1f} ns/packet\n",
+             name,
+             op,
+             nof_packets,
+             secs,
+             nof_packets / secs,
+             secs * 1e9 / nof_packets);
+}
+
+int run_benchmark(const char* name, uint8_t ip_version, bool seq_ip_id)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("ROHC", false);
+  pdcp_rohc_config_t    cfg;
+  cfg.profile_rtp = true;
+  cfg.profile_udp = true;
+  cfg.profile_ip  = true;
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(cfg);
+  decompressor.configure(cfg);
+
+  // Interleave the calls, each one on its own port and SSRC
+  uint32_t                   trace_len = (nof_packets + nof_flows - 1) / nof_flows;
+  std::vector<test_packet_t> trace;
+  for (uint32_t f = 0; f < nof_flows; ++f) {
+    std::vector<test_packet_t> flow = make_voip_trace(trace_len, ip_version, seq_ip_id, f);
+    for (uint32_t i = 0; i < flow.size(); ++i) {
+      flow[i].src_port += 2 * f;
+      flow[i].ssrc += f;
+      trace.push_back(flow[i]);
+    }
+  }
+  std::vector<test_packet_t> interleaved(trace.size());
+  for (uint32_t i = 0; i < trace.size(); ++i) {
+    interleaved[(i % trace_len) * nof_flows + i / trace_len] = trace[i];
+  }
+
+  bench_result_t                    result;
+  std::vector<unique_byte_buffer_t> batch;
+  for (uint32_t start = 0; start < nof_packets; start += batch_size) {
+    batch.clear();
+    for (uint32_t i = start; i < std::min(start + batch_size, nof_packets); ++i) {
+      batch.push_back(build_test_packet(interleaved[i]));
+      TESTASSERT(batch.back() != nullptr);
+      result.hdr_bytes_in += batch.back()->N_bytes - interleaved[i].payload_len;
+    }
+
+    auto t_start = std::chrono::steady_clock::now();
+    for (unique_byte_buffer_t& pkt : batch) {
+      compressor.compress(*pkt);
+    }
+    result.compress_time += std::chrono::steady_clock::now() - t_start;
+    for (uint32_t i = 0; i < batch.size(); ++i) {
+      result.hdr_bytes_out += batch[i]->N_bytes - interleaved[start + i].payload_len;
+    }
+
+    t_start = std::chrono::steady_clock::now();
+    for (unique_byte_buffer_t& pkt : batch) {
+      decompressor.decompress(*pkt);
+    }
+    result.decompress_time += std::chrono::steady_clock::now() - t_start;
+  }
+
+  print_result(name, "compress", result.compress_time);
+  print_result(name, "decompress", result.decompress_time);
+  fmt::print("{:<10} headers {} B -> {} B ({:.2f} B/packet), {} IR packets\n",
+             name,
+             result.hdr_bytes_in,
+             result.hdr_bytes_out,
+             (double)result.hdr_bytes_out / nof_packets,
+             compressor.get_metrics().nof_ir_packets);
+  TESTASSERT(decompressor.get_metrics().nof_errors == 0);
+  TESTASSERT(decompressor.get_metrics().nof_packets == nof_packets);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nfb]\n", prog);
+  printf("\t-n number of packets [Default %d]\n", nof_packets);
+  printf("\t-f number of multiplexed VoIP calls [Default %d]\n", nof_flows);
+  printf("\t-b batch size [Default %d]\n", batch_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:f:b:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_packets = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'f':
+        nof_flows = std::min(std::max(1L, strtol(argv[optind - 1], nullptr, 10)), 16L);
+        break;
+      case 'b':
+        batch_size = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("ROHC", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  TESTASSERT(run_benchmark("IPv4", 4, true) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark("IPv4 rnd", 4, false) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark("IPv6", 6, false) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,430 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "pdcp_nr_test.h"
+#include "pdcp_rohc_test.h"
+
+using namespace srsran;
+
+/*
+ * Test helpers
+ */
+struct loopback_result_t {
+  uint32_t nof_delivered = 0;
+  uint32_t nof_failed    = 0;
+  uint64_t hdr_bytes_in  = 0; ///< uncompressed headers
+  uint64_t hdr_bytes_out = 0; ///< ROHC headers
+};
+
+// Compresses each packet of the trace and decompresses the ones that are not lost, which must match the original
+int run_loopback(rohc_compressor&                  compressor,
+                 rohc_decompressor&                decompressor,
+                 const std::vector<test_packet_t>& trace,
+                 const std::vector<bool>&          lost,
+                 loopback_result_t&                result)
+{
+  for (uint32_t i = 0; i < trace.size(); ++i) {
+    unique_byte_buffer_t pkt  = build_test_packet(trace[i]);
+    unique_byte_buffer_t orig = make_byte_buffer();
+    TESTASSERT(pkt != nullptr and orig != nullptr);
+    *orig = *pkt;
+
+    TESTASSERT(compressor.compress(*pkt));
+    result.hdr_bytes_in += orig->N_bytes - trace[i].payload_len;
+    result.hdr_bytes_out += pkt->N_bytes - trace[i].payload_len;
+    if (not lost.empty() and lost[i]) {
+      continue;
+    }
+    if (decompressor.decompress(*pkt)) {
+      TESTASSERT(compare_two_packets(pkt, orig) == 0);
+      result.nof_delivered++;
+    } else {
+      result.nof_failed++;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+pdcp_rohc_config_t make_rohc_cfg(bool rtp, bool udp, bool ip, uint16_t max_cid = 15)
+{
+  pdcp_rohc_config_t cfg;
+  cfg.max_cid     = max_cid;
+  cfg.profile_rtp = rtp;
+  cfg.profile_udp = udp;
+  cfg.profile_ip  = ip;
+  return cfg;
+}
+
+/*
+ * Tests
+ */
+// Check values of the CRCs, as in the CRC catalogue (CRC-3/ROHC, CRC-7/ROHC and CRC-8/ROHC)
+int test_crc()
+{
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  TESTASSERT(rohc_crc(rohc_crc_type_t::crc3, check, sizeof(check)) == 0x6);
+  TESTASSERT(rohc_crc(rohc_crc_type_t::crc7, check, sizeof(check)) == 0x53);
+  TESTASSERT(rohc_crc(rohc_crc_type_t::crc8, check, sizeof(check)) == 0xd0);
+  return SRSRAN_SUCCESS;
+}
+
+// RTP profile with a VoIP trace. After the first IR packets, most headers are compressed to UO-0 plus UDP checksum
+int test_rtp_voip(uint8_t ip_version, bool seq_ip_id, srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, true, true));
+  decompressor.configure(make_rohc_cfg(true, true, true));
+
+  std::vector<test_packet_t> trace = make_voip_trace(2000, ip_version, seq_ip_id, 0);
+  loopback_result_t          result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, {}, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size());
+  TESTASSERT(result.nof_failed == 0);
+
+  // UO-0 and UDP checksum, plus the IP-ID if it is random
+  double avg_hdr = (double)result.hdr_bytes_out / trace.size();
+  TESTASSERT(avg_hdr < (ip_version == 4 and not seq_ip_id ? 6.0 : 4.0));
+  TESTASSERT(compressor.get_metrics().nof_ir_packets == decompressor.get_metrics().nof_ir_packets);
+  TESTASSERT(decompressor.get_metrics().nof_errors == 0);
+  return SRSRAN_SUCCESS;
+}
+
+// Lost packets, in bursts shorter than the W-LSB window, must not cause decompression failures
+int test_rtp_losses(srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, false, false));
+  decompressor.configure(make_rohc_cfg(true, false, false));
+
+  std::vector<test_packet_t> trace = make_voip_trace(5000, 4, true, 1);
+  std::vector<bool>          lost(trace.size(), false);
+  std::mt19937               rng(2);
+  uint32_t                   nof_lost = 0;
+  for (uint32_t i = 10; i < trace.size(); i += 20) {
+    uint32_t burst = std::uniform_int_distribution<uint32_t>(1, 3)(rng);
+    for (uint32_t j = 0; j < burst; ++j, ++nof_lost) {
+      lost[i + j] = true;
+    }
+  }
+
+  loopback_result_t result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, lost, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size() - nof_lost);
+  TESTASSERT(result.nof_failed == 0);
+  return SRSRAN_SUCCESS;
+}
+
+// Changes of the fields that can not be inferred reinitialize the context
+int test_rtp_dynamic_changes(srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, false, false));
+  decompressor.configure(make_rohc_cfg(true, false, false));
+
+  std::vector<test_packet_t> trace = make_voip_trace(600, 4, true, 3);
+  for (uint32_t i = 100; i < trace.size(); ++i) {
+    trace[i].ttl = 32; // TTL change
+  }
+  for (uint32_t i = 200; i < trace.size(); ++i) {
+    trace[i].rtp_pt = 97; // codec change
+  }
+  for (uint32_t i = 300; i < trace.size(); ++i) {
+    trace[i].ip_id = 0x1000 + (i * 7919) % 0xefff; // IP-ID becomes random
+  }
+  for (uint32_t i = 400; i < trace.size(); ++i) {
+    trace[i].ts = trace[400].ts + (i - 400) * 160; // TS stride change
+  }
+  trace[500].sn += 1000; // SN jump
+  for (uint32_t i = 501; i < trace.size(); ++i) {
+    trace[i].sn = trace[500].sn + (i - 500);
+  }
+
+  loopback_result_t result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, {}, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size());
+  TESTASSERT(compressor.get_metrics().nof_ir_packets > 5 * 3);
+  return SRSRAN_SUCCESS;
+}
+
+// UDP and IP profiles, for flows that do not carry RTP
+int test_udp_ip_profiles(uint8_t ip_version, srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, true, true));
+  decompressor.configure(make_rohc_cfg(true, true, true));
+
+  std::vector<test_packet_t> trace;
+  for (uint32_t i = 0; i < 500; ++i) {
+    test_packet_t udp = {};
+    udp.ip_version    = ip_version;
+    udp.dst_port      = 53; // not RTP
+    udp.rtp           = false;
+    udp.ip_id         = 100 + i;
+    udp.payload_len   = 40 + i % 100;
+    trace.push_back(udp);
+
+    test_packet_t tcp = udp;
+    tcp.protocol      = 6;
+    tcp.ip_id         = 1000 + i;
+    tcp.payload_len   = 20 + 1300;
+    trace.push_back(tcp);
+  }
+
+  loopback_result_t result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, {}, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size());
+  // UO-0, plus the UDP checksum for the UDP flow
+  TESTASSERT((double)result.hdr_bytes_out / trace.size() < 4.0);
+  return SRSRAN_SUCCESS;
+}
+
+// Packets that the enabled profiles can not compress are sent with the uncompressed profile
+int test_uncompressed_profile(uint16_t max_cid, srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, false, false, max_cid));
+  decompressor.configure(make_rohc_cfg(true, false, false, max_cid));
+
+  std::vector<test_packet_t> trace;
+  for (uint32_t i = 0; i < 300; ++i) {
+    test_packet_t pkt = {};
+    pkt.rtp           = false;
+    pkt.ip_id         = i;
+    switch (i % 4) {
+      case 0:
+        pkt.protocol = 6; // TCP
+        break;
+      case 1:
+        pkt.fragment = true;
+        break;
+      case 2:
+        pkt.ip_version = 6;
+        pkt.protocol   = 44; // IPv6 fragment header
+        break;
+      default:
+        pkt.raw_first_octet = 0xe0 + i % 32; // not IP, looks like a ROHC packet type
+        break;
+    }
+    trace.push_back(pkt);
+  }
+
+  loopback_result_t result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, {}, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size());
+  // Once the context is established, IP packets are sent with a single octet of overhead (CID or large CID)
+  TESTASSERT(result.hdr_bytes_out - result.hdr_bytes_in < trace.size() * 2);
+  return SRSRAN_SUCCESS;
+}
+
+// Flows interleaved on different CIDs, with and without enough CIDs to hold all of them
+int test_cid_multiplexing(uint32_t nof_flows, uint16_t max_cid, srslog::basic_logger& logger)
+{
+  rohc_compressor   compressor(logger);
+  rohc_decompressor decompressor(logger);
+  compressor.configure(make_rohc_cfg(true, true, true, max_cid));
+  decompressor.configure(make_rohc_cfg(true, true, true, max_cid));
+
+  std::vector<std::vector<test_packet_t> > flows;
+  for (uint32_t f = 0; f < nof_flows; ++f) {
+    flows.push_back(make_voip_trace(300, f % 2 == 0 ? 4 : 6, true, 10 + f));
+    for (test_packet_t& pkt : flows.back()) {
+      pkt.src_port += 2 * f;
+      pkt.ssrc += f;
+    }
+  }
+  std::vector<test_packet_t> trace;
+  for (uint32_t i = 0; i < flows[0].size(); ++i) {
+    for (uint32_t f = 0; f < nof_flows; ++f) {
+      trace.push_back(flows[f][i]);
+    }
+  }
+
+  loopback_result_t result;
+  TESTASSERT(run_loopback(compressor, decompressor, trace, {}, result) == SRSRAN_SUCCESS);
+  TESTASSERT(result.nof_delivered == trace.size());
+  if (nof_flows <= max_cid + 1U) {
+    TESTASSERT(compressor.get_metrics().nof_ir_packets < nof_flows * 3 * 8);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// VoIP call through a pair of NR PDCP entities with ROHC and security enabled
+int test_pdcp_nr_loopback(srslog::basic_logger& logger)
+{
+  pdcp_config_t cfg_tx = {1,
+                          PDCP_RB_IS_DRB,
+                          SECURITY_DIRECTION_UPLINK,
+                          SECURITY_DIRECTION_DOWNLINK,
+                          PDCP_SN_LEN_12,
+                          pdcp_t_reordering_t::ms500,
+                          pdcp_discard_timer_t::infinity,
+                          false,
+                          srsran_rat_t::nr};
+  cfg_tx.rohc          = make_rohc_cfg(true, true, true);
+  pdcp_config_t cfg_rx = cfg_tx;
+  cfg_rx.tx_direction  = SECURITY_DIRECTION_DOWNLINK;
+  cfg_rx.rx_direction  = SECURITY_DIRECTION_UPLINK;
+  pdcp_nr_test_helper pdcp_tx(cfg_tx, sec_cfg, logger);
+  pdcp_nr_test_helper pdcp_rx(cfg_rx, sec_cfg, logger);
+
+  std::vector<test_packet_t> trace     = make_voip_trace(3000, 4, true, 4);
+  uint64_t                   sdu_bytes = 0, pdu_bytes = 0;
+  for (const test_packet_t& pkt : trace) {
+    unique_byte_buffer_t sdu = build_test_packet(pkt);
+    unique_byte_buffer_t pdu = make_byte_buffer();
+    unique_byte_buffer_t out = make_byte_buffer();
+    unique_byte_buffer_t exp = make_byte_buffer();
+    TESTASSERT(sdu != nullptr and pdu != nullptr and out != nullptr and exp != nullptr);
+    *exp = *sdu;
+    sdu_bytes += sdu->N_bytes;
+
+    pdcp_tx.pdcp.write_sdu(std::move(sdu));
+    pdcp_tx.rlc.get_last_sdu(pdu);
+    pdu_bytes += pdu->N_bytes;
+    pdcp_rx.pdcp.write_pdu(std::move(pdu));
+    pdcp_rx.gw.get_last_pdu(out);
+    TESTASSERT(compare_two_packets(exp, out) == 0);
+  }
+  TESTASSERT(pdcp_rx.gw.rx_count == trace.size());
+
+  // PDCP header and MAC-I add 6 bytes to each packet
+  uint64_t payload_bytes = 0;
+  for (const test_packet_t& pkt : trace) {
+    payload_bytes += pkt.payload_len;
+  }
+  uint64_t hdr_bytes  = sdu_bytes - payload_bytes;
+  uint64_t rohc_bytes = pdu_bytes - trace.size() * 6 - payload_bytes;
+  fmt::print("VoIP trace over PDCP NR: {} packets, {} B of IP/UDP/RTP headers compressed to {} B ({:.1f} B/packet), "
+             "{:.1f}% of the PDCP SDU bytes saved\n",
+             trace.size(),
+             hdr_bytes,
+             rohc_bytes,
+             (double)rohc_bytes / trace.size(),
+             100.0 * (hdr_bytes - rohc_bytes) / sdu_bytes);
+  TESTASSERT(rohc_bytes * 8 < hdr_bytes);
+  return SRSRAN_SUCCESS;
+}
+
+// Header compression is released and set up again by reconfiguring active NR PDCP entities
+int test_pdcp_nr_reconfiguration(srslog::basic_logger& logger)
+{
+  pdcp_config_t cfg_tx = {1,
+                          PDCP_RB_IS_DRB,
+                          SECURITY_DIRECTION_UPLINK,
+                          SECURITY_DIRECTION_DOWNLINK,
+                          PDCP_SN_LEN_12,
+                          pdcp_t_reordering_t::ms500,
+                          pdcp_discard_timer_t::infinity,
+                          false,
+                          srsran_rat_t::nr};
+  cfg_tx.rohc          = make_rohc_cfg(true, true, true);
+  pdcp_config_t cfg_rx = cfg_tx;
+  cfg_rx.tx_direction  = SECURITY_DIRECTION_DOWNLINK;
+  cfg_rx.rx_direction  = SECURITY_DIRECTION_UPLINK;
+  pdcp_nr_test_helper pdcp_tx(cfg_tx, sec_cfg, logger);
+  pdcp_nr_test_helper pdcp_rx(cfg_rx, sec_cfg, logger);
+
+  std::vector<test_packet_t> trace = make_voip_trace(300, 4, true, 5);
+  uint32_t                   idx   = 0;
+  // Sends the next packets of the trace and returns the number of them whose PDU is smaller than the SDU
+  auto send_packets = [&](uint32_t nof_packets, uint32_t& nof_compressed) {
+    nof_compressed = 0;
+    for (uint32_t i = 0; i < nof_packets; ++i, ++idx) {
+      unique_byte_buffer_t sdu = build_test_packet(trace[idx]);
+      unique_byte_buffer_t pdu = make_byte_buffer();
+      unique_byte_buffer_t out = make_byte_buffer();
+      unique_byte_buffer_t exp = make_byte_buffer();
+      TESTASSERT(sdu != nullptr and pdu != nullptr and out != nullptr and exp != nullptr);
+      *exp = *sdu;
+
+      pdcp_tx.pdcp.write_sdu(std::move(sdu));
+      pdcp_tx.rlc.get_last_sdu(pdu);
+      // PDCP header and MAC-I add 6 bytes to each packet
+      nof_compressed += pdu->N_bytes < exp->N_bytes + 6 ? 1 : 0;
+      pdcp_rx.pdcp.write_pdu(std::move(pdu));
+      pdcp_rx.gw.get_last_pdu(out);
+      TESTASSERT(compare_two_packets(exp, out) == 0);
+    }
+    return SRSRAN_SUCCESS;
+  };
+
+  uint32_t nof_compressed = 0;
+  TESTASSERT(send_packets(100, nof_compressed) == SRSRAN_SUCCESS);
+  TESTASSERT(nof_compressed > 90);
+
+  // Release header compression. Packets are sent uncompressed from now on
+  cfg_tx.rohc = {};
+  cfg_rx.rohc = {};
+  TESTASSERT(pdcp_tx.pdcp.configure(cfg_tx));
+  TESTASSERT(pdcp_rx.pdcp.configure(cfg_rx));
+  TESTASSERT(send_packets(100, nof_compressed) == SRSRAN_SUCCESS);
+  TESTASSERT(nof_compressed == 0);
+
+  // Parameters other than the header compression cannot be reconfigured
+  pdcp_config_t cfg_sn18 = cfg_tx;
+  cfg_sn18.sn_len        = PDCP_SN_LEN_18;
+  TESTASSERT(not pdcp_tx.pdcp.configure(cfg_sn18));
+
+  // Set up header compression again. The flow restarts with IR packets
+  cfg_tx.rohc = make_rohc_cfg(true, true, true);
+  cfg_rx.rohc = cfg_tx.rohc;
+  TESTASSERT(pdcp_tx.pdcp.configure(cfg_tx));
+  TESTASSERT(pdcp_rx.pdcp.configure(cfg_rx));
+  TESTASSERT(send_packets(100, nof_compressed) == SRSRAN_SUCCESS);
+  TESTASSERT(nof_compressed > 90);
+
+  TESTASSERT(pdcp_rx.gw.rx_count == trace.size());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  auto& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::info);
+  logger.set_hex_dump_max_size(128);
+
+  TESTASSERT(test_crc() == SRSRAN_SUCCESS);
+  TESTASSERT(test_rtp_voip(4, true, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_rtp_voip(4, false, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_rtp_voip(6, false, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_rtp_losses(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_rtp_dynamic_changes(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_udp_ip_profiles(4, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_udp_ip_profiles(6, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_uncompressed_profile(15, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_uncompressed_profile(500, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_cid_multiplexing(8, 15, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_cid_multiplexing(8, 3, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_cid_multiplexing(40, 1000, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcp_nr_loopback(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcp_nr_reconfiguration(logger) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_ROHC_TEST_H
+#define SRSRAN_PDCP_ROHC_TEST_H
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/upper/rohc.h"
+#include <numeric>
+#include <random>
+
+// Description of a test packet. By default a VoIP packet over RTP/UDP/IPv4
+struct test_packet_t {
+  uint8_t  ip_version      = 4;
+  uint8_t  protocol        = 17;
+  uint8_t  tos             = 0xb8;
+  uint8_t  ttl             = 64;
+  uint16_t ip_id           = 0;
+  bool     df              = true;
+  bool     fragment        = false;
+  uint16_t src_port        = 40000;
+  uint16_t dst_port        = 50000;
+  bool     rtp             = true;
+  bool     rtp_marker      = false;
+  uint8_t  rtp_pt          = 96;
+  uint16_t sn              = 0;
+  uint32_t ts              = 0;
+  uint32_t ssrc            = 0x1234abcd;
+  uint32_t payload_len     = 33;
+  uint8_t  raw_first_octet = 0; ///< if set, the packet is not IP and starts with this octet
+};
+
+inline void put16(uint8_t* p, uint16_t v)
+{
+  p[0] = v >> 8;
+  p[1] = v & 0xff;
+}
+
+inline void put32(uint8_t* p, uint32_t v)
+{
+  put16(p, v >> 16);
+  put16(p + 2, v & 0xffff);
+}
+
+inline srsran::unique_byte_buffer_t build_test_packet(const test_packet_t& t)
+{
+  srsran::unique_byte_buffer_t pkt = srsran::make_byte_buffer();
+  if (pkt == nullptr) {
+    return pkt;
+  }
+  uint8_t* p = pkt->msg;
+  if (t.raw_first_octet != 0) {
+    for (uint32_t i = 0; i < t.payload_len; ++i) {
+      p[i] = i + t.ip_id;
+    }
+    p[0]         = t.raw_first_octet;
+    pkt->N_bytes = t.payload_len;
+    return pkt;
+  }
+
+  uint32_t ip_len    = t.ip_version == 4 ? 20 : 40;
+  bool     has_udp   = t.protocol == 17;
+  uint32_t udp_len   = has_udp ? 8 : 0;
+  uint32_t rtp_len   = has_udp and t.rtp ? 12 : 0;
+  uint32_t total_len = ip_len + udp_len + rtp_len + t.payload_len;
+  if (t.ip_version == 4) {
+    p[0] = 0x45;
+    p[1] = t.tos;
+    put16(p + 2, total_len);
+    put16(p + 4, t.ip_id);
+    put16(p + 6, (t.df ? 0x4000 : 0) | (t.fragment ? 0x2000 : 0));
+    p[8] = t.ttl;
+    p[9] = t.protocol;
+    put16(p + 10, 0);
+    put32(p + 12, 0x0a2d0001);
+    put32(p + 16, 0xc0a80164);
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < 20; i += 2) {
+      sum += (uint32_t)p[i] << 8 | p[i + 1];
+    }
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    put16(p + 10, ~sum & 0xffff);
+  } else {
+    p[0] = 0x60 | t.tos >> 4;
+    p[1] = (t.tos & 0x0f) << 4 | 0x0a;
+    put16(p + 2, 0xbcde);
+    put16(p + 4, total_len - ip_len);
+    p[6] = t.protocol;
+    p[7] = t.ttl;
+    for (uint32_t i = 0; i < 16; ++i) {
+      p[8 + i]  = i == 0 ? 0x20 : (i == 15 ? 0x01 : 0x0d);
+      p[24 + i] = i == 0 ? 0x20 : (i == 15 ? 0x02 : 0x0b);
+    }
+  }
+
+  uint8_t* udp = p + ip_len;
+  if (has_udp) {
+    put16(udp, t.src_port);
+    put16(udp + 2, t.dst_port);
+    put16(udp + 4, total_len - ip_len);
+    put16(udp + 6, (t.sn * 7919 + t.ts) | 1); // not a real checksum, but non-zero as most are
+  }
+  uint8_t* rtp = udp + udp_len;
+  if (rtp_len != 0) {
+    rtp[0] = 0x80;
+    rtp[1] = (t.rtp_marker ? 0x80 : 0) | t.rtp_pt;
+    put16(rtp + 2, t.sn);
+    put32(rtp + 4, t.ts);
+    put32(rtp + 8, t.ssrc);
+  }
+  uint8_t* payload = rtp + rtp_len;
+  for (uint32_t i = 0; i < t.payload_len; ++i) {
+    payload[i] = i * 13 + t.sn;
+  }
+  pkt->N_bytes = total_len;
+  return pkt;
+}
+
+/*
+ * Synthetic VoIP call with AMR-WB at 12.65 kbps: one frame every 20 ms during talkspurts and one SID frame every
+ * 160 ms during silences. The first packet of each talkspurt has the RTP marker set.
+ */
+inline std::vector<test_packet_t>
+make_voip_trace(uint32_t nof_packets, uint8_t ip_version, bool seq_ip_id, uint32_t seed)
+{
+  const uint32_t ts_per_frame = 320; // 20 ms at 16 kHz
+
+  std::mt19937               rng(seed);
+  std::vector<test_packet_t> trace;
+  uint16_t                   sn      = rng();
+  uint32_t                   ts      = rng();
+  uint16_t                   ip_id   = rng();
+  bool                       talking = true;
+  uint32_t                   left    = 100;
+  bool                       first   = true;
+  for (uint32_t i = 0; i < nof_packets; ++i) {
+    test_packet_t pkt = {};
+    pkt.ip_version    = ip_version;
+    pkt.sn            = sn++;
+    pkt.ts            = ts;
+    pkt.ip_id         = seq_ip_id ? ip_id++ : (uint16_t)rng();
+    pkt.rtp_marker    = talking and first;
+    pkt.payload_len   = talking ? 33 : 7;
+    trace.push_back(pkt);
+
+    ts += talking ? ts_per_frame : 8 * ts_per_frame;
+    first = false;
+    if (--left == 0) {
+      talking = not talking;
+      first   = true;
+      left    = talking ? std::uniform_int_distribution<uint32_t>(50, 200)(rng)
+                        : std::uniform_int_distribution<uint32_t>(3, 15)(rng);
+    }
+  }
+  return trace;
+}
+
+#endif // SRSRAN_PDCP_ROHC_TEST_H
@@ -0,0 +1,244 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_lte.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <thread>
+
+using namespace srsran;
+
+/*
+ * Throughput benchmark of a pair of RLC AM LTE entities, with the upper layer and the two MAC directions running in
+ * separate threads, as in the eNB/UE stacks:
+ *  - PDCP thread: writes SDUs into the transmitting entity;
+ *  - DL MAC thread: reads data PDUs from the transmitting entity and writes them into the receiving entity;
+ *  - UL MAC thread: reads status PDUs from the receiving entity and writes them into the transmitting entity.
+ * The same traffic is then run from a single thread, as a reference for the cost of the cross-thread synchronization.
+ */
+
+namespace {
+
+uint32_t nof_sdus   = 100000;
+uint32_t sdu_size   = 1500;
+uint32_t grant_size = 9000;
+
+class benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    nof_rx_sdus.fetch_add(1, std::memory_order_relaxed);
+  }
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  std::atomic<uint32_t> nof_rx_sdus{0};
+};
+
+rlc_config_t benchmark_config()
+{
+  rlc_config_t cfg = rlc_config_t::default_rlc_am_config();
+  // Timers are not run by the benchmark, and no PDU is lost
+  cfg.am.t_status_prohibit = 0;
+  cfg.am.poll_pdu          = 16;
+  cfg.am.poll_byte         = 64;
+  cfg.tx_queue_length      = 256;
+  return cfg;
+}
+
+/// Writes an SDU into the entity. Returns false if the SDU could not be allocated or enqueued
+bool write_sdu(rlc_am& rlc, uint32_t pdcp_sn)
+{
+  if (rlc.sdu_queue_is_full()) {
+    return false;
+  }
+  unique_byte_buffer_t sdu = make_byte_buffer();
+  if (sdu == nullptr) {
+    return false;
+  }
+  sdu->N_bytes    = sdu_size;
+  sdu->md.pdcp_sn = pdcp_sn % (1U << 18U); // 18-bit PDCP SN
+  rlc.write_sdu(std::move(sdu));
+  return true;
+}
+
+/// Moves at most one PDU from "src" to "dst". Returns false if "src" had nothing to send
+bool transfer_pdu(rlc_am& src, rlc_am& dst, byte_buffer_t& pdu, uint32_t nof_bytes)
+{
+  pdu.N_bytes = src.read_pdu(pdu.msg, nof_bytes);
+  if (pdu.N_bytes == 0) {
+    return false;
+  }
+  dst.write_pdu(pdu.msg, pdu.N_bytes);
+  return true;
+}
+
+void print_result(const char* name, std::chrono::nanoseconds elapsed, uint32_t nof_rx_sdus)
+{
+  double secs = std::chrono::duration<double>(elapsed).count();
+  fmt::print("{:<16} {:>8} SDUs in {:>7.3f} s | {:>10.0f} SDU/s | {:>8.1f} Mbps\n",
+             name,
+             nof_rx_sdus,
+             secs,
+             nof_rx_sdus / secs,
+             nof_rx_sdus * sdu_size * 8 / secs / 1e6);
+}
+
+int run_multi_thread()
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_am           rlc_tx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am           rlc_rx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(benchmark_config()));
+  TESTASSERT(rlc_rx.configure(benchmark_config()));
+
+  std::atomic<bool> running{true};
+  auto              t_start = std::chrono::steady_clock::now();
+
+  std::thread pdcp_thread([&]() {
+    for (uint32_t sn = 0; sn < nof_sdus and running;) {
+      if (write_sdu(rlc_tx, sn)) {
+        sn++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread dl_mac_thread([&]() {
+    unique_byte_buffer_t pdu = make_byte_buffer();
+    while (running) {
+      if (not transfer_pdu(rlc_tx, rlc_rx, *pdu, grant_size)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread ul_mac_thread([&]() {
+    unique_byte_buffer_t pdu = make_byte_buffer();
+    while (running) {
+      if (not transfer_pdu(rlc_rx, rlc_tx, *pdu, grant_size)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  auto deadline = t_start + std::chrono::seconds(60);
+  while (tester.nof_rx_sdus < nof_sdus and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  auto elapsed = std::chrono::steady_clock::now() - t_start;
+  running      = false;
+  pdcp_thread.join();
+  dl_mac_thread.join();
+  ul_mac_thread.join();
+
+  print_result("multi-thread", elapsed, tester.nof_rx_sdus);
+  TESTASSERT(tester.nof_rx_sdus == nof_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+int run_single_thread()
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_am           rlc_tx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am           rlc_rx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(benchmark_config()));
+  TESTASSERT(rlc_rx.configure(benchmark_config()));
+
+  unique_byte_buffer_t pdu     = make_byte_buffer();
+  uint32_t             sn      = 0;
+  auto                 t_start = std::chrono::steady_clock::now();
+  while (tester.nof_rx_sdus < nof_sdus) {
+    while (sn < nof_sdus and write_sdu(rlc_tx, sn)) {
+      sn++;
+    }
+    bool dl = transfer_pdu(rlc_tx, rlc_rx, *pdu, grant_size);
+    bool ul = transfer_pdu(rlc_rx, rlc_tx, *pdu, grant_size);
+    TESTASSERT(dl or ul or sn < nof_sdus or tester.nof_rx_sdus == nof_sdus);
+  }
+  print_result("single-thread", std::chrono::steady_clock::now() - t_start, tester.nof_rx_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nsg]\n", prog);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-g MAC grant size in bytes [Default %d]\n", grant_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:s:g:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'g':
+        grant_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("RLC_AM_1").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC_AM_2").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(run_single_thread() == SRSRAN_SUCCESS);
+  TESTASSERT(run_multi_thread() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -2426,6 +2426,47 @@ int rlc_am_nr_control_pdu_test_nack_merge_range_range(rlc_am_nr_sn_size_t sn_siz
   return SRSRAN_SUCCESS;
 }
 
+// Test merge of NACKs into a sequence longer than the maximum NACK range
+int rlc_am_nr_control_pdu_test_nack_range_overflow(rlc_am_nr_sn_size_t sn_size)
+{
+  test_delimit_logger delimiter("Control PDU ({} bit SN) test NACK range overflow", to_number(sn_size));
+
+  const uint32_t mod_nr    = cardinality(sn_size);
+  const uint32_t first_sn  = mod_nr - 100; // the sequence wraps around the SN space
+  const uint32_t nof_nacks = 600;
+
+  rlc_am_nr_status_pdu_t status_pdu(sn_size);
+  for (uint32_t i = 0; i < nof_nacks; i++) {
+    rlc_status_nack_t nack;
+    nack.nack_sn = (first_sn + i) % mod_nr;
+    status_pdu.push_nack(nack);
+  }
+  status_pdu.ack_sn = (first_sn + nof_nacks) % mod_nr;
+
+  // Split into 255 + 255 + 90
+  TESTASSERT_EQ(3, status_pdu.nacks.size());
+  TESTASSERT_EQ(first_sn, status_pdu.nacks[0].nack_sn);
+  TESTASSERT_EQ(255, status_pdu.nacks[0].nack_range);
+  TESTASSERT_EQ((first_sn + 255) % mod_nr, status_pdu.nacks[1].nack_sn);
+  TESTASSERT_EQ(255, status_pdu.nacks[1].nack_range);
+  TESTASSERT_EQ((first_sn + 510) % mod_nr, status_pdu.nacks[2].nack_sn);
+  TESTASSERT_EQ(90, status_pdu.nacks[2].nack_range);
+
+  // Pack and unpack
+  srsran::byte_buffer_t pdu;
+  TESTASSERT(rlc_am_nr_write_status_pdu(status_pdu, sn_size, &pdu) == SRSRAN_SUCCESS);
+  TESTASSERT_EQ(status_pdu.packed_size, pdu.N_bytes);
+  rlc_am_nr_status_pdu_t status_pdu_rx(sn_size);
+  TESTASSERT(rlc_am_nr_read_status_pdu(&pdu, sn_size, &status_pdu_rx) == SRSRAN_SUCCESS);
+  TESTASSERT_EQ(status_pdu.ack_sn, status_pdu_rx.ack_sn);
+  TESTASSERT_EQ(status_pdu.nacks.size(), status_pdu_rx.nacks.size());
+  for (uint32_t i = 0; i < status_pdu.nacks.size(); i++) {
+    TESTASSERT(status_pdu.nacks[i] == status_pdu_rx.nacks[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 // Test status PDU for correct trimming and estimation of packed size
 // 1) Test init, copy and reset
 // 2) Test step-wise growth and trimming of status PDU while covering several corner cases
@@ -3025,6 +3066,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (rlc_am_nr_control_pdu_test_nack_range_overflow(rlc_am_nr_sn_size_t::size12bits)) {
+    fprintf(stderr, "rlc_am_nr_control_pdu_test_nack_range_overflow(size12bits) failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (rlc_am_nr_control_pdu_test_trimming(rlc_am_nr_sn_size_t::size12bits)) {
     fprintf(stderr, "rlc_am_nr_control_pdu_test_trimming(size12bits) failed.\n");
     return SRSRAN_ERROR;
@@ -3080,6 +3126,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (rlc_am_nr_control_pdu_test_nack_range_overflow(rlc_am_nr_sn_size_t::size18bits)) {
+    fprintf(stderr, "rlc_am_nr_control_pdu_test_nack_range_overflow(size18bits) failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (rlc_am_nr_control_pdu_test_trimming(rlc_am_nr_sn_size_t::size18bits)) {
     fprintf(stderr, "rlc_am_nr_control_pdu_test_trimming(size18bits) failed.\n");
     return SRSRAN_ERROR;
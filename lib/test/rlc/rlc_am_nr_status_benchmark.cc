@@ -0,0 +1,290 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+
+using namespace srsran;
+
+/*
+ * Benchmark of the status reporting of RLC AM NR with 18-bit SNs and large windows. The receiving window is filled
+ * with a sequence of SDUs received with random losses, and then the time it takes to:
+ *  - compute the length of the status PDU, as done on every buffer state query;
+ *  - build a status PDU that fits into a given grant;
+ *  - handle the status PDU at the transmitting entity, first and for repeated reports of the same losses,
+ * is measured. The transmitting entity keeps all the SDUs of its window in the byte buffer pool, so a smaller
+ * window is used for the last measurement.
+ */
+
+namespace {
+
+uint32_t nof_sdus     = 100000;
+uint32_t nof_tx_sdus  = 3000;
+uint32_t sdu_size     = 64;
+uint32_t max_status   = 9000;
+uint32_t nof_repeats  = 100;
+float    loss_rate    = 0.01;
+float    burst_length = 16;
+
+class benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+};
+
+/// Two-state loss model. Losses come in bursts with the given mean length, with a mean burst length of 1 being
+/// independent losses
+class loss_model
+{
+public:
+  loss_model(float rate_, float mean_burst_) :
+    rate(rate_), p_exit_burst(1.0 / mean_burst_), p_enter_burst(rate_ * p_exit_burst / (1.0 - rate_))
+  {}
+
+  bool next(std::mt19937& rng)
+  {
+    if (p_exit_burst >= 1.0) {
+      return dist(rng) < rate;
+    }
+    in_burst = in_burst ? dist(rng) >= p_exit_burst : dist(rng) < p_enter_burst;
+    return in_burst;
+  }
+
+private:
+  std::uniform_real_distribution<float> dist{0.0, 1.0};
+  float                                 rate;
+  float                                 p_exit_burst;
+  float                                 p_enter_burst;
+  bool                                  in_burst = false;
+};
+
+rlc_config_t benchmark_config()
+{
+  rlc_config_t cfg = rlc_config_t::default_rlc_am_nr_config(18);
+  // Only t-Reassembly is run by the benchmark, to update RX_Highest_Status
+  cfg.am_nr.t_status_prohibit = 0;
+  cfg.am_nr.t_reassembly      = 5;
+  cfg.am_nr.t_poll_retx       = 10000;
+  cfg.am_nr.poll_pdu          = -1;
+  cfg.am_nr.poll_byte         = -1;
+  cfg.am_nr.max_retx_thresh   = 1000;
+  return cfg;
+}
+
+/// Writes the data PDUs with SN=0..nof_pdus-1 into the entity, skipping the lost ones. The last PDU is always
+/// received, so that the RX window spans all the SNs. Returns the number of lost PDUs
+uint32_t fill_rx_window(rlc_am& rlc_rx, timer_handler& timers, uint32_t nof_pdus, float mean_burst)
+{
+  std::mt19937           rng(0);
+  loss_model             losses(loss_rate, mean_burst);
+  std::vector<uint8_t>   pdu(sdu_size + 3);
+  rlc_am_nr_pdu_header_t header = {};
+  header.dc                     = RLC_DC_FIELD_DATA_PDU;
+  header.si                     = rlc_nr_si_field_t::full_sdu;
+  header.sn_size                = rlc_am_nr_sn_size_t::size18bits;
+
+  uint32_t nof_lost = 0;
+  for (uint32_t sn = 0; sn < nof_pdus; sn++) {
+    if (sn + 1 < nof_pdus and losses.next(rng)) {
+      nof_lost++;
+      continue;
+    }
+    header.sn = sn;
+    rlc_am_nr_write_data_pdu_header(header, pdu.data());
+    rlc_rx.write_pdu(pdu.data(), pdu.size());
+  }
+
+  // Let t-Reassembly expire twice, so that RX_Highest_Status reaches the end of the window
+  uint32_t nof_steps = static_cast<uint32_t>(2 * benchmark_config().am_nr.t_reassembly + 2);
+  for (uint32_t i = 0; i < nof_steps; i++) {
+    timers.step_all();
+  }
+  return nof_lost;
+}
+
+double avg_us(std::chrono::nanoseconds elapsed, uint32_t n)
+{
+  return std::chrono::duration<double, std::micro>(elapsed).count() / n;
+}
+
+int run_benchmark(const char* name, float mean_burst)
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_am           rlc_tx(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_1"), 1, &tester, &tester, &timers);
+  rlc_am           rlc_rx(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_2"), 1, &tester, &tester, &timers);
+  rlc_am           rlc_rx_tx(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(benchmark_config()));
+  TESTASSERT(rlc_rx.configure(benchmark_config()));
+  TESTASSERT(rlc_rx_tx.configure(benchmark_config()));
+  rlc_am_nr_tx* tx    = dynamic_cast<rlc_am_nr_tx*>(rlc_tx.get_tx());
+  rlc_am_nr_rx* rx    = dynamic_cast<rlc_am_nr_rx*>(rlc_rx.get_rx());
+  rlc_am_nr_rx* rx_tx = dynamic_cast<rlc_am_nr_rx*>(rlc_rx_tx.get_rx());
+
+  uint32_t nof_lost = fill_rx_window(rlc_rx, timers, nof_sdus, mean_burst);
+
+  // Length of the full status PDU
+  uint32_t status_len = 0;
+  auto     t_start    = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repeats; i++) {
+    status_len = rx->get_status_pdu_length();
+  }
+  auto t_length = std::chrono::steady_clock::now() - t_start;
+
+  // Status PDU that fits into the grant
+  rlc_am_nr_status_pdu_t status(rlc_am_nr_sn_size_t::size18bits);
+  t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repeats; i++) {
+    rx->get_status_pdu(&status, max_status);
+  }
+  auto t_build = std::chrono::steady_clock::now() - t_start;
+  TESTASSERT(status.packed_size <= max_status);
+  TESTASSERT(status.packed_size == status_len or status_len > max_status);
+  size_t nof_nacks = status.nacks.size();
+
+  // Status PDU handling at the transmitting entity. The data PDUs are not needed, as the status PDU is generated by
+  // an entity that receives the same SNs with the same losses
+  unique_byte_buffer_t pdu = make_byte_buffer();
+  TESTASSERT(pdu != nullptr);
+  for (uint32_t i = 0; i < nof_tx_sdus; i++) {
+    unique_byte_buffer_t sdu = make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->N_bytes    = sdu_size;
+    sdu->md.pdcp_sn = i;
+    rlc_tx.write_sdu(std::move(sdu));
+    TESTASSERT_EQ(sdu_size + 3, rlc_tx.read_pdu(pdu->msg, sdu_size + 3));
+  }
+  fill_rx_window(rlc_rx_tx, timers, nof_tx_sdus, mean_burst);
+  rx_tx->get_status_pdu(&status, max_status);
+  TESTASSERT(rlc_am_nr_write_status_pdu(status, rlc_am_nr_sn_size_t::size18bits, pdu.get()) == SRSRAN_SUCCESS);
+
+  t_start = std::chrono::steady_clock::now();
+  tx->handle_control_pdu(pdu->msg, pdu->N_bytes);
+  auto     t_handle_first = std::chrono::steady_clock::now() - t_start;
+  uint32_t nof_retx       = tx->get_retx_queue_size();
+  t_start                 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repeats; i++) {
+    tx->handle_control_pdu(pdu->msg, pdu->N_bytes);
+  }
+  auto t_handle_repeated = std::chrono::steady_clock::now() - t_start;
+  // Repeated reports of the same losses do not schedule retransmissions again
+  TESTASSERT_EQ(nof_retx, tx->get_retx_queue_size());
+
+  fmt::print("{:<8} RX {:>6} lost SNs, status {:>6} B, {:>4} NACKs in grant | length {:>8.1f} us | build {:>8.1f} us | "
+             "TX {:>5} retx | handle {:>8.1f} us, repeated {:>8.1f} us\n",
+             name,
+             nof_lost,
+             status_len,
+             nof_nacks,
+             avg_us(t_length, nof_repeats),
+             avg_us(t_build, nof_repeats),
+             nof_retx,
+             avg_us(t_handle_first, 1),
+             avg_us(t_handle_repeated, nof_repeats));
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ntsmrlb]\n", prog);
+  printf("\t-n number of SDUs in the RX window [Default %d]\n", nof_sdus);
+  printf("\t-t number of SDUs in the TX window [Default %d]\n", nof_tx_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-m maximum status PDU size in bytes [Default %d]\n", max_status);
+  printf("\t-r number of repetitions of each measurement [Default %d]\n", nof_repeats);
+  printf("\t-l SDU loss rate [Default %.3f]\n", loss_rate);
+  printf("\t-b mean length of the loss bursts [Default %.1f]\n", burst_length);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:t:s:m:r:l:b:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 't':
+        nof_tx_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'm':
+        max_status = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'r':
+        nof_repeats = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      case 'l':
+        loss_rate = strtof(argv[optind - 1], nullptr);
+        break;
+      case 'b':
+        burst_length = std::max(1.0f, strtof(argv[optind - 1], nullptr));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  uint32_t window_size = am_window_size(rlc_am_nr_sn_size_t::size18bits);
+  if (nof_sdus == 0 or nof_sdus > window_size or nof_tx_sdus == 0 or nof_tx_sdus > window_size) {
+    fprintf(stderr, "The number of SDUs must be within the 18-bit SN window\n");
+    exit(-1);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("RLC_1").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("RLC_2").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  TESTASSERT(run_benchmark("random", 1) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark("bursty", burst_length) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
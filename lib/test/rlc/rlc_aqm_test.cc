@@ -0,0 +1,138 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/rlc/rlc_aqm.h"
+
+using namespace srsran;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+const uint32_t sdu_size   = 1000;
+const uint32_t queue_size = 1024;
+
+struct aqm_sim_result {
+  uint32_t nof_written = 0;
+  uint32_t nof_read    = 0;
+  uint32_t nof_dropped = 0;
+  double   max_delay_ms  = 0; ///< Over the last quarter of the simulation
+  double   mean_delay_ms = 0; ///< Over the last quarter of the simulation
+};
+
+/// Writes one SDU every arrival_us and reads one every service_us, with simulated time
+aqm_sim_result simulate(const rlc_aqm_config_t& cfg, uint32_t arrival_us, uint32_t service_us, uint32_t duration_ms)
+{
+  rlc_aqm                aqm;
+  spsc_byte_buffer_queue queue(queue_size);
+  aqm.configure(cfg);
+
+  aqm_sim_result             result    = {};
+  rlc_aqm::clock::time_point t0        = rlc_aqm::clock::now();
+  microseconds               duration  = milliseconds(duration_ms);
+  double                     delay_sum = 0;
+  uint32_t                   nof_meas  = 0;
+  for (microseconds t{0}; t < duration; t += microseconds(50)) {
+    rlc_aqm::clock::time_point now = t0 + t;
+    if (t.count() % arrival_us == 0) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      sdu->N_bytes             = sdu_size;
+      if (aqm.enqueue(*sdu, queue.size_bytes(), now) and queue.try_write(std::move(sdu))) {
+        result.nof_written++;
+      }
+    }
+    if (t.count() % service_us == 0) {
+      // Skip the dropped SDUs, as the RLC entities do while building a PDU
+      unique_byte_buffer_t sdu;
+      while (sdu == nullptr and not queue.is_empty()) {
+        sdu = aqm.read(queue, now);
+      }
+      if (sdu == nullptr) {
+        continue;
+      }
+      result.nof_read++;
+      if (t > duration * 3 / 4) {
+        double delay_ms      = std::chrono::duration<double, std::milli>(now - sdu->md.queue_tp).count();
+        result.max_delay_ms  = std::max(result.max_delay_ms, delay_ms);
+        delay_sum           += delay_ms;
+        nof_meas++;
+      }
+    }
+  }
+  result.mean_delay_ms = nof_meas > 0 ? delay_sum / nof_meas : 0;
+  result.nof_dropped   = aqm.get_nof_drops();
+  fmt::print("{:<5}: {} written, {} read, {} dropped, delay mean={:.1f} ms, max={:.1f} ms\n",
+             to_string(cfg.type),
+             result.nof_written,
+             result.nof_read,
+             result.nof_dropped,
+             result.mean_delay_ms,
+             result.max_delay_ms);
+  return result;
+}
+
+int aqm_disabled_test()
+{
+  // With 20% overload the queue keeps growing, and so does the delay
+  aqm_sim_result result = simulate(rlc_aqm_config_t{}, 1000, 1250, 5000);
+  TESTASSERT(result.nof_dropped == 0);
+  TESTASSERT(result.mean_delay_ms > 500);
+  return SRSRAN_SUCCESS;
+}
+
+int aqm_underload_test()
+{
+  // No SDU is dropped while the queue drains faster than it is filled
+  for (const rlc_aqm_config_t& cfg : {rlc_aqm_config_t::codel(), rlc_aqm_config_t::pie()}) {
+    aqm_sim_result result = simulate(cfg, 1000, 900, 5000);
+    TESTASSERT(result.nof_dropped == 0);
+    TESTASSERT(result.nof_read == result.nof_written);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int codel_overload_test()
+{
+  // Traffic that does not back off on drops is the worst case, the drop rate takes a few seconds to match the overload
+  aqm_sim_result result = simulate(rlc_aqm_config_t::codel(), 1000, 1250, 20000);
+  TESTASSERT(result.nof_dropped > 0);
+  TESTASSERT(result.nof_read + result.nof_dropped + queue_size >= result.nof_written);
+  TESTASSERT(result.max_delay_ms < 250);
+  return SRSRAN_SUCCESS;
+}
+
+int pie_overload_test()
+{
+  aqm_sim_result result = simulate(rlc_aqm_config_t::pie(), 1000, 1250, 20000);
+  TESTASSERT(result.nof_dropped > 0);
+  TESTASSERT(result.max_delay_ms < 250);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(aqm_disabled_test() == SRSRAN_SUCCESS);
+  TESTASSERT(aqm_underload_test() == SRSRAN_SUCCESS);
+  TESTASSERT(codel_overload_test() == SRSRAN_SUCCESS);
+  TESTASSERT(pie_overload_test() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -204,6 +204,133 @@ int meas_obj_test()
   return 0;
 }
 
+int bsr_filter_test()
+{
+  // Exact levels for small occupancies, 8 levels per power of two above
+  uint32_t prev_level = 0;
+  for (uint32_t nof_bytes = 1; nof_bytes < 1U << 20U; ++nof_bytes) {
+    uint32_t level = rlc_bsr_filter::to_level(nof_bytes);
+    TESTASSERT(level == prev_level + 1 or (nof_bytes > 16 and level == prev_level) or nof_bytes == 16);
+    prev_level = level;
+  }
+  TESTASSERT(rlc_bsr_filter::to_level(0) == 0);
+  TESTASSERT(rlc_bsr_filter::to_level(1000) == rlc_bsr_filter::to_level(1023));
+  TESTASSERT(rlc_bsr_filter::to_level(1023) != rlc_bsr_filter::to_level(1024));
+
+  rlc_bsr_filter filter;
+  TESTASSERT(filter.update(0, 0));
+  TESTASSERT(not filter.update(0, 0));
+  TESTASSERT(filter.update(1, 0));
+  TESTASSERT(filter.update(0, 0));
+  TESTASSERT(filter.update(1000, 0));
+  TESTASSERT(not filter.update(1010, 0));
+  TESTASSERT(filter.update(1010, 2));
+  filter.reset();
+  TESTASSERT(filter.update(1010, 2));
+
+  return 0;
+}
+
+// The buffer state is only pushed to the MAC when its level changes, and always after a PDU is read
+int bsr_push_test()
+{
+  rlc_tester            tester;
+  srsran::timer_handler timers(1);
+
+  struct bsr_report_t {
+    uint32_t lcid, tx_queue, prio_tx_queue;
+  };
+  std::vector<bsr_report_t> reports;
+
+  rlc rlc1("RLC_1");
+  rlc1.init(&tester, &tester, &timers, 0, [&reports](uint32_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue) {
+    reports.push_back({lcid, tx_queue, prio_tx_queue});
+  });
+
+  uint32_t lcid = 3;
+  TESTASSERT(rlc1.add_bearer(lcid, rlc_config_t::default_rlc_um_config(10)) == SRSRAN_SUCCESS);
+
+  const uint32_t nof_sdus = 100;
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->N_bytes    = 100;
+    sdu->md.pdcp_sn = i;
+    rlc1.write_sdu(lcid, std::move(sdu));
+  }
+  TESTASSERT(not reports.empty() and reports.size() < nof_sdus * 2 / 3);
+  for (const bsr_report_t& r : reports) {
+    TESTASSERT(r.lcid == lcid and r.prio_tx_queue == 0);
+  }
+
+  // The last report is at most one level away from the actual buffer state
+  uint32_t buffer_state = rlc1.get_buffer_state(lcid);
+  TESTASSERT(reports.back().tx_queue <= buffer_state and reports.back().tx_queue * 9 / 8 >= buffer_state);
+
+  // Discarded SDUs are removed from the buffer state
+  for (uint32_t i = 0; i < nof_sdus; i += 2) {
+    rlc1.discard_sdu(lcid, i);
+  }
+  TESTASSERT(rlc1.get_buffer_state(lcid) < buffer_state / 2 + 100);
+
+  // Each PDU read is followed by an exact report, down to the empty buffer
+  byte_buffer_t pdu;
+  while (rlc1.has_data_locked(lcid)) {
+    size_t nof_reports = reports.size();
+    pdu.N_bytes        = rlc1.read_pdu(lcid, pdu.msg, 250);
+    TESTASSERT(pdu.N_bytes > 0);
+    TESTASSERT(reports.size() == nof_reports + 1);
+    TESTASSERT(reports.back().tx_queue == rlc1.get_buffer_state(lcid));
+  }
+  TESTASSERT(reports.back().tx_queue == 0);
+
+  return 0;
+}
+
+// SDUs discarded while in the UM Tx queue are skipped when building PDUs
+int um_discard_test()
+{
+  rlc_tester            tester;
+  srsran::timer_handler timers(1);
+
+  rlc rlc1("RLC_1");
+  rlc rlc2("RLC_2");
+  rlc1.init(&tester, &tester, &timers, 0);
+  rlc2.init(&tester, &tester, &timers, 0);
+
+  uint32_t     lcid = 1;
+  rlc_config_t cnfg = rlc_config_t::default_rlc_um_config(10);
+  TESTASSERT(rlc1.add_bearer(lcid, cnfg) == SRSRAN_SUCCESS);
+  TESTASSERT(rlc2.add_bearer(lcid, cnfg) == SRSRAN_SUCCESS);
+
+  tester.set_expected_sdu_len(10);
+  for (uint32_t i = 0; i < NBUFS; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    memset(sdu->msg, i, 10);
+    sdu->N_bytes    = 10;
+    sdu->md.pdcp_sn = i;
+    rlc1.write_sdu(lcid, std::move(sdu));
+  }
+  rlc1.discard_sdu(lcid, 0);
+  rlc1.discard_sdu(lcid, 2);
+  rlc1.discard_sdu(lcid, 3);
+
+  // Two SDUs with a single LI
+  TESTASSERT(rlc1.get_buffer_state(lcid) == 2 * 10 + 2 + 3);
+  byte_buffer_t pdu;
+  pdu.N_bytes = rlc1.read_pdu(lcid, pdu.msg, 100);
+  TESTASSERT(pdu.N_bytes == 2 * 10 + 2 + 2);
+  TESTASSERT(rlc1.get_buffer_state(lcid) == 0);
+
+  rlc2.write_pdu(lcid, pdu.msg, pdu.N_bytes);
+  TESTASSERT(tester.n_sdus == 2);
+  TESTASSERT(tester.sdus[0]->msg[0] == 1);
+  TESTASSERT(tester.sdus[1]->msg[9] == 4);
+
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
@@ -211,4 +338,13 @@ int main(int argc, char** argv)
   if (meas_obj_test()) {
     return -1;
   }
+  if (bsr_filter_test()) {
+    return -1;
+  }
+  if (bsr_push_test()) {
+    return -1;
+  }
+  if (um_discard_test()) {
+    return -1;
+  }
 }
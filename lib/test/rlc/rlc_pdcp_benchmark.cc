@@ -0,0 +1,516 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_gw_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc.h"
+#include "srsran/upper/pdcp.h"
+#include <algorithm>
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <thread>
+#include <time.h>
+
+using namespace srsran;
+
+/*
+ * Benchmark of the PDCP+RLC data path of the different DRB types, from the SDU written into the transmitting PDCP to
+ * the SDU delivered by the receiving PDCP, with security disabled.
+ * Each UE runs in its own thread a transmitting and a receiving node linked by a channel that loses PDUs, and delays
+ * them by a random number of TTIs, which reorders them. Every loop iteration is a TTI: new SDUs are written, each
+ * bearer gets one MAC grant in each direction, and the timers are stepped. SDUs carry their write time and a sequence
+ * number, so that the receiving node measures the latency and checks the delivery order.
+ * Results are printed per bearer type and can be written in JSON to track regressions.
+ */
+
+namespace {
+
+uint32_t    nof_sdus      = 100000;
+uint32_t    sdu_size      = 1500;
+uint32_t    grant_size    = 9000;
+uint32_t    sdus_per_tti  = 4;
+uint32_t    nof_bearers   = 1;
+uint32_t    nof_ues       = 1;
+float       loss_rate     = 0.0;
+uint32_t    reorder_ttis  = 0;
+std::string bearer_filter;
+std::string json_filename;
+
+const uint32_t first_lcid      = 3;
+const uint32_t max_nof_bearers = 8;
+const uint32_t sdu_header_len  = sizeof(uint64_t) + sizeof(uint32_t); // Write time and sequence number
+const uint32_t max_idle_ttis   = 1000;
+const uint32_t min_grant_size  = 8; // Smaller grants are not worth segmenting an SDU
+
+struct bearer_type_t {
+  const char*  name;
+  srsran_rat_t rat;
+  rlc_mode_t   mode;
+  uint32_t     rlc_sn_len;
+  uint8_t      pdcp_sn_len;
+};
+
+const bearer_type_t bearer_types[] = {{"LTE-UM5", srsran_rat_t::lte, rlc_mode_t::um, 5, PDCP_SN_LEN_12},
+                                      {"LTE-UM10", srsran_rat_t::lte, rlc_mode_t::um, 10, PDCP_SN_LEN_12},
+                                      {"LTE-AM10", srsran_rat_t::lte, rlc_mode_t::am, 10, PDCP_SN_LEN_12},
+                                      {"NR-UM6", srsran_rat_t::nr, rlc_mode_t::um, 6, PDCP_SN_LEN_18},
+                                      {"NR-UM12", srsran_rat_t::nr, rlc_mode_t::um, 12, PDCP_SN_LEN_18},
+                                      {"NR-AM12", srsran_rat_t::nr, rlc_mode_t::am, 12, PDCP_SN_LEN_18},
+                                      {"NR-AM18", srsran_rat_t::nr, rlc_mode_t::am, 18, PDCP_SN_LEN_18}};
+
+rlc_config_t make_rlc_config(const bearer_type_t& type)
+{
+  rlc_config_t cfg;
+  if (type.rat == srsran_rat_t::lte) {
+    cfg                    = type.mode == rlc_mode_t::um ? rlc_config_t::default_rlc_um_config(type.rlc_sn_len)
+                                                         : rlc_config_t::default_rlc_am_config();
+    cfg.am.max_retx_thresh = 32;
+  } else {
+    cfg                       = type.mode == rlc_mode_t::um ? rlc_config_t::default_rlc_um_nr_config(type.rlc_sn_len)
+                                                            : rlc_config_t::default_rlc_am_nr_config(type.rlc_sn_len);
+    cfg.am_nr.max_retx_thresh = 32;
+  }
+  return cfg;
+}
+
+pdcp_config_t make_pdcp_config(const bearer_type_t& type, uint32_t lcid, bool is_tx)
+{
+  // With AM, t-Reordering is longer than the RLC retransmissions, so that no SDU is skipped
+  return {static_cast<uint8_t>(lcid - first_lcid + 1),
+          PDCP_RB_IS_DRB,
+          is_tx ? SECURITY_DIRECTION_DOWNLINK : SECURITY_DIRECTION_UPLINK,
+          is_tx ? SECURITY_DIRECTION_UPLINK : SECURITY_DIRECTION_DOWNLINK,
+          type.pdcp_sn_len,
+          type.mode == rlc_mode_t::am ? pdcp_t_reordering_t::ms500 : pdcp_t_reordering_t::ms50,
+          pdcp_discard_timer_t::infinity,
+          false,
+          type.rat};
+}
+
+std::chrono::nanoseconds thread_cpu_time()
+{
+  struct timespec ts = {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/// PDCP and RLC of one end of the link. Received SDUs are checked and their latency recorded
+class benchmark_node : public srsue::rrc_interface_rlc,
+                       public srsue::rrc_interface_pdcp,
+                       public srsue::gw_interface_pdcp
+{
+public:
+  benchmark_node(task_scheduler* task_sched, const char* rlc_logname, const char* pdcp_logname) :
+    rlc(rlc_logname), pdcp(task_sched, pdcp_logname)
+  {
+    rlc.init(&pdcp, this, task_sched->get_timer_handler(), 0);
+    pdcp.init(&rlc, this, this);
+  }
+
+  void add_bearers(const bearer_type_t& type, bool is_tx)
+  {
+    check_order = type.mode == rlc_mode_t::am;
+    for (uint32_t lcid = first_lcid; lcid < first_lcid + nof_bearers; ++lcid) {
+      TESTASSERT(rlc.add_bearer(lcid, make_rlc_config(type)) == SRSRAN_SUCCESS);
+      TESTASSERT(pdcp.add_bearer(lcid, make_pdcp_config(type, lcid, is_tx)) == SRSRAN_SUCCESS);
+    }
+  }
+
+  // GW and RRC interfaces. Only DRB SDUs are expected
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    auto     now = std::chrono::steady_clock::now().time_since_epoch();
+    uint64_t tx_time_ns;
+    uint32_t seq;
+    TESTASSERT(lcid >= first_lcid and lcid < first_lcid + nof_bearers);
+    TESTASSERT(sdu->N_bytes == sdu_size);
+    memcpy(&tx_time_ns, sdu->msg, sizeof(tx_time_ns));
+    memcpy(&seq, sdu->msg + sizeof(tx_time_ns), sizeof(seq));
+
+    // SDUs are delivered in order, and without gaps in AM
+    uint32_t& expected_seq = next_seq[lcid - first_lcid];
+    TESTASSERT(check_order ? seq == expected_seq : seq >= expected_seq);
+    expected_seq = seq + 1;
+
+    latencies_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() - tx_time_ns);
+    rx_bytes += sdu->N_bytes;
+  }
+  void        write_pdu_bcch_bch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_bcch_dlsch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_pcch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_mch(uint32_t lcid, unique_byte_buffer_t pdu) final {}
+  void        notify_pdcp_integrity_error(uint32_t lcid) final {}
+  void        max_retx_attempted() final { TESTASSERT(false); }
+  void        protocol_failure() final { TESTASSERT(false); }
+  const char* get_rb_name(uint32_t lcid) final { return "DRB"; }
+
+  srsran::rlc  rlc;
+  srsran::pdcp pdcp;
+
+  std::array<uint32_t, max_nof_bearers> next_seq = {};
+  std::vector<uint64_t>                 latencies_ns;
+  uint64_t                              rx_bytes    = 0;
+  bool                                  check_order = false;
+};
+
+struct channel_pdu_t {
+  uint32_t             lcid;
+  uint32_t             rx_tti;
+  unique_byte_buffer_t pdu;
+};
+
+/// Results of one UE, or of all the UEs once merged
+struct benchmark_result {
+  uint64_t                 nof_tx_sdus = 0;
+  uint64_t                 nof_rx_sdus = 0;
+  uint64_t                 rx_bytes    = 0;
+  std::chrono::nanoseconds elapsed{0}; ///< Time until the last SDU was received, the maximum among the UEs
+  std::chrono::nanoseconds cpu_time{0};
+  std::vector<uint64_t>    latencies_ns;
+
+  void merge(benchmark_result& other)
+  {
+    nof_tx_sdus += other.nof_tx_sdus;
+    nof_rx_sdus += other.nof_rx_sdus;
+    rx_bytes += other.rx_bytes;
+    elapsed  = std::max(elapsed, other.elapsed);
+    cpu_time += other.cpu_time;
+    latencies_ns.insert(latencies_ns.end(), other.latencies_ns.begin(), other.latencies_ns.end());
+  }
+};
+
+class benchmark_ue
+{
+public:
+  benchmark_ue(const bearer_type_t& type, uint32_t ue_idx) :
+    tx(&task_sched, "RLC_1", "PDCP_1"), rx(&task_sched, "RLC_2", "PDCP_2"), rng(ue_idx)
+  {
+    tx.add_bearers(type, true);
+    rx.add_bearers(type, false);
+  }
+
+  benchmark_result run()
+  {
+    std::array<uint32_t, max_nof_bearers> nof_written = {};
+    std::chrono::nanoseconds              cpu_start   = thread_cpu_time();
+    std::chrono::nanoseconds              cpu_last_rx = cpu_start;
+    auto                                  t_start     = std::chrono::steady_clock::now();
+    auto                                  t_last_rx   = t_start;
+    uint64_t                              total_sdus  = static_cast<uint64_t>(nof_sdus) * nof_bearers;
+    uint64_t                              nof_tx_sdus = 0;
+
+    for (uint32_t idle_ttis = 0; rx.latencies_ns.size() < total_sdus and idle_ttis < max_idle_ttis;) {
+      for (uint32_t lcid = first_lcid; lcid < first_lcid + nof_bearers; ++lcid) {
+        uint32_t& seq = nof_written[lcid - first_lcid];
+        for (uint32_t i = 0; i < sdus_per_tti and seq < nof_sdus and not tx.rlc.sdu_queue_is_full(lcid); ++i) {
+          tx.pdcp.write_sdu(lcid, make_sdu(seq++));
+          nof_tx_sdus++;
+        }
+      }
+
+      size_t nof_rx_sdus = rx.latencies_ns.size();
+      bool   active      = transfer(tx, rx, dl_channel);
+      active             = transfer(rx, tx, ul_channel) or active;
+      task_sched.tic();
+      task_sched.run_pending_tasks();
+      tti++;
+
+      if (rx.latencies_ns.size() > nof_rx_sdus) {
+        t_last_rx   = std::chrono::steady_clock::now();
+        cpu_last_rx = thread_cpu_time();
+      }
+      idle_ttis = (active or nof_tx_sdus < total_sdus) ? 0 : idle_ttis + 1;
+    }
+
+    benchmark_result result;
+    result.nof_tx_sdus  = nof_tx_sdus;
+    result.nof_rx_sdus  = rx.latencies_ns.size();
+    result.rx_bytes     = rx.rx_bytes;
+    result.elapsed      = t_last_rx - t_start;
+    result.cpu_time     = cpu_last_rx - cpu_start;
+    result.latencies_ns = std::move(rx.latencies_ns);
+    return result;
+  }
+
+private:
+  static unique_byte_buffer_t make_sdu(uint32_t seq)
+  {
+    unique_byte_buffer_t sdu = make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    uint64_t now_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    memcpy(sdu->msg, &now_ns, sizeof(now_ns));
+    memcpy(sdu->msg + sizeof(now_ns), &seq, sizeof(seq));
+    sdu->N_bytes = sdu_size;
+    return sdu;
+  }
+
+  /// Reads one grant of PDUs per bearer from "src" and delivers to "dst" the PDUs that went through the channel.
+  /// Returns false if no PDU was read nor is left in the channel
+  bool transfer(benchmark_node& src, benchmark_node& dst, std::vector<channel_pdu_t>& channel)
+  {
+    bool read = false;
+    for (uint32_t lcid = first_lcid; lcid < first_lcid + nof_bearers; ++lcid) {
+      // NR RLC PDUs carry a single SDU, so the grant may be filled with several of them
+      for (uint32_t grant_left = grant_size; grant_left > min_grant_size and src.rlc.get_buffer_state(lcid) > 0;) {
+        unique_byte_buffer_t pdu = make_byte_buffer();
+        TESTASSERT(pdu != nullptr);
+        pdu->N_bytes = src.rlc.read_pdu(lcid, pdu->msg, grant_left);
+        if (pdu->N_bytes == 0) {
+          break;
+        }
+        grant_left -= pdu->N_bytes;
+        read = true;
+        if (loss_dist(rng) >= loss_rate) {
+          channel.push_back({lcid, tti + delay_dist(rng), std::move(pdu)});
+        }
+      }
+    }
+
+    // PDUs are delayed by a random number of TTIs, which reorders them
+    auto it = channel.begin();
+    while (it != channel.end()) {
+      if (it->rx_tti > tti) {
+        ++it;
+        continue;
+      }
+      dst.rlc.write_pdu(it->lcid, it->pdu->msg, it->pdu->N_bytes);
+      it = channel.erase(it);
+    }
+    return read or not channel.empty();
+  }
+
+  task_scheduler                          task_sched;
+  benchmark_node                          tx;
+  benchmark_node                          rx;
+  std::vector<channel_pdu_t>              dl_channel;
+  std::vector<channel_pdu_t>              ul_channel;
+  uint32_t                                tti = 0;
+  std::mt19937                            rng;
+  std::uniform_real_distribution<float>   loss_dist{0.0, 1.0};
+  std::uniform_int_distribution<uint32_t> delay_dist{0, reorder_ttis};
+};
+
+benchmark_result run_benchmark(const bearer_type_t& type)
+{
+  std::vector<std::unique_ptr<benchmark_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new benchmark_ue(type, i));
+  }
+
+  std::vector<benchmark_result> ue_results(nof_ues);
+  std::vector<std::thread>      threads;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    threads.emplace_back([&ues, &ue_results, i]() { ue_results[i] = ues[i]->run(); });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  benchmark_result result;
+  for (benchmark_result& ue_result : ue_results) {
+    result.merge(ue_result);
+  }
+  std::sort(result.latencies_ns.begin(), result.latencies_ns.end());
+  if (type.mode == rlc_mode_t::am) {
+    TESTASSERT(result.nof_rx_sdus == result.nof_tx_sdus);
+  }
+  return result;
+}
+
+double latency_percentile_us(const std::vector<uint64_t>& sorted_latencies_ns, double percentile)
+{
+  if (sorted_latencies_ns.empty()) {
+    return 0;
+  }
+  size_t idx = std::min(static_cast<size_t>(sorted_latencies_ns.size() * percentile / 100),
+                        sorted_latencies_ns.size() - 1);
+  return sorted_latencies_ns[idx] / 1e3;
+}
+
+double latency_mean_us(const std::vector<uint64_t>& latencies_ns)
+{
+  if (latencies_ns.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (uint64_t l : latencies_ns) {
+    sum += l;
+  }
+  return sum / latencies_ns.size() / 1e3;
+}
+
+void print_result(const bearer_type_t& type, const benchmark_result& result)
+{
+  double secs = std::chrono::duration<double>(result.elapsed).count();
+  fmt::print("{:<8} {:>8} SDUs in {:>7.3f} s | {:>8.1f} Mbps | {:>6.0f} ns/SDU CPU | latency mean={:.1f} "
+             "p50={:.1f} p99={:.1f} max={:.1f} us\n",
+             type.name,
+             result.nof_rx_sdus,
+             secs,
+             result.rx_bytes * 8 / secs / 1e6,
+             static_cast<double>(result.cpu_time.count()) / std::max(result.nof_rx_sdus, uint64_t(1)),
+             latency_mean_us(result.latencies_ns),
+             latency_percentile_us(result.latencies_ns, 50),
+             latency_percentile_us(result.latencies_ns, 99),
+             latency_percentile_us(result.latencies_ns, 100));
+}
+
+std::string to_json(const bearer_type_t& type, const benchmark_result& result)
+{
+  double secs = std::chrono::duration<double>(result.elapsed).count();
+  return fmt::format(
+      "  {{\"bearer\": \"{}\", \"rat\": \"{}\", \"mode\": \"{}\", \"rlc_sn_len\": {}, \"pdcp_sn_len\": {}, "
+      "\"sdu_size\": {}, \"grant_size\": {}, \"sdus_per_tti\": {}, \"nof_ues\": {}, \"nof_bearers\": {}, "
+      "\"loss_rate\": {}, \"reorder_ttis\": {}, \"tx_sdus\": {}, \"rx_sdus\": {}, \"elapsed_s\": {:.6f}, "
+      "\"throughput_mbps\": {:.3f}, \"sdus_per_s\": {:.1f}, \"cpu_ns_per_sdu\": {:.1f}, "
+      "\"latency_us\": {{\"mean\": {:.3f}, \"p50\": {:.3f}, \"p90\": {:.3f}, \"p99\": {:.3f}, \"p999\": {:.3f}, "
+      "\"max\": {:.3f}}}}}",
+      type.name,
+      to_string(type.rat),
+      to_string(type.mode, false),
+      type.rlc_sn_len,
+      type.pdcp_sn_len,
+      sdu_size,
+      grant_size,
+      sdus_per_tti,
+      nof_ues,
+      nof_bearers,
+      loss_rate,
+      reorder_ttis,
+      result.nof_tx_sdus,
+      result.nof_rx_sdus,
+      secs,
+      result.rx_bytes * 8 / secs / 1e6,
+      result.nof_rx_sdus / secs,
+      static_cast<double>(result.cpu_time.count()) / std::max(result.nof_rx_sdus, uint64_t(1)),
+      latency_mean_us(result.latencies_ns),
+      latency_percentile_us(result.latencies_ns, 50),
+      latency_percentile_us(result.latencies_ns, 90),
+      latency_percentile_us(result.latencies_ns, 99),
+      latency_percentile_us(result.latencies_ns, 99.9),
+      latency_percentile_us(result.latencies_ns, 100));
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nsgpbulrmj]\n", prog);
+  printf("\t-n number of SDUs per bearer and UE [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes, at least %d [Default %d]\n", sdu_header_len, sdu_size);
+  printf("\t-g MAC grant size in bytes, per bearer and TTI [Default %d]\n", grant_size);
+  printf("\t-p SDUs written per bearer and TTI [Default %d]\n", sdus_per_tti);
+  printf("\t-b number of bearers per UE, up to %d [Default %d]\n", max_nof_bearers, nof_bearers);
+  printf("\t-u number of UEs, each run in its own thread [Default %d]\n", nof_ues);
+  printf("\t-l PDU loss rate [Default %.2f]\n", loss_rate);
+  printf("\t-r maximum PDU delay in TTIs, PDUs are reordered if not 0 [Default %d]\n", reorder_ttis);
+  printf("\t-m bearer type [Default all]:");
+  for (const bearer_type_t& type : bearer_types) {
+    printf(" %s", type.name);
+  }
+  printf("\n\t-j JSON output file, - for stdout [Default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:s:g:p:b:u:l:r:m:j:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 's':
+        sdu_size = std::max((uint32_t)strtol(argv[optind - 1], nullptr, 10), sdu_header_len);
+        break;
+      case 'g':
+        grant_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'p':
+        sdus_per_tti = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'b':
+        nof_bearers = std::min(std::max(1L, strtol(argv[optind - 1], nullptr, 10)), (long)max_nof_bearers);
+        break;
+      case 'u':
+        nof_ues = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      case 'l':
+        loss_rate = strtof(argv[optind - 1], nullptr);
+        break;
+      case 'r':
+        reorder_ttis = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'm':
+        bearer_filter = argv[optind - 1];
+        break;
+      case 'j':
+        json_filename = argv[optind - 1];
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Unacknowledged and reordered SDUs are buffered by every bearer
+  byte_buffer_pool::get_instance(std::max(4096U, nof_ues * nof_bearers * 1024U));
+
+  for (const char* name : {"RLC_1", "RLC_2", "PDCP_1", "PDCP_2"}) {
+    srslog::fetch_basic_logger(name, false).set_level(srslog::basic_levels::error);
+  }
+  srslog::init();
+
+  std::vector<std::string> json_results;
+  for (const bearer_type_t& type : bearer_types) {
+    if (not bearer_filter.empty() and bearer_filter != type.name) {
+      continue;
+    }
+    benchmark_result result = run_benchmark(type);
+    print_result(type, result);
+    json_results.push_back(to_json(type, result));
+  }
+  TESTASSERT(not json_results.empty());
+
+  if (not json_filename.empty()) {
+    FILE* f = json_filename == "-" ? stdout : fopen(json_filename.c_str(), "w");
+    TESTASSERT(f != nullptr);
+    fmt::print(f, "[\n{}\n]\n", fmt::join(json_results.begin(), json_results.end(), ",\n"));
+    if (f != stdout) {
+      fclose(f);
+    }
+  }
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,271 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_lte.h"
+#include "srsran/rlc/rlc_um_lte.h"
+#include "srsran/rlc/rlc_um_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+
+using namespace srsran;
+
+/*
+ * Benchmark of the receiving side of the RLC entities. The PDUs built by a transmitting entity with small MAC grants,
+ * so that SDUs are segmented, are delivered to the receiving entity out of order and with random losses. Only the
+ * time spent by the receiving entity handling the PDUs is measured.
+ * Status PDUs of AM bearers are delivered in order and without losses.
+ */
+
+namespace {
+
+uint32_t nof_sdus       = 100000;
+uint32_t sdu_size       = 1500;
+uint32_t grant_size     = 200;
+uint32_t grants_per_tti = 8;
+uint32_t reorder_depth  = 8;
+float    loss_rate      = 0.01;
+
+class benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final { nof_rx_sdus++; }
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint32_t nof_rx_sdus = 0;
+};
+
+struct benchmark_result {
+  uint32_t                 nof_rx_pdus = 0;
+  std::chrono::nanoseconds rx_time{0};
+};
+
+/// Passes the data PDU to the receiving entity, measuring the time it takes
+void deliver_pdu(rlc_common& rlc_rx, unique_byte_buffer_t pdu, benchmark_result& result)
+{
+  auto t_start = std::chrono::steady_clock::now();
+  rlc_rx.write_pdu(pdu->msg, pdu->N_bytes);
+  result.rx_time += std::chrono::steady_clock::now() - t_start;
+  result.nof_rx_pdus++;
+}
+
+/// Runs one TTI. Returns false once there is nothing left to transmit
+bool run_tti(rlc_common&                        rlc_tx,
+             rlc_common&                        rlc_rx,
+             std::vector<unique_byte_buffer_t>& reorder_buffer,
+             uint32_t&                          nof_tx_sdus,
+             std::mt19937&                      rng,
+             benchmark_result&                  result)
+{
+  std::uniform_real_distribution<float> loss_dist(0.0, 1.0);
+
+  while (nof_tx_sdus < nof_sdus and not rlc_tx.sdu_queue_is_full()) {
+    unique_byte_buffer_t sdu = make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->N_bytes    = sdu_size;
+    sdu->md.pdcp_sn = nof_tx_sdus % (1U << 18U); // 18-bit PDCP SN
+    rlc_tx.write_sdu(std::move(sdu));
+    nof_tx_sdus++;
+  }
+
+  bool tx_active = false;
+  for (uint32_t i = 0; i < grants_per_tti; ++i) {
+    unique_byte_buffer_t pdu = make_byte_buffer();
+    TESTASSERT(pdu != nullptr);
+    pdu->N_bytes = rlc_tx.read_pdu(pdu->msg, grant_size);
+    if (pdu->N_bytes == 0) {
+      break;
+    }
+    tx_active = true;
+    if (loss_dist(rng) < loss_rate) {
+      continue;
+    }
+    // Deliver a random PDU among the last "reorder_depth" ones
+    reorder_buffer.push_back(std::move(pdu));
+    if (reorder_buffer.size() >= reorder_depth) {
+      uint32_t idx = std::uniform_int_distribution<uint32_t>(0, reorder_buffer.size() - 1)(rng);
+      std::swap(reorder_buffer[idx], reorder_buffer.back());
+      deliver_pdu(rlc_rx, std::move(reorder_buffer.back()), result);
+      reorder_buffer.pop_back();
+    }
+  }
+  if (not tx_active) {
+    // Flush the PDUs still being reordered
+    for (unique_byte_buffer_t& pdu : reorder_buffer) {
+      deliver_pdu(rlc_rx, std::move(pdu), result);
+    }
+    reorder_buffer.clear();
+  }
+
+  // Feedback of AM bearers
+  unique_byte_buffer_t status = make_byte_buffer();
+  status->N_bytes             = rlc_rx.read_pdu(status->msg, grant_size);
+  if (status->N_bytes > 0) {
+    rlc_tx.write_pdu(status->msg, status->N_bytes);
+    tx_active = true;
+  }
+  return tx_active or nof_tx_sdus < nof_sdus;
+}
+
+int run_benchmark(const char*       name,
+                  rlc_common&       rlc_tx,
+                  rlc_common&       rlc_rx,
+                  benchmark_tester& tester,
+                  timer_handler&    timers)
+{
+  std::mt19937                      rng(0);
+  std::vector<unique_byte_buffer_t> reorder_buffer;
+  benchmark_result                  result;
+  uint32_t                          nof_tx_sdus = 0;
+
+  // Keep running while there is data to transmit, and until the timers of the receiving entity expire
+  const uint32_t idle_ttis = 100;
+  for (uint32_t nof_idle_ttis = 0; nof_idle_ttis < idle_ttis;) {
+    if (run_tti(rlc_tx, rlc_rx, reorder_buffer, nof_tx_sdus, rng, result)) {
+      nof_idle_ttis = 0;
+    } else {
+      nof_idle_ttis++;
+    }
+    timers.step_all();
+  }
+
+  double secs = std::chrono::duration<double>(result.rx_time).count();
+  fmt::print("{:<8} {:>8} PDUs in {:>7.3f} s | {:>10.0f} PDU/s | {:>8} of {} SDUs received\n",
+             name,
+             result.nof_rx_pdus,
+             secs,
+             result.nof_rx_pdus / secs,
+             tester.nof_rx_sdus,
+             nof_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+int run_um_lte()
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_um_lte       rlc_tx(srslog::fetch_basic_logger("RLC_1"), 1, &tester, &tester, &timers);
+  rlc_um_lte       rlc_rx(srslog::fetch_basic_logger("RLC_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(rlc_config_t::default_rlc_um_config(10)));
+  TESTASSERT(rlc_rx.configure(rlc_config_t::default_rlc_um_config(10)));
+  return run_benchmark("UM LTE", rlc_tx, rlc_rx, tester, timers);
+}
+
+int run_um_nr()
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_um_nr        rlc_tx(srslog::fetch_basic_logger("RLC_1"), 1, &tester, &tester, &timers);
+  rlc_um_nr        rlc_rx(srslog::fetch_basic_logger("RLC_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(rlc_config_t::default_rlc_um_nr_config(12)));
+  TESTASSERT(rlc_rx.configure(rlc_config_t::default_rlc_um_nr_config(12)));
+  return run_benchmark("UM NR", rlc_tx, rlc_rx, tester, timers);
+}
+
+int run_am_lte()
+{
+  benchmark_tester tester;
+  timer_handler    timers(8);
+  rlc_am           rlc_tx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_1"), 1, &tester, &tester, &timers);
+  rlc_am           rlc_rx(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_2"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc_tx.configure(rlc_config_t::default_rlc_am_config()));
+  TESTASSERT(rlc_rx.configure(rlc_config_t::default_rlc_am_config()));
+  TESTASSERT(run_benchmark("AM LTE", rlc_tx, rlc_rx, tester, timers) == SRSRAN_SUCCESS);
+  // Lost PDUs are retransmitted
+  TESTASSERT(tester.nof_rx_sdus == nof_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nsgtrl]\n", prog);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_size);
+  printf("\t-g MAC grant size in bytes [Default %d]\n", grant_size);
+  printf("\t-t number of MAC grants per TTI [Default %d]\n", grants_per_tti);
+  printf("\t-r reordering depth in PDUs [Default %d]\n", reorder_depth);
+  printf("\t-l PDU loss rate [Default %.3f]\n", loss_rate);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:s:g:t:r:l:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 's':
+        sdu_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'g':
+        grant_size = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 't':
+        grants_per_tti = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'r':
+        reorder_depth = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      case 'l':
+        loss_rate = strtof(argv[optind - 1], nullptr);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("RLC_1").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("RLC_2").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  TESTASSERT(run_um_lte() == SRSRAN_SUCCESS);
+  TESTASSERT(run_um_nr() == SRSRAN_SUCCESS);
+  TESTASSERT(run_am_lte() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -171,8 +171,8 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
 void rlc_tester::write_pdu(uint32_t rx_lcid, srsran::unique_byte_buffer_t sdu)
 {
   assert(rx_lcid == lcid);
-  if (args.mode != "AM") {
-    // Only AM will guarantee to deliver SDUs, take first byte as reference for other modes
+  if (args.mode != "AM" or args.aqm != "none") {
+    // Only AM without AQM will guarantee to deliver SDUs, take first byte as reference for other modes
     next_expected_sdu = sdu->msg[0];
   }
 
@@ -191,6 +191,9 @@ void rlc_tester::write_pdu(uint32_t rx_lcid, srsran::unique_byte_buffer_t sdu)
       exit(-1);
     }
   }
+  if (rx_tracker != nullptr) {
+    rx_tracker->on_rx(next_expected_sdu, sdu->N_bytes);
+  }
   next_expected_sdu += 1;
   rx_pdus++;
 }
@@ -226,6 +229,9 @@ void rlc_tester::run_thread()
       pdu->msg[i] = payload;
     }
     pdu->N_bytes = sdu_size;
+    if (tx_tracker != nullptr) {
+      tx_tracker->on_tx(payload);
+    }
     payload++;
 
     rlc_pdcp->write_sdu(lcid, std::move(pdu));
@@ -304,6 +310,15 @@ void stress_test(stress_test_args_t args)
     exit(-1);
   }
 
+  if (args.aqm == "codel") {
+    cnfg_.aqm = srsran::rlc_aqm_config_t::codel();
+  } else if (args.aqm == "pie") {
+    cnfg_.aqm = srsran::rlc_aqm_config_t::pie();
+  } else if (args.aqm != "none") {
+    std::cout << "Unsupported AQM " << args.aqm << ", exiting." << std::endl;
+    exit(-1);
+  }
+
   // generate random seed if needed
   uint32_t seed = 0;
   if (not args.zero_seed) {
@@ -324,6 +339,10 @@ void stress_test(stress_test_args_t args)
   rlc_tester tester2(&rlc2, "tester2", args, lcid, seed);
   mac_dummy  mac(&rlc1, &rlc2, args, lcid, &timers, &pcap, seed);
 
+  sdu_latency_tracker latency1to2, latency2to1;
+  tester1.set_latency_trackers(&latency1to2, &latency2to1);
+  tester2.set_latency_trackers(&latency2to1, &latency1to2);
+
   rlc1.init(&tester1, &tester1, &timers, 0);
   rlc2.init(&tester2, &tester2, &timers, 0);
 
@@ -376,6 +395,7 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  latency2to1.print("RLC2->RLC1", args.test_duration_sec);
 
   rlc2.get_metrics(metrics, 1);
   printf("RLC2 received %" PRIu64 " SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
@@ -385,6 +405,7 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  latency1to2.print("RLC1->RLC2", args.test_duration_sec);
 }
 
 int main(int argc, char** argv)
@@ -26,11 +26,14 @@
 #include "srsran/common/threads.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/rlc/rlc.h"
+#include <algorithm>
 #include <boost/program_options.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <cassert>
 #include <cstdlib>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <pthread.h>
 #include <random>
 
@@ -85,6 +88,7 @@ typedef struct {
   std::string log_filename;
   uint32_t    min_sdu_size;
   uint32_t    max_sdu_size;
+  std::string aqm;
 } stress_test_args_t;
 
 void parse_args(stress_test_args_t* args, int argc, char* argv[])
@@ -121,7 +125,8 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
       ("nof_pdu_tti",   bpo::value<uint32_t>(&args->nof_pdu_tti)->default_value(1), "Number of PDUs processed in a TTI")
       ("log_hex_limit",   bpo::value<int32_t>(&args->log_hex_limit)->default_value(-1), "Maximum bytes in hex log")
       ("min_sdu_size",   bpo::value<uint32_t>(&args->min_sdu_size)->default_value(5), "Minimum SDU size")
-      ("max_sdu_size",   bpo::value<uint32_t>(&args->max_sdu_size)->default_value(1500), "Maximum SDU size");
+      ("max_sdu_size",   bpo::value<uint32_t>(&args->max_sdu_size)->default_value(1500), "Maximum SDU size")
+      ("aqm",           bpo::value<std::string>(&args->aqm)->default_value("none"), "Active queue management of the Tx SDU queue (none/codel/pie)");
   // clang-format on
 
   // these options are allowed on the command line
@@ -153,6 +158,72 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
   }
 }
 
+/**
+ * Measures the latency of the SDUs of one direction, from the write in the Tx RLC to the delivery by the Rx RLC.
+ * SDUs are identified by their payload byte. Delivery is in order, so the first SDU in flight with the same payload is
+ * the received one, and the SDUs sent before it were lost.
+ */
+class sdu_latency_tracker
+{
+public:
+  void on_tx(uint8_t payload)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (in_flight.size() >= max_in_flight) {
+      in_flight.pop_front();
+    }
+    in_flight.emplace_back(payload, clock::now());
+  }
+
+  void on_rx(uint8_t payload, uint32_t nof_bytes)
+  {
+    clock::time_point           now = clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    rx_bytes += nof_bytes;
+    // Only look in a window shorter than the payload wrap-around, to avoid matching an older SDU
+    auto window_end = in_flight.begin() + std::min(in_flight.size(), (size_t)UINT8_MAX);
+    auto it         = std::find_if(
+        in_flight.begin(), window_end, [payload](const std::pair<uint8_t, clock::time_point>& e) {
+          return e.first == payload;
+        });
+    if (it == window_end) {
+      return;
+    }
+    latencies_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(now - it->second).count());
+    in_flight.erase(in_flight.begin(), it + 1);
+  }
+
+  void print(const char* name, uint32_t duration_sec)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (latencies_us.empty()) {
+      printf("%s: no SDUs received\n", name);
+      return;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    uint64_t sum = 0;
+    for (uint32_t l : latencies_us) {
+      sum += l;
+    }
+    printf("%s: throughput=%.2f Mbps, latency mean=%.1f ms, p50=%.1f ms, p99=%.1f ms, max=%.1f ms\n",
+           name,
+           rx_bytes * 8 / (duration_sec * 1e6),
+           sum / (latencies_us.size() * 1e3),
+           latencies_us[latencies_us.size() / 2] / 1e3,
+           latencies_us[latencies_us.size() * 99 / 100] / 1e3,
+           latencies_us.back() / 1e3);
+  }
+
+private:
+  using clock                       = std::chrono::steady_clock;
+  const static size_t max_in_flight = 8192;
+
+  std::mutex                                        mutex;
+  std::deque<std::pair<uint8_t, clock::time_point>> in_flight;
+  std::vector<uint32_t>                             latencies_us;
+  uint64_t                                          rx_bytes = 0;
+};
+
 class mac_dummy : public srsran::thread
 {
 public:
@@ -273,6 +344,12 @@ public:
 
   uint64_t get_nof_rx_pdus() const { return rx_pdus; }
 
+  void set_latency_trackers(sdu_latency_tracker* tx_tracker_, sdu_latency_tracker* rx_tracker_)
+  {
+    tx_tracker = tx_tracker_;
+    rx_tracker = rx_tracker_;
+  }
+
 private:
   const static size_t max_pdcp_sn = 262143U; // 18bit SN
   void                run_thread() final;
@@ -291,6 +368,9 @@ private:
 
   srsue::rlc_interface_pdcp* rlc_pdcp = nullptr; // used by run_thread to push PDCP SDUs to RLC
 
+  sdu_latency_tracker* tx_tracker = nullptr;
+  sdu_latency_tracker* rx_tracker = nullptr;
+
   std::mt19937                    mt19937;
   std::uniform_int_distribution<> int_dist;
 };
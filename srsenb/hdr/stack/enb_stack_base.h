@@ -71,6 +71,7 @@ typedef struct {
 typedef struct {
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   uint32_t         gtpu_indirect_tunnel_timeout_msec;
+  bool             ctrl_offload_enable; // Unpack RRC/S1AP messages in a separate control-plane thread
   mac_args_t       mac;
   s1ap_args_t      s1ap;
   pcap_args_t      mac_pcap;
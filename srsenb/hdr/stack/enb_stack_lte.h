@@ -30,6 +30,7 @@
 #include "mac/mac.h"
 #include "rrc/rrc.h"
 #include "s1ap/s1ap.h"
+#include "srsran/common/offload_executor.h"
 #include "srsran/common/task_scheduler.h"
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
@@ -120,19 +121,19 @@ public:
   // rrc_eutra_interface_rrc_nr
   void sgnb_addition_ack(uint16_t eutra_rnti, sgnb_addition_ack_params_t params) final
   {
-    x2_task_queue.push([this, eutra_rnti, params]() { rrc.sgnb_addition_ack(eutra_rnti, params); });
+    push_x2_task([this, eutra_rnti, params]() { rrc.sgnb_addition_ack(eutra_rnti, params); });
   }
   void sgnb_addition_reject(uint16_t eutra_rnti) final
   {
-    x2_task_queue.push([this, eutra_rnti]() { rrc.sgnb_addition_reject(eutra_rnti); });
+    push_x2_task([this, eutra_rnti]() { rrc.sgnb_addition_reject(eutra_rnti); });
   }
   void sgnb_addition_complete(uint16_t eutra_rnti, uint16_t nr_rnti) final
   {
-    x2_task_queue.push([this, eutra_rnti, nr_rnti]() { rrc.sgnb_addition_complete(eutra_rnti, nr_rnti); });
+    push_x2_task([this, eutra_rnti, nr_rnti]() { rrc.sgnb_addition_complete(eutra_rnti, nr_rnti); });
   }
   void sgnb_inactivity_timeout(uint16_t eutra_rnti) final
   {
-    x2_task_queue.push([this, eutra_rnti]() { rrc.sgnb_inactivity_timeout(eutra_rnti); });
+    push_x2_task([this, eutra_rnti]() { rrc.sgnb_inactivity_timeout(eutra_rnti); });
   }
   void set_activity_user(uint16_t eutra_rnti) final
   {
@@ -141,7 +142,7 @@ public:
   }
   void sgnb_release_ack(uint16_t eutra_rnti) final
   {
-    x2_task_queue.push([this, eutra_rnti]() { rrc.sgnb_release_ack(eutra_rnti); });
+    push_x2_task([this, eutra_rnti]() { rrc.sgnb_release_ack(eutra_rnti); });
   }
 
   // gtpu_interface_pdcp
@@ -153,6 +154,17 @@ private:
   void run_thread() override;
   void stop_impl();
   void tti_clock_impl();
+  void get_thread_metrics(stack_thread_metrics_t& m);
+
+  template <typename Task>
+  void push_x2_task(Task&& task)
+  {
+    x2_task_queue.push([this, task = std::forward<Task>(task)]() mutable {
+      auto t_start = std::chrono::steady_clock::now();
+      task();
+      thread_load.x2 += std::chrono::steady_clock::now() - t_start;
+    });
+  }
 
   // args
   stack_args_t args    = {};
@@ -174,6 +186,14 @@ private:
   // task handling
   srsran::task_scheduler    task_sched;
   srsran::task_queue_handle enb_task_queue, sync_task_queue, metrics_task_queue, x2_task_queue;
+  srsran::offload_executor  ctrl_executor;
+
+  // Time spent by the stack thread in each layer. The metrics report the increment since the previous report
+  struct thread_load_t {
+    std::chrono::steady_clock::time_point tp = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds              busy{0}, timers{0}, rrc{0}, s1ap{0}, x2{0}, ctrl{0}, offload{0};
+  };
+  thread_load_t thread_load, last_thread_load;
 
   // bearer management
   enb_bearer_manager                 bearers; // helper to manage mapping between EPS and radio bearers
@@ -58,12 +58,27 @@ struct mac_ue_metrics_t {
   float ul_mcs;
   int   ul_mcs_samples;
 };
+/// HARQ softbuffer pool metrics for each cc.
+struct mac_softbuffer_metrics_t {
+  /// Number of Tx/Rx softbuffers currently bound to HARQ processes.
+  uint32_t nof_tx_used;
+  uint32_t nof_rx_used;
+  /// Peak number of Tx/Rx softbuffers simultaneously bound to HARQ processes.
+  uint32_t max_tx_used;
+  uint32_t max_rx_used;
+  /// Number of Tx/Rx softbuffer requests that failed due to pool exhaustion.
+  uint32_t nof_tx_exhausted;
+  uint32_t nof_rx_exhausted;
+};
+
 /// MAC misc information for each cc.
 struct mac_cc_info_t {
   /// PCI value.
   uint32_t pci;
   /// RACH preamble counter per cc.
   uint32_t cc_rach_counter;
+  /// HARQ softbuffer pool occupancy.
+  mac_softbuffer_metrics_t softbuffers;
 };
 
 /// Main MAC metrics.
@@ -203,8 +203,8 @@ private:
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
-  // Softbuffer pool
-  std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
+  // HARQ softbuffer pool of each cell
+  std::vector<std::unique_ptr<cc_softbuffer_pool> > softbuffer_pools;
 };
 
 } // namespace srsenb
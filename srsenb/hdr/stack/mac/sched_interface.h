@@ -304,8 +304,17 @@ public:
    */
   virtual int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds) = 0;
 
+  /**
+   * Process the HARQ-ACK feedback of a DL TB
+   *
+   * @param tti TTI in which the feedback was received
+   * @param pid if not null, set to the DL HARQ process the feedback belongs to
+   * @return number of bytes of the TB, or a negative value if the feedback does not match any HARQ process
+   */
+  virtual int
+  dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack, uint32_t* pid = nullptr) = 0;
+
   /* DL information */
-  virtual int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)        = 0;
   virtual int dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)                                 = 0;
   virtual int dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)                 = 0;
   virtual int dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)               = 0;
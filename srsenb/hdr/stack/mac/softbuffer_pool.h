@@ -0,0 +1,130 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SOFTBUFFER_POOL_H
+#define SRSENB_SOFTBUFFER_POOL_H
+
+#include "common/mac_metrics.h"
+#include "srsran/adt/pool/pool_interface.h"
+#include "srsran/phy/fec/softbuffer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace srsenb {
+
+/// LTE Tx softbuffer with capacity for a fixed number of code blocks
+class cc_tx_softbuffer
+{
+public:
+  explicit cc_tx_softbuffer(uint32_t max_cb) { srsran_softbuffer_tx_init_guru(&buffer, max_cb, SOFTBUFFER_SIZE); }
+  cc_tx_softbuffer(const cc_tx_softbuffer&) = delete;
+  cc_tx_softbuffer& operator=(const cc_tx_softbuffer&) = delete;
+  ~cc_tx_softbuffer() { srsran_softbuffer_tx_free(&buffer); }
+
+  srsran_softbuffer_tx_t*       get() { return &buffer; }
+  const srsran_softbuffer_tx_t* get() const { return &buffer; }
+
+private:
+  srsran_softbuffer_tx_t buffer = {};
+};
+
+/// LTE Rx softbuffer with capacity for a fixed number of code blocks, storing either 16-bit or 8-bit LLRs
+class cc_rx_softbuffer
+{
+public:
+  cc_rx_softbuffer(uint32_t max_cb, bool llr_is_8bit)
+  {
+    if (llr_is_8bit) {
+      srsran_softbuffer_rx_init_guru_8bit(&buffer, max_cb, SOFTBUFFER_SIZE);
+    } else {
+      srsran_softbuffer_rx_init_guru(&buffer, max_cb, SOFTBUFFER_SIZE);
+    }
+  }
+  cc_rx_softbuffer(const cc_rx_softbuffer&) = delete;
+  cc_rx_softbuffer& operator=(const cc_rx_softbuffer&) = delete;
+  ~cc_rx_softbuffer() { srsran_softbuffer_rx_free(&buffer); }
+
+  srsran_softbuffer_rx_t*       get() { return &buffer; }
+  const srsran_softbuffer_rx_t* get() const { return &buffer; }
+
+private:
+  srsran_softbuffer_rx_t buffer = {};
+};
+
+/**
+ * Cell-wide pool of HARQ softbuffers shared by all the UEs of a carrier.
+ * Softbuffers are grouped in size classes with a power-of-two number of code blocks (capped by the cell bandwidth), so
+ * that a HARQ process only holds the memory its TBS requires, and only while its transmission is ongoing.
+ * Thread-safe.
+ */
+class cc_softbuffer_pool
+{
+public:
+  using tx_softbuffer_ptr = srsran::unique_pool_ptr<cc_tx_softbuffer>;
+  using rx_softbuffer_ptr = srsran::unique_pool_ptr<cc_rx_softbuffer>;
+
+  /**
+   * @param nof_prb Cell bandwidth, which determines the size of the largest softbuffer class
+   * @param max_nof_buffers Maximum number of softbuffers simultaneously in use per direction (0 for no limit)
+   * @param nof_prealloc Number of softbuffers preallocated per size class and direction
+   * @param rx_8bit Store Rx LLRs with 8-bit, halving the Rx softbuffer memory (requires 8-bit PUSCH decoding)
+   */
+  cc_softbuffer_pool(uint32_t nof_prb, uint32_t max_nof_buffers, uint32_t nof_prealloc, bool rx_8bit = false);
+  cc_softbuffer_pool(const cc_softbuffer_pool&) = delete;
+  cc_softbuffer_pool(cc_softbuffer_pool&&)      = delete;
+  cc_softbuffer_pool& operator=(const cc_softbuffer_pool&) = delete;
+  cc_softbuffer_pool& operator=(cc_softbuffer_pool&&) = delete;
+  ~cc_softbuffer_pool();
+
+  /// Get a Tx softbuffer able to hold a TB of "tbs" bytes. Returns nullptr if the pool is exhausted.
+  tx_softbuffer_ptr get_tx(uint32_t tbs);
+
+  /// Get a Rx softbuffer able to hold a TB of "tbs" bytes. Returns nullptr if the pool is exhausted.
+  rx_softbuffer_ptr get_rx(uint32_t tbs);
+
+  uint32_t max_nof_cb() const { return class_nof_cb.back(); }
+  size_t   nof_size_classes() const { return class_nof_cb.size(); }
+
+  void get_metrics(mac_softbuffer_metrics_t& metrics) const;
+
+private:
+  struct usage_counter {
+    std::atomic<uint32_t> used{0};
+    std::atomic<uint32_t> max_used{0};
+    std::atomic<uint32_t> nof_exhausted{0};
+  };
+
+  size_t get_size_class(uint32_t tbs) const;
+  bool   reserve(usage_counter& counter);
+
+  const uint32_t max_nof_buffers;
+
+  std::vector<uint32_t>                                                  class_nof_cb;
+  std::vector<std::unique_ptr<srsran::obj_pool_itf<cc_tx_softbuffer> > > tx_pools;
+  std::vector<std::unique_ptr<srsran::obj_pool_itf<cc_rx_softbuffer> > > rx_pools;
+
+  usage_counter tx_usage, rx_usage;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_SOFTBUFFER_POOL_H
@@ -24,9 +24,11 @@
 
 #include "common/mac_metrics.h"
 #include "sched_interface.h"
+#include "softbuffer_pool.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/pool_interface.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
@@ -45,30 +47,6 @@ class rrc_interface_mac;
 class rlc_interface_mac;
 class phy_interface_stack_lte;
 
-/// Class to manage the allocation, deallocation & access to UE carrier DL + UL softbuffers
-struct ue_cc_softbuffers {
-  // List of Tx softbuffers for all HARQ processes of one carrier
-  using cc_softbuffer_tx_list_t = std::vector<srsran_softbuffer_tx_t>;
-  // List of Rx softbuffers for all HARQ processes of one carrier
-  using cc_softbuffer_rx_list_t = std::vector<srsran_softbuffer_rx_t>;
-
-  const uint32_t          nof_tx_harq_proc;
-  const uint32_t          nof_rx_harq_proc;
-  cc_softbuffer_tx_list_t softbuffer_tx_list;
-  cc_softbuffer_rx_list_t softbuffer_rx_list;
-
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
-  ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
-  ~ue_cc_softbuffers();
-  void clear();
-
-  srsran_softbuffer_tx_t& get_tx(uint32_t pid, uint32_t tb_idx)
-  {
-    return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
-  }
-  srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
-};
-
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
 class cc_used_buffers_map
 {
@@ -102,24 +80,44 @@ public:
   ~cc_buffer_handler();
 
   void reset();
-  void allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_);
+  void allocate_cc(cc_softbuffer_pool* softbuffer_pool_);
   void deallocate_cc();
 
-  bool                    empty() const { return cc_softbuffers == nullptr; }
-  srsran_softbuffer_tx_t& get_tx_softbuffer(uint32_t pid, uint32_t tb_idx)
-  {
-    return cc_softbuffers->get_tx(pid, tb_idx);
-  }
-  srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
-  srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
+  bool empty() const { return softbuffer_pool == nullptr; }
+
+  /// Get the Tx softbuffer of a DL HARQ process. For new transmissions, a softbuffer sized for the TBS is bound to it
+  srsran_softbuffer_tx_t*
+  get_tx_softbuffer(tti_point tti_tx_dl, uint32_t pid, uint32_t tb_idx, uint32_t tbs, bool new_tx);
+  /// Get the Rx softbuffer of a UL HARQ process. For new transmissions, a softbuffer sized for the TBS is bound to it
+  srsran_softbuffer_rx_t* get_rx_softbuffer(tti_point tti_tx_ul, uint32_t tbs, bool new_tx);
+  /// Return the Tx softbuffer of an acknowledged TB of a DL HARQ process to the cell pool
+  void release_tx_softbuffer(uint32_t pid, uint32_t tb_idx);
+  /// Return the Rx softbuffer of the TB successfully decoded at tti_rx to the cell pool
+  void release_rx_softbuffer(tti_point tti_rx);
+  /// Return to the cell pool softbuffers of HARQ processes that were not used recently
+  void clear_old_softbuffers(tti_point current_tti);
+
+  srsran::byte_buffer_t* get_tx_payload_buffer(size_t harq_pid, size_t tb)
   {
     return tx_payload_buffer[harq_pid][tb].get();
   }
   cc_used_buffers_map& get_rx_used_buffers() { return rx_used_buffers; }
 
 private:
-  // CC softbuffers
-  srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers;
+  struct dl_harq_softbuffers_t {
+    tti_point                                                        tti_tx;
+    std::array<cc_softbuffer_pool::tx_softbuffer_ptr, SRSRAN_MAX_TB> tb;
+  };
+  struct ul_harq_softbuffer_t {
+    tti_point                             tti_tx;
+    cc_softbuffer_pool::rx_softbuffer_ptr buffer;
+  };
+
+  // CC softbuffers, bound to HARQ processes only while a transmission is ongoing
+  cc_softbuffer_pool*                                    softbuffer_pool = nullptr;
+  std::mutex                                             softbuffer_mutex;
+  std::array<dl_harq_softbuffers_t, SRSRAN_FDD_NOF_HARQ> dl_harq_softbuffers;
+  std::array<ul_harq_softbuffer_t, SRSRAN_FDD_NOF_HARQ>  ul_harq_softbuffers;
 
   // buffers
   cc_used_buffers_map rx_used_buffers;
@@ -131,15 +129,15 @@ private:
 class ue : public srsran::read_pdu_interface, public mac_ta_ue_interface
 {
 public:
-  ue(uint16_t                                 rnti,
-     uint32_t                                 enb_cc_idx,
-     sched_interface*                         sched,
-     rrc_interface_mac*                       rrc_,
-     rlc_interface_mac*                       rlc,
-     phy_interface_stack_lte*                 phy_,
-     srslog::basic_logger&                    logger,
-     uint32_t                                 nof_cells_,
-     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool);
+  ue(uint16_t                                           rnti,
+     uint32_t                                           enb_cc_idx,
+     sched_interface*                                   sched,
+     rrc_interface_mac*                                 rrc_,
+     rlc_interface_mac*                                 rlc,
+     phy_interface_stack_lte*                           phy_,
+     srslog::basic_logger&                              logger,
+     uint32_t                                           nof_cells_,
+     srsran::span<std::unique_ptr<cc_softbuffer_pool> > softbuffer_pools);
 
   virtual ~ue();
   void reset();
@@ -168,8 +166,15 @@ public:
                             uint32_t                             nof_pdu_elems,
                             uint32_t                             grant_size);
 
-  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
-  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
+  srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx,
+                                            uint32_t tti,
+                                            uint32_t harq_process,
+                                            uint32_t tb_idx,
+                                            uint32_t tbs,
+                                            bool     new_tx);
+  srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, bool new_tx);
+  void                    release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t pid, uint32_t tb_idx);
+  void                    release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx);
 
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
@@ -214,7 +219,7 @@ private:
   uint32_t         dl_pmi_counter = 0;
   mac_ue_metrics_t ue_metrics     = {};
 
-  srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
+  srsran::span<std::unique_ptr<cc_softbuffer_pool> > softbuffer_pools;
 
   srsran::block_queue<uint32_t> pending_ta_commands;
   ta                            ta_fsm;
@@ -31,6 +31,7 @@
 #include "srsran/common/bearer_manager.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/common/offload_executor.h"
 #include "srsran/common/stack_procedure.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/timeout.h"
@@ -82,6 +83,8 @@ public:
   void stop();
   void get_metrics(rrc_metrics_t& m);
   void tti_clock();
+  /// Unpack the UL-DCCH messages in the given executor rather than in the stack thread
+  void set_ctrl_executor(srsran::offload_executor* executor_) { ctrl_executor = executor_; }
 
   // rrc_interface_mac
   int      add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override;
@@ -198,6 +201,10 @@ private:
 
   void config_mac();
   void parse_ul_dcch(ue& ue, uint32_t lcid, srsran::unique_byte_buffer_t pdu);
+  void handle_ul_dcch(ue&                          ue,
+                      uint32_t                     lcid,
+                      srsran::unique_byte_buffer_t pdu,
+                      asn1::rrc::ul_dcch_msg_s&    ul_dcch_msg);
   void parse_ul_ccch(ue& ue, srsran::unique_byte_buffer_t pdu);
   void send_rrc_connection_reject(uint16_t rnti);
 
@@ -210,6 +217,14 @@ private:
     uint32_t                     arg;
     srsran::unique_byte_buffer_t pdu;
   };
+  struct offloaded_rrc_pdu {
+    rrc_pdu                  pdu;
+    uint32_t                 ue_generation = 0; ///< generation of the UE with the PDU RNTI when it was offloaded
+    asn1::rrc::ul_dcch_msg_s ul_dcch_msg;
+    bool                     unpacked = false;
+  };
+  void offload_rx_pdu(rrc_pdu p);
+  void process_rx_pdu(rrc_pdu& p, asn1::rrc::ul_dcch_msg_s* ul_dcch_msg);
   void log_rx_pdu_fail(uint16_t rnti, uint32_t lcid, srsran::const_byte_span pdu, const char* cause);
   void
   log_rxtx_pdu_impl(direction_t dir, uint16_t rnti, uint32_t lcid, srsran::const_byte_span pdu, const char* msg_type);
@@ -225,6 +240,8 @@ private:
 
   bool                                running = false;
   srsran::dyn_blocking_queue<rrc_pdu> rx_pdu_queue;
+  srsran::offload_executor*           ctrl_executor      = nullptr;
+  uint32_t                            ue_generation_count = 0;
 
   asn1::rrc::mcch_msg_s  mcch;
   bool                   enable_mbms     = false;
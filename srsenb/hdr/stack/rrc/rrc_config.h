@@ -26,6 +26,7 @@
 #include "srsran/asn1/rrc.h"
 #include "srsran/common/security.h"
 #include "srsran/interfaces/enb_rrc_interface_types.h"
+#include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/phy/common/phy_common.h"
 #include <array>
 
@@ -45,6 +46,7 @@ struct rrc_cfg_qci_t {
   asn1::rrc::lc_ch_cfg_s::ul_specific_params_s_ lc_cfg;
   asn1::rrc::pdcp_cfg_s                         pdcp_cfg;
   asn1::rrc::rlc_cfg_c                          rlc_cfg;
+  srsran::rlc_aqm_config_t                      aqm_cfg;
 };
 
 struct srb_cfg_t {
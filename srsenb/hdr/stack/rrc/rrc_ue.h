@@ -95,6 +95,10 @@ public:
   void send_ue_info_req();
 
   void parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
+  /// Handles an UL-DCCH message that was already unpacked from "pdu"
+  void handle_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu, asn1::rrc::ul_dcch_msg_s& ul_dcch_msg);
+  /// Unpacks an UL-DCCH message. It does not access any UE state, so it can be called outside of the stack thread
+  static bool unpack_ul_dcch(const srsran::byte_buffer_t& pdu, asn1::rrc::ul_dcch_msg_s& ul_dcch_msg);
 
   /// List of generated RRC events.
   enum class rrc_event_type {
@@ -166,8 +170,9 @@ public:
 
   const ue_cell_ded_list& get_cell_list() const { return ue_cell_list; }
 
-  uint16_t rnti   = 0;
-  rrc*     parent = nullptr;
+  uint16_t rnti       = 0;
+  uint32_t generation = 0; ///< tells this UE apart from previous UEs that used the same RNTI
+  rrc*     parent     = nullptr;
 
   bool                          connect_notified = false;
   unique_rnti_ptr<rrc_mobility> mobility_handler;
@@ -37,6 +37,7 @@
 #include "srsran/adt/optional.h"
 #include "srsran/asn1/s1ap.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/offload_executor.h"
 #include "srsran/common/stack_procedure.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/srslog/srslog.h"
@@ -119,6 +120,13 @@ public:
   bool
   handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu, const sockaddr_in& from, const sctp_sndrcvinfo& sri, int flags);
   void start_pcap(srsran::s1ap_pcap* pcap_);
+  /// Unpack the PDUs received from the MME in the given executor rather than in the stack thread
+  void set_ctrl_executor(srsran::offload_executor* executor_);
+  /// Total time spent by the stack thread handling messages received from the MME
+  std::chrono::microseconds get_rx_busy_time() const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(rx_busy_time);
+  }
 
 private:
   static const int MME_PORT        = 36412;
@@ -152,6 +160,18 @@ private:
   // PCAP
   srsran::s1ap_pcap* pcap = nullptr;
 
+  // Control-plane offloading
+  struct mme_rx_msg_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  from;
+    sctp_sndrcvinfo              sri;
+    int                          flags;
+    asn1::s1ap::s1ap_pdu_c       rx_pdu;
+    bool                         unpacked = false;
+  };
+  srsran::offload_executor* ctrl_executor = nullptr;
+  std::chrono::nanoseconds  rx_busy_time{0};
+
   asn1::s1ap::s1_setup_resp_s s1setupresponse;
 
   void build_tai_cgi();
@@ -159,7 +179,12 @@ private:
   bool setup_s1();
   bool sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnti, const char* procedure_name);
 
-  bool handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu);
+  bool process_mme_rx_msg(srsran::unique_byte_buffer_t  pdu,
+                          const sockaddr_in&            from,
+                          const sctp_sndrcvinfo&        sri,
+                          int                           flags,
+                          const asn1::s1ap::s1ap_pdu_c* unpacked_pdu);
+  bool handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, const asn1::s1ap::s1ap_pdu_c* unpacked_pdu = nullptr);
   bool handle_initiatingmessage(const asn1::s1ap::init_msg_s& msg);
   bool handle_successfuloutcome(const asn1::s1ap::successful_outcome_s& msg);
   bool handle_unsuccessfuloutcome(const asn1::s1ap::unsuccessful_outcome_s& msg);
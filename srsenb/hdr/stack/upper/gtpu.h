@@ -25,7 +25,8 @@
 
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/bounded_vector.h"
-#include "srsran/adt/circular_map.h"
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/expected.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
@@ -126,8 +127,51 @@ public:
   bool remove_rnti(uint16_t rnti);
 
 private:
-  using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, SRSENB_MAX_UES * MAX_TUNNELS_PER_UE>;
-  using tunnel_ctxt_it = typename tunnel_list_t::iterator;
+  /**
+   * Tunnel table indexed directly by TEID-In. As the eNB allocates its own TEIDs, the lower TEID bits encode the table
+   * slot and the upper bits a generation counter that is incremented whenever the slot is reused, so that the TEID of
+   * a removed tunnel never resolves to the tunnel that took its slot. A lookup is a mask and one comparison.
+   */
+  class tunnel_table
+  {
+  public:
+    const static uint32_t SLOT_BITS = 10;
+    const static uint32_t SLOT_MASK = (1U << SLOT_BITS) - 1;
+    const static size_t   CAPACITY  = 1U << SLOT_BITS;
+    static_assert(CAPACITY >= SRSENB_MAX_UES * MAX_TUNNELS_PER_UE, "Tunnel table is too small");
+
+    tunnel_table();
+    ~tunnel_table();
+    tunnel_table(const tunnel_table&)            = delete;
+    tunnel_table& operator=(const tunnel_table&) = delete;
+
+    tunnel* find(uint32_t teid)
+    {
+      slot_t& slot = slots[teid & SLOT_MASK];
+      return slot.teid == teid ? &slot.tun.get() : nullptr;
+    }
+    bool    contains(uint32_t teid) const { return slots[teid & SLOT_MASK].teid == teid; }
+    tunnel& operator[](uint32_t teid)
+    {
+      srsran_assert(contains(teid), "Accessing non-existent TEID=0x%x", teid);
+      return slots[teid & SLOT_MASK].tun.get();
+    }
+
+    /// Creates a tunnel in the least recently freed slot and returns its TEID
+    srsran::expected<uint32_t> insert();
+    bool                       erase(uint32_t teid);
+    size_t                     size() const { return CAPACITY - free_slots.size(); }
+
+  private:
+    struct slot_t {
+      uint32_t                             teid       = 0; ///< a TEID of another slot while the slot is free
+      uint32_t                             generation = 0;
+      srsran::detail::type_storage<tunnel> tun;
+    };
+
+    std::array<slot_t, CAPACITY>                       slots;
+    srsran::static_circular_buffer<uint32_t, CAPACITY> free_slots;
+  };
 
   // Used to differentiate whether GTPU is used in NR or LTE context.
   srsran::srsran_rat_t ran_type;
@@ -138,7 +182,7 @@ private:
   srslog::basic_logger&     logger;
 
   std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                                       tunnels;
+  tunnel_table                                        tunnels;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
@@ -175,9 +219,18 @@ public:
   void handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
 
+  /// Number of S1-U packets handled by the fast path, and by the generic path
+  struct rx_path_counters_t {
+    uint64_t fast_path = 0;
+    uint64_t slow_path = 0;
+  };
+  const rx_path_counters_t& get_rx_path_counters() const { return rx_counters; }
+
 private:
   static const int GTPU_PORT = 2152;
 
+  [[gnu::noinline]] void handle_gtpu_s1u_rx_slow_path(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+
   void rem_tunnel(uint32_t teidin);
 
   srsran::socket_manager_itf* rx_socket_handler = nullptr;
@@ -225,6 +278,8 @@ private:
   // Tx sequence number for signaling messages
   uint32_t tx_seq = 0;
 
+  rx_path_counters_t rx_counters;
+
   // Socket file descriptor
   int fd = -1;
 
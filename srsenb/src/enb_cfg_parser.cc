@@ -67,6 +67,51 @@ bool contains_value(T value, const std::initializer_list<T>& list)
   return false;
 }
 
+/// Parses the optional "rohc" section of a DRB PDCP config. LTE and NR share the same ROHC parameters
+template <typename RohcCfg>
+static int parse_rohc_cfg(libconfig::Setting& root, RohcCfg& rohc, const char* qos_name, uint32_t qos_id)
+{
+  libconfig::Setting& r = root["rohc"];
+
+  uint32_t max_cid = 15;
+  if (r.lookupValue("max_cid", max_cid)) {
+    if (max_cid < 1 or max_cid > 16383) {
+      fprintf(stderr, "Error invalid ROHC max_cid=%d for %s=%d. Valid range is 1-16383\n", max_cid, qos_name, qos_id);
+      return SRSRAN_ERROR;
+    }
+    // 15 is the default value when the field is absent
+    rohc.max_cid_present = max_cid != 15;
+    rohc.max_cid         = max_cid;
+  }
+
+  if (not r.exists("profiles") or r["profiles"].getLength() == 0) {
+    fprintf(stderr, "Error no ROHC profiles configured for %s=%d\n", qos_name, qos_id);
+    return SRSRAN_ERROR;
+  }
+  for (int i = 0; i < r["profiles"].getLength(); i++) {
+    uint32_t profile = r["profiles"][i];
+    switch (profile) {
+      case 0x0001:
+        rohc.profiles.profile0x0001 = true;
+        break;
+      case 0x0002:
+        rohc.profiles.profile0x0002 = true;
+        break;
+      case 0x0004:
+        rohc.profiles.profile0x0004 = true;
+        break;
+      default:
+        fprintf(stderr,
+                "Error ROHC profile 0x%04x not supported for %s=%d. Supported profiles are 0x0001, 0x0002 and 0x0004\n",
+                profile,
+                qos_name,
+                qos_id);
+        return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 bool sib_is_present(const sched_info_list_l& l, sib_type_e sib_num)
 {
   for (uint32_t i = 0; i < l.size(); i++) {
@@ -790,7 +835,11 @@ int field_qci::parse(libconfig::Setting& root)
 
     qcicfg.pdcp_cfg.rlc_am_present =
         q["pdcp_config"].lookupValue("status_report_required", qcicfg.pdcp_cfg.rlc_am.status_report_required);
-    qcicfg.pdcp_cfg.hdr_compress.set(pdcp_cfg_s::hdr_compress_c_::types::not_used);
+    if (q["pdcp_config"].exists("rohc")) {
+      HANDLEPARSERCODE(parse_rohc_cfg(q["pdcp_config"], qcicfg.pdcp_cfg.hdr_compress.set_rohc(), "qci", qci));
+    } else {
+      qcicfg.pdcp_cfg.hdr_compress.set(pdcp_cfg_s::hdr_compress_c_::types::not_used);
+    }
 
     // Parse RLC section
     rlc_cfg_c* rlc_cfg = &qcicfg.rlc_cfg;
@@ -924,6 +973,21 @@ int field_qci::parse(libconfig::Setting& root)
 
     if (q.exists("enb_specific")) {
       qcicfg.enb_dl_max_retx_thres = (int)q["enb_specific"]["dl_max_retx_thresh"];
+
+      // Active queue management of the DL RLC SDU queue
+      std::string aqm_str;
+      if (q["enb_specific"].lookupValue("aqm", aqm_str)) {
+        if (boost::iequals(aqm_str, "codel")) {
+          qcicfg.aqm_cfg = srsran::rlc_aqm_config_t::codel();
+        } else if (boost::iequals(aqm_str, "pie")) {
+          qcicfg.aqm_cfg = srsran::rlc_aqm_config_t::pie();
+        } else if (not boost::iequals(aqm_str, "none")) {
+          ERROR("Invalid aqm=%s in qci=%d. Valid values are none, codel and pie", aqm_str.c_str(), qci);
+          return SRSRAN_ERROR;
+        }
+        q["enb_specific"].lookupValue("aqm_target", qcicfg.aqm_cfg.target_ms);
+        q["enb_specific"].lookupValue("aqm_interval", qcicfg.aqm_cfg.interval_ms);
+      }
     }
 
     cfg.insert(std::make_pair(qci, qcicfg));
@@ -1076,7 +1140,11 @@ int field_five_qi::parse(libconfig::Setting& root)
     parser::field<bool> integrity_protection("integrity_protection", &drb_cfg->integrity_protection_present);
     integrity_protection.parse(drb);
 
-    drb_cfg->hdr_compress.set_not_used();
+    if (drb.exists("rohc")) {
+      HANDLEPARSERCODE(parse_rohc_cfg(drb, drb_cfg->hdr_compress.set_rohc(), "five_qi", five_qi));
+    } else {
+      drb_cfg->hdr_compress.set_not_used();
+    }
     // Finish DRB config
 
     // t_Reordering
@@ -2092,6 +2160,9 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
   // MAC needs to know the cell bandwidth to dimension softbuffers
   args_->stack.mac.nof_prb = args_->enb.n_prb;
 
+  // With 8-bit PUSCH decoding, the MAC Rx softbuffers only need to store 8-bit LLRs
+  args_->stack.mac.rx_softbuffer_8bit = args_->phy.pusch_8bit_decoder;
+
   // RRC needs eNB id for SIB1 packing
   rrc_cfg_->enb_id = args_->stack.s1ap.enb_id;
 
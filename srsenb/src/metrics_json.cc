@@ -92,8 +92,41 @@ DECLARE_METRIC_SET("ue_container",
 DECLARE_METRIC("carrier_id", metric_carrier_id, uint32_t, "");
 DECLARE_METRIC("pci", metric_pci, uint32_t, "");
 DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
+DECLARE_METRIC("dl_softbuffers", metric_dl_softbuffers, uint32_t, "");
+DECLARE_METRIC("ul_softbuffers", metric_ul_softbuffers, uint32_t, "");
+DECLARE_METRIC("softbuffer_pool_exhausted", metric_softbuffer_pool_exhausted, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
-DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
+DECLARE_METRIC_SET("cell_container",
+                   mset_cell_container,
+                   metric_carrier_id,
+                   metric_pci,
+                   metric_nof_rach,
+                   metric_dl_softbuffers,
+                   metric_ul_softbuffers,
+                   metric_softbuffer_pool_exhausted,
+                   mlist_ues);
+
+/// Stack thread load metrics.
+DECLARE_METRIC("period", metric_stack_period, float, "ms");
+DECLARE_METRIC("busy", metric_stack_busy, float, "ms");
+DECLARE_METRIC("timers", metric_stack_timers, float, "ms");
+DECLARE_METRIC("rrc", metric_stack_rrc, float, "ms");
+DECLARE_METRIC("s1ap", metric_stack_s1ap, float, "ms");
+DECLARE_METRIC("x2", metric_stack_x2, float, "ms");
+DECLARE_METRIC("ctrl", metric_stack_ctrl, float, "ms");
+DECLARE_METRIC("other", metric_stack_other, float, "ms");
+DECLARE_METRIC("offload", metric_stack_offload, float, "ms");
+DECLARE_METRIC_SET("stack_thread",
+                   mset_stack_thread,
+                   metric_stack_period,
+                   metric_stack_busy,
+                   metric_stack_timers,
+                   metric_stack_rrc,
+                   metric_stack_s1ap,
+                   metric_stack_x2,
+                   metric_stack_ctrl,
+                   metric_stack_other,
+                   metric_stack_offload);
 
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
@@ -101,7 +134,8 @@ DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t =
+    srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mset_stack_thread, mlist_cell>;
 
 } // namespace
 
@@ -222,6 +256,10 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     cell.write<metric_carrier_id>(cc_idx);
     cell.write<metric_nof_rach>(m.stack.mac.cc_info[cc_idx].cc_rach_counter);
     cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
+    const mac_softbuffer_metrics_t& softbuffers = m.stack.mac.cc_info[cc_idx].softbuffers;
+    cell.write<metric_dl_softbuffers>(softbuffers.nof_tx_used);
+    cell.write<metric_ul_softbuffers>(softbuffers.nof_rx_used);
+    cell.write<metric_softbuffer_pool_exhausted>(softbuffers.nof_tx_exhausted + softbuffers.nof_rx_exhausted);
 
     // For each UE in this cell...
     for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
@@ -238,6 +276,19 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // Fill the stack thread load.
+  const stack_thread_metrics_t& thread = m.stack.thread;
+  auto&                         load   = ctx.get<mset_stack_thread>();
+  load.write<metric_stack_period>(thread.period_ms);
+  load.write<metric_stack_busy>(thread.busy_ms);
+  load.write<metric_stack_timers>(thread.timers_ms);
+  load.write<metric_stack_rrc>(thread.rrc_ms);
+  load.write<metric_stack_s1ap>(thread.s1ap_ms);
+  load.write<metric_stack_x2>(thread.x2_ms);
+  load.write<metric_stack_ctrl>(thread.ctrl_ms);
+  load.write<metric_stack_other>(thread.other_ms);
+  load.write<metric_stack_offload>(thread.offload_ms);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
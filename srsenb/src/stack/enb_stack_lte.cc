@@ -156,6 +156,13 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     return SRSRAN_ERROR;
   }
 
+  // Move the unpacking of RRC/S1AP messages out of the stack thread
+  if (args.ctrl_offload_enable) {
+    ctrl_executor.start(&task_sched);
+    rrc.set_ctrl_executor(&ctrl_executor);
+    s1ap.set_ctrl_executor(&ctrl_executor);
+  }
+
   started = true;
   start(STACK_MAIN_THREAD_PRIO);
 
@@ -171,8 +178,12 @@ void enb_stack_lte::tti_clock()
 
 void enb_stack_lte::tti_clock_impl()
 {
+  auto t_start = std::chrono::steady_clock::now();
   task_sched.tic();
+  auto t_timers = std::chrono::steady_clock::now();
   rrc.tti_clock();
+  thread_load.timers += t_timers - t_start;
+  thread_load.rrc += std::chrono::steady_clock::now() - t_timers;
 }
 
 void enb_stack_lte::stop()
@@ -186,6 +197,7 @@ void enb_stack_lte::stop()
 void enb_stack_lte::stop_impl()
 {
   get_rx_io_manager().stop();
+  ctrl_executor.stop();
 
   s1ap.stop();
   gtpu.stop();
@@ -224,6 +236,7 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    get_thread_metrics(metrics.thread);
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
@@ -237,6 +250,29 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
   return false;
 }
 
+void enb_stack_lte::get_thread_metrics(stack_thread_metrics_t& m)
+{
+  using msec_t = std::chrono::duration<float, std::milli>;
+
+  thread_load.tp      = std::chrono::steady_clock::now();
+  thread_load.busy    = task_sched.busy_time();
+  thread_load.s1ap    = s1ap.get_rx_busy_time();
+  thread_load.ctrl    = ctrl_executor.completion_time();
+  thread_load.offload = ctrl_executor.busy_time();
+
+  m.period_ms  = msec_t(thread_load.tp - last_thread_load.tp).count();
+  m.busy_ms    = msec_t(thread_load.busy - last_thread_load.busy).count();
+  m.timers_ms  = msec_t(thread_load.timers - last_thread_load.timers).count();
+  m.rrc_ms     = msec_t(thread_load.rrc - last_thread_load.rrc).count();
+  m.s1ap_ms    = msec_t(thread_load.s1ap - last_thread_load.s1ap).count();
+  m.x2_ms      = msec_t(thread_load.x2 - last_thread_load.x2).count();
+  m.ctrl_ms    = msec_t(thread_load.ctrl - last_thread_load.ctrl).count();
+  m.offload_ms = msec_t(thread_load.offload - last_thread_load.offload).count();
+  m.other_ms   = std::max(0.0f, m.busy_ms - m.timers_ms - m.rrc_ms - m.s1ap_ms - m.x2_ms - m.ctrl_ms);
+
+  last_thread_load = thread_load;
+}
+
 void enb_stack_lte::run_thread()
 {
   while (started.load(std::memory_order_relaxed)) {
@@ -250,7 +286,7 @@ void enb_stack_lte::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_
   auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) {
     gtpu_adapter->write_pdu(rnti, lcid, std::move(pdu));
   };
-  x2_task_queue.push(std::bind(task, std::move(pdu)));
+  push_x2_task(std::bind(task, std::move(pdu)));
 }
 
 } // namespace srsenb
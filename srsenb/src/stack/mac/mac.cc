@@ -79,14 +79,12 @@ bool mac::init(const mac_args_t&        args_,
     srsran_softbuffer_tx_init(&cc.rar_softbuffer_tx, args.nof_prb);
   }
 
-  // Initiate common pool of softbuffers
-  uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
-  };
-  auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
-  softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
-      8, 8, args.nof_prealloc_ues, init_softbuffers, recycle_softbuffers));
+  // Initiate cell-wide pools of HARQ softbuffers, shared by all UEs
+  softbuffer_pools.resize(cells.size());
+  for (auto& pool : softbuffer_pools) {
+    pool.reset(new cc_softbuffer_pool(
+        args.nof_prb, args.max_nof_softbuffers, args.nof_prealloc_ues, args.rx_softbuffer_8bit));
+  }
 
   detected_rachs.resize(cells.size());
 
@@ -263,6 +261,9 @@ void mac::get_metrics(mac_metrics_t& metrics)
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
+    if (cc < softbuffer_pools.size()) {
+      softbuffer_pools[cc]->get_metrics(metrics.cc_info[cc].softbuffers);
+    }
   }
 }
 
@@ -297,7 +298,14 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+  // The scheduler associates the feedback to its HARQ process, which also works for TDD ACK/NACK timings
+  uint32_t pid       = 0;
+  int      nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack, &pid);
+
+  // Acknowledged TBs do not need their softbuffer for retransmissions anymore
+  if (ack and nof_bytes > 0) {
+    ue_db[rnti]->release_tx_softbuffer(enb_cc_idx, pid, tb_idx);
+  }
   ue_db[rnti]->metrics_tx(ack, nof_bytes);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
@@ -317,6 +325,11 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
   ue_db[rnti]->set_tti(tti_rx);
   ue_db[rnti]->metrics_rx(crc, nof_bytes);
 
+  // Successfully decoded TBs do not need their softbuffer for combining retransmissions anymore
+  if (crc) {
+    ue_db[rnti]->release_rx_softbuffer(enb_cc_idx, tti_rx);
+  }
+
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
   // Scheduler uses eNB's CC mapping
@@ -501,7 +514,7 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
 
     // Allocate and initialize UE object
     unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pools);
 
     // Add UE to rnti map
     srsran::rwlock_write_guard rw_lock(rwlock);
@@ -673,8 +686,21 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+          // Disabled TBs do not hold a softbuffer
+          if (sched_result.data[i].tbs[tb] == 0) {
+            dl_sched_res->pdsch[n].softbuffer_tx[tb] = nullptr;
+            dl_sched_res->pdsch[n].data[tb]          = nullptr;
+            continue;
+          }
+
+          // New transmissions get a softbuffer from the cell pool, retransmissions reuse the one already bound
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx,
+                                             tti_tx_dl,
+                                             sched_result.data[i].dci.pid,
+                                             tb,
+                                             sched_result.data[i].tbs[tb],
+                                             sched_result.data[i].nof_pdu_elems[tb] > 0);
 
           // If the Rx soft-buffer is not given, abort transmission
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
@@ -1003,7 +1029,8 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(
+              enb_cc_idx, tti_tx_ul, sched_result.pusch[i].tbs, sched_result.pusch[i].current_tx_nb == 0);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
@@ -1011,7 +1038,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
             continue;
           }
 
-          if (sched_result.pusch[n].current_tx_nb == 0) {
+          if (sched_result.pusch[i].current_tx_nb == 0) {
             srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
           }
           phy_ul_sched_res->pusch[n].data =
@@ -1062,7 +1089,7 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   current_mcch_length = mcch_payload_length;
 
   unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pools);
 
   auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
   if (!ret) {
@@ -240,12 +240,15 @@ int sched_ue_cell::set_ul_crc(tti_point tti_rx, bool crc_res)
   return pid;
 }
 
-int sched_ue_cell::set_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack)
+int sched_ue_cell::set_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack, uint32_t* pid)
 {
   CHECK_VALID_CC("DL ACK Info");
 
   std::tuple<uint32_t, int, int> p2        = harq_ent.set_ack_info(tti_rx, tb_idx, ack);
   int                            tbs_acked = std::get<1>(p2);
+  if (pid != nullptr) {
+    *pid = std::get<0>(p2);
+  }
   if (tbs_acked <= 0) {
     logger.warning("SCHED: Received ACK info for unknown TTI=%d", tti_rx.to_uint());
     return tbs_acked;
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/softbuffer_pool.h"
+#include "srsran/adt/pool/obj_pool.h"
+#include "srsran/common/common.h"
+
+extern "C" {
+#include "srsran/phy/fec/turbo/turbodecoder_gen.h"
+#include "srsran/phy/phch/ra.h"
+}
+
+namespace srsenb {
+
+/// Number of code blocks required for a TB of "tbs" bytes. Same dimensioning as srsran_softbuffer_rx_reset_tbs()
+static uint32_t tbs_to_nof_cb(uint32_t tbs)
+{
+  return (tbs * 8 + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+}
+
+cc_softbuffer_pool::cc_softbuffer_pool(uint32_t nof_prb,
+                                       uint32_t max_nof_buffers_,
+                                       uint32_t nof_prealloc,
+                                       bool     rx_8bit) :
+  max_nof_buffers(max_nof_buffers_)
+{
+  // The largest class covers the maximum TBS of the cell, same as srsran_softbuffer_tx_init()
+  int max_tbs = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  srsran_assert(max_tbs > 0, "Invalid nof_prb=%d", nof_prb);
+  uint32_t max_cb = (uint32_t)max_tbs / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+
+  for (uint32_t nof_cb = 1; nof_cb < max_cb; nof_cb *= 2) {
+    class_nof_cb.push_back(nof_cb);
+  }
+  class_nof_cb.push_back(max_cb);
+
+  const size_t batch_size = 8;
+  for (uint32_t nof_cb : class_nof_cb) {
+    auto init_tx_softbuffer = [nof_cb](void* ptr) { new (ptr) cc_tx_softbuffer(nof_cb); };
+    auto recycle_tx         = [this](cc_tx_softbuffer&) { tx_usage.used--; };
+    tx_pools.emplace_back(new srsran::background_obj_pool<cc_tx_softbuffer>(
+        batch_size, batch_size, nof_prealloc, init_tx_softbuffer, recycle_tx));
+
+    auto init_rx_softbuffer = [nof_cb, rx_8bit](void* ptr) { new (ptr) cc_rx_softbuffer(nof_cb, rx_8bit); };
+    auto recycle_rx         = [this](cc_rx_softbuffer&) { rx_usage.used--; };
+    rx_pools.emplace_back(new srsran::background_obj_pool<cc_rx_softbuffer>(
+        batch_size, batch_size, nof_prealloc, init_rx_softbuffer, recycle_rx));
+  }
+}
+
+cc_softbuffer_pool::~cc_softbuffer_pool()
+{
+  srsran_expect(tx_usage.used == 0 and rx_usage.used == 0,
+                "Destroying softbuffer pool with softbuffers still in use (tx=%d, rx=%d)",
+                tx_usage.used.load(),
+                rx_usage.used.load());
+}
+
+size_t cc_softbuffer_pool::get_size_class(uint32_t tbs) const
+{
+  uint32_t nof_cb = tbs_to_nof_cb(tbs);
+  size_t   idx    = 0;
+  while (idx + 1 < class_nof_cb.size() and class_nof_cb[idx] < nof_cb) {
+    idx++;
+  }
+  return idx;
+}
+
+bool cc_softbuffer_pool::reserve(usage_counter& counter)
+{
+  uint32_t nof_used = ++counter.used;
+  if (max_nof_buffers > 0 and nof_used > max_nof_buffers) {
+    counter.used--;
+    counter.nof_exhausted++;
+    return false;
+  }
+  uint32_t max_used = counter.max_used.load(std::memory_order_relaxed);
+  while (nof_used > max_used and not counter.max_used.compare_exchange_weak(max_used, nof_used)) {
+  }
+  return true;
+}
+
+cc_softbuffer_pool::tx_softbuffer_ptr cc_softbuffer_pool::get_tx(uint32_t tbs)
+{
+  if (not reserve(tx_usage)) {
+    return nullptr;
+  }
+  return tx_pools[get_size_class(tbs)]->make();
+}
+
+cc_softbuffer_pool::rx_softbuffer_ptr cc_softbuffer_pool::get_rx(uint32_t tbs)
+{
+  if (not reserve(rx_usage)) {
+    return nullptr;
+  }
+  return rx_pools[get_size_class(tbs)]->make();
+}
+
+void cc_softbuffer_pool::get_metrics(mac_softbuffer_metrics_t& metrics) const
+{
+  metrics.nof_tx_used      = tx_usage.used.load(std::memory_order_relaxed);
+  metrics.nof_rx_used      = rx_usage.used.load(std::memory_order_relaxed);
+  metrics.max_tx_used      = tx_usage.max_used.load(std::memory_order_relaxed);
+  metrics.max_rx_used      = rx_usage.max_used.load(std::memory_order_relaxed);
+  metrics.nof_tx_exhausted = tx_usage.nof_exhausted.load(std::memory_order_relaxed);
+  metrics.nof_rx_exhausted = rx_usage.nof_exhausted.load(std::memory_order_relaxed);
+}
+
+} // namespace srsenb
@@ -32,45 +32,6 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
-  nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
-{
-  // Create and init Rx buffers
-  softbuffer_rx_list.resize(nof_rx_harq_proc);
-  for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
-  }
-
-  // Create and init Tx buffers
-  softbuffer_tx_list.resize(nof_tx_harq_proc * SRSRAN_MAX_TB);
-  for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_init(&buffer, nof_prb);
-  }
-}
-
-ue_cc_softbuffers::~ue_cc_softbuffers()
-{
-  for (auto& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_free(&buffer);
-  }
-  softbuffer_rx_list.clear();
-
-  for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_free(&buffer);
-  }
-  softbuffer_tx_list.clear();
-}
-
-void ue_cc_softbuffers::clear()
-{
-  for (auto& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_reset(&buffer);
-  }
-  for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_reset(&buffer);
-  }
-}
-
 cc_used_buffers_map::cc_used_buffers_map() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
 cc_used_buffers_map::~cc_used_buffers_map()
@@ -159,40 +120,111 @@ cc_buffer_handler::~cc_buffer_handler()
   deallocate_cc();
 }
 
-/**
- * Allocate and initialize softbuffers for Tx and Rx. It uses the configured
- * number of HARQ processes and cell width.
- *
- * @param num_cc Number of carriers to add buffers for (default 1)
- * @return number of carriers
- */
-void cc_buffer_handler::allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_)
+void cc_buffer_handler::allocate_cc(cc_softbuffer_pool* softbuffer_pool_)
 {
   srsran_assert(empty(), "Cannot allocate softbuffers in CC that is already initialized");
-  cc_softbuffers = std::move(cc_softbuffers_);
+  softbuffer_pool = softbuffer_pool_;
 }
 
 void cc_buffer_handler::deallocate_cc()
 {
-  cc_softbuffers.reset();
+  reset();
+  softbuffer_pool = nullptr;
 }
 
 void cc_buffer_handler::reset()
 {
-  if (not empty()) {
-    cc_softbuffers->clear();
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  for (auto& h : dl_harq_softbuffers) {
+    for (auto& tb : h.tb) {
+      tb.reset();
+    }
+  }
+  for (auto& h : ul_harq_softbuffers) {
+    h.buffer.reset();
+  }
+}
+
+srsran_softbuffer_tx_t*
+cc_buffer_handler::get_tx_softbuffer(tti_point tti_tx_dl, uint32_t pid, uint32_t tb_idx, uint32_t tbs, bool new_tx)
+{
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  dl_harq_softbuffers_t&      h = dl_harq_softbuffers.at(pid);
+  if (new_tx) {
+    // Release previous softbuffer before requesting a new one, as its size may not match the new TBS
+    h.tb.at(tb_idx).reset();
+    h.tb[tb_idx] = softbuffer_pool->get_tx(tbs);
+  }
+  if (h.tb.at(tb_idx) == nullptr) {
+    return nullptr;
+  }
+  h.tti_tx = tti_tx_dl;
+  return h.tb[tb_idx]->get();
+}
+
+srsran_softbuffer_rx_t* cc_buffer_handler::get_rx_softbuffer(tti_point tti_tx_ul, uint32_t tbs, bool new_tx)
+{
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  ul_harq_softbuffer_t&       h = ul_harq_softbuffers[tti_tx_ul.to_uint() % SRSRAN_FDD_NOF_HARQ];
+  if (new_tx) {
+    h.buffer.reset();
+    h.buffer = softbuffer_pool->get_rx(tbs);
+  }
+  if (h.buffer == nullptr) {
+    return nullptr;
+  }
+  h.tti_tx = tti_tx_ul;
+  return h.buffer->get();
+}
+
+void cc_buffer_handler::release_tx_softbuffer(uint32_t pid, uint32_t tb_idx)
+{
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  if (pid < dl_harq_softbuffers.size() and tb_idx < SRSRAN_MAX_TB) {
+    dl_harq_softbuffers[pid].tb[tb_idx].reset();
+  }
+}
+
+void cc_buffer_handler::release_rx_softbuffer(tti_point tti_rx)
+{
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  ul_harq_softbuffer_t&       h = ul_harq_softbuffers[tti_rx.to_uint() % SRSRAN_FDD_NOF_HARQ];
+  if (h.tti_tx == tti_rx) {
+    h.buffer.reset();
+  }
+}
+
+void cc_buffer_handler::clear_old_softbuffers(tti_point current_tti)
+{
+  // HARQ processes whose softbuffers were not used for this long are considered to have been dropped by the scheduler
+  static const uint32_t old_tti_threshold = SRSRAN_FDD_NOF_HARQ * 8;
+
+  std::lock_guard<std::mutex> lock(softbuffer_mutex);
+  for (auto& h : dl_harq_softbuffers) {
+    if (h.tti_tx.is_valid() and current_tti - h.tti_tx > (int)old_tti_threshold) {
+      for (auto& tb : h.tb) {
+        tb.reset();
+      }
+      h.tti_tx.reset();
+    }
+  }
+  for (auto& h : ul_harq_softbuffers) {
+    if (h.tti_tx.is_valid() and current_tti - h.tti_tx > (int)old_tti_threshold) {
+      h.buffer.reset();
+      h.tti_tx.reset();
+    }
   }
 }
 
-ue::ue(uint16_t                                 rnti_,
-       uint32_t                                 enb_cc_idx,
-       sched_interface*                         sched_,
-       rrc_interface_mac*                       rrc_,
-       rlc_interface_mac*                       rlc_,
-       phy_interface_stack_lte*                 phy_,
-       srslog::basic_logger&                    logger_,
-       uint32_t                                 nof_cells_,
-       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_) :
+ue::ue(uint16_t                                           rnti_,
+       uint32_t                                           enb_cc_idx,
+       sched_interface*                                   sched_,
+       rrc_interface_mac*                                 rrc_,
+       rlc_interface_mac*                                 rlc_,
+       phy_interface_stack_lte*                           phy_,
+       srslog::basic_logger&                              logger_,
+       uint32_t                                           nof_cells_,
+       srsran::span<std::unique_ptr<cc_softbuffer_pool> > softbuffer_pools_) :
   rnti(rnti_),
   sched(sched_),
   rrc(rrc_),
@@ -203,11 +235,11 @@ ue::ue(uint16_t                                 rnti_,
   mch_mac_msg_dl(10, logger_),
   mac_msg_ul(20, logger_),
   ta_fsm(this),
-  softbuffer_pool(softbuffer_pool_),
+  softbuffer_pools(softbuffer_pools_),
   cc_buffers(nof_cells_)
 {
   // Allocate buffer for PCell
-  cc_buffers[enb_cc_idx].allocate_cc(softbuffer_pool->make());
+  cc_buffers[enb_cc_idx].allocate_cc(softbuffer_pools[enb_cc_idx].get());
 }
 
 ue::~ue() {}
@@ -240,29 +272,48 @@ void ue::ue_cfg(const sched_interface::ue_cfg_t& ue_cfg)
   for (const auto& ue_cc : ue_cfg.supported_cc_list) {
     // Allocate and initialize Rx/Tx softbuffers for new carriers (exclude PCell)
     if (ue_cc.active and cc_buffers[ue_cc.enb_cc_idx].empty()) {
-      cc_buffers[ue_cc.enb_cc_idx].allocate_cc(softbuffer_pool->make());
+      cc_buffers[ue_cc.enb_cc_idx].allocate_cc(softbuffer_pools[ue_cc.enb_cc_idx].get());
     }
   }
 }
 
-srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti)
+srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, bool new_tx)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
 
-  return &cc_buffers[enb_cc_idx].get_rx_softbuffer(tti);
+  return cc_buffers[enb_cc_idx].get_rx_softbuffer(tti_point{tti}, tbs, new_tx);
 }
 
-srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
+srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx,
+                                              uint32_t tti,
+                                              uint32_t harq_process,
+                                              uint32_t tb_idx,
+                                              uint32_t tbs,
+                                              bool     new_tx)
 {
   if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
     ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
     return nullptr;
   }
 
-  return &cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
+  return cc_buffers[enb_cc_idx].get_tx_softbuffer(tti_point{tti}, harq_process, tb_idx, tbs, new_tx);
+}
+
+void ue::release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t pid, uint32_t tb_idx)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].release_tx_softbuffer(pid, tb_idx);
+  }
+}
+
+void ue::release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].release_rx_softbuffer(tti_point{tti_rx});
+  }
 }
 
 uint8_t* ue::request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len)
@@ -276,6 +327,9 @@ void ue::clear_old_buffers(uint32_t tti)
   // remove old buffers
   for (auto& cc : cc_buffers) {
     cc.get_rx_used_buffers().clear_old_pdus(tti_point{tti});
+    if (not cc.empty()) {
+      cc.clear_old_softbuffers(tti_point{tti});
+    }
   }
 }
 
@@ -243,6 +243,7 @@ int rrc::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& sched_ue_cfg)
         logger.error("Adding user rnti=0x%x - Failed to allocate user resources", rnti);
         return SRSRAN_ERROR;
       }
+      u->generation = ++ue_generation_count;
       users.insert(std::make_pair(rnti, std::move(u)));
     }
     rlc->add_user(rnti);
@@ -682,6 +683,14 @@ void rrc::parse_ul_dcch(ue& ue, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   ue.parse_ul_dcch(lcid, std::move(pdu));
 }
 
+///< User mutex must be hold by caller
+void rrc::handle_ul_dcch(ue& ue, uint32_t lcid, srsran::unique_byte_buffer_t pdu, ul_dcch_msg_s& ul_dcch_msg)
+{
+  srsran_assert(pdu != nullptr, "handle_ul_dcch called for empty message");
+
+  ue.handle_ul_dcch(lcid, std::move(pdu), ul_dcch_msg);
+}
+
 ///< User mutex must be hold by caller
 void rrc::process_release_complete(uint16_t rnti)
 {
@@ -1032,55 +1041,100 @@ void rrc::tti_clock()
   // pop cmds from queue
   rrc_pdu p;
   while (rx_pdu_queue.try_pop(p)) {
-    // check if user exists
-    auto user_it = users.find(p.rnti);
-    if (user_it == users.end()) {
-      if (p.pdu != nullptr) {
-        log_rx_pdu_fail(p.rnti, p.lcid, *p.pdu, "unknown rnti");
-      } else {
-        logger.warning("Ignoring rnti=0x%x command %d arg %d. Cause: unknown rnti", p.rnti, p.lcid, p.arg);
-      }
-      continue;
+    if (ctrl_executor != nullptr) {
+      offload_rx_pdu(std::move(p));
+    } else {
+      process_rx_pdu(p, nullptr);
     }
-    ue& ue = *user_it->second;
-
-    // handle queue cmd
-    switch (p.lcid) {
-      case srb_to_lcid(lte_srb::srb0):
-        parse_ul_ccch(ue, std::move(p.pdu));
-        break;
-      case srb_to_lcid(lte_srb::srb1):
-      case srb_to_lcid(lte_srb::srb2):
-        parse_ul_dcch(ue, p.lcid, std::move(p.pdu));
-        break;
-      case LCID_REM_USER:
-        rem_user(p.rnti);
-        break;
-      case LCID_REL_USER:
-        process_release_complete(p.rnti);
-        break;
-      case LCID_ACT_USER:
-        user_it->second->set_activity();
-        break;
-      case LCID_RADLINK_DL:
-        user_it->second->set_radiolink_dl_state(p.arg);
-        break;
-      case LCID_RADLINK_UL:
-        user_it->second->set_radiolink_ul_state(p.arg);
-        break;
-      case LCID_RLC_RTX:
-        user_it->second->max_rlc_retx_reached();
-        break;
-      case LCID_PROT_FAIL:
-        user_it->second->protocol_failure();
-        break;
-      case LCID_EXIT:
-        logger.info("Exiting thread");
-        break;
-      default:
-        logger.error("Rx PDU with invalid bearer id: %d", p.lcid);
-        break;
+  }
+}
+
+void rrc::offload_rx_pdu(rrc_pdu p)
+{
+  // The UL-DCCH messages are unpacked in the control-plane executor. The other commands are also passed through the
+  // executor, even though there is nothing to unpack, so that they are not reordered with respect to the messages of
+  // the same UE.
+  std::unique_ptr<offloaded_rrc_pdu> work(new offloaded_rrc_pdu{});
+  auto                               user_it = users.find(p.rnti);
+  work->ue_generation                        = user_it != users.end() ? user_it->second->generation : 0;
+  work->pdu                                  = std::move(p);
+  ctrl_executor->execute(
+      [work = std::move(work)]() mutable {
+        const rrc_pdu& rx = work->pdu;
+        if ((rx.lcid == srb_to_lcid(lte_srb::srb1) or rx.lcid == srb_to_lcid(lte_srb::srb2)) and rx.pdu != nullptr) {
+          work->unpacked = ue::unpack_ul_dcch(*rx.pdu, work->ul_dcch_msg);
+        }
+        return std::move(work);
+      },
+      [this](std::unique_ptr<offloaded_rrc_pdu> work) {
+        // The UE may have been removed and its RNTI given to a new UE while the PDU was in the executor, as new UEs
+        // are added without going through it
+        auto user_it = users.find(work->pdu.rnti);
+        if (user_it != users.end() and user_it->second->generation != work->ue_generation) {
+          logger.info("Discarding rnti=0x%x command %d queued for a previous UE with the same RNTI",
+                      work->pdu.rnti,
+                      work->pdu.lcid);
+          return;
+        }
+        // Messages that failed to unpack are unpacked again in the stack thread, which logs the failure
+        process_rx_pdu(work->pdu, work->unpacked ? &work->ul_dcch_msg : nullptr);
+      });
+}
+
+void rrc::process_rx_pdu(rrc_pdu& p, ul_dcch_msg_s* ul_dcch_msg)
+{
+  // check if user exists
+  auto user_it = users.find(p.rnti);
+  if (user_it == users.end()) {
+    if (p.pdu != nullptr) {
+      log_rx_pdu_fail(p.rnti, p.lcid, *p.pdu, "unknown rnti");
+    } else {
+      logger.warning("Ignoring rnti=0x%x command %d arg %d. Cause: unknown rnti", p.rnti, p.lcid, p.arg);
     }
+    return;
+  }
+  ue& ue = *user_it->second;
+
+  // handle queue cmd
+  switch (p.lcid) {
+    case srb_to_lcid(lte_srb::srb0):
+      parse_ul_ccch(ue, std::move(p.pdu));
+      break;
+    case srb_to_lcid(lte_srb::srb1):
+    case srb_to_lcid(lte_srb::srb2):
+      if (ul_dcch_msg != nullptr) {
+        handle_ul_dcch(ue, p.lcid, std::move(p.pdu), *ul_dcch_msg);
+      } else {
+        parse_ul_dcch(ue, p.lcid, std::move(p.pdu));
+      }
+      break;
+    case LCID_REM_USER:
+      rem_user(p.rnti);
+      break;
+    case LCID_REL_USER:
+      process_release_complete(p.rnti);
+      break;
+    case LCID_ACT_USER:
+      user_it->second->set_activity();
+      break;
+    case LCID_RADLINK_DL:
+      user_it->second->set_radiolink_dl_state(p.arg);
+      break;
+    case LCID_RADLINK_UL:
+      user_it->second->set_radiolink_ul_state(p.arg);
+      break;
+    case LCID_RLC_RTX:
+      user_it->second->max_rlc_retx_reached();
+      break;
+    case LCID_PROT_FAIL:
+      user_it->second->protocol_failure();
+      break;
+    case LCID_EXIT:
+      logger.info("Exiting thread");
+      break;
+    default:
+      logger.error("Rx PDU with invalid bearer id: %d", p.lcid);
+      break;
   }
 }
 
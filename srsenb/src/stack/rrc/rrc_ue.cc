@@ -329,16 +329,25 @@ bool rrc::ue::is_idle()
   return state == RRC_STATE_IDLE;
 }
 
+bool rrc::ue::unpack_ul_dcch(const srsran::byte_buffer_t& pdu, ul_dcch_msg_s& ul_dcch_msg)
+{
+  asn1::cbit_ref bref(pdu.msg, pdu.N_bytes);
+  return ul_dcch_msg.unpack(bref) == asn1::SRSASN_SUCCESS and
+         ul_dcch_msg.msg.type().value == ul_dcch_msg_type_c::types_opts::c1;
+}
+
 void rrc::ue::parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
-  ul_dcch_msg_s  ul_dcch_msg;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (ul_dcch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
-      ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
+  ul_dcch_msg_s ul_dcch_msg;
+  if (not unpack_ul_dcch(*pdu, ul_dcch_msg)) {
     parent->log_rx_pdu_fail(rnti, lcid, *pdu, "Failed to unpack UL-DCCH message");
     return;
   }
+  handle_ul_dcch(lcid, std::move(pdu), ul_dcch_msg);
+}
 
+void rrc::ue::handle_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu, ul_dcch_msg_s& ul_dcch_msg)
+{
   // Log Rx message
   parent->log_rrc_message(Rx, rnti, lcid, *pdu, ul_dcch_msg, ul_dcch_msg.msg.c1().type().to_string());
 
@@ -1609,6 +1618,7 @@ void rrc::ue::apply_rlc_rb_updates(const rr_cfg_ded_s& pending_rr_cfg)
         parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres > 0) {
       rlc_cfg.am.max_retx_thresh = parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres;
     }
+    rlc_cfg.aqm = parent->cfg.qci_cfg.at(erab.qos_params.qci).aqm_cfg;
     parent->rlc->add_bearer(rnti, drb.lc_ch_id, rlc_cfg);
 
     // register EPS bearer over LTE PDCP
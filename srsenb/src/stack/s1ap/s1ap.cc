@@ -619,6 +619,44 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
                              const sockaddr_in&           from,
                              const sctp_sndrcvinfo&       sri,
                              int                          flags)
+{
+  auto t_start = std::chrono::steady_clock::now();
+  bool ret     = true;
+
+  if (ctrl_executor == nullptr) {
+    ret = process_mme_rx_msg(std::move(pdu), from, sri, flags, nullptr);
+  } else {
+    // Unpack the S1AP PDU in the control-plane executor. SCTP notifications are also passed through the executor, so
+    // that they are not handled before the PDUs that were received ahead of them.
+    std::unique_ptr<mme_rx_msg_t> msg(new mme_rx_msg_t{});
+    msg->pdu   = std::move(pdu);
+    msg->from  = from;
+    msg->sri   = sri;
+    msg->flags = flags;
+    ctrl_executor->execute(
+        [msg = std::move(msg)]() mutable {
+          if ((msg->flags & MSG_NOTIFICATION) == 0 and msg->pdu->N_bytes != 0) {
+            asn1::cbit_ref bref(msg->pdu->msg, msg->pdu->N_bytes);
+            msg->unpacked = msg->rx_pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+          }
+          return std::move(msg);
+        },
+        [this](std::unique_ptr<mme_rx_msg_t> msg) {
+          // Failed unpackings are repeated in the stack thread, which reports the error to the MME
+          process_mme_rx_msg(
+              std::move(msg->pdu), msg->from, msg->sri, msg->flags, msg->unpacked ? &msg->rx_pdu : nullptr);
+        });
+  }
+
+  rx_busy_time += std::chrono::steady_clock::now() - t_start;
+  return ret;
+}
+
+bool s1ap::process_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
+                              const sockaddr_in&           from,
+                              const sctp_sndrcvinfo&       sri,
+                              int                          flags,
+                              const s1ap_pdu_c*            unpacked_pdu)
 {
   // Handle Notification Case
   if (flags & MSG_NOTIFICATION) {
@@ -673,29 +711,32 @@ bool s1ap::handle_mme_rx_msg(srsran::unique_byte_buffer_t pdu,
   }
 
   if ((flags & MSG_NOTIFICATION) == 0 && pdu->N_bytes != 0) {
-    handle_s1ap_rx_pdu(pdu.get());
+    handle_s1ap_rx_pdu(pdu.get(), unpacked_pdu);
   }
 
   return true;
 }
 
-bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
+bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, const s1ap_pdu_c* unpacked_pdu)
 {
   // Save message to PCAP
   if (pcap != nullptr) {
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  s1ap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
-    logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
-    cause_c cause;
-    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
-    send_error_indication(cause);
-    return false;
+  s1ap_pdu_c rx_pdu_buffer;
+  if (unpacked_pdu == nullptr) {
+    asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+    if (rx_pdu_buffer.unpack(bref) != asn1::SRSASN_SUCCESS) {
+      logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
+      cause_c cause;
+      cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+      send_error_indication(cause);
+      return false;
+    }
+    unpacked_pdu = &rx_pdu_buffer;
   }
+  const s1ap_pdu_c& rx_pdu = *unpacked_pdu;
   log_s1ap_msg(rx_pdu, srsran::make_span(*pdu), true);
 
   switch (rx_pdu.type().value) {
@@ -2141,6 +2182,11 @@ void s1ap::start_pcap(srsran::s1ap_pcap* pcap_)
 {
   pcap = pcap_;
 }
+
+void s1ap::set_ctrl_executor(srsran::offload_executor* executor_)
+{
+  ctrl_executor = executor_;
+}
 /*******************************************************************************
 /*               s1ap::ue Class
 ********************************************************************************/
@@ -22,6 +22,7 @@
 #include "srsran/upper/gtpu.h"
 #include "srsenb/hdr/stack/upper/gtpu.h"
 #include "srsran/common/common_nr.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
@@ -42,10 +43,62 @@ namespace srsenb {
 #define TEID_IN_FMT "TEID In=0x%x"
 #define TEID_OUT_FMT "TEID Out=0x%x"
 
+// Length of the PDCP PDU number extension header, including its length and next extension type fields
+#define HEADER_PDCP_PDU_NUMBER_LEN 4
+
+gtpu_tunnel_manager::tunnel_table::tunnel_table()
+{
+  for (uint32_t i = 0; i < CAPACITY; ++i) {
+    slots[i].teid = i ^ SLOT_MASK;
+    free_slots.push(i);
+  }
+}
+
+gtpu_tunnel_manager::tunnel_table::~tunnel_table()
+{
+  for (uint32_t i = 0; i < CAPACITY; ++i) {
+    if ((slots[i].teid & SLOT_MASK) == i) {
+      slots[i].teid = i ^ SLOT_MASK;
+      slots[i].tun.destroy();
+    }
+  }
+}
+
+srsran::expected<uint32_t> gtpu_tunnel_manager::tunnel_table::insert()
+{
+  if (free_slots.empty()) {
+    return srsran::default_error_t{};
+  }
+  uint32_t idx = free_slots.top();
+  free_slots.pop();
+
+  // Generation 0 is skipped, so that TEID 0 is never allocated
+  slot_t& slot    = slots[idx];
+  slot.generation = (slot.generation + 1) & (UINT32_MAX >> SLOT_BITS);
+  if (slot.generation == 0) {
+    slot.generation = 1;
+  }
+  slot.tun.emplace();
+  slot.teid = (slot.generation << SLOT_BITS) | idx;
+  return slot.teid;
+}
+
+bool gtpu_tunnel_manager::tunnel_table::erase(uint32_t teid)
+{
+  if (not contains(teid)) {
+    return false;
+  }
+  uint32_t idx = teid & SLOT_MASK;
+  slots[idx].tun.destroy();
+  slots[idx].teid = idx ^ SLOT_MASK;
+  free_slots.push(idx);
+  return true;
+}
+
 gtpu_tunnel_manager::gtpu_tunnel_manager(srsran::task_sched_handle task_sched_,
                                          srslog::basic_logger&     logger,
                                          srsran::srsran_rat_t      ran_type_) :
-  logger(logger), ran_type(ran_type_), task_sched(task_sched_), tunnels(1)
+  logger(logger), ran_type(ran_type_), task_sched(task_sched_)
 {
 }
 
@@ -57,14 +110,13 @@ void gtpu_tunnel_manager::init(const gtpu_args_t& args, pdcp_interface_gtpu* pdc
 
 const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t teid)
 {
-  auto it = tunnels.find(teid);
-  return it != tunnels.end() ? &it->second : nullptr;
+  return tunnels.find(teid);
 }
 
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -99,7 +151,7 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
     logger.warning("Adding TEID with invalid PDU Session Id=%d", eps_bearer_id);
     return nullptr;
   }
-  auto ret_pair = tunnels.insert(tunnel());
+  auto ret_pair = tunnels.insert();
   if (not ret_pair) {
     logger.warning("Unable to create new GTPU TEID In");
     return nullptr;
@@ -633,6 +685,49 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
   logger.debug("Received %d bytes from S1-U interface", pdu->N_bytes);
   pdu->set_timestamp();
 
+  // Fast path: G-PDU without optional fields, or with the PDCP PDU number as its only extension header, to a tunnel
+  // that delivers SDUs to PDCP. Everything else, including malformed packets, is left to the generic path
+  const uint8_t* ptr     = pdu->msg;
+  uint32_t       hdr_len = 0;
+  uint32_t       pdcp_sn = undefined_pdcp_sn;
+  if (pdu->N_bytes > GTPU_EXTENDED_HEADER_LEN + HEADER_PDCP_PDU_NUMBER_LEN) {
+    switch ((uint16_t)(ptr[0] << 8U | ptr[1])) {
+      case (GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL) << 8U | GTPU_MSG_DATA_PDU:
+        hdr_len = GTPU_BASE_HEADER_LEN;
+        break;
+      case (GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL | GTPU_FLAGS_EXTENDED_HDR) << 8U | GTPU_MSG_DATA_PDU:
+        if (ptr[11] == GTPU_EXT_HEADER_PDCP_PDU_NUMBER and ptr[12] == 1 and
+            ptr[15] == GTPU_EXT_NO_MORE_EXTENSION_HEADERS) {
+          hdr_len = GTPU_EXTENDED_HEADER_LEN + HEADER_PDCP_PDU_NUMBER_LEN;
+          pdcp_sn = ptr[13] << 8U | ptr[14];
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  if (hdr_len > 0) {
+    uint32_t teid;
+    uint8_to_uint32(ptr + 4, &teid);
+    const gtpu_tunnel* tun        = tunnels.find_tunnel(teid);
+    uint8_t            ip_version = ptr[hdr_len] >> 4U;
+    if (tun != nullptr and tun->state == gtpu_tunnel_state::pdcp_active and not tun->rx_timer.is_valid() and
+        (ip_version == 4 or ip_version == 6)) {
+      rx_counters.fast_path++;
+      pdu->msg += hdr_len;
+      pdu->N_bytes -= hdr_len;
+      log_message(*tun, true, srsran::make_span(pdu));
+      pdcp->write_sdu(tun->rnti, tun->eps_bearer_id, std::move(pdu), pdcp_sn == undefined_pdcp_sn ? -1 : (int)pdcp_sn);
+      return;
+    }
+  }
+
+  rx_counters.slow_path++;
+  handle_gtpu_s1u_rx_slow_path(std::move(pdu), addr);
+}
+
+void gtpu::handle_gtpu_s1u_rx_slow_path(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
+{
   // Decode GTPU Header
   gtpu_header_t header;
   if (not gtpu_read_header(pdu.get(), &header, logger)) {
@@ -195,7 +195,7 @@ void rlc::reestablish(uint16_t rnti)
 }
 
 // In the eNodeB, there is no polling for buffer state from the scheduler.
-// This function is called by UE RLC instance every time the tx/retx buffers are updated
+// This function is called by UE RLC instance when the occupancy level of the tx/retx buffers changes
 void rlc::update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
   logger.debug("Buffer state: rnti=0x%x, lcid=%d, tx_queue=%d, prio_tx_queue=%d", rnti, lcid, tx_queue, prio_tx_queue);
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/softbuffer_pool.h"
+#include "srsenb/hdr/stack/mac/ue.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+void test_softbuffer_size_classes()
+{
+  cc_softbuffer_pool pool(100, 0, 2);
+
+  // Small TBs get single-CB softbuffers
+  cc_softbuffer_pool::tx_softbuffer_ptr tx_small = pool.get_tx(100);
+  TESTASSERT(tx_small != nullptr);
+  TESTASSERT(tx_small->get()->max_cb == 1);
+
+  // Large TBs get a softbuffer that can hold all their CBs
+  cc_softbuffer_pool::rx_softbuffer_ptr rx_large = pool.get_rx(6000);
+  TESTASSERT(rx_large != nullptr);
+  TESTASSERT(rx_large->get()->max_cb >= 8);
+  TESTASSERT(rx_large->get()->max_cb <= pool.max_nof_cb());
+
+  // TBs beyond the cell maximum are capped to the largest class
+  cc_softbuffer_pool::tx_softbuffer_ptr tx_max = pool.get_tx(100000);
+  TESTASSERT(tx_max != nullptr);
+  TESTASSERT(tx_max->get()->max_cb == pool.max_nof_cb());
+
+  mac_softbuffer_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_tx_used == 2 and metrics.nof_rx_used == 1);
+
+  tx_small.reset();
+  tx_max.reset();
+  rx_large.reset();
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_tx_used == 0 and metrics.nof_rx_used == 0);
+  TESTASSERT(metrics.max_tx_used == 2 and metrics.max_rx_used == 1);
+}
+
+void test_softbuffer_pool_exhaustion()
+{
+  const uint32_t     max_nof_buffers = 4;
+  cc_softbuffer_pool pool(25, max_nof_buffers, 1);
+
+  std::vector<cc_softbuffer_pool::tx_softbuffer_ptr> buffers;
+  for (uint32_t i = 0; i < max_nof_buffers; ++i) {
+    buffers.push_back(pool.get_tx(200));
+    TESTASSERT(buffers.back() != nullptr);
+  }
+  TESTASSERT(pool.get_tx(200) == nullptr);
+
+  mac_softbuffer_metrics_t metrics = {};
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_tx_used == max_nof_buffers);
+  TESTASSERT(metrics.nof_tx_exhausted == 1);
+
+  // Released softbuffers can be reused
+  buffers.pop_back();
+  TESTASSERT(pool.get_tx(200) != nullptr);
+  buffers.clear();
+}
+
+void test_ue_harq_softbuffer_binding()
+{
+  cc_softbuffer_pool pool(50, 0, 2);
+  mac_softbuffer_metrics_t metrics = {};
+
+  {
+    cc_buffer_handler cc;
+    cc.allocate_cc(&pool);
+
+    // DL: softbuffer bound on new tx, kept for retx and released on ACK
+    tti_point               tti_tx{10};
+    srsran_softbuffer_tx_t* tx = cc.get_tx_softbuffer(tti_tx, 3, 0, 1000, true);
+    TESTASSERT(tx != nullptr);
+    TESTASSERT(cc.get_tx_softbuffer(tti_tx + 8, 3, 0, 1000, false) == tx);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_tx_used == 1);
+    cc.release_tx_softbuffer(2, 0);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_tx_used == 1);
+    cc.release_tx_softbuffer(3, 0);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_tx_used == 0);
+    TESTASSERT(cc.get_tx_softbuffer(tti_tx + 16, 3, 0, 1000, false) == nullptr);
+
+    // UL: softbuffer bound on new tx and released on CRC OK
+    srsran_softbuffer_rx_t* rx = cc.get_rx_softbuffer(tti_tx, 500, true);
+    TESTASSERT(rx != nullptr);
+    TESTASSERT(cc.get_rx_softbuffer(tti_tx + SRSRAN_FDD_NOF_HARQ, 500, false) == rx);
+    cc.release_rx_softbuffer(tti_tx + SRSRAN_FDD_NOF_HARQ);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_rx_used == 0);
+
+    // Stale HARQ processes return their softbuffers to the pool
+    TESTASSERT(cc.get_tx_softbuffer(tti_tx, 1, 0, 1000, true) != nullptr);
+    TESTASSERT(cc.get_rx_softbuffer(tti_tx, 500, true) != nullptr);
+    cc.clear_old_softbuffers(tti_tx + 1);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_tx_used == 1 and metrics.nof_rx_used == 1);
+    cc.clear_old_softbuffers(tti_tx + 1000);
+    pool.get_metrics(metrics);
+    TESTASSERT(metrics.nof_tx_used == 0 and metrics.nof_rx_used == 0);
+
+    // Softbuffers still bound are returned when the UE carrier is removed
+    TESTASSERT(cc.get_tx_softbuffer(tti_tx, 2, 1, 1000, true) != nullptr);
+  }
+  pool.get_metrics(metrics);
+  TESTASSERT(metrics.nof_tx_used == 0);
+}
+
+} // namespace srsenb
+
+int main()
+{
+  srslog::init();
+
+  srsenb::test_softbuffer_size_classes();
+  srsenb::test_softbuffer_pool_exhaustion();
+  srsenb::test_ue_harq_softbuffer_binding();
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,519 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/stack/rrc/rrc.h"
+#include "srsenb/hdr/stack/s1ap/s1ap.h"
+#include "srsenb/test/rrc/test_helpers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+
+/*
+ * Attach-storm benchmark of the eNB control plane. A batch of synthetic UEs is attached at once, as happens after a
+ * cell restart, by feeding canned UE messages to srsenb::rrc and driving srsenb::s1ap against a local MME stand-in.
+ * Each UE goes through RRC connection establishment, S1AP initial context setup, security mode, UE capability
+ * enquiry, RRC reconfiguration with E-RAB setup and, at the end of the batch, UE context release.
+ *
+ * Only the time spent inside the eNB RRC/S1AP handlers is accounted per procedure; the work of the MME stand-in is
+ * excluded. The benchmark reports the attach rate and the latency percentiles of each procedure.
+ */
+
+using namespace asn1::s1ap;
+
+namespace {
+
+struct bench_params {
+  uint32_t    nof_ues     = 100;
+  uint32_t    nof_batches = 5;
+  std::string mme_addr    = "127.0.1.1";
+  std::string enb_addr    = "127.0.1.100";
+};
+
+enum class proc_type {
+  rrc_conn_setup,
+  initial_ue_msg,
+  init_ctxt_setup,
+  security_mode,
+  ue_cap_enquiry,
+  rrc_reconf,
+  ue_ctxt_release,
+  nof_procs
+};
+
+const char* to_string(proc_type p)
+{
+  static const char* names[] = {"RRCConnectionSetup",
+                                "InitialUEMessage",
+                                "InitialContextSetup",
+                                "SecurityModeCommand",
+                                "UECapabilityEnquiry",
+                                "RRCReconfiguration",
+                                "UEContextRelease"};
+  return names[(size_t)p];
+}
+
+/// Collects the duration of each procedure step, in nanoseconds
+class proc_latency_stats
+{
+public:
+  using clock = std::chrono::high_resolution_clock;
+
+  template <typename Func>
+  void measure(proc_type p, const Func& f)
+  {
+    auto tp = clock::now();
+    f();
+    samples[(size_t)p].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - tp).count());
+  }
+
+  uint64_t total_ns() const
+  {
+    uint64_t sum = 0;
+    for (const auto& s : samples) {
+      for (uint64_t v : s) {
+        sum += v;
+      }
+    }
+    return sum;
+  }
+
+  void print(uint32_t nof_attaches, double wall_time_sec)
+  {
+    fmt::print("{:<22} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+               "Procedure",
+               "count",
+               "mean[us]",
+               "p50[us]",
+               "p90[us]",
+               "p99[us]",
+               "max[us]");
+    for (size_t i = 0; i < samples.size(); ++i) {
+      std::vector<uint64_t>& s = samples[i];
+      if (s.empty()) {
+        continue;
+      }
+      std::sort(s.begin(), s.end());
+      double mean = 0;
+      for (uint64_t v : s) {
+        mean += v;
+      }
+      mean /= s.size();
+      fmt::print("{:<22} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n",
+                 to_string((proc_type)i),
+                 s.size(),
+                 mean / 1000.0,
+                 percentile(s, 0.5) / 1000.0,
+                 percentile(s, 0.9) / 1000.0,
+                 percentile(s, 0.99) / 1000.0,
+                 s.back() / 1000.0);
+    }
+    double cp_time_sec = total_ns() / 1e9;
+    fmt::print("Attaches: {}, control-plane processing time: {:.3f} s, wall time: {:.3f} s\n",
+               nof_attaches,
+               cp_time_sec,
+               wall_time_sec);
+    fmt::print("Attach rate: {:.1f} attaches/s (control-plane time), {:.1f} attaches/s (wall time)\n",
+               cp_time_sec > 0 ? nof_attaches / cp_time_sec : 0,
+               wall_time_sec > 0 ? nof_attaches / wall_time_sec : 0);
+  }
+
+private:
+  static double percentile(const std::vector<uint64_t>& sorted, double q)
+  {
+    size_t idx = std::min((size_t)(q * sorted.size()), sorted.size() - 1);
+    return sorted[idx];
+  }
+
+  std::array<std::vector<uint64_t>, (size_t)proc_type::nof_procs> samples;
+};
+
+/// MME stand-in. It accepts the eNB SCTP association and answers the S1AP procedures of the attach
+struct mme_standin {
+  explicit mme_standin(const char* addr_str)
+  {
+    using namespace srsran::net_utils;
+    srsran::net_utils::set_sockaddr(&mme_sockaddr, addr_str, MME_PORT);
+    fd = open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP);
+    srsran_assert(fd > 0, "Failed to open MME stand-in socket");
+    srsran_assert(bind_addr(fd, mme_sockaddr), "Failed to bind MME stand-in socket to %s", addr_str);
+    srsran_assert(listen(fd, SOMAXCONN) == 0, "Failed to listen to incoming SCTP connections");
+
+    // Do not block forever if the eNB does not send an expected message
+    timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  }
+  mme_standin(const mme_standin&) = delete;
+  mme_standin& operator=(const mme_standin&) = delete;
+  ~mme_standin()
+  {
+    if (fd > 0) {
+      close(fd);
+    }
+  }
+
+  /// Reads eNB messages until one with the given type and procedure code is found
+  bool read_until(s1ap_pdu_c::types_opts::options type, uint16_t proc_code, s1ap_pdu_c& pdu)
+  {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    while (true) {
+      sctp_sndrcvinfo sri   = {};
+      int             flags = 0;
+      ssize_t         n     = sctp_recvmsg(fd, sdu->msg, sdu->get_tailroom(), nullptr, nullptr, &sri, &flags);
+      if (n <= 0) {
+        return false;
+      }
+      if ((flags & MSG_NOTIFICATION) != 0) {
+        continue;
+      }
+      asn1::cbit_ref bref(sdu->msg, n);
+      if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+        return false;
+      }
+      if (pdu.type().value == type and get_proc_code(pdu) == proc_code) {
+        return true;
+      }
+    }
+  }
+
+  static uint16_t get_proc_code(const s1ap_pdu_c& pdu)
+  {
+    switch (pdu.type().value) {
+      case s1ap_pdu_c::types_opts::init_msg:
+        return pdu.init_msg().proc_code;
+      case s1ap_pdu_c::types_opts::successful_outcome:
+        return pdu.successful_outcome().proc_code;
+      case s1ap_pdu_c::types_opts::unsuccessful_outcome:
+        return pdu.unsuccessful_outcome().proc_code;
+      default:
+        break;
+    }
+    return 0;
+  }
+
+  static const int   MME_PORT = 36412;
+  struct sockaddr_in mme_sockaddr = {};
+  int                fd           = -1;
+};
+
+struct dummy_socket_manager : public srsran::socket_manager_itf {
+  dummy_socket_manager() : srsran::socket_manager_itf(srslog::fetch_basic_logger("TEST")) {}
+
+  bool add_socket_handler(int fd, recv_callback_t handler) final { return true; }
+  bool remove_socket(int fd) final { return true; }
+};
+
+const uint8_t s1_setup_resp[] = {0x20, 0x11, 0x00, 0x25, 0x00, 0x00, 0x03, 0x00, 0x3d, 0x40, 0x0a, 0x03, 0x80, 0x73,
+                                 0x72, 0x73, 0x6d, 0x6d, 0x65, 0x30, 0x31, 0x00, 0x69, 0x00, 0x0b, 0x00, 0x00, 0x00,
+                                 0xf1, 0x10, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1a, 0x00, 0x57, 0x40, 0x01, 0xff};
+
+/// Canned UE messages, as used by test_helpers::bring_rrc_to_reconf_state
+const uint8_t rrc_conn_request[] = {0x40, 0x12, 0xf6, 0xfb, 0xe2, 0xc6};
+
+const uint8_t rrc_conn_setup_complete[] = {0x20, 0x00, 0x40, 0x2e, 0x90, 0x50, 0x49, 0xe8, 0x06, 0x0e, 0x82, 0xa2,
+                                           0x17, 0xec, 0x13, 0xe2, 0x0f, 0x00, 0x02, 0x02, 0x5e, 0xdf, 0x7c, 0x58,
+                                           0x05, 0xc0, 0xc0, 0x00, 0x08, 0x04, 0x03, 0xa0, 0x23, 0x23, 0xc0};
+
+const uint8_t sec_mode_complete[] = {0x28, 0x00};
+
+const uint8_t ue_cap_info[] = {0x38, 0x01, 0x01, 0x0c, 0x98, 0x00, 0x00, 0x18, 0x00, 0x0f,
+                               0x30, 0x20, 0x80, 0x00, 0x01, 0x00, 0x0e, 0x01, 0x00, 0x00};
+
+const uint8_t rrc_conn_reconf_complete[] = {0x10, 0x00};
+
+const uint8_t s1ap_init_ctxt_setup_req[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+struct bench_ue {
+  uint16_t rnti           = SRSRAN_INVALID_RNTI;
+  uint32_t enb_ue_s1ap_id = 0;
+  uint32_t mme_ue_s1ap_id = 0;
+};
+
+class attach_storm_bench
+{
+public:
+  explicit attach_storm_bench(const bench_params& params_) :
+    params(params_),
+    s1ap_obj(&task_sched, srslog::fetch_basic_logger("S1AP"), &rx_sockets),
+    mme(params.mme_addr.c_str())
+  {}
+
+  int init()
+  {
+    srsenb::all_args_t args;
+    TESTASSERT(test_helpers::parse_default_cfg(&rrc_cfg, args) == SRSRAN_SUCCESS);
+
+    srsenb::s1ap_args_t s1ap_args = args.stack.s1ap;
+    s1ap_args.enb_id              = 0x19B;
+    s1ap_args.cell_id             = 0x01;
+    s1ap_args.tac                 = 7;
+    s1ap_args.s1c_bind_addr       = params.enb_addr;
+    s1ap_args.gtp_bind_addr       = params.enb_addr;
+    s1ap_args.mme_addr            = params.mme_addr;
+    s1ap_args.enb_name            = "srsenb01";
+
+    TESTASSERT(rrc.init(rrc_cfg, &phy, &mac, &rlc, &pdcp, &s1ap_obj, &gtpu) == SRSRAN_SUCCESS);
+    TESTASSERT(s1ap_obj.init(s1ap_args, &rrc) == SRSRAN_SUCCESS);
+    // The SCTP association is established in the background
+    task_sched.run_next_task();
+
+    // S1 Setup
+    s1ap_pdu_c pdu;
+    TESTASSERT(mme.read_until(s1ap_pdu_c::types_opts::init_msg, ASN1_S1AP_ID_S1_SETUP, pdu));
+    srsran::unique_byte_buffer_t sdu;
+    srsran::copy_msg_to_buffer(sdu, s1_setup_resp);
+    TESTASSERT(s1ap_obj.handle_mme_rx_msg(std::move(sdu), mme.mme_sockaddr, {}, 0));
+    TESTASSERT(s1ap_obj.is_mme_connected());
+    return SRSRAN_SUCCESS;
+  }
+
+  int run()
+  {
+    std::vector<bench_ue> ues(params.nof_ues);
+    auto                  tp = proc_latency_stats::clock::now();
+    for (uint32_t b = 0; b < params.nof_batches; ++b) {
+      for (uint32_t i = 0; i < params.nof_ues; ++i) {
+        ues[i]      = {};
+        ues[i].rnti = 0x46 + i;
+      }
+      TESTASSERT(run_batch(ues) == SRSRAN_SUCCESS);
+    }
+    double wall_time_sec =
+        std::chrono::duration_cast<std::chrono::microseconds>(proc_latency_stats::clock::now() - tp).count() / 1e6;
+    stats.print(params.nof_ues * params.nof_batches, wall_time_sec);
+    return SRSRAN_SUCCESS;
+  }
+
+private:
+  /// All the UEs of a batch go through each attach step before the next step starts, as in an attach storm
+  int run_batch(std::vector<bench_ue>& ues)
+  {
+    s1ap_pdu_c pdu;
+
+    // RRC Connection Request -> RRC Connection Setup
+    for (bench_ue& ue : ues) {
+      sched_interface::ue_cfg_t ue_cfg = {};
+      ue_cfg.supported_cc_list.resize(1);
+      ue_cfg.supported_cc_list[0].active     = true;
+      ue_cfg.supported_cc_list[0].enb_cc_idx = 0;
+      stats.measure(proc_type::rrc_conn_setup, [&]() {
+        rrc.add_user(ue.rnti, ue_cfg);
+        write_ue_pdu(ue.rnti, 0, rrc_conn_request);
+      });
+    }
+    step_ttis(1);
+
+    // RRC Connection Setup Complete -> S1AP Initial UE Message
+    for (bench_ue& ue : ues) {
+      stats.measure(proc_type::initial_ue_msg, [&]() { write_ue_pdu(ue.rnti, 1, rrc_conn_setup_complete); });
+      if (not mme.read_until(s1ap_pdu_c::types_opts::init_msg, ASN1_S1AP_ID_INIT_UE_MSG, pdu)) {
+        fprintf(stderr, "No Initial UE Message received for rnti=0x%x. Too many UEs for the cell?\n", ue.rnti);
+        return SRSRAN_ERROR;
+      }
+      ue.enb_ue_s1ap_id = pdu.init_msg().value.init_ue_msg()->enb_ue_s1ap_id.value.value;
+      ue.mme_ue_s1ap_id = next_mme_ue_s1ap_id++;
+    }
+    step_ttis(1);
+
+    // S1AP Initial Context Setup Request -> E-RAB setup, RRC Security Mode Command
+    s1ap_pdu_c     icsr;
+    asn1::cbit_ref bref(s1ap_init_ctxt_setup_req, sizeof(s1ap_init_ctxt_setup_req));
+    TESTASSERT(icsr.unpack(bref) == asn1::SRSASN_SUCCESS);
+    for (bench_ue& ue : ues) {
+      auto& req                        = icsr.init_msg().value.init_context_setup_request();
+      req->mme_ue_s1ap_id.value        = ue.mme_ue_s1ap_id;
+      req->enb_ue_s1ap_id.value        = ue.enb_ue_s1ap_id;
+      srsran::unique_byte_buffer_t sdu = pack_pdu(icsr);
+      TESTASSERT(sdu != nullptr);
+      stats.measure(proc_type::init_ctxt_setup, [&]() {
+        s1ap_obj.handle_mme_rx_msg(std::move(sdu), mme.mme_sockaddr, {}, 0);
+        rrc.tti_clock();
+      });
+    }
+    step_ttis(1);
+
+    // RRC Security Mode Complete -> RRC UE Capability Enquiry
+    for (bench_ue& ue : ues) {
+      stats.measure(proc_type::security_mode, [&]() { write_ue_pdu(ue.rnti, 1, sec_mode_complete); });
+    }
+    step_ttis(1);
+
+    // RRC UE Capability Information -> RRC Connection Reconfiguration, S1AP UE Capability Info Indication
+    for (bench_ue& ue : ues) {
+      stats.measure(proc_type::ue_cap_enquiry, [&]() { write_ue_pdu(ue.rnti, 1, ue_cap_info); });
+      TESTASSERT(mme.read_until(s1ap_pdu_c::types_opts::init_msg, ASN1_S1AP_ID_UE_CAP_INFO_IND, pdu));
+    }
+    step_ttis(1);
+
+    // RRC Connection Reconfiguration Complete -> S1AP Initial Context Setup Response
+    for (bench_ue& ue : ues) {
+      stats.measure(proc_type::rrc_reconf, [&]() { write_ue_pdu(ue.rnti, 1, rrc_conn_reconf_complete); });
+      TESTASSERT(mme.read_until(s1ap_pdu_c::types_opts::successful_outcome, ASN1_S1AP_ID_INIT_CONTEXT_SETUP, pdu));
+      const auto& resp = pdu.successful_outcome().value.init_context_setup_resp();
+      TESTASSERT(not resp->erab_failed_to_setup_list_ctxt_su_res_present);
+    }
+    step_ttis(1);
+
+    // S1AP UE Context Release Command -> S1AP UE Context Release Complete, RRC Connection Release
+    s1ap_pdu_c rel_cmd;
+    rel_cmd.set_init_msg().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE);
+    auto& rel                        = rel_cmd.init_msg().value.ue_context_release_cmd();
+    rel->cause.value.set_nas().value = cause_nas_opts::normal_release;
+    ue_s1ap_id_pair_s& id_pair       = rel->ue_s1ap_ids.value.set_ue_s1ap_id_pair();
+    for (bench_ue& ue : ues) {
+      id_pair.mme_ue_s1ap_id           = ue.mme_ue_s1ap_id;
+      id_pair.enb_ue_s1ap_id           = ue.enb_ue_s1ap_id;
+      srsran::unique_byte_buffer_t sdu = pack_pdu(rel_cmd);
+      TESTASSERT(sdu != nullptr);
+      stats.measure(proc_type::ue_ctxt_release, [&]() {
+        s1ap_obj.handle_mme_rx_msg(std::move(sdu), mme.mme_sockaddr, {}, 0);
+        rrc.tti_clock();
+      });
+      TESTASSERT(mme.read_until(s1ap_pdu_c::types_opts::successful_outcome, ASN1_S1AP_ID_UE_CONTEXT_RELEASE, pdu));
+    }
+
+    // Let RRC remove the released UEs
+    step_ttis(100);
+    TESTASSERT(rrc.get_nof_users() == 0);
+    return SRSRAN_SUCCESS;
+  }
+
+  void write_ue_pdu(uint16_t rnti, uint32_t lcid, srsran::const_byte_span msg)
+  {
+    srsran::unique_byte_buffer_t pdu;
+    srsran::copy_msg_to_buffer(pdu, msg);
+    rrc.write_pdu(rnti, lcid, std::move(pdu));
+    rrc.tti_clock();
+  }
+
+  void step_ttis(uint32_t nof_ttis)
+  {
+    for (uint32_t i = 0; i < nof_ttis; ++i) {
+      task_sched.tic();
+      rrc.tti_clock();
+    }
+  }
+
+  static srsran::unique_byte_buffer_t pack_pdu(const s1ap_pdu_c& pdu)
+  {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    if (sdu == nullptr) {
+      return nullptr;
+    }
+    asn1::bit_ref bref(sdu->msg, sdu->get_tailroom());
+    if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+      return nullptr;
+    }
+    sdu->N_bytes = bref.distance_bytes();
+    return sdu;
+  }
+
+  bench_params params;
+
+  srsran::task_scheduler     task_sched;
+  dummy_socket_manager       rx_sockets;
+  srsenb::rrc_cfg_t          rrc_cfg;
+  srsenb::enb_bearer_manager bearers;
+  srsenb::rrc                rrc{&task_sched, bearers};
+  srsenb::s1ap               s1ap_obj;
+  mac_dummy                  mac;
+  rlc_dummy                  rlc;
+  pdcp_dummy                 pdcp;
+  phy_dummy                  phy;
+  gtpu_dummy                 gtpu;
+  mme_standin                mme;
+
+  proc_latency_stats stats;
+  uint32_t           next_mme_ue_s1ap_id = 1;
+};
+
+void usage(char* prog)
+{
+  printf("Usage: %s -i repository_dir [u] [n] [m] [e]\n", prog);
+  printf("\t-u number of UEs attaching in each batch\n");
+  printf("\t-n number of batches\n");
+  printf("\t-m MME stand-in address\n");
+  printf("\t-e eNB S1-C bind address\n");
+}
+
+void parse_args(bench_params& params, int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "i:u:n:m:e:")) != -1) {
+    switch (opt) {
+      case 'i':
+        argparse::repository_dir = optarg;
+        break;
+      case 'u':
+        params.nof_ues = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'n':
+        params.nof_batches = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'm':
+        params.mme_addr = optarg;
+        break;
+      case 'e':
+        params.enb_addr = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (argparse::repository_dir.empty()) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bench_params params;
+  parse_args(params, argc, argv);
+
+  srslog::fetch_basic_logger("RRC", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("S1AP", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  std::unique_ptr<attach_storm_bench> bench(new attach_storm_bench(params));
+  TESTASSERT(bench->init() == SRSRAN_SUCCESS);
+  TESTASSERT(bench->run() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
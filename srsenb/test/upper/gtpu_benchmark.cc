@@ -0,0 +1,242 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/gtpu.h"
+#include "srsenb/test/common/dummy_classes_common.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <chrono>
+#include <getopt.h>
+#include <linux/ip.h>
+#include <random>
+
+/*
+ * Benchmark of the S1-U Rx path of the eNB GTP-U, with G-PDUs spread randomly over all the tunnels.
+ * Packets are encoded in batches outside of the measured time.
+ */
+
+namespace srsenb {
+
+uint32_t nof_packets = 1000000;
+uint32_t nof_ues     = 100;
+uint32_t batch_size  = 512;
+
+const uint32_t nof_bearers_per_ue = 10;
+const uint32_t first_bearer_id    = 5;
+
+class pdcp_sink : public pdcp_dummy
+{
+public:
+  void write_sdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu, int pdcp_sn) override
+  {
+    nof_sdus++;
+    nof_bytes += sdu->N_bytes;
+    // SDUs are released outside of the measured time
+    sdus.push_back(std::move(sdu));
+  }
+  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
+  {
+    return {};
+  }
+
+  std::vector<srsran::unique_byte_buffer_t> sdus;
+  uint64_t                                  nof_sdus  = 0;
+  uint64_t                                  nof_bytes = 0;
+};
+
+struct dummy_socket_manager : public srsran::socket_manager_itf {
+  dummy_socket_manager() : srsran::socket_manager_itf(srslog::fetch_basic_logger("TEST")) {}
+  bool add_socket_handler(int fd, recv_callback_t handler) final { return true; }
+  bool remove_socket(int fd) final { return true; }
+};
+
+srsran::unique_byte_buffer_t encode_gpdu(uint32_t teid, uint32_t payload_len)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    return pdu;
+  }
+  struct iphdr ip_pkt = {};
+  ip_pkt.version      = 4;
+  ip_pkt.ihl          = 5;
+  ip_pkt.tot_len      = htons(payload_len + sizeof(struct iphdr));
+  pdu->append_bytes((uint8_t*)&ip_pkt, sizeof(struct iphdr));
+  memset(pdu->msg + pdu->N_bytes, 0xab, payload_len);
+  pdu->N_bytes += payload_len;
+
+  srsran::gtpu_header_t header = {};
+  header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  header.message_type          = GTPU_MSG_DATA_PDU;
+  header.length                = pdu->N_bytes;
+  header.teid                  = teid;
+  gtpu_write_header(&header, pdu.get(), srslog::fetch_basic_logger("GTPU"));
+  return pdu;
+}
+
+void print_result(const char* name, uint64_t count, std::chrono::nanoseconds time)
+{
+  double secs = std::chrono::duration<double>(time).count();
+  fmt::print("{:<12} {:>8} in {:>7.3f} s | {:>6.1f} ns/packet\n", name, count, secs, secs * 1e9 / count);
+}
+
+int run_benchmark()
+{
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  pdcp_sink              pdcp;
+  gtpu_args_t            gtpu_args = {};
+  gtpu_args.gtp_bind_addr          = "127.0.3.1";
+  gtpu_args.mme_addr               = "127.0.3.100";
+
+  gtpu enb_gtpu(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte, &rx_sockets);
+  TESTASSERT(enb_gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+
+  // Create one tunnel per UE bearer
+  std::vector<uint32_t> teids;
+  uint32_t              addr_in = 0;
+  for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+    for (uint32_t bearer = 0; bearer < nof_bearers_per_ue; ++bearer) {
+      srsran::expected<uint32_t> teid =
+          enb_gtpu.add_bearer(0x46 + ue, first_bearer_id + bearer, 0x7f000301, teids.size() + 1, addr_in);
+      TESTASSERT(teid.has_value());
+      teids.push_back(teid.value());
+    }
+  }
+
+  // Replace a fraction of the tunnels, so that the table contains reused slots
+  for (uint32_t ue = 0; ue < nof_ues; ue += 4) {
+    enb_gtpu.rem_user(0x46 + ue);
+    for (uint32_t bearer = 0; bearer < nof_bearers_per_ue; ++bearer) {
+      srsran::expected<uint32_t> teid =
+          enb_gtpu.add_bearer(0x46 + ue, first_bearer_id + bearer, 0x7f000301, bearer + 1, addr_in);
+      TESTASSERT(teid.has_value());
+      teids[ue * nof_bearers_per_ue + bearer] = teid.value();
+    }
+  }
+
+  std::mt19937                              rng(0);
+  std::uniform_int_distribution<uint32_t>   tun_dist(0, teids.size() - 1);
+  std::vector<srsran::unique_byte_buffer_t> batch;
+  std::chrono::nanoseconds                  rx_time{0};
+  sockaddr_in                               sgw_addr = {};
+  for (uint32_t start = 0; start < nof_packets; start += batch_size) {
+    batch.clear();
+    for (uint32_t i = start; i < std::min(start + batch_size, nof_packets); ++i) {
+      batch.push_back(encode_gpdu(teids[tun_dist(rng)], 100));
+      TESTASSERT(batch.back() != nullptr);
+    }
+
+    auto t_start = std::chrono::steady_clock::now();
+    for (srsran::unique_byte_buffer_t& pdu : batch) {
+      enb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_addr);
+    }
+    rx_time += std::chrono::steady_clock::now() - t_start;
+    pdcp.sdus.clear();
+  }
+  TESTASSERT(pdcp.nof_sdus == nof_packets);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().fast_path == nof_packets);
+
+  // Tunnel lookups alone, including TEIDs of removed tunnels
+  gtpu_tunnel_manager tunnels(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte);
+  tunnels.init(gtpu_args, &pdcp);
+  std::vector<uint32_t> lookup_teids;
+  for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+    for (uint32_t bearer = 0; bearer < nof_bearers_per_ue; ++bearer) {
+      const gtpu_tunnel* tun = tunnels.add_tunnel(0x46 + ue, first_bearer_id + bearer, bearer + 1, 0x7f000301);
+      TESTASSERT(tun != nullptr);
+      lookup_teids.push_back(tun->teid_in);
+    }
+  }
+  std::vector<uint32_t> stale_teids;
+  for (uint32_t i = 0; i < lookup_teids.size(); i += 8) {
+    const gtpu_tunnel* old_tun       = tunnels.find_tunnel(lookup_teids[i]);
+    uint16_t           rnti          = old_tun->rnti;
+    uint32_t           eps_bearer_id = old_tun->eps_bearer_id;
+    TESTASSERT(tunnels.remove_tunnel(lookup_teids[i]));
+    const gtpu_tunnel* new_tun = tunnels.add_tunnel(rnti, eps_bearer_id, 1, 0x7f000301);
+    TESTASSERT(new_tun != nullptr);
+    stale_teids.push_back(lookup_teids[i]);
+    lookup_teids[i] = new_tun->teid_in;
+  }
+  lookup_teids.insert(lookup_teids.end(), stale_teids.begin(), stale_teids.end());
+  std::shuffle(lookup_teids.begin(), lookup_teids.end(), rng);
+  uint64_t nof_found = 0;
+  auto     t_start   = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_packets; ++i) {
+    nof_found += tunnels.find_tunnel(lookup_teids[i % lookup_teids.size()]) != nullptr;
+  }
+  std::chrono::nanoseconds lookup_time = std::chrono::steady_clock::now() - t_start;
+  TESTASSERT(nof_found > 0 and nof_found < nof_packets);
+
+  fmt::print("{} tunnels, {} packets of {} bytes\n", teids.size(), nof_packets, 100 + sizeof(struct iphdr));
+  print_result("S1-U Rx", nof_packets, rx_time);
+  print_result("TEID lookup", nof_packets, lookup_time);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nub]\n", prog);
+  printf("\t-n number of packets [Default %d]\n", srsenb::nof_packets);
+  printf("\t-u number of UEs with %d tunnels each [Default %d]\n", srsenb::nof_bearers_per_ue, srsenb::nof_ues);
+  printf("\t-b batch size [Default %d]\n", srsenb::batch_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n:u:b:")) != -1) {
+    switch (opt) {
+      case 'n':
+        srsenb::nof_packets = (uint32_t)strtol(argv[optind - 1], nullptr, 10);
+        break;
+      case 'u':
+        srsenb::nof_ues = std::min(std::max(1L, strtol(argv[optind - 1], nullptr, 10)), 100L);
+        break;
+      case 'b':
+        srsenb::batch_size = std::max(1L, strtol(argv[optind - 1], nullptr, 10));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("TEST", false).set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("COMN", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -213,6 +213,88 @@ void test_gtpu_tunnel_manager()
   tunnels.remove_tunnel(before_tun->teid_in);
   TESTASSERT(tunnels.find_rnti_bearer_tunnels(0x46, drb1_eps_bearer_id).size() == 1);
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
+
+  // TEST: The TEID of a removed tunnel is not resolved, even once its slot is reused by other tunnels
+  uint32_t old_teid = after_tun->teid_in;
+  TESTASSERT(tunnels.remove_tunnel(old_teid));
+  TESTASSERT(tunnels.find_tunnel(old_teid) == nullptr);
+  for (uint32_t i = 0; i < 2000; ++i) {
+    const gtpu_tunnel* new_tun = tunnels.add_tunnel(0x48, drb1_eps_bearer_id, 9, sgw_addr);
+    TESTASSERT(new_tun != nullptr);
+    TESTASSERT(new_tun->teid_in != old_teid and new_tun->teid_in != 0);
+    TESTASSERT(tunnels.find_tunnel(old_teid) == nullptr);
+    TESTASSERT(tunnels.remove_tunnel(new_tun->teid_in));
+  }
+}
+
+void test_gtpu_rx_fast_path()
+{
+  const char *       sgw_addr_str = "127.0.0.1", *enb_addr_str = "127.0.4.1";
+  struct sockaddr_in sgw_sockaddr = {}, enb_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  srsran::net_utils::set_sockaddr(&enb_sockaddr, enb_addr_str, GTPU_PORT);
+  uint32_t sgw_addr = ntohl(sgw_sockaddr.sin_addr.s_addr);
+
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("GTPU");
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  pdcp_tester            pdcp;
+  srsenb::gtpu           enb_gtpu(&task_sched, logger, srsran::srsran_rat_t::lte, &rx_sockets);
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr = enb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  TESTASSERT(enb_gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  uint32_t teid_in = enb_gtpu.add_bearer(0x46, 5, sgw_addr, 1, addr_in).value();
+
+  std::vector<uint8_t> data_vec(10);
+  std::iota(data_vec.begin(), data_vec.end(), 0);
+
+  // TEST: G-PDU without optional fields is delivered to PDCP by the fast path
+  enb_gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data_vec, teid_in, sgw_sockaddr, enb_sockaddr), sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().fast_path == 1);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().slow_path == 0);
+  TESTASSERT(pdcp.last_sdu != nullptr and pdcp.last_sdu->N_bytes == PDU_HEADER_SIZE + data_vec.size());
+  TESTASSERT(std::equal(data_vec.begin(), data_vec.end(), pdcp.last_sdu->msg + PDU_HEADER_SIZE));
+  TESTASSERT(pdcp.last_pdcp_sn == -1 and pdcp.last_rnti == 0x46 and pdcp.last_eps_bearer_id == 5);
+
+  // TEST: G-PDU with a PDCP PDU number is delivered to PDCP by the fast path, with its PDCP SN
+  pdcp.clear();
+  srsran::unique_byte_buffer_t pdu    = encode_ipv4_packet(data_vec, teid_in, sgw_sockaddr, enb_sockaddr);
+  srsran::gtpu_header_t        header = {};
+  header.flags             = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL | GTPU_FLAGS_EXTENDED_HDR;
+  header.message_type      = GTPU_MSG_DATA_PDU;
+  header.length            = pdu->N_bytes;
+  header.teid              = teid_in;
+  header.next_ext_hdr_type = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
+  header.ext_buffer        = {0x01, 0x01, 0x02, 0x00};
+  gtpu_write_header(&header, pdu.get(), logger);
+  enb_gtpu.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().fast_path == 2);
+  TESTASSERT(pdcp.last_sdu != nullptr and pdcp.last_sdu->N_bytes == PDU_HEADER_SIZE + data_vec.size());
+  TESTASSERT(pdcp.last_pdcp_sn == 0x102);
+
+  // TEST: G-PDUs to unknown TEIDs, or to tunnels that are buffering, take the generic path
+  pdcp.clear();
+  enb_gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data_vec, teid_in + 1, sgw_sockaddr, enb_sockaddr),
+                                     sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().slow_path == 1);
+  TESTASSERT(pdcp.last_sdu == nullptr);
+  enb_gtpu.set_tunnel_status(teid_in, false);
+  enb_gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data_vec, teid_in, sgw_sockaddr, enb_sockaddr), sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().slow_path == 2);
+  TESTASSERT(pdcp.last_sdu == nullptr);
+  enb_gtpu.set_tunnel_status(teid_in, true);
+  TESTASSERT(pdcp.last_sdu != nullptr and pdcp.last_sdu->N_bytes == PDU_HEADER_SIZE + data_vec.size());
+
+  // TEST: End markers take the generic path and remove the tunnel
+  enb_gtpu.handle_gtpu_s1u_rx_packet(encode_end_marker(teid_in), sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().fast_path == 2);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().slow_path == 3);
+  pdcp.clear();
+  enb_gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data_vec, teid_in, sgw_sockaddr, enb_sockaddr), sgw_sockaddr);
+  TESTASSERT(enb_gtpu.get_rx_path_counters().slow_path == 4);
+  TESTASSERT(pdcp.last_sdu == nullptr);
 }
 
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
@@ -395,6 +477,7 @@ int main(int argc, char** argv)
   srsran::test_init(argc, argv);
 
   srsenb::test_gtpu_tunnel_manager();
+  srsenb::test_gtpu_rx_fast_path();
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::success) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
@@ -25,6 +25,7 @@
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/srsran.h"
+#include <vector>
 
 namespace srsue {
 namespace nr {
@@ -33,7 +34,8 @@ class cell_search
 public:
   struct args_t {
     double                      max_srate_hz;
-    srsran_subcarrier_spacing_t ssb_min_scs = srsran_subcarrier_spacing_15kHz;
+    srsran_subcarrier_spacing_t ssb_min_scs     = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    max_sweep_freqs = 16; ///< SSB frequencies correlated at once when sweeping
   };
 
   struct cfg_t {
@@ -43,11 +45,13 @@ public:
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
+    std::vector<double>         ssb_freqs_hz; ///< Optional SSB frequencies swept in every slot instead of ssb_freq_hz
   };
 
   struct ret_t {
     enum { CELL_FOUND = 1, CELL_NOT_FOUND = 0, ERROR = -1 } result;
     srsran_ssb_search_res_t ssb_res;
+    double                  ssb_freq_hz; ///< SSB center frequency of the found cell
   };
 
   cell_search(srslog::basic_logger& logger);
@@ -59,8 +63,12 @@ public:
   ret_t run_slot(const cf_t* buffer, uint32_t slot_sz);
 
 private:
-  srslog::basic_logger&        logger;
-  srsran_ssb_t                 ssb    = {};
+  ret_t run_sweep(const cf_t* buffer, uint32_t slot_sz);
+
+  srslog::basic_logger&                logger;
+  srsran_ssb_t                         ssb = {};
+  std::vector<double>                  sweep_freqs_hz;
+  std::vector<srsran_ssb_search_res_t> sweep_res;
 };
 } // namespace nr
 } // namespace srsue
@@ -21,11 +21,11 @@
 #ifndef SRSUE_INTRA_MEASURE_BASE_H
 #define SRSUE_INTRA_MEASURE_BASE_H
 
+#include "intra_measure_pool.h"
 #include "srsran/interfaces/ue_phy_interfaces.h"
 #include <condition_variable>
 #include <mutex>
 #include <srsran/common/common.h>
-#include <srsran/common/threads.h>
 #include <srsran/common/tti_sync_cv.h>
 #include <vector>
 
@@ -35,7 +35,7 @@ namespace scell {
 /**
  * @brief Describes a generic base class to perform intra-frequency measurements
  */
-class intra_measure_base : public srsran::thread
+class intra_measure_base : private intra_measure_pool::measurer_itf
 {
   /*
    * The intra-cell measurement has 5 different states:
@@ -43,9 +43,10 @@ class intra_measure_base : public srsran::thread
    *          except quit can transition to idle.
    *  - wait: waits for the TTI trigger to transition to receive
    *  - receive: captures base-band samples for intra_freq_meas_len_ms and goes to measure.
-   *  - measure: enables the inner thread to start the measuring function. The asynchronous buffer will transition to
-   *             wait as soon as it has read the data from the buffer.
-   *  - quit: stops the inner thread and quits. Transition from any state measure state.
+   *  - measure: the captured samples are measured in place by a task of the shared measurement pool, which transitions
+   *             to wait once the measurement is complete. If the pool rejects the measurement, it transitions to wait
+   *             straight away.
+   *  - quit: stops accepting samples and measurements. Transition from any state measure state.
    *
    * FSM abstraction:
    *
@@ -53,7 +54,7 @@ class intra_measure_base : public srsran::thread
    *  | Idle | --------------------->| Wait |------------------------------>| Receive |
    *  +------+                       +------+                               +---------+
    *     ^                              ^                                        |          stop  +------+
-   *     |                  Read buffer |                                        |          ----->| Quit |
+   *     |             Measurement done |                                        |          ----->| Quit |
    *   init                        +---------+    intra_freq_meas_len_ms         |                +------+
    * meas_stop                     | Measure |<----------------------------------+
    *                               +---------+
@@ -123,9 +124,8 @@ public:
   virtual uint32_t get_earfcn() const = 0;
 
   /**
-   * @brief Synchronous wait mechanism, blocks the writer thread while it is in measure state. If the asynchronous
-   * thread is too slow, use this method for stalling the writing thread and wait the asynchronous thread to clear the
-   * buffer.
+   * @brief Synchronous wait mechanism, blocks the writer thread while it is in measure state. If the measurement pool
+   * is too slow, use this method for stalling the writing thread and wait the measurement to complete.
    */
   void wait_meas()
   { // Only used by scell_search_test
@@ -157,8 +157,9 @@ protected:
 
   /**
    * @brief Constructor is only accessible through inherited classes
+   * @param pool_ Measurement pool shared with other components, it shall outlive this component
    */
-  intra_measure_base(srslog::basic_logger& logger, meas_itf& new_cell_itf_);
+  intra_measure_base(srslog::basic_logger& logger, meas_itf& new_cell_itf_, intra_measure_pool& pool_);
 
   /**
    * @brief Destructor is only accessible through inherited classes
@@ -183,17 +184,18 @@ private:
   {
   public:
     typedef enum {
-      initial = 0, /// Initial state, it transitions to idle once the internal thread has started
-      idle,        ///< Internal thread runs, it does not capture data
+      initial = 0, /// Initial state, it transitions to idle once it has been initialised
+      idle,        ///< It does not capture data
       wait_first,  ///< Wait for the TTI trigger (if configured)
       wait,        ///< Wait for the period time to pass
-      receive,     ///< Accumulate samples in ring buffer
+      receive,     ///< Accumulate samples in the buffer
       measure,     ///< Module is busy measuring
-      quit         ///< Quit thread, no transitions are allowed
+      quit         ///< Quit, no transitions are allowed
     } state_t;
 
   private:
-    state_t                 state = initial;
+    state_t                 state     = initial;
+    bool                    measuring = false; ///< A measurement task owns the buffer
     std::mutex              mutex;
     std::condition_variable cvar;
 
@@ -220,12 +222,42 @@ private:
         state = new_state;
       }
 
-      // Notifies to the inner thread about the change of state
+      // Notifies to the waiting threads about the change of state
       cvar.notify_all();
     }
 
     /**
-     * @brief Waits for a state transition to a state different than the provided, used for blocking the inner thread
+     * @brief Sets whether a measurement task owns the buffer
+     */
+    void set_measuring(bool measuring_)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      measuring = measuring_;
+      cvar.notify_all();
+    }
+
+    /**
+     * @brief Checks whether a measurement task owns the buffer
+     */
+    bool is_measuring()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return measuring;
+    }
+
+    /**
+     * @brief Waits for the measurement task in progress, if any, to release the buffer
+     */
+    void wait_measure_finish()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (measuring) {
+        cvar.wait(lock);
+      }
+    }
+
+    /**
+     * @brief Waits for a state transition to a state different than the provided
      */
     void wait_change(state_t s)
     {
@@ -259,7 +291,7 @@ private:
   }
 
   /**
-   * @brief Writes baseband data in the internal soft-buffer
+   * @brief Writes baseband data in the internal buffer and requests the measurement once it is full
    * @param data Provides baseband data
    * @param nsamples Number of samples to write
    */
@@ -274,7 +306,7 @@ private:
   /**
    * @brief Pure virtual function to perform measurements
    * @note The context is pass-by-value to protect it from concurrency. However, the buffer is pass-by-reference
-   * as it is protected by the state.
+   * as no samples are written while it is being measured.
    * @param context Provides current measurement context
    * @param buffer Provides current measurement context
    * @param rx_gain_offset Provides last received rx_gain_offset
@@ -288,13 +320,10 @@ private:
   void measure_proc();
 
   /**
-   * @brief Internal asynchronous low priority thread, waits for measure internal state to execute the measurement
-   * process. It stops when the internal state transitions to quit.
+   * @brief Measurement task, executed by the shared pool once the buffer is full. It releases the buffer and
+   * transitions to wait when the measurement is complete.
    */
-  void run_thread() override;
-
-  ///< Internal Thread priority, low by default
-  const static int INTRA_FREQ_MEAS_PRIO = DEFAULT_PRIORITY + 5;
+  void run_measurement() override;
 
   /// Returns a copy of the current used context.
   measure_context_t get_context() const
@@ -305,12 +334,13 @@ private:
 
   internal_state        state;
   srslog::basic_logger& logger;
+  intra_measure_pool&   pool;
   mutable std::mutex    mutex;
   uint32_t              last_measure_tti = 0;
   measure_context_t     context;
 
-  std::vector<cf_t>   search_buffer;
-  srsran_ringbuffer_t ring_buffer = {};
+  std::vector<cf_t> buffer;           ///< Captured samples, measured in place
+  uint32_t          buffer_count = 0; ///< Number of samples written in the buffer
 };
 
 } // namespace scell
@@ -38,8 +38,9 @@ public:
    * @brief Constructor
    * @param logger Logging object
    * @param new_meas_itf_ Interface to report measurement to higher layers
+   * @param pool_ Measurement pool shared with other components
    */
-  intra_measure_lte(srslog::basic_logger& logger, meas_itf& new_meas_itf_);
+  intra_measure_lte(srslog::basic_logger& logger, meas_itf& new_meas_itf_, intra_measure_pool& pool_);
 
   /**
    * @brief Destructor
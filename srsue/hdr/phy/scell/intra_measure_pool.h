@@ -0,0 +1,121 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSUE_INTRA_MEASURE_POOL_H
+#define SRSUE_INTRA_MEASURE_POOL_H
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <mutex>
+
+namespace srsue {
+namespace scell {
+
+/**
+ * @brief Low priority worker pool shared by the intra-frequency measurements of all carriers and RATs
+ *
+ * Measurements are queued as tasks once their samples are captured. The CPU time they take is accounted in periods,
+ * and measurements requested after the budget of the current period is exhausted are skipped. This bounds the load of
+ * the measurements regardless of the number of configured carriers.
+ */
+class intra_measure_pool
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Interface of the objects whose measurements run in the pool
+   */
+  class measurer_itf
+  {
+  public:
+    virtual ~measurer_itf()        = default;
+    virtual void run_measurement() = 0;
+  };
+
+  struct args_t {
+    uint32_t nof_workers = 1;   ///< Number of measurement threads shared by all carriers
+    uint32_t period_ms   = 200; ///< Budget accounting period in milliseconds
+    uint32_t budget_ms   = 0;   ///< Measurement CPU time allowed per period in milliseconds, 0 for unlimited
+  };
+
+  struct metrics_t {
+    uint32_t nof_meas       = 0;    ///< Number of completed measurements
+    uint32_t nof_skipped    = 0;    ///< Number of measurements skipped for exceeding the budget
+    float    latency_avg_ms = 0.0f; ///< Average time from the end of the capture to the end of the measurement
+    float    latency_max_ms = 0.0f; ///< Maximum time from the end of the capture to the end of the measurement
+    float    exec_avg_ms    = 0.0f; ///< Average measurement execution time
+    float    exec_max_ms    = 0.0f; ///< Maximum measurement execution time
+  };
+
+  explicit intra_measure_pool(srslog::basic_logger& logger_);
+
+  /**
+   * @brief Starts the measurement workers, it can be called only once
+   * @param args Pool arguments
+   */
+  void init(const args_t& args);
+
+  /**
+   * @brief Stops the workers, pending measurements are discarded
+   * @note the measurers shall be stopped beforehand, so that none of them waits for a discarded measurement
+   */
+  void stop();
+
+  /**
+   * @brief Queues the measurement of an object unless the budget of the current period is exhausted
+   * @param m Object to measure, it shall outlive the measurement
+   * @return True if the measurement has been queued, false if it has been skipped
+   */
+  bool push_measurement(measurer_itf& m);
+
+  /**
+   * @brief Gets the measurement metrics accumulated since the previous call
+   * @return The measurement metrics
+   */
+  metrics_t get_metrics();
+
+private:
+  void account(clock::time_point        t_queued,
+               clock::time_point        t_start,
+               clock::time_point        t_end,
+               std::chrono::nanoseconds cpu_time);
+
+  ///< Workers thread priority, low by default
+  const static int INTRA_FREQ_MEAS_PRIO = DEFAULT_PRIORITY + 5;
+
+  srslog::basic_logger&    logger;
+  srsran::task_thread_pool workers;
+  args_t                   args = {};
+
+  std::mutex                mutex;
+  clock::time_point         period_start   = {};
+  std::chrono::microseconds period_spent   = {}; ///< Thread CPU time spent in the current period
+  uint32_t                  period_count   = 0;  ///< Measurements queued in the current period
+  metrics_t                 metrics        = {};
+  double                    latency_sum_ms = 0.0;
+  double                    exec_sum_ms    = 0.0;
+};
+
+} // namespace scell
+} // namespace srsue
+
+#endif // SRSUE_INTRA_MEASURE_POOL_H
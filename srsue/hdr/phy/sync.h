@@ -58,6 +58,7 @@ public:
     thread("SYNC"),
     search_p(phy_logger),
     sfn_p(phy_logger),
+    intra_meas_pool(phy_logger),
     phy_logger(phy_logger),
     phy_lib_logger(phy_lib_logger),
     sf_buffer(sync_nof_rx_subframes),
@@ -214,6 +215,7 @@ private:
   // Objects for internal use
   search                                                  search_p;
   sfn_sync                                                sfn_p;
+  scell::intra_measure_pool                               intra_meas_pool;
   std::vector<std::unique_ptr<scell::intra_measure_lte> > intra_freq_meas;
   std::mutex                                              intra_freq_cfg_mutex;
 
@@ -326,6 +326,15 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<uint32_t>(&args->phy.intra_freq_meas_period_ms)->default_value(200),
        "Period of intra-frequency neighbour cell measurement in ms. Maximum as per 3GPP is 200 ms.")
 
+    ("phy.intra_freq_meas_nof_workers",
+       bpo::value<uint32_t>(&args->phy.intra_freq_meas_nof_workers)->default_value(1),
+       "Number of low priority threads shared by the intra-frequency measurements of all carriers.")
+
+    ("phy.intra_freq_meas_budget_ms",
+       bpo::value<uint32_t>(&args->phy.intra_freq_meas_budget_ms)->default_value(100),
+       "CPU time in ms the intra-frequency measurements of all carriers can take in every measurement period. "
+       "Measurements beyond it are skipped. Set to 0 for unlimited.")
+
     ("phy.correct_sync_error",
        bpo::value<bool>(&args->phy.correct_sync_error)->default_value(false),
        "Channel estimator measures and pre-compensates time synchronization error. Increases CPU usage, improves PDSCH "
@@ -42,6 +42,7 @@ bool cell_search::init(const args_t& args)
   ssb_args.min_scs           = args.ssb_min_scs;
   ssb_args.enable_search     = true;
   ssb_args.enable_decode     = true;
+  ssb_args.max_sweep_freqs   = args.max_sweep_freqs;
 
   // Initialise SSB
   if (srsran_ssb_init(&ssb, &ssb_args) < SRSRAN_SUCCESS) {
@@ -75,12 +76,22 @@ bool cell_search::start(const cfg_t& cfg)
     logger.error("Cell search: Error setting SSB configuration");
     return false;
   }
+
+  // Prepare the sweep results, so they are not allocated in every slot
+  sweep_freqs_hz = cfg.ssb_freqs_hz;
+  sweep_res.resize(sweep_freqs_hz.size());
   return true;
 }
 
 cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
 {
+  // Sweep all the SSB frequencies if they are given
+  if (not sweep_freqs_hz.empty()) {
+    return run_sweep(buffer, slot_sz);
+  }
+
   cell_search::ret_t ret = {};
+  ret.ssb_freq_hz        = ssb.cfg.ssb_freq_hz;
 
   // Search for SSB
   if (srsran_ssb_search(&ssb, buffer, slot_sz + ssb.ssb_sz, &ret.ssb_res) < SRSRAN_SUCCESS) {
@@ -95,5 +106,35 @@ cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
   return ret;
 }
 
+cell_search::ret_t cell_search::run_sweep(const cf_t* buffer, uint32_t slot_sz)
+{
+  cell_search::ret_t ret = {};
+  ret.result             = ret_t::CELL_NOT_FOUND;
+
+  // Search for SSB in all the frequencies at once
+  if (srsran_ssb_search_sweep(&ssb,
+                              buffer,
+                              slot_sz + ssb.ssb_sz,
+                              sweep_freqs_hz.data(),
+                              (uint32_t)sweep_freqs_hz.size(),
+                              sweep_res.data()) < SRSRAN_SUCCESS) {
+    logger.error("Error occurred sweeping SSB");
+    ret.result = ret_t::ERROR;
+    return ret;
+  }
+
+  // Select the decoded SSB with the highest SNR
+  for (uint32_t i = 0; i < sweep_res.size(); i++) {
+    const srsran_ssb_search_res_t& res = sweep_res[i];
+    if (res.measurements.snr_dB >= -10.0f and res.pbch_msg.crc and
+        (ret.result != ret_t::CELL_FOUND or res.measurements.snr_dB > ret.ssb_res.measurements.snr_dB)) {
+      ret.result      = ret_t::CELL_FOUND;
+      ret.ssb_res     = res;
+      ret.ssb_freq_hz = sweep_freqs_hz[i];
+    }
+  }
+  return ret;
+}
+
 } // namespace nr
 } // namespace srsue
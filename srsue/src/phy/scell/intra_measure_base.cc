@@ -28,17 +28,23 @@
 namespace srsue {
 namespace scell {
 
-intra_measure_base::intra_measure_base(srslog::basic_logger& logger, meas_itf& new_cell_itf_) :
-  logger(logger), context(new_cell_itf_), thread("SYNC_INTRA_MEASURE")
+intra_measure_base::intra_measure_base(srslog::basic_logger& logger,
+                                       meas_itf&             new_cell_itf_,
+                                       intra_measure_pool&   pool_) :
+  logger(logger), pool(pool_), context(new_cell_itf_)
 {}
 
 intra_measure_base::~intra_measure_base()
 {
-  srsran_ringbuffer_free(&ring_buffer);
+  stop();
 }
 
 void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
 {
+  // The buffer cannot be resized while it is being measured
+  state.wait_measure_finish();
+
+  std::lock_guard<std::mutex> lock(mutex);
   context.cc_idx = cc_idx_;
 
   context.meas_len_ms        = args.len_ms;
@@ -59,38 +65,24 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
     return;
   }
 
-  // Calculate the new required bytes
-  int max_required_bytes = (int)(sizeof(cf_t) * context.meas_len_ms * context.sf_len);
-
-  // Reallocate only if the required capacity exceds the new requirement
-  if (ring_buffer.capacity < max_required_bytes) {
-    search_buffer.resize((size_t)context.meas_len_ms * (size_t)context.sf_len);
-
-    srsran_ringbuffer_free(&ring_buffer);
-
-    // Initialise buffer for the maximum number of PRB
-    if (srsran_ringbuffer_init(&ring_buffer, max_required_bytes) < SRSRAN_SUCCESS) {
-      ERROR("Error initiating ringbuffer");
-      return;
-    }
+  // Reallocate only if the required capacity exceeds the current one
+  size_t required_len = (size_t)context.meas_len_ms * (size_t)context.sf_len;
+  if (buffer.size() < required_len) {
+    buffer.resize(required_len);
   }
 
   if (state.get_state() == internal_state::initial) {
     state.set_state(internal_state::idle);
-    start(INTRA_FREQ_MEAS_PRIO);
   }
 }
 
 void intra_measure_base::stop()
 {
-  // Notify quit to asynchronous thread. If it is measuring, it will first finish the measure, report to stack and
-  // then it will finish
+  // Notify quit. If a measurement is in progress, it will first finish the measure and report to stack
   state.set_state(internal_state::quit);
 
-  // Wait for the asynchronous thread to finish
-  wait_thread_finish();
-
-  srsran_ringbuffer_stop(&ring_buffer);
+  // Wait for the measurement in progress to finish
+  state.wait_measure_finish();
 }
 
 void intra_measure_base::set_rx_gain_offset(float rx_gain_offset_db_)
@@ -101,7 +93,7 @@ void intra_measure_base::set_rx_gain_offset(float rx_gain_offset_db_)
 void intra_measure_base::meas_stop()
 {
   // Transition state to idle
-  // Ring-buffer shall not be reset, it will automatically be reset as soon as the FSM transitions to receive
+  // The buffer shall not be reset, it will automatically be reset as soon as the FSM transitions to receive
   state.set_state(internal_state::idle);
   Log(info, "Disabled neighbour cell search");
 }
@@ -117,27 +109,35 @@ void intra_measure_base::set_cells_to_meas(const std::set<uint32_t>& pci)
 
 void intra_measure_base::write(cf_t* data, uint32_t nsamples)
 {
-  int nbytes = (int)(nsamples * sizeof(cf_t));
-
   mutex.lock();
-  int required_nbytes = ((int)context.meas_len_ms * (int)context.sf_len * (int)sizeof(cf_t));
+  uint32_t required_len = context.meas_len_ms * context.sf_len;
   mutex.unlock();
 
-  // As nbytes might not match the sub-frame size, make sure that buffer does not overflow
-  nbytes = SRSRAN_MIN(srsran_ringbuffer_space(&ring_buffer), nbytes);
-
-  // Try writing in the buffer
-  if (srsran_ringbuffer_write(&ring_buffer, data, nbytes) < nbytes) {
-    Log(warning, "Error writing to ringbuffer");
+  if (required_len > buffer.size()) {
+    Log(warning, "Measurement length (%d samples) exceeds the buffer size (%zd samples)", required_len, buffer.size());
 
     // Transition to wait, so it can keep receiving without stopping the component operation
     state.set_state(internal_state::wait);
-  } else {
-    // As soon as there are enough samples in the buffer, transition to measure
-    if (srsran_ringbuffer_status(&ring_buffer) >= required_nbytes) {
-      Log(debug, "Starting search and measurements");
-      state.set_state(internal_state::measure);
-    }
+    return;
+  }
+
+  // As nsamples might not match the sub-frame size, make sure that buffer does not overflow
+  nsamples = SRSRAN_MIN(nsamples, required_len - buffer_count);
+  srsran_vec_cf_copy(&buffer[buffer_count], data, nsamples);
+  buffer_count += nsamples;
+
+  // As soon as there are enough samples in the buffer, hand it over to the measurement pool
+  if (buffer_count < required_len) {
+    return;
+  }
+
+  Log(debug, "Starting search and measurements");
+  state.set_measuring(true);
+  state.set_state(internal_state::measure);
+  if (not pool.push_measurement(*this)) {
+    Log(info, "Measurement skipped, the measurement CPU budget is exhausted");
+    state.set_measuring(false);
+    state.set_state(internal_state::wait);
   }
 }
 
@@ -154,11 +154,11 @@ void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples)
       break;
     case internal_state::wait:
     case internal_state::wait_first:
-      // Check measurement trigger condition
-      if (receive_tti_trigger(tti)) {
+      // Check measurement trigger condition, the buffer might still be in use if the FSM has been restarted
+      if (receive_tti_trigger(tti) and not state.is_measuring()) {
         state.set_state(internal_state::receive);
         last_measure_tti = tti;
-        srsran_ringbuffer_reset(&ring_buffer);
+        buffer_count     = 0;
 
         // Write baseband to ensure measurement starts in the right TTI
         Log(debug, "Start writing");
@@ -177,56 +177,26 @@ void intra_measure_base::measure_proc()
   // Grab a copy of the context and pass it to the measure_rat method.
   measure_context_t context_copy = get_context();
 
-  // Read data from buffer and find cells in it
-  int ret = srsran_ringbuffer_read_timed(&ring_buffer,
-                                         search_buffer.data(),
-                                         ((int)context_copy.meas_len_ms * (int)context_copy.sf_len * (int)sizeof(cf_t)),
-                                         1000);
+  // Perform measurements for the actual RAT
+  if (not measure_rat(std::move(context_copy), buffer, rx_gain_offset_db)) {
+    Log(error, "Error measuring RAT");
+  }
+}
 
-  // As this function is called once the ring-buffer has enough data to process, it is not expected to fail
-  if (ret < SRSRAN_SUCCESS) {
-    Log(error, "Ringbuffer read returned %d", ret);
-    return;
+void intra_measure_base::run_measurement()
+{
+  // Skip the measurement if the component is quitting
+  if (state.get_state() != internal_state::quit) {
+    measure_proc();
   }
 
-  // Go to receive before finishing, so new samples can be enqueued before the thread finishes
+  // Prevents transition to wait if state has changed while measuring
   if (state.get_state() == internal_state::measure) {
-    // Prevents transition to wait if state has changed while reading the ring-buffer
     state.set_state(internal_state::wait);
   }
 
-  // Perform measurements for the actual RAT
-  if (not measure_rat(std::move(context_copy), search_buffer, rx_gain_offset_db)) {
-    Log(error, "Error measuring RAT");
-  }
-}
-
-void intra_measure_base::run_thread()
-{
-  bool quit = false;
-
-  do {
-    // Get state
-    internal_state::state_t s = state.get_state();
-    switch (s) {
-      case internal_state::initial:
-      case internal_state::idle:
-      case internal_state::wait:
-      case internal_state::wait_first:
-      case internal_state::receive:
-        // Wait for a different state
-        state.wait_change(s);
-        break;
-      case internal_state::measure:
-        // Run the measurement process
-        measure_proc();
-        break;
-      case internal_state::quit:
-        // Quit loop
-        quit = true;
-        break;
-    }
-  } while (not quit);
+  // Release the buffer
+  state.set_measuring(false);
 }
 
 } // namespace scell
@@ -28,12 +28,16 @@ namespace scell {
     logger.level("INTRA-%s-%d: " fmt, to_string(get_rat()).c_str(), get_earfcn(), ##__VA_ARGS__);                      \
   } while (false)
 
-intra_measure_lte::intra_measure_lte(srslog::basic_logger& logger_, meas_itf& new_cell_itf_) :
-  logger(logger_), scell_rx(logger_), intra_measure_base(logger_, new_cell_itf_)
+intra_measure_lte::intra_measure_lte(srslog::basic_logger& logger_,
+                                     meas_itf&             new_cell_itf_,
+                                     intra_measure_pool&   pool_) :
+  logger(logger_), scell_rx(logger_), intra_measure_base(logger_, new_cell_itf_, pool_)
 {}
 
 intra_measure_lte::~intra_measure_lte()
 {
+  // Wait for any measurement in progress before releasing the RAT specific objects
+  stop();
   scell_rx.deinit();
   srsran_refsignal_dl_sync_free(&refsignal_dl_sync);
 }
@@ -28,12 +28,16 @@
 namespace srsue {
 namespace scell {
 
-intra_measure_nr::intra_measure_nr(srslog::basic_logger& logger_, meas_itf& new_meas_itf_) :
-  logger(logger_), intra_measure_base(logger_, new_meas_itf_)
+intra_measure_nr::intra_measure_nr(srslog::basic_logger& logger_,
+                                   meas_itf&             new_meas_itf_,
+                                   intra_measure_pool&   pool_) :
+  logger(logger_), intra_measure_base(logger_, new_meas_itf_, pool_)
 {}
 
 intra_measure_nr::~intra_measure_nr()
 {
+  // Wait for any measurement in progress before releasing the RAT specific objects
+  stop();
   srsran_ssb_free(&ssb);
 }
 
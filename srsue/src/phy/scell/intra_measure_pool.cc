@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsue/hdr/phy/scell/intra_measure_pool.h"
+#include <time.h>
+
+namespace srsue {
+namespace scell {
+
+static float to_ms(intra_measure_pool::clock::duration d)
+{
+  return std::chrono::duration<float, std::milli>(d).count();
+}
+
+// CPU time consumed by the calling thread. Unlike the wall-clock time, it does not count the time the low priority
+// measurement threads are preempted by the PHY workers
+static std::chrono::nanoseconds thread_cpu_time()
+{
+  struct timespec ts = {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+intra_measure_pool::intra_measure_pool(srslog::basic_logger& logger_) : logger(logger_), workers(1, true) {}
+
+void intra_measure_pool::init(const args_t& args_)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    args         = args_;
+    period_start = clock::now();
+  }
+  workers.set_nof_workers(std::max(args.nof_workers, 1U));
+  workers.start(INTRA_FREQ_MEAS_PRIO);
+}
+
+void intra_measure_pool::stop()
+{
+  workers.stop();
+}
+
+bool intra_measure_pool::push_measurement(measurer_itf& m)
+{
+  clock::time_point t_queued = clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Start a new accounting period, the CPU time of the measurements still in progress counts in the new one
+    if (t_queued - period_start >= std::chrono::milliseconds(args.period_ms)) {
+      logger.debug("INTRA: %d measurements took %.1f ms in the last %d ms",
+                   period_count,
+                   period_spent.count() / 1000.0,
+                   args.period_ms);
+      period_start = t_queued;
+      period_spent = {};
+      period_count = 0;
+    }
+
+    if (args.budget_ms > 0 and period_spent >= std::chrono::milliseconds(args.budget_ms)) {
+      metrics.nof_skipped++;
+      return false;
+    }
+    period_count++;
+  }
+
+  workers.push_task([this, &m, t_queued]() {
+    clock::time_point        t_start   = clock::now();
+    std::chrono::nanoseconds cpu_start = thread_cpu_time();
+    m.run_measurement();
+    account(t_queued, t_start, clock::now(), thread_cpu_time() - cpu_start);
+  });
+  return true;
+}
+
+void intra_measure_pool::account(clock::time_point         t_queued,
+                                 clock::time_point         t_start,
+                                 clock::time_point         t_end,
+                                 std::chrono::nanoseconds cpu_time)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  period_spent += std::chrono::duration_cast<std::chrono::microseconds>(cpu_time);
+
+  float latency_ms       = to_ms(t_end - t_queued);
+  float exec_ms          = to_ms(t_end - t_start);
+  latency_sum_ms        += latency_ms;
+  exec_sum_ms           += exec_ms;
+  metrics.latency_max_ms = std::max(metrics.latency_max_ms, latency_ms);
+  metrics.exec_max_ms    = std::max(metrics.exec_max_ms, exec_ms);
+  metrics.nof_meas++;
+}
+
+intra_measure_pool::metrics_t intra_measure_pool::get_metrics()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  metrics_t ret = metrics;
+  if (ret.nof_meas > 0) {
+    ret.latency_avg_ms = (float)(latency_sum_ms / ret.nof_meas);
+    ret.exec_avg_ms    = (float)(exec_sum_ms / ret.nof_meas);
+  }
+  metrics        = {};
+  latency_sum_ms = 0.0;
+  exec_sum_ms    = 0.0;
+  return ret;
+}
+
+} // namespace scell
+} // namespace srsue
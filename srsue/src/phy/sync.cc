@@ -96,11 +96,17 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
-  // Start intra-frequency measurement
+  // Start intra-frequency measurement, the measurements of all carriers share the same workers and CPU budget
   {
+    scell::intra_measure_pool::args_t pool_args = {};
+    pool_args.nof_workers                       = worker_com->args->intra_freq_meas_nof_workers;
+    pool_args.period_ms                         = worker_com->args->intra_freq_meas_period_ms;
+    pool_args.budget_ms                         = worker_com->args->intra_freq_meas_budget_ms;
+    intra_meas_pool.init(pool_args);
+
     std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
     for (uint32_t i = 0; i < worker_com->args->nof_lte_carriers; i++) {
-      scell::intra_measure_lte*         q    = new scell::intra_measure_lte(phy_logger, *this);
+      scell::intra_measure_lte*         q    = new scell::intra_measure_lte(phy_logger, *this, intra_meas_pool);
       scell::intra_measure_base::args_t args = {};
       args.len_ms                            = worker_com->args->intra_freq_meas_len_ms;
       args.period_ms                         = worker_com->args->intra_freq_meas_period_ms;
@@ -143,6 +149,17 @@ void sync::stop()
   for (auto& q : intra_freq_meas) {
     q->stop();
   }
+  intra_meas_pool.stop();
+
+  scell::intra_measure_pool::metrics_t meas_metrics = intra_meas_pool.get_metrics();
+  phy_logger.info("Intra-frequency measurements: %d done, %d skipped, latency avg=%.1f max=%.1f ms, execution "
+                  "avg=%.1f max=%.1f ms",
+                  meas_metrics.nof_meas,
+                  meas_metrics.nof_skipped,
+                  meas_metrics.latency_avg_ms,
+                  meas_metrics.latency_max_ms,
+                  meas_metrics.exec_avg_ms,
+                  meas_metrics.exec_max_ms);
 
   // Reset (stop Rx stream) as soon as possible to avoid base-band Rx buffer overflow
   radio_h->reset();
@@ -188,8 +188,12 @@ int main(int argc, char** argv)
   // Create measurement callback
   meas_itf_listener rrc;
 
+  // Create measurement pool
+  srsue::scell::intra_measure_pool intra_measure_pool(logger);
+  intra_measure_pool.init({});
+
   // Create measurement object
-  srsue::scell::intra_measure_nr intra_measure(logger, rrc);
+  srsue::scell::intra_measure_nr intra_measure(logger, rrc, intra_measure_pool);
 
   // Initialise measurement instance
   srsue::scell::intra_measure_nr::args_t meas_args = {};
@@ -283,8 +287,9 @@ int main(int argc, char** argv)
   // make sure last measurement has been received before stopping
   intra_measure.wait_meas();
 
-  // Stop, it will block until the asynchronous thread quits
+  // Stop, it will block until the measurement in progress finishes
   intra_measure.stop();
+  intra_measure_pool.stop();
 
   logger.warning("NR intra frequency performance %d Msps\n", intra_measure.get_perf());
   srslog::flush();
@@ -25,9 +25,11 @@
 #include "srsran/interfaces/phy_interface_types.h"
 #include "srsran/radio/radio.h"
 #include "srsran/srslog/srslog.h"
+#include "srsue/hdr/phy/nr/cell_search.h"
 #include "srsue/hdr/phy/scell/intra_measure_nr.h"
 #include <boost/program_options.hpp>
 #include <boost/program_options/parsers.hpp>
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -167,6 +169,10 @@ struct args_t {
   // File parameters
   std::string filename            = "";
   double      file_freq_offset_hz = 0.0;
+
+  // Cell search benchmark parameters
+  bool     search_bench       = false;
+  uint32_t search_repetitions = 10;
 };
 
 class meas_itf_listener : public srsue::scell::intra_measure_base::meas_itf
@@ -289,6 +295,7 @@ int parse_args(int argc, char** argv, args_t& args)
   bpo::options_description over_the_air("Mode 1: Over the air options (Default)");
   bpo::options_description simulation("Mode 2: Simulation options (enabled if simulation_cell_list is not empty)");
   bpo::options_description file("Mode 3: File (enabled if filename is provided)");
+  bpo::options_description search("Mode 4: Cell search benchmark (enabled if search.bench is true)");
 
   // clang-format off
   measure.add_options()
@@ -317,7 +324,12 @@ int parse_args(int argc, char** argv, args_t& args)
       ("file.freq_offset", bpo::value<double>(&args.file_freq_offset_hz)->default_value(args.file_freq_offset_hz), "File name providing baseband")
       ;
 
-  options.add(measure).add(over_the_air).add(simulation).add(file).add_options()
+  search.add_options()
+      ("search.bench",       bpo::value<bool>(&args.search_bench)->default_value(args.search_bench),                 "Compares the time to detect the cells searching the synchronization raster point by point and sweeping it")
+      ("search.repetitions", bpo::value<uint32_t>(&args.search_repetitions)->default_value(args.search_repetitions), "Number of times the synchronization raster is searched")
+      ;
+
+  options.add(measure).add(over_the_air).add(simulation).add(file).add(search).add_options()
       ("help,h",        "Show this message")
       ("log_level",     bpo::value<std::string>(&args.log_level)->default_value(args.log_level),    "Intra measurement log level (none, warning, info, debug)")
       ("duration",      bpo::value<uint32_t>(&args.duration_s)->default_value(args.duration_s),     "Duration of the test in seconds")
@@ -357,6 +369,123 @@ int parse_args(int argc, char** argv, args_t& args)
   return ret;
 }
 
+static int search_benchmark(const args_t&         args,
+                            srslog::basic_logger& logger,
+                            uint16_t              band,
+                            double                center_freq_hz,
+                            double                ssb_freq_hz)
+{
+  srsran::srsran_band_helper bands;
+  uint32_t                   sf_len  = (uint32_t)round(args.srate_hz / 1000.0);
+  uint32_t                   slot_sz = sf_len * SRSRAN_NOF_SF_X_FRAME / 2;
+  TESTASSERT(not args.pcis_to_simulate.empty());
+
+  // Select the synchronization raster points whose SSB fits in the base-band and is in the subcarrier grid
+  std::vector<double>                       raster_hz;
+  double                                    ssb_scs_hz = SRSRAN_SUBC_SPACING_NR(args.ssb_scs);
+  srsran::srsran_band_helper::sync_raster_t ss         = bands.get_sync_raster(band, args.ssb_scs);
+  TESTASSERT(ss.valid());
+  for (; not ss.end(); ss.next()) {
+    double offset_hz = ss.get_frequency() - center_freq_hz;
+    if (std::abs(offset_hz) <= (args.srate_hz - SRSRAN_SSB_BW_SUBC * ssb_scs_hz) / 2.0 and
+        std::fmod(std::abs(offset_hz), ssb_scs_hz) == 0.0) {
+      raster_hz.push_back(ss.get_frequency());
+    }
+  }
+
+  // Capture a half radio frame from the simulated cells, with an extra subframe for the SSB at the end of the search
+  std::vector<cf_t> capture(slot_sz + sf_len);
+  std::vector<cf_t> sf_buffer(sf_len);
+  {
+    std::vector<std::unique_ptr<test_gnb> > test_gnb_v;
+    for (const uint32_t& pci : args.pcis_to_simulate) {
+      test_gnb::args_t gnb_args = {};
+      gnb_args.pci              = pci;
+      gnb_args.srate_hz         = args.srate_hz;
+      gnb_args.center_freq_hz   = center_freq_hz;
+      gnb_args.ssb_freq_hz      = ssb_freq_hz;
+      gnb_args.ssb_scs          = args.ssb_scs;
+      gnb_args.ssb_period_ms    = args.ssb_period_ms;
+      gnb_args.band             = band;
+      gnb_args.log_level        = args.log_level;
+      test_gnb_v.push_back(std::unique_ptr<test_gnb>(new test_gnb(gnb_args)));
+    }
+
+    srsran::rf_timestamp_t ts = {};
+    for (uint32_t sf_idx = 0; sf_idx < capture.size() / sf_len; sf_idx++) {
+      srsran_vec_cf_zero(sf_buffer.data(), sf_len);
+      for (auto& gnb : test_gnb_v) {
+        TESTASSERT(gnb->work(sf_idx, sf_buffer, ts) == SRSRAN_SUCCESS);
+      }
+      srsran_vec_cf_copy(&capture[sf_idx * sf_len], sf_buffer.data(), sf_len);
+      ts.add(0.001);
+    }
+  }
+
+  // Initialise cell search
+  srsue::nr::cell_search         searcher(logger);
+  srsue::nr::cell_search::args_t cs_args = {};
+  cs_args.max_srate_hz                   = args.srate_hz;
+  cs_args.ssb_min_scs                    = args.ssb_scs;
+  TESTASSERT(searcher.init(cs_args));
+
+  srsue::nr::cell_search::cfg_t cs_cfg = {};
+  cs_cfg.srate_hz                      = args.srate_hz;
+  cs_cfg.center_freq_hz                = center_freq_hz;
+  cs_cfg.ssb_scs                       = args.ssb_scs;
+  cs_cfg.ssb_pattern                   = bands.get_ssb_pattern(band, args.ssb_scs);
+  cs_cfg.duplex_mode                   = bands.get_duplex_mode(band);
+
+  // Asserts a cell search result found one of the simulated cells at the SSB frequency
+  auto assert_found = [&args, ssb_freq_hz](const srsue::nr::cell_search::ret_t& ret) {
+    TESTASSERT(ret.result == srsue::nr::cell_search::ret_t::CELL_FOUND);
+    TESTASSERT(args.pcis_to_simulate.count(ret.ssb_res.N_id) > 0);
+    TESTASSERT(std::abs(ret.ssb_freq_hz - ssb_freq_hz) < 1.0);
+    return SRSRAN_SUCCESS;
+  };
+
+  using clock = std::chrono::steady_clock;
+
+  double t_detect_us = 0.0;
+  double t_raster_us = 0.0;
+  double t_sweep_us  = 0.0;
+  for (uint32_t rep = 0; rep < args.search_repetitions; rep++) {
+    // Search every raster point, as the UE does tuning the radio to each of them
+    clock::time_point t_start = clock::now();
+    bool              found   = false;
+    for (double freq_hz : raster_hz) {
+      cs_cfg.ssb_freq_hz = freq_hz;
+      TESTASSERT(searcher.start(cs_cfg));
+      srsue::nr::cell_search::ret_t ret = searcher.run_slot(capture.data(), slot_sz);
+      TESTASSERT(ret.result != srsue::nr::cell_search::ret_t::ERROR);
+      if (not found and ret.result == srsue::nr::cell_search::ret_t::CELL_FOUND) {
+        TESTASSERT(assert_found(ret) == SRSRAN_SUCCESS);
+        t_detect_us += std::chrono::duration<double, std::micro>(clock::now() - t_start).count();
+        found = true;
+      }
+    }
+    t_raster_us += std::chrono::duration<double, std::micro>(clock::now() - t_start).count();
+    TESTASSERT(found);
+
+    // Sweep all the raster points in the same capture
+    t_start             = clock::now();
+    cs_cfg.ssb_freqs_hz = raster_hz;
+    TESTASSERT(searcher.start(cs_cfg));
+    TESTASSERT(assert_found(searcher.run_slot(capture.data(), slot_sz)) == SRSRAN_SUCCESS);
+    t_sweep_us += std::chrono::duration<double, std::micro>(clock::now() - t_start).count();
+    cs_cfg.ssb_freqs_hz.clear();
+  }
+
+  double nof_reps = (double)SRSRAN_MAX(args.search_repetitions, 1);
+  printf("Cell search of %d raster points: point by point %.1f ms (detected in %.1f ms); sweep %.1f ms;\n",
+         (uint32_t)raster_hz.size(),
+         t_raster_us / nof_reps / 1000.0,
+         t_detect_us / nof_reps / 1000.0,
+         t_sweep_us / nof_reps / 1000.0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret;
@@ -384,14 +513,23 @@ int main(int argc, char** argv)
                center_freq_hz / 1e6,
                ssb_freq_hz / 1e6);
 
+  // Run cell search benchmark instead of measuring
+  if (args.search_bench) {
+    return search_benchmark(args, logger, band, center_freq_hz, ssb_freq_hz);
+  }
+
   // Allocate buffer
   std::vector<cf_t> baseband_buffer(sf_len);
 
   // Create measurement callback
   meas_itf_listener rrc;
 
+  // Create measurement pool
+  srsue::scell::intra_measure_pool intra_measure_pool(logger);
+  intra_measure_pool.init({});
+
   // Create measurement instance
-  srsue::scell::intra_measure_nr intra_measure(logger, rrc);
+  srsue::scell::intra_measure_nr intra_measure(logger, rrc, intra_measure_pool);
 
   // Initialise measurement instance
   srsue::scell::intra_measure_nr::args_t meas_args = {};
@@ -526,8 +664,9 @@ int main(int argc, char** argv)
     intra_measure.wait_meas();
   }
 
-  // Stop, it will block until the asynchronous thread quits
+  // Stop, it will block until the measurement in progress finishes
   intra_measure.stop();
+  intra_measure_pool.stop();
 
   logger.warning("NR intra frequency performance %d Msps\n", intra_measure.get_perf());
 
@@ -457,10 +457,11 @@ int main(int argc, char** argv)
   json_channel.set_enabled(enable_json_report);
   srslog::init();
 
-  cf_t*                           baseband_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
-  srsran::rf_timestamp_t          ts              = {};
-  meas_itf_listener               rrc(json_channel);
-  srsue::scell::intra_measure_lte intra_measure(logger, rrc);
+  cf_t*                            baseband_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
+  srsran::rf_timestamp_t           ts              = {};
+  meas_itf_listener                rrc(json_channel);
+  srsue::scell::intra_measure_pool intra_measure_pool(logger);
+  srsue::scell::intra_measure_lte  intra_measure(logger, rrc, intra_measure_pool);
 
   // Simulation only
   std::vector<std::unique_ptr<test_enb> > test_enb_v;
@@ -528,6 +529,10 @@ int main(int argc, char** argv)
 
   logger.set_level(srslog::str_to_basic_level(intra_meas_log_level));
 
+  srsue::scell::intra_measure_pool::args_t pool_args = {};
+  pool_args.period_ms                                = phy_args.intra_freq_meas_period_ms;
+  intra_measure_pool.init(pool_args);
+
   srsue::scell::intra_measure_base::args_t args = {};
   args.len_ms                                   = phy_args.intra_freq_meas_len_ms;
   args.period_ms                                = phy_args.intra_freq_meas_period_ms;
@@ -709,8 +714,18 @@ int main(int argc, char** argv)
     intra_measure.wait_meas();
   }
 
-  // Stop, it will block until the asynchronous thread quits
+  // Stop, it will block until the measurement in progress finishes
   intra_measure.stop();
+  intra_measure_pool.stop();
+
+  srsue::scell::intra_measure_pool::metrics_t meas_metrics = intra_measure_pool.get_metrics();
+  printf("Measurements: %d done, %d skipped, latency avg=%.1f max=%.1f ms, execution avg=%.1f max=%.1f ms\n",
+         meas_metrics.nof_meas,
+         meas_metrics.nof_skipped,
+         meas_metrics.latency_avg_ms,
+         meas_metrics.latency_max_ms,
+         meas_metrics.exec_avg_ms,
+         meas_metrics.exec_max_ms);
 
   ret = rrc.print_stats() ? SRSRAN_SUCCESS : SRSRAN_ERROR;
 
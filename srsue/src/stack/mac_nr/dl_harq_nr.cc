@@ -166,9 +166,9 @@ dl_harq_entity_nr::dl_harq_process_nr::~dl_harq_process_nr()
 
 bool dl_harq_entity_nr::dl_harq_process_nr::init(int pid_)
 {
-  if (softbuffer_rx == nullptr || srsran_softbuffer_rx_init_guru(softbuffer_rx.get(),
-                                                                 SRSRAN_SCH_NR_MAX_NOF_CB_LDPC,
-                                                                 SRSRAN_LDPC_MAX_LEN_ENCODED_CB) != SRSRAN_SUCCESS) {
+  if (softbuffer_rx == nullptr ||
+      srsran_softbuffer_rx_init_guru_8bit(
+          softbuffer_rx.get(), SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) != SRSRAN_SUCCESS) {
     logger.error("Couldn't allocate and/or initialize softbuffer");
     return false;
   }
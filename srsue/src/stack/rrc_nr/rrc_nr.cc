@@ -736,18 +736,19 @@ int rrc_nr::send_ue_capability_info(const asn1::rrc_nr::ue_cap_enquiry_s& msg)
       ue_cap.rlc_params.um_with_short_sn_present = true;
       ue_cap.rlc_params.um_with_long_sn_present  = true;
 
-      // PDCP parameters
-      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0000 = false;
-      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0001 = false;
-      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0002 = false;
+      // PDCP parameters. ROHC profiles implemented by the PDCP header compressor (uncompressed, RTP, UDP and IP)
+      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0000 = true;
+      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0001 = true;
+      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0002 = true;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0003 = false;
-      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0004 = false;
+      ue_cap.pdcp_params.supported_rohc_profiles.profile0x0004 = true;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0006 = false;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0101 = false;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0102 = false;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0103 = false;
       ue_cap.pdcp_params.supported_rohc_profiles.profile0x0104 = false;
-      ue_cap.pdcp_params.max_num_rohc_context_sessions.value   = pdcp_params_s::max_num_rohc_context_sessions_opts::cs2;
+
+      ue_cap.pdcp_params.max_num_rohc_context_sessions = pdcp_params_s::max_num_rohc_context_sessions_opts::cs16;
 
       if (args.pdcp_short_sn_support) {
         ue_cap.pdcp_params.short_sn_present = true;
@@ -42,8 +42,8 @@ public:
   dummy_rx_harq_proc() : data(0)
   {
     // Initialise softbuffer
-    if (srsran_softbuffer_rx_init_guru(&softbuffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-        SRSRAN_SUCCESS) {
+    if (srsran_softbuffer_rx_init_guru_8bit(
+            &softbuffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
       ERROR("Error Tx buffer");
     }
   }